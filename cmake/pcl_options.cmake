@@ -30,6 +30,10 @@ mark_as_advanced(PCL_ONLY_CORE_POINT_TYPES)
 option(PCL_NO_PRECOMPILE "Do not precompile PCL code for any point types at all." OFF)
 mark_as_advanced(PCL_NO_PRECOMPILE)
 
+# Record timings of the main algorithms in pcl::profiling::Registry
+option(PCL_ENABLE_PROFILING "Instrument PCL algorithms with the profiling registry of pcl/common/profiler.h." OFF)
+mark_as_advanced(PCL_ENABLE_PROFILING)
+
 # Enable or Disable the check for SSE optimizations
 option(PCL_ENABLE_SSE "Enable or Disable SSE optimizations." ON)
 mark_as_advanced(PCL_ENABLE_SSE)
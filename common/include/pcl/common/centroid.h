@@ -163,6 +163,54 @@ namespace pcl
     return (compute3DCentroid <PointT, double> (cloud, indices, centroid));
   }
 
+  /** \brief Compute the 3D bounding box and the 3D (X-Y-Z) centroid of a set of points in a single pass.
+    * \param[in] cloud the input point cloud
+    * \param[out] min_pt the resultant minimum bounds, as returned by getMinMax3D
+    * \param[out] max_pt the resultant maximum bounds, as returned by getMinMax3D
+    * \param[out] centroid the output centroid
+    * \return number of valid (finite) points used to determine the bounds and the centroid.
+    * \note if return value is 0, the centroid is not changed, thus not valid.
+    * \ingroup common
+    */
+  template <typename PointT, typename Scalar> inline unsigned int
+  computeBoundsAndCentroid (const pcl::PointCloud<PointT> &cloud,
+                            Eigen::Vector4f &min_pt, Eigen::Vector4f &max_pt,
+                            Eigen::Matrix<Scalar, 4, 1> &centroid);
+
+  /** \brief Compute the 3D bounding box and the 3D (X-Y-Z) centroid of a set of points using their
+    * indices in a single pass.
+    * \param[in] cloud the input point cloud
+    * \param[in] indices the point cloud indices that need to be used
+    * \param[out] min_pt the resultant minimum bounds, as returned by getMinMax3D
+    * \param[out] max_pt the resultant maximum bounds, as returned by getMinMax3D
+    * \param[out] centroid the output centroid
+    * \return number of valid (finite) points used to determine the bounds and the centroid.
+    * \note if return value is 0, the centroid is not changed, thus not valid.
+    * \ingroup common
+    */
+  template <typename PointT, typename Scalar> inline unsigned int
+  computeBoundsAndCentroid (const pcl::PointCloud<PointT> &cloud,
+                            const std::vector<int> &indices,
+                            Eigen::Vector4f &min_pt, Eigen::Vector4f &max_pt,
+                            Eigen::Matrix<Scalar, 4, 1> &centroid);
+
+  /** \brief Compute the 3D bounding box and the 3D (X-Y-Z) centroid of a set of points using their
+    * indices in a single pass.
+    * \param[in] cloud the input point cloud
+    * \param[in] indices the point cloud indices that need to be used
+    * \param[out] min_pt the resultant minimum bounds, as returned by getMinMax3D
+    * \param[out] max_pt the resultant maximum bounds, as returned by getMinMax3D
+    * \param[out] centroid the output centroid
+    * \return number of valid (finite) points used to determine the bounds and the centroid.
+    * \note if return value is 0, the centroid is not changed, thus not valid.
+    * \ingroup common
+    */
+  template <typename PointT, typename Scalar> inline unsigned int
+  computeBoundsAndCentroid (const pcl::PointCloud<PointT> &cloud,
+                            const pcl::PointIndices &indices,
+                            Eigen::Vector4f &min_pt, Eigen::Vector4f &max_pt,
+                            Eigen::Matrix<Scalar, 4, 1> &centroid);
+
   /** \brief Compute the 3x3 covariance matrix of a given set of points.
     * The result is returned as a Eigen::Matrix3f.
     * Note: the covariance matrix is not normalized with the number of
@@ -489,6 +537,63 @@ namespace pcl
     return (computeMeanAndCovarianceMatrix<PointT, double> (cloud, indices, covariance_matrix, centroid));
   }
 
+  /** \brief Compute the normalized 3x3 covariance matrices and the centroids of many small
+    * neighborhoods in one pass, e.g. the k nearest neighbors of every point of a cloud.
+    *
+    * The neighborhoods are given in compressed sparse row form: neighborhood q consists of the
+    * points indices[offsets[q]] ... indices[offsets[q+1] - 1], so offsets holds one entry more than
+    * there are neighborhoods. For each neighborhood the result equals the one of
+    * computeMeanAndCovarianceMatrix (cloud, neighborhood indices, ...), but the coordinates are
+    * accumulated relative to the first valid point, which keeps the float version accurate for
+    * neighborhoods far away from the origin. The moments are summed with SSE2 if available and the
+    * neighborhoods are distributed over nr_threads OpenMP threads if compiled with OpenMP.
+    * \param[in] cloud the input point cloud
+    * \param[in] offsets the start of each neighborhood in indices, followed by indices.size ()
+    * \param[in] indices the concatenated point indices of all neighborhoods
+    * \param[out] covariance_matrices the resultant 3x3 covariance matrix of each neighborhood
+    * \param[out] centroids the centroid of each neighborhood
+    * \param[out] point_counts the number of valid points in each neighborhood; the covariance
+    * matrix and the centroid of a neighborhood without valid points are set to zero
+    * \param[in] nr_threads the number of threads to use, 0 for all available cores
+    * \ingroup common
+    */
+  template <typename PointT, typename Scalar> void
+  computeMeanAndCovarianceMatrices (const pcl::PointCloud<PointT> &cloud,
+                                    const std::vector<int> &offsets,
+                                    const std::vector<int> &indices,
+                                    std::vector<Eigen::Matrix<Scalar, 3, 3>, Eigen::aligned_allocator<Eigen::Matrix<Scalar, 3, 3> > > &covariance_matrices,
+                                    std::vector<Eigen::Matrix<Scalar, 4, 1>, Eigen::aligned_allocator<Eigen::Matrix<Scalar, 4, 1> > > &centroids,
+                                    std::vector<unsigned int> &point_counts,
+                                    unsigned int nr_threads = 0);
+
+  /** \brief Compute the centroid and the eigenvector of the smallest eigenvalue of the covariance
+    * matrix (i.e. the surface normal) of many small neighborhoods in one pass.
+    *
+    * Fuses computeMeanAndCovarianceMatrices with pcl::eigen33Batch, which solves the covariance
+    * matrices of blocks of neighborhoods together. The neighborhoods are given as for
+    * computeMeanAndCovarianceMatrices. Neighborhoods with less than 3 valid points get NaN
+    * eigenvectors, eigenvalues and curvatures, like computePointNormal.
+    * \param[in] cloud the input point cloud
+    * \param[in] offsets the start of each neighborhood in indices, followed by indices.size ()
+    * \param[in] indices the concatenated point indices of all neighborhoods
+    * \param[out] centroids the centroid of each neighborhood
+    * \param[out] eigen_vectors the unit eigenvector of the smallest eigenvalue of each neighborhood
+    * \param[out] eigen_values the smallest eigenvalue of each neighborhood
+    * \param[out] curvatures the surface curvature of each neighborhood, i.e. the smallest eigenvalue
+    * divided by the sum of all eigenvalues
+    * \param[in] nr_threads the number of threads to use, 0 for all available cores
+    * \ingroup common
+    */
+  template <typename PointT, typename Scalar> void
+  computeSmallestEigenVectors (const pcl::PointCloud<PointT> &cloud,
+                               const std::vector<int> &offsets,
+                               const std::vector<int> &indices,
+                               std::vector<Eigen::Matrix<Scalar, 4, 1>, Eigen::aligned_allocator<Eigen::Matrix<Scalar, 4, 1> > > &centroids,
+                               std::vector<Eigen::Matrix<Scalar, 3, 1>, Eigen::aligned_allocator<Eigen::Matrix<Scalar, 3, 1> > > &eigen_vectors,
+                               std::vector<Scalar> &eigen_values,
+                               std::vector<Scalar> &curvatures,
+                               unsigned int nr_threads = 0);
+
   /** \brief Compute the normalized 3x3 covariance matrix for a already demeaned point cloud.
     * Normalized means that every entry has been divided by the number of entries in indices.
     * For small number of points, or if you want explicitely the sample-variance, scale the covariance matrix
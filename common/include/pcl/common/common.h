@@ -41,6 +41,13 @@
 #include <pcl/pcl_base.h>
 #include <cfloat>
 
+/** \brief Number of points from which getMinMax3D, compute3DCentroid, computeBoundsAndCentroid
+  * and demeanPointCloud split their work over OpenMP threads.
+  */
+#ifndef PCL_COMMON_PARALLEL_MIN_POINTS
+#define PCL_COMMON_PARALLEL_MIN_POINTS 100000
+#endif
+
 /**
   * \file pcl/common/common.h
   * Define standard C methods and C++ classes that are common to all methods
@@ -542,6 +542,28 @@ namespace pcl
     evals *= scale;
   }
 
+  /** \brief determines the eigenvalues and one selected eigenvector of many symmetric positive semi definite
+    * 3x3 matrices, stored as structure of arrays.
+    *
+    * Row i of mats holds the upper triangle (xx, xy, xz, yy, yz, zz) of the i-th matrix. Since Eigen matrices are
+    * column major, each coefficient is contiguous in memory, which lets the float version process four matrices per
+    * SSE2 instruction. The double version, and the float version without SSE2, solve one matrix after the other and
+    * give exactly the result of eigen33 (mat, evals) and of eigen33 (mat, eigenvalue, eigenvector) for index 0.
+    * The SSE2 version evaluates the trigonometric functions with polynomial approximations; its eigenvalues differ from
+    * the scalar ones by a few float epsilons relative to the largest coefficient of the matrix, and so do its
+    * eigenvectors whenever the selected eigenvalue is well separated from the other two.
+    * \param[in] mats n x 6 matrix of upper triangles
+    * \param[in] index which eigenvector to compute: 0 for the one of the smallest eigenvalue, 2 for the largest
+    * \param[out] evals n x 3 matrix of eigenvalues in ascending order
+    * \param[out] evecs n x 3 matrix of the selected unit eigenvectors
+    * \note if the selected eigenvalue is not unique, any eigenvector that is consistent to it may be returned.
+    * \ingroup common
+    */
+  template <typename Scalar> void
+  eigen33Batch (const Eigen::Matrix<Scalar, Eigen::Dynamic, 6> &mats, int index,
+                Eigen::Matrix<Scalar, Eigen::Dynamic, 3> &evals,
+                Eigen::Matrix<Scalar, Eigen::Dynamic, 3> &evecs);
+
   /** \brief Calculate the inverse of a 2x2 matrix
     * \param[in] matrix matrix to be inverted
     * \param[out] inverse the resultant inverted matrix
@@ -42,8 +42,16 @@
 #define PCL_COMMON_IMPL_CENTROID_H_
 
 #include <pcl/common/centroid.h>
+#include <pcl/common/common.h>
+#include <pcl/common/eigen.h>
 #include <pcl/conversions.h>
 #include <boost/mpl/size.hpp>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 ///////////////////////////////////////////////////////////////////////////////////////////
 template <typename PointT, typename Scalar> inline unsigned int
@@ -83,43 +91,15 @@ pcl::compute3DCentroid (const pcl::PointCloud<PointT> &cloud,
   if (cloud.empty ())
     return (0);
 
-  // Initialize to 0
-  centroid.setZero ();
-  // For each point in the cloud
-  // If the data is dense, we don't need to check for NaN
-  if (cloud.is_dense)
-  {
-    for (size_t i = 0; i < cloud.size (); ++i)
-    {
-      centroid[0] += cloud[i].x;
-      centroid[1] += cloud[i].y;
-      centroid[2] += cloud[i].z;
-    }
-    centroid[3] = 0;
-    centroid /= static_cast<Scalar> (cloud.size ());
-
-    return (static_cast<unsigned int> (cloud.size ()));
-  }
-  // NaN or Inf values could exist => check for them
-  else
-  {
-    unsigned cp = 0;
-    for (size_t i = 0; i < cloud.size (); ++i)
-    {
-      // Check if the point is invalid
-      if (!isFinite (cloud [i]))
-        continue;
-
-      centroid[0] += cloud[i].x;
-      centroid[1] += cloud[i].y;
-      centroid[2] += cloud[i].z;
-      ++cp;
-    }
-    centroid[3] = 0;
-    centroid /= static_cast<Scalar> (cp);
-
-    return (cp);
-  }
+  // The bounds come for free with the sums, dense and non-dense clouds take separate paths
+  detail::BoundsAndSum moments;
+  detail::computeBoundsAndSum (cloud, static_cast<const int*> (0), cloud.size (), moments);
+  if (moments.count == 0)
+    return (0);
+  for (int d = 0; d < 3; ++d)
+    centroid[d] = static_cast<Scalar> (moments.sum[d] / static_cast<double> (moments.count));
+  centroid[3] = 0;
+  return (static_cast<unsigned int> (moments.count));
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -131,40 +111,14 @@ pcl::compute3DCentroid (const pcl::PointCloud<PointT> &cloud,
   if (indices.empty ())
     return (0);
 
-  // Initialize to 0
-  centroid.setZero ();
-  // If the data is dense, we don't need to check for NaN
-  if (cloud.is_dense)
-  {
-    for (size_t i = 0; i < indices.size (); ++i)
-    {
-      centroid[0] += cloud[indices[i]].x;
-      centroid[1] += cloud[indices[i]].y;
-      centroid[2] += cloud[indices[i]].z;
-    }
-    centroid[3] = 0;
-    centroid /= static_cast<Scalar> (indices.size ());
-    return (static_cast<unsigned int> (indices.size ()));
-  }
-  // NaN or Inf values could exist => check for them
-  else
-  {
-    unsigned cp = 0;
-    for (size_t i = 0; i < indices.size (); ++i)
-    {
-      // Check if the point is invalid
-      if (!isFinite (cloud [indices[i]]))
-        continue;
-
-      centroid[0] += cloud[indices[i]].x;
-      centroid[1] += cloud[indices[i]].y;
-      centroid[2] += cloud[indices[i]].z;
-      ++cp;
-    }
-    centroid[3] = 0;
-    centroid /= static_cast<Scalar> (cp);
-    return (cp);
-  }
+  detail::BoundsAndSum moments;
+  detail::computeBoundsAndSum (cloud, &indices[0], indices.size (), moments);
+  if (moments.count == 0)
+    return (0);
+  for (int d = 0; d < 3; ++d)
+    centroid[d] = static_cast<Scalar> (moments.sum[d] / static_cast<double> (moments.count));
+  centroid[3] = 0;
+  return (static_cast<unsigned int> (moments.count));
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////
@@ -176,6 +130,54 @@ pcl::compute3DCentroid (const pcl::PointCloud<PointT> &cloud,
   return (pcl::compute3DCentroid (cloud, indices.indices, centroid));
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////////
+template <typename PointT, typename Scalar> inline unsigned int
+pcl::computeBoundsAndCentroid (const pcl::PointCloud<PointT> &cloud,
+                               Eigen::Vector4f &min_pt, Eigen::Vector4f &max_pt,
+                               Eigen::Matrix<Scalar, 4, 1> &centroid)
+{
+  detail::BoundsAndSum moments;
+  detail::computeBoundsAndSum (cloud, static_cast<const int*> (0), cloud.size (), moments);
+  min_pt = Eigen::Vector4f::Map (moments.min_p);
+  max_pt = Eigen::Vector4f::Map (moments.max_p);
+  if (moments.count == 0)
+    return (0);
+  for (int d = 0; d < 3; ++d)
+    centroid[d] = static_cast<Scalar> (moments.sum[d] / static_cast<double> (moments.count));
+  centroid[3] = 0;
+  return (static_cast<unsigned int> (moments.count));
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+template <typename PointT, typename Scalar> inline unsigned int
+pcl::computeBoundsAndCentroid (const pcl::PointCloud<PointT> &cloud,
+                               const std::vector<int> &indices,
+                               Eigen::Vector4f &min_pt, Eigen::Vector4f &max_pt,
+                               Eigen::Matrix<Scalar, 4, 1> &centroid)
+{
+  detail::BoundsAndSum moments;
+  detail::computeBoundsAndSum (cloud, indices.empty () ? static_cast<const int*> (0) : &indices[0],
+                               indices.size (), moments);
+  min_pt = Eigen::Vector4f::Map (moments.min_p);
+  max_pt = Eigen::Vector4f::Map (moments.max_p);
+  if (moments.count == 0)
+    return (0);
+  for (int d = 0; d < 3; ++d)
+    centroid[d] = static_cast<Scalar> (moments.sum[d] / static_cast<double> (moments.count));
+  centroid[3] = 0;
+  return (static_cast<unsigned int> (moments.count));
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+template <typename PointT, typename Scalar> inline unsigned int
+pcl::computeBoundsAndCentroid (const pcl::PointCloud<PointT> &cloud,
+                               const pcl::PointIndices &indices,
+                               Eigen::Vector4f &min_pt, Eigen::Vector4f &max_pt,
+                               Eigen::Matrix<Scalar, 4, 1> &centroid)
+{
+  return (pcl::computeBoundsAndCentroid (cloud, indices.indices, min_pt, max_pt, centroid));
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////////
 template <typename PointT, typename Scalar> inline unsigned
 pcl::computeCovarianceMatrix (const pcl::PointCloud<PointT> &cloud,
@@ -627,6 +629,271 @@ pcl::computeMeanAndCovarianceMatrix (const pcl::PointCloud<PointT> &cloud,
   return (computeMeanAndCovarianceMatrix (cloud, indices.indices, covariance_matrix, centroid));
 }
 
+namespace pcl
+{
+  namespace detail
+  {
+    /** \brief Adds the sums of xx, xy, xz, yy, yz, zz, x, y and z over n points given as
+      * separate coordinate arrays to accu (same order as computeMeanAndCovarianceMatrix).
+      */
+    template <typename Scalar> inline void
+    accumulateMoments (const Scalar *x, const Scalar *y, const Scalar *z, size_t n, Scalar *accu)
+    {
+      for (size_t i = 0; i < n; ++i)
+      {
+        accu [0] += x[i] * x[i];
+        accu [1] += x[i] * y[i];
+        accu [2] += x[i] * z[i];
+        accu [3] += y[i] * y[i];
+        accu [4] += y[i] * z[i];
+        accu [5] += z[i] * z[i];
+        accu [6] += x[i];
+        accu [7] += y[i];
+        accu [8] += z[i];
+      }
+    }
+
+#if defined(__SSE2__)
+    inline void
+    accumulateMoments (const float *x, const float *y, const float *z, size_t n, float *accu)
+    {
+      __m128 sum[9];
+      for (int k = 0; k < 9; ++k)
+        sum[k] = _mm_setzero_ps ();
+      size_t i = 0;
+      for (; i + 4 <= n; i += 4)
+      {
+        const __m128 px = _mm_loadu_ps (x + i), py = _mm_loadu_ps (y + i), pz = _mm_loadu_ps (z + i);
+        sum[0] = _mm_add_ps (sum[0], _mm_mul_ps (px, px));
+        sum[1] = _mm_add_ps (sum[1], _mm_mul_ps (px, py));
+        sum[2] = _mm_add_ps (sum[2], _mm_mul_ps (px, pz));
+        sum[3] = _mm_add_ps (sum[3], _mm_mul_ps (py, py));
+        sum[4] = _mm_add_ps (sum[4], _mm_mul_ps (py, pz));
+        sum[5] = _mm_add_ps (sum[5], _mm_mul_ps (pz, pz));
+        sum[6] = _mm_add_ps (sum[6], px);
+        sum[7] = _mm_add_ps (sum[7], py);
+        sum[8] = _mm_add_ps (sum[8], pz);
+      }
+      float lanes[4];
+      for (int k = 0; k < 9; ++k)
+      {
+        _mm_storeu_ps (lanes, sum[k]);
+        accu [k] += (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+      }
+      accumulateMoments<float> (x + i, y + i, z + i, n - i, accu);
+    }
+
+    inline void
+    accumulateMoments (const double *x, const double *y, const double *z, size_t n, double *accu)
+    {
+      __m128d sum[9];
+      for (int k = 0; k < 9; ++k)
+        sum[k] = _mm_setzero_pd ();
+      size_t i = 0;
+      for (; i + 2 <= n; i += 2)
+      {
+        const __m128d px = _mm_loadu_pd (x + i), py = _mm_loadu_pd (y + i), pz = _mm_loadu_pd (z + i);
+        sum[0] = _mm_add_pd (sum[0], _mm_mul_pd (px, px));
+        sum[1] = _mm_add_pd (sum[1], _mm_mul_pd (px, py));
+        sum[2] = _mm_add_pd (sum[2], _mm_mul_pd (px, pz));
+        sum[3] = _mm_add_pd (sum[3], _mm_mul_pd (py, py));
+        sum[4] = _mm_add_pd (sum[4], _mm_mul_pd (py, pz));
+        sum[5] = _mm_add_pd (sum[5], _mm_mul_pd (pz, pz));
+        sum[6] = _mm_add_pd (sum[6], px);
+        sum[7] = _mm_add_pd (sum[7], py);
+        sum[8] = _mm_add_pd (sum[8], pz);
+      }
+      double lanes[2];
+      for (int k = 0; k < 9; ++k)
+      {
+        _mm_storeu_pd (lanes, sum[k]);
+        accu [k] += lanes[0] + lanes[1];
+      }
+      accumulateMoments<double> (x + i, y + i, z + i, n - i, accu);
+    }
+#endif
+
+    /** \brief Computes the centroid and the normalized covariance matrix of the valid points
+      * indices[begin] ... indices[end - 1] of cloud, using buffer as scratch memory.
+      * \return the number of valid points; centroid and covariance_matrix are zero if there are none
+      */
+    template <typename PointT, typename Scalar> unsigned int
+    computeNeighborhoodMoments (const pcl::PointCloud<PointT> &cloud,
+                                const std::vector<int> &indices, int begin, int end,
+                                std::vector<Scalar> &buffer,
+                                Eigen::Matrix<Scalar, 3, 3> &covariance_matrix,
+                                Eigen::Matrix<Scalar, 4, 1> &centroid)
+    {
+      // An empty neighborhood has no valid points, callers turn it into a NaN normal and curvature
+      if (end <= begin)
+      {
+        covariance_matrix.setZero ();
+        centroid.setZero ();
+        return (0);
+      }
+
+      const size_t size = static_cast<size_t> (end - begin);
+      if (buffer.size () < 3 * size)
+        buffer.resize (3 * size);
+      Scalar *x = &buffer[0], *y = x + size, *z = y + size;
+
+      // Gather the valid points relative to the first one into separate coordinate arrays
+      size_t n = 0;
+      Scalar shift[3] = {0, 0, 0};
+      for (int i = begin; i < end; ++i)
+      {
+        const PointT &p = cloud[indices[i]];
+        if (!cloud.is_dense && !isFinite (p))
+          continue;
+        if (n == 0)
+        {
+          shift[0] = p.x; shift[1] = p.y; shift[2] = p.z;
+        }
+        x[n] = static_cast<Scalar> (p.x) - shift[0];
+        y[n] = static_cast<Scalar> (p.y) - shift[1];
+        z[n] = static_cast<Scalar> (p.z) - shift[2];
+        ++n;
+      }
+
+      if (n == 0)
+      {
+        covariance_matrix.setZero ();
+        centroid.setZero ();
+        return (0);
+      }
+
+      Scalar accu[9] = {0, 0, 0, 0, 0, 0, 0, 0, 0};
+      accumulateMoments (x, y, z, n, accu);
+      for (int k = 0; k < 9; ++k)
+        accu[k] /= static_cast<Scalar> (n);
+
+      centroid[0] = accu[6] + shift[0]; centroid[1] = accu[7] + shift[1]; centroid[2] = accu[8] + shift[2];
+      centroid[3] = 0;
+      covariance_matrix.coeffRef (0) = accu [0] - accu [6] * accu [6];
+      covariance_matrix.coeffRef (1) = accu [1] - accu [6] * accu [7];
+      covariance_matrix.coeffRef (2) = accu [2] - accu [6] * accu [8];
+      covariance_matrix.coeffRef (4) = accu [3] - accu [7] * accu [7];
+      covariance_matrix.coeffRef (5) = accu [4] - accu [7] * accu [8];
+      covariance_matrix.coeffRef (8) = accu [5] - accu [8] * accu [8];
+      covariance_matrix.coeffRef (3) = covariance_matrix.coeff (1);
+      covariance_matrix.coeffRef (6) = covariance_matrix.coeff (2);
+      covariance_matrix.coeffRef (7) = covariance_matrix.coeff (5);
+      return (static_cast<unsigned int> (n));
+    }
+
+    /** \brief The number of threads to use for nr_threads, 0 meaning all cores */
+    inline int
+    getThreadCount (unsigned int nr_threads)
+    {
+#ifdef _OPENMP
+      return (nr_threads == 0 ? omp_get_num_procs () : static_cast<int> (nr_threads));
+#else
+      (void)nr_threads;
+      return (1);
+#endif
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+template <typename PointT, typename Scalar> void
+pcl::computeMeanAndCovarianceMatrices (const pcl::PointCloud<PointT> &cloud,
+                                       const std::vector<int> &offsets,
+                                       const std::vector<int> &indices,
+                                       std::vector<Eigen::Matrix<Scalar, 3, 3>, Eigen::aligned_allocator<Eigen::Matrix<Scalar, 3, 3> > > &covariance_matrices,
+                                       std::vector<Eigen::Matrix<Scalar, 4, 1>, Eigen::aligned_allocator<Eigen::Matrix<Scalar, 4, 1> > > &centroids,
+                                       std::vector<unsigned int> &point_counts,
+                                       unsigned int nr_threads)
+{
+  const int nr_neighborhoods = offsets.empty () ? 0 : static_cast<int> (offsets.size ()) - 1;
+  covariance_matrices.resize (nr_neighborhoods);
+  centroids.resize (nr_neighborhoods);
+  point_counts.resize (nr_neighborhoods);
+  const int threads = detail::getThreadCount (nr_threads);
+  (void)threads;
+
+#ifdef _OPENMP
+#pragma omp parallel num_threads (threads)
+#endif
+  {
+    std::vector<Scalar> buffer;
+#ifdef _OPENMP
+#pragma omp for schedule (dynamic, 256)
+#endif
+    for (int q = 0; q < nr_neighborhoods; ++q)
+      point_counts[q] = detail::computeNeighborhoodMoments (cloud, indices, offsets[q], offsets[q + 1], buffer,
+                                                            covariance_matrices[q], centroids[q]);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+template <typename PointT, typename Scalar> void
+pcl::computeSmallestEigenVectors (const pcl::PointCloud<PointT> &cloud,
+                                  const std::vector<int> &offsets,
+                                  const std::vector<int> &indices,
+                                  std::vector<Eigen::Matrix<Scalar, 4, 1>, Eigen::aligned_allocator<Eigen::Matrix<Scalar, 4, 1> > > &centroids,
+                                  std::vector<Eigen::Matrix<Scalar, 3, 1>, Eigen::aligned_allocator<Eigen::Matrix<Scalar, 3, 1> > > &eigen_vectors,
+                                  std::vector<Scalar> &eigen_values,
+                                  std::vector<Scalar> &curvatures,
+                                  unsigned int nr_threads)
+{
+  const int nr_neighborhoods = offsets.empty () ? 0 : static_cast<int> (offsets.size ()) - 1;
+  centroids.resize (nr_neighborhoods);
+  eigen_vectors.resize (nr_neighborhoods);
+  eigen_values.resize (nr_neighborhoods);
+  curvatures.resize (nr_neighborhoods);
+  const int threads = detail::getThreadCount (nr_threads);
+  (void)threads;
+
+#ifdef _OPENMP
+#pragma omp parallel num_threads (threads)
+#endif
+  {
+    // The covariance matrices of a block of neighborhoods are solved together by eigen33Batch
+    const int block_size = 256;
+    const int nr_blocks = (nr_neighborhoods + block_size - 1) / block_size;
+    std::vector<Scalar> buffer;
+    Eigen::Matrix<Scalar, 3, 3> covariance_matrix;
+    Eigen::Matrix<Scalar, Eigen::Dynamic, 6> covariance_matrices (block_size, 6);
+    Eigen::Matrix<Scalar, Eigen::Dynamic, 3> evals, evecs;
+    std::vector<unsigned int> point_counts (block_size);
+#ifdef _OPENMP
+#pragma omp for schedule (dynamic, 1)
+#endif
+    for (int b = 0; b < nr_blocks; ++b)
+    {
+      const int begin = b * block_size, size = std::min (block_size, nr_neighborhoods - begin);
+      covariance_matrices.conservativeResize (size, 6);
+      for (int i = 0; i < size; ++i)
+      {
+        const int q = begin + i;
+        point_counts[i] = detail::computeNeighborhoodMoments (cloud, indices, offsets[q], offsets[q + 1], buffer,
+                                                              covariance_matrix, centroids[q]);
+        covariance_matrices.row (i) << covariance_matrix.coeff (0), covariance_matrix.coeff (1), covariance_matrix.coeff (2),
+                                       covariance_matrix.coeff (4), covariance_matrix.coeff (5), covariance_matrix.coeff (8);
+      }
+
+      pcl::eigen33Batch (covariance_matrices, 0, evals, evecs);
+
+      for (int i = 0; i < size; ++i)
+      {
+        const int q = begin + i;
+        if (point_counts[i] < 3)
+        {
+          eigen_vectors[q].setConstant (std::numeric_limits<Scalar>::quiet_NaN ());
+          eigen_values[q] = curvatures[q] = std::numeric_limits<Scalar>::quiet_NaN ();
+          continue;
+        }
+        eigen_vectors[q] = evecs.row (i).transpose ();
+        eigen_values[q] = evals (i, 0);
+        // The sum of the eigenvalues is the trace of the covariance matrix
+        const Scalar trace = covariance_matrices (i, 0) + covariance_matrices (i, 3) + covariance_matrices (i, 5);
+        curvatures[q] = trace != 0 ? std::abs (eigen_values[q] / trace) : 0;
+      }
+    }
+  }
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////////
 template <typename PointT, typename Scalar> void
 pcl::demeanPointCloud (ConstCloudIterator<PointT> &cloud_iterator,
@@ -660,6 +927,84 @@ pcl::demeanPointCloud (ConstCloudIterator<PointT> &cloud_iterator,
   cloud_out.height = 1;
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////////
+namespace pcl
+{
+  namespace detail
+  {
+    /** \brief Subtract centroid from the coordinates of the nr_points points in place. */
+    template <typename PointT> inline void
+    subtractCentroid (PointT *points, int nr_points, const float centroid[3])
+    {
+#if defined(__SSE2__)
+      if (nr_points > 0 && hasPackedXYZ (points[0]))
+      {
+        const __m128 c = _mm_setr_ps (centroid[0], centroid[1], centroid[2], 0.0f);
+#ifdef _OPENMP
+#pragma omp parallel for if (nr_points >= PCL_COMMON_PARALLEL_MIN_POINTS) schedule (static)
+#endif
+        for (int i = 0; i < nr_points; ++i)
+          _mm_storeu_ps (&points[i].x, _mm_sub_ps (_mm_loadu_ps (&points[i].x), c));
+        return;
+      }
+#endif
+#ifdef _OPENMP
+#pragma omp parallel for if (nr_points >= PCL_COMMON_PARALLEL_MIN_POINTS) schedule (static)
+#endif
+      for (int i = 0; i < nr_points; ++i)
+      {
+        points[i].x -= centroid[0];
+        points[i].y -= centroid[1];
+        points[i].z -= centroid[2];
+      }
+    }
+
+    /** \brief Write the coordinates of the first nr_points points of the cloud (or of the points in
+      * indices, if not NULL) minus centroid to the columns of the column-major 4xN matrix out, with
+      * 0 in the fourth row.
+      */
+    template <typename PointT, typename Scalar> inline void
+    demeanToMatrix (const pcl::PointCloud<PointT> &cloud, const int *indices, int nr_points,
+                    const Eigen::Matrix<Scalar, 4, 1> &centroid, Scalar *out)
+    {
+#ifdef _OPENMP
+#pragma omp parallel for if (nr_points >= PCL_COMMON_PARALLEL_MIN_POINTS) schedule (static)
+#endif
+      for (int i = 0; i < nr_points; ++i)
+      {
+        const PointT &point = cloud.points[indices ? indices[i] : i];
+        out[4 * i + 0] = point.x - centroid[0];
+        out[4 * i + 1] = point.y - centroid[1];
+        out[4 * i + 2] = point.z - centroid[2];
+        out[4 * i + 3] = 0;
+      }
+    }
+
+#if defined(__SSE2__)
+    template <typename PointT> inline void
+    demeanToMatrix (const pcl::PointCloud<PointT> &cloud, const int *indices, int nr_points,
+                    const Eigen::Matrix<float, 4, 1> &centroid, float *out)
+    {
+      if (nr_points == 0 || !hasPackedXYZ (cloud.points[0]))
+      {
+        demeanToMatrix<PointT, float> (cloud, indices, nr_points, centroid, out);
+        return;
+      }
+      const __m128 c = _mm_setr_ps (centroid[0], centroid[1], centroid[2], 0.0f);
+      const __m128 xyz = _mm_castsi128_ps (_mm_setr_epi32 (-1, -1, -1, 0));
+#ifdef _OPENMP
+#pragma omp parallel for if (nr_points >= PCL_COMMON_PARALLEL_MIN_POINTS) schedule (static)
+#endif
+      for (int i = 0; i < nr_points; ++i)
+      {
+        const __m128 pt = _mm_loadu_ps (&cloud.points[indices ? indices[i] : i].x);
+        _mm_storeu_ps (out + 4 * i, _mm_and_ps (_mm_sub_ps (pt, c), xyz));
+      }
+    }
+#endif
+  }
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////////
 template <typename PointT, typename Scalar> void
 pcl::demeanPointCloud (const pcl::PointCloud<PointT> &cloud_in,
@@ -669,12 +1014,9 @@ pcl::demeanPointCloud (const pcl::PointCloud<PointT> &cloud_in,
   cloud_out = cloud_in;
 
   // Subtract the centroid from cloud_in
-  for (size_t i = 0; i < cloud_in.points.size (); ++i)
-  {
-    cloud_out[i].x -= static_cast<float> (centroid[0]);
-    cloud_out[i].y -= static_cast<float> (centroid[1]);
-    cloud_out[i].z -= static_cast<float> (centroid[2]);
-  }
+  const float c[3] = {static_cast<float> (centroid[0]), static_cast<float> (centroid[1]), static_cast<float> (centroid[2])};
+  if (!cloud_out.points.empty ())
+    detail::subtractCentroid (&cloud_out.points[0], static_cast<int> (cloud_out.points.size ()), c);
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////////
@@ -699,7 +1041,11 @@ pcl::demeanPointCloud (const pcl::PointCloud<PointT> &cloud_in,
   cloud_out.resize (indices.size ());
 
   // Subtract the centroid from cloud_in
-  for (size_t i = 0; i < indices.size (); ++i)
+  const int nr_points = static_cast<int> (indices.size ());
+#ifdef _OPENMP
+#pragma omp parallel for if (nr_points >= PCL_COMMON_PARALLEL_MIN_POINTS) schedule (static)
+#endif
+  for (int i = 0; i < nr_points; ++i)
   {
     cloud_out[i].x = static_cast<float> (cloud_in[indices[i]].x - centroid[0]);
     cloud_out[i].y = static_cast<float> (cloud_in[indices[i]].y - centroid[1]);
@@ -754,21 +1100,11 @@ pcl::demeanPointCloud (const pcl::PointCloud<PointT> &cloud_in,
                        const Eigen::Matrix<Scalar, 4, 1> &centroid,
                        Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic> &cloud_out)
 {
-  size_t npts = cloud_in.size ();
-
-  cloud_out = Eigen::Matrix<Scalar, 4, Eigen::Dynamic>::Zero (4, npts);        // keep the data aligned
+  const int npts = static_cast<int> (cloud_in.size ());
 
-  for (size_t i = 0; i < npts; ++i)
-  {
-    cloud_out (0, i) = cloud_in[i].x - centroid[0];
-    cloud_out (1, i) = cloud_in[i].y - centroid[1];
-    cloud_out (2, i) = cloud_in[i].z - centroid[2];
-    // One column at a time
-    //cloud_out.block<4, 1> (0, i) = cloud_in.points[i].getVector4fMap () - centroid;
-  }
-
-  // Make sure we zero the 4th dimension out (1 row, N columns)
-  //cloud_out.block (3, 0, 1, npts).setZero ();
+  // Every column, including the zero 4th row, is written by demeanToMatrix
+  cloud_out.resize (4, npts);
+  detail::demeanToMatrix (cloud_in, static_cast<const int*> (0), npts, centroid, cloud_out.data ());
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////////
@@ -778,21 +1114,11 @@ pcl::demeanPointCloud (const pcl::PointCloud<PointT> &cloud_in,
                        const Eigen::Matrix<Scalar, 4, 1> &centroid,
                        Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic> &cloud_out)
 {
-  size_t npts = indices.size ();
-
-  cloud_out = Eigen::Matrix<Scalar, 4, Eigen::Dynamic>::Zero (4, npts);        // keep the data aligned
-
-  for (size_t i = 0; i < npts; ++i)
-  {
-    cloud_out (0, i) = cloud_in[indices[i]].x - centroid[0];
-    cloud_out (1, i) = cloud_in[indices[i]].y - centroid[1];
-    cloud_out (2, i) = cloud_in[indices[i]].z - centroid[2];
-    // One column at a time
-    //cloud_out.block<4, 1> (0, i) = cloud_in.points[indices[i]].getVector4fMap () - centroid;
-  }
+  const int npts = static_cast<int> (indices.size ());
 
-  // Make sure we zero the 4th dimension out (1 row, N columns)
-  //cloud_out.block (3, 0, 1, npts).setZero ();
+  // Every column, including the zero 4th row, is written by demeanToMatrix
+  cloud_out.resize (4, npts);
+  detail::demeanToMatrix (cloud_in, npts > 0 ? &indices[0] : static_cast<const int*> (0), npts, centroid, cloud_out.data ());
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////////
@@ -40,6 +40,10 @@
 
 #include <pcl/point_types.h>
 #include <pcl/common/common.h>
+#include <algorithm>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 //////////////////////////////////////////////////////////////////////////////////////////////
 inline double
@@ -207,78 +211,201 @@ pcl::getMaxDistance (const pcl::PointCloud<PointT> &cloud, const std::vector<int
     max_pt = Eigen::Vector4f(std::numeric_limits<float>::quiet_NaN(),std::numeric_limits<float>::quiet_NaN(),std::numeric_limits<float>::quiet_NaN(),std::numeric_limits<float>::quiet_NaN());
 }
 
-//////////////////////////////////////////////////////////////////////////////////////////////
-template <typename PointT> inline void
-pcl::getMinMax3D (const pcl::PointCloud<PointT> &cloud, PointT &min_pt, PointT &max_pt)
+namespace pcl
 {
-  Eigen::Array4f min_p, max_p;
-  min_p.setConstant (FLT_MAX);
-  max_p.setConstant (-FLT_MAX);
-
-  // If the data is dense, we don't need to check for NaN
-  if (cloud.is_dense)
+  namespace detail
   {
-    for (size_t i = 0; i < cloud.points.size (); ++i)
+    /** \brief Bounds, coordinate sums and number of finite points of (a part of) a point cloud,
+      * as gathered by computeBoundsAndSum.
+      */
+    struct BoundsAndSum
+    {
+      BoundsAndSum () : count (0)
+      {
+        for (int d = 0; d < 4; ++d)
+        {
+          min_p[d] = FLT_MAX;
+          max_p[d] = -FLT_MAX;
+          sum[d] = 0;
+        }
+      }
+
+      /** \brief Add the bounds, sums and count of another part of the cloud. */
+      inline void
+      merge (const BoundsAndSum &other)
+      {
+        for (int d = 0; d < 4; ++d)
+        {
+          min_p[d] = std::min (min_p[d], other.min_p[d]);
+          max_p[d] = std::max (max_p[d], other.max_p[d]);
+          sum[d] += other.sum[d];
+        }
+        count += other.count;
+      }
+
+      /** \brief The minimum and maximum of x, y, z and of the fourth float of the point. */
+      float min_p[4], max_p[4];
+      /** \brief The sums of x, y and z, accumulated in double precision. */
+      double sum[4];
+      /** \brief The number of finite points. */
+      size_t count;
+    };
+
+    /** \brief Check whether the x, y and z coordinates of PointT are stored as the first three
+      * floats of a 4 float block (PCL_ADD_POINT4D), so that they can be loaded with one SSE load.
+      */
+    template <typename PointT> inline bool
+    hasPackedXYZ (const PointT &point)
     {
-      pcl::Array4fMapConst pt = cloud.points[i].getArray4fMap ();
-      min_p = min_p.min (pt);
-      max_p = max_p.max (pt);
+      const char *x = reinterpret_cast<const char*> (&point.x);
+      return (reinterpret_cast<const char*> (&point.y) == x + sizeof (float) &&
+              reinterpret_cast<const char*> (&point.z) == x + 2 * sizeof (float) &&
+              x + 4 * sizeof (float) <= reinterpret_cast<const char*> (&point) + sizeof (PointT));
     }
-  }
-  // NaN or Inf values could exist => check for them
-  else
-  {
-    for (size_t i = 0; i < cloud.points.size (); ++i)
+
+    /** \brief Add the points [begin, end) of the cloud (or of the indices, if UseIndices) to result.
+      * The finiteness test is compiled in for non-dense clouds only.
+      */
+    template <typename PointT, bool CheckFinite, bool UseIndices> inline void
+    accumulateBoundsAndSum (const pcl::PointCloud<PointT> &cloud, const int *indices,
+                            size_t begin, size_t end, BoundsAndSum &result)
     {
-      // Check if the point is invalid
-      if (!pcl_isfinite (cloud.points[i].x) || 
-          !pcl_isfinite (cloud.points[i].y) || 
-          !pcl_isfinite (cloud.points[i].z))
-        continue;
-      pcl::Array4fMapConst pt = cloud.points[i].getArray4fMap ();
-      min_p = min_p.min (pt);
-      max_p = max_p.max (pt);
+      if (begin >= end)
+        return;
+      const PointT *points = &cloud.points[0];
+      const bool packed = hasPackedXYZ (points[0]);
+#if defined(__SSE2__)
+      if (packed)
+      {
+        const __m128 zero = _mm_setzero_ps ();
+        const __m128 lowest = _mm_set1_ps (-FLT_MAX), highest = _mm_set1_ps (FLT_MAX);
+        __m128 min_v = _mm_loadu_ps (result.min_p), max_v = _mm_loadu_ps (result.max_p);
+        __m128d sum_xy = _mm_setzero_pd (), sum_zw = _mm_setzero_pd ();
+        size_t count = 0;
+        for (size_t i = begin; i < end; ++i)
+        {
+          __m128 pt = _mm_loadu_ps (&points[UseIndices ? indices[i] : i].x);
+          if (CheckFinite)
+          {
+            // x - x is 0 for finite values and NaN otherwise; the x, y and z tests are broadcast
+            __m128 finite = _mm_cmpeq_ps (_mm_sub_ps (pt, pt), zero);
+            finite = _mm_and_ps (_mm_and_ps (_mm_shuffle_ps (finite, finite, _MM_SHUFFLE (0, 0, 0, 0)),
+                                             _mm_shuffle_ps (finite, finite, _MM_SHUFFLE (1, 1, 1, 1))),
+                                 _mm_shuffle_ps (finite, finite, _MM_SHUFFLE (2, 2, 2, 2)));
+            count += _mm_movemask_ps (finite) & 1;
+            min_v = _mm_min_ps (min_v, _mm_or_ps (_mm_and_ps (finite, pt), _mm_andnot_ps (finite, highest)));
+            max_v = _mm_max_ps (max_v, _mm_or_ps (_mm_and_ps (finite, pt), _mm_andnot_ps (finite, lowest)));
+            pt = _mm_and_ps (finite, pt);
+          }
+          else
+          {
+            min_v = _mm_min_ps (min_v, pt);
+            max_v = _mm_max_ps (max_v, pt);
+          }
+          sum_xy = _mm_add_pd (sum_xy, _mm_cvtps_pd (pt));
+          sum_zw = _mm_add_pd (sum_zw, _mm_cvtps_pd (_mm_movehl_ps (pt, pt)));
+        }
+        _mm_storeu_ps (result.min_p, min_v);
+        _mm_storeu_ps (result.max_p, max_v);
+        double sums[4];
+        _mm_storeu_pd (sums, sum_xy);
+        _mm_storeu_pd (sums + 2, sum_zw);
+        for (int d = 0; d < 3; ++d)
+          result.sum[d] += sums[d];
+        result.count += CheckFinite ? count : end - begin;
+        return;
+      }
+#endif
+      for (size_t i = begin; i < end; ++i)
+      {
+        const PointT &point = points[UseIndices ? indices[i] : i];
+        if (CheckFinite && (!pcl_isfinite (point.x) || !pcl_isfinite (point.y) || !pcl_isfinite (point.z)))
+          continue;
+        const float pt[4] = {point.x, point.y, point.z, packed ? (&point.x)[3] : 0.0f};
+        for (int d = 0; d < 4; ++d)
+        {
+          result.min_p[d] = std::min (result.min_p[d], pt[d]);
+          result.max_p[d] = std::max (result.max_p[d], pt[d]);
+        }
+        result.sum[0] += pt[0];
+        result.sum[1] += pt[1];
+        result.sum[2] += pt[2];
+        ++result.count;
+      }
+    }
+
+    /** \brief Add the points [begin, end) of the cloud (or of the indices, if not NULL) to result,
+      * using the fast path that matches cloud.is_dense.
+      */
+    template <typename PointT> inline void
+    accumulateBoundsAndSum (const pcl::PointCloud<PointT> &cloud, const int *indices,
+                            size_t begin, size_t end, BoundsAndSum &result)
+    {
+      if (cloud.is_dense)
+      {
+        if (indices)
+          accumulateBoundsAndSum<PointT, false, true> (cloud, indices, begin, end, result);
+        else
+          accumulateBoundsAndSum<PointT, false, false> (cloud, indices, begin, end, result);
+      }
+      else
+      {
+        if (indices)
+          accumulateBoundsAndSum<PointT, true, true> (cloud, indices, begin, end, result);
+        else
+          accumulateBoundsAndSum<PointT, true, false> (cloud, indices, begin, end, result);
+      }
+    }
+
+    /** \brief Compute the bounds, the coordinate sums and the number of finite points of the first
+      * nr_points points of the cloud, or of the points in indices if it is not NULL.
+      *
+      * Large inputs are split into fixed blocks that are processed in parallel and merged in
+      * order, so that the result does not depend on the number of threads.
+      */
+    template <typename PointT> inline void
+    computeBoundsAndSum (const pcl::PointCloud<PointT> &cloud, const int *indices, size_t nr_points,
+                         BoundsAndSum &result)
+    {
+      result = BoundsAndSum ();
+      if (nr_points < PCL_COMMON_PARALLEL_MIN_POINTS)
+      {
+        accumulateBoundsAndSum (cloud, indices, 0, nr_points, result);
+        return;
+      }
+
+      const size_t block_size = 1 << 16;
+      const int nr_blocks = static_cast<int> ((nr_points + block_size - 1) / block_size);
+      std::vector<BoundsAndSum> blocks (nr_blocks);
+#ifdef _OPENMP
+#pragma omp parallel for schedule (static)
+#endif
+      for (int b = 0; b < nr_blocks; ++b)
+        accumulateBoundsAndSum (cloud, indices, b * block_size, std::min (nr_points, (b + 1) * block_size), blocks[b]);
+      for (int b = 0; b < nr_blocks; ++b)
+        result.merge (blocks[b]);
     }
   }
-  min_pt.x = min_p[0]; min_pt.y = min_p[1]; min_pt.z = min_p[2];
-  max_pt.x = max_p[0]; max_pt.y = max_p[1]; max_pt.z = max_p[2];
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////////
 template <typename PointT> inline void
-pcl::getMinMax3D (const pcl::PointCloud<PointT> &cloud, Eigen::Vector4f &min_pt, Eigen::Vector4f &max_pt)
+pcl::getMinMax3D (const pcl::PointCloud<PointT> &cloud, PointT &min_pt, PointT &max_pt)
 {
-  Eigen::Array4f min_p, max_p;
-  min_p.setConstant (FLT_MAX);
-  max_p.setConstant (-FLT_MAX);
+  detail::BoundsAndSum bounds;
+  detail::computeBoundsAndSum (cloud, static_cast<const int*> (0), cloud.points.size (), bounds);
+  min_pt.x = bounds.min_p[0]; min_pt.y = bounds.min_p[1]; min_pt.z = bounds.min_p[2];
+  max_pt.x = bounds.max_p[0]; max_pt.y = bounds.max_p[1]; max_pt.z = bounds.max_p[2];
+}
 
-  // If the data is dense, we don't need to check for NaN
-  if (cloud.is_dense)
-  {
-    for (size_t i = 0; i < cloud.points.size (); ++i)
-    {
-      pcl::Array4fMapConst pt = cloud.points[i].getArray4fMap ();
-      min_p = min_p.min (pt);
-      max_p = max_p.max (pt);
-    }
-  }
-  // NaN or Inf values could exist => check for them
-  else
-  {
-    for (size_t i = 0; i < cloud.points.size (); ++i)
-    {
-      // Check if the point is invalid
-      if (!pcl_isfinite (cloud.points[i].x) || 
-          !pcl_isfinite (cloud.points[i].y) || 
-          !pcl_isfinite (cloud.points[i].z))
-        continue;
-      pcl::Array4fMapConst pt = cloud.points[i].getArray4fMap ();
-      min_p = min_p.min (pt);
-      max_p = max_p.max (pt);
-    }
-  }
-  min_pt = min_p;
-  max_pt = max_p;
+//////////////////////////////////////////////////////////////////////////////////////////////
+template <typename PointT> inline void
+pcl::getMinMax3D (const pcl::PointCloud<PointT> &cloud, Eigen::Vector4f &min_pt, Eigen::Vector4f &max_pt)
+{
+  detail::BoundsAndSum bounds;
+  detail::computeBoundsAndSum (cloud, static_cast<const int*> (0), cloud.points.size (), bounds);
+  min_pt = Eigen::Vector4f::Map (bounds.min_p);
+  max_pt = Eigen::Vector4f::Map (bounds.max_p);
 }
 
 
@@ -287,37 +414,7 @@ template <typename PointT> inline void
 pcl::getMinMax3D (const pcl::PointCloud<PointT> &cloud, const pcl::PointIndices &indices,
                   Eigen::Vector4f &min_pt, Eigen::Vector4f &max_pt)
 {
-  Eigen::Array4f min_p, max_p;
-  min_p.setConstant (FLT_MAX);
-  max_p.setConstant (-FLT_MAX);
-
-  // If the data is dense, we don't need to check for NaN
-  if (cloud.is_dense)
-  {
-    for (size_t i = 0; i < indices.indices.size (); ++i)
-    {
-      pcl::Array4fMapConst pt = cloud.points[indices.indices[i]].getArray4fMap ();
-      min_p = min_p.min (pt);
-      max_p = max_p.max (pt);
-    }
-  }
-  // NaN or Inf values could exist => check for them
-  else
-  {
-    for (size_t i = 0; i < indices.indices.size (); ++i)
-    {
-      // Check if the point is invalid
-      if (!pcl_isfinite (cloud.points[indices.indices[i]].x) || 
-          !pcl_isfinite (cloud.points[indices.indices[i]].y) || 
-          !pcl_isfinite (cloud.points[indices.indices[i]].z))
-        continue;
-      pcl::Array4fMapConst pt = cloud.points[indices.indices[i]].getArray4fMap ();
-      min_p = min_p.min (pt);
-      max_p = max_p.max (pt);
-    }
-  }
-  min_pt = min_p;
-  max_pt = max_p;
+  getMinMax3D (cloud, indices.indices, min_pt, max_pt);
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////////
@@ -325,34 +422,11 @@ template <typename PointT> inline void
 pcl::getMinMax3D (const pcl::PointCloud<PointT> &cloud, const std::vector<int> &indices,
                   Eigen::Vector4f &min_pt, Eigen::Vector4f &max_pt)
 {
-  min_pt.setConstant (FLT_MAX);
-  max_pt.setConstant (-FLT_MAX);
-
-  // If the data is dense, we don't need to check for NaN
-  if (cloud.is_dense)
-  {
-    for (size_t i = 0; i < indices.size (); ++i)
-    {
-      pcl::Array4fMapConst pt = cloud.points[indices[i]].getArray4fMap ();
-      min_pt = min_pt.array ().min (pt);
-      max_pt = max_pt.array ().max (pt);
-    }
-  }
-  // NaN or Inf values could exist => check for them
-  else
-  {
-    for (size_t i = 0; i < indices.size (); ++i)
-    {
-      // Check if the point is invalid
-      if (!pcl_isfinite (cloud.points[indices[i]].x) || 
-          !pcl_isfinite (cloud.points[indices[i]].y) || 
-          !pcl_isfinite (cloud.points[indices[i]].z))
-        continue;
-      pcl::Array4fMapConst pt = cloud.points[indices[i]].getArray4fMap ();
-      min_pt = min_pt.array ().min (pt);
-      max_pt = max_pt.array ().max (pt);
-    }
-  }
+  detail::BoundsAndSum bounds;
+  detail::computeBoundsAndSum (cloud, indices.empty () ? static_cast<const int*> (0) : &indices[0],
+                               indices.size (), bounds);
+  min_pt = Eigen::Vector4f::Map (bounds.min_p);
+  max_pt = Eigen::Vector4f::Map (bounds.max_p);
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////////
@@ -40,6 +40,9 @@
 #define PCL_COMMON_EIGEN_IMPL_HPP_
 
 #include <pcl/pcl_macros.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 //////////////////////////////////////////////////////////////////////////////////////////
 void 
@@ -299,5 +302,242 @@ pcl::umeyama (const Eigen::MatrixBase<Derived>& src, const Eigen::MatrixBase<Oth
   return (Rt);
 }
 
-#endif  //PCL_COMMON_EIGEN_IMPL_HPP_
+namespace pcl
+{
+  namespace detail
+  {
+    /** \brief Solves row i of the structure of arrays given to eigen33Batch with the scalar code of eigen33 */
+    template <typename Scalar> void
+    eigen33BatchRow (const Eigen::Matrix<Scalar, Eigen::Dynamic, 6> &mats, int index, int i,
+                     Eigen::Matrix<Scalar, Eigen::Dynamic, 3> &evals,
+                     Eigen::Matrix<Scalar, Eigen::Dynamic, 3> &evecs)
+    {
+      typedef Eigen::Matrix<Scalar, 3, 3> Matrix;
+      typedef Eigen::Matrix<Scalar, 3, 1> Vector;
+      Matrix mat;
+      mat << mats (i, 0), mats (i, 1), mats (i, 2),
+             mats (i, 1), mats (i, 3), mats (i, 4),
+             mats (i, 2), mats (i, 4), mats (i, 5);
+
+      Scalar scale = mat.cwiseAbs ().maxCoeff ();
+      if (scale <= std::numeric_limits<Scalar>::min ())
+        scale = Scalar (1.0);
+
+      Matrix scaledMat = mat / scale;
+      Vector roots;
+      computeRoots (scaledMat, roots);
+      evals.row (i) = roots.transpose () * scale;
+
+      scaledMat.diagonal ().array () -= roots (index);
+
+      Vector vec1 = scaledMat.row (0).cross (scaledMat.row (1));
+      Vector vec2 = scaledMat.row (0).cross (scaledMat.row (2));
+      Vector vec3 = scaledMat.row (1).cross (scaledMat.row (2));
+
+      Scalar len1 = vec1.squaredNorm ();
+      Scalar len2 = vec2.squaredNorm ();
+      Scalar len3 = vec3.squaredNorm ();
+
+      if (len1 >= len2 && len1 >= len3)
+        evecs.row (i) = vec1.transpose () / std::sqrt (len1);
+      else if (len2 >= len1 && len2 >= len3)
+        evecs.row (i) = vec2.transpose () / std::sqrt (len2);
+      else
+        evecs.row (i) = vec3.transpose () / std::sqrt (len3);
+    }
+
+    template <typename Scalar> void
+    eigen33Batch (const Eigen::Matrix<Scalar, Eigen::Dynamic, 6> &mats, int index,
+                  Eigen::Matrix<Scalar, Eigen::Dynamic, 3> &evals,
+                  Eigen::Matrix<Scalar, Eigen::Dynamic, 3> &evecs)
+    {
+      for (int i = 0; i < mats.rows (); ++i)
+        eigen33BatchRow (mats, index, i, evals, evecs);
+    }
+
+#if defined(__SSE2__)
+    /** \brief mask ? a : b */
+    inline __m128
+    select (const __m128 &mask, const __m128 &a, const __m128 &b)
+    {
+      return (_mm_or_ps (_mm_and_ps (mask, a), _mm_andnot_ps (mask, b)));
+    }
+
+    /** \brief atan2 (y, x) for y >= 0, following the single precision Cephes approximation */
+    inline __m128
+    atan2Positive (const __m128 &y, const __m128 &x)
+    {
+      const __m128 zero = _mm_setzero_ps (), one = _mm_set1_ps (1.0f);
+      const __m128 abs_x = _mm_andnot_ps (_mm_set1_ps (-0.0f), x);
+      const __m128 num = _mm_min_ps (abs_x, y), den = _mm_max_ps (abs_x, y);
+      // a = tan of the angle to the closer axis, in [0, 1]
+      __m128 a = select (_mm_cmpgt_ps (den, zero), _mm_div_ps (num, den), zero);
+      // Reduce [tan (pi/8), 1] to [-tan (pi/8), 0]
+      const __m128 reduce = _mm_cmpgt_ps (a, _mm_set1_ps (0.4142135623730950f));
+      a = select (reduce, _mm_div_ps (_mm_sub_ps (a, one), _mm_add_ps (a, one)), a);
+      const __m128 z = _mm_mul_ps (a, a);
+      __m128 p = _mm_set1_ps (8.05374449538e-2f);
+      p = _mm_sub_ps (_mm_mul_ps (p, z), _mm_set1_ps (1.38776856032e-1f));
+      p = _mm_add_ps (_mm_mul_ps (p, z), _mm_set1_ps (1.99777106478e-1f));
+      p = _mm_sub_ps (_mm_mul_ps (p, z), _mm_set1_ps (3.33329491539e-1f));
+      __m128 r = _mm_add_ps (_mm_mul_ps (_mm_mul_ps (p, z), a), a);
+      r = _mm_add_ps (r, _mm_and_ps (reduce, _mm_set1_ps (static_cast<float> (M_PI / 4))));
+      // Undo the reflections at the diagonal and at the y axis
+      r = select (_mm_cmpgt_ps (y, abs_x), _mm_sub_ps (_mm_set1_ps (static_cast<float> (M_PI / 2)), r), r);
+      return (select (_mm_cmplt_ps (x, zero), _mm_sub_ps (_mm_set1_ps (static_cast<float> (M_PI)), r), r));
+    }
+
+    /** \brief sin and cos of t in [0, pi/3], Cephes polynomials around pi/6 */
+    inline void
+    sinCosSmall (const __m128 &t, __m128 &sin_t, __m128 &cos_t)
+    {
+      const __m128 x = _mm_sub_ps (t, _mm_set1_ps (static_cast<float> (M_PI / 6)));
+      const __m128 z = _mm_mul_ps (x, x);
+      __m128 s = _mm_set1_ps (-1.9515295891e-4f);
+      s = _mm_add_ps (_mm_mul_ps (s, z), _mm_set1_ps (8.3321608736e-3f));
+      s = _mm_sub_ps (_mm_mul_ps (s, z), _mm_set1_ps (1.6666654611e-1f));
+      s = _mm_add_ps (_mm_mul_ps (_mm_mul_ps (s, z), x), x);
+      __m128 c = _mm_set1_ps (2.443315711809948e-5f);
+      c = _mm_sub_ps (_mm_mul_ps (c, z), _mm_set1_ps (1.388731625493765e-3f));
+      c = _mm_add_ps (_mm_mul_ps (c, z), _mm_set1_ps (4.166664568298827e-2f));
+      c = _mm_sub_ps (_mm_mul_ps (_mm_mul_ps (c, z), z), _mm_mul_ps (_mm_set1_ps (0.5f), z));
+      c = _mm_add_ps (c, _mm_set1_ps (1.0f));
+      // Rotate back by pi/6
+      const __m128 cos6 = _mm_set1_ps (0.8660254037844386f), sin6 = _mm_set1_ps (0.5f);
+      sin_t = _mm_add_ps (_mm_mul_ps (s, cos6), _mm_mul_ps (c, sin6));
+      cos_t = _mm_sub_ps (_mm_mul_ps (c, cos6), _mm_mul_ps (s, sin6));
+    }
+
+    /** \brief Four matrices of eigen33Batch at once, following the steps of computeRoots and eigen33 */
+    inline void
+    eigen33Batch4 (const float *const in[6], int index, float *const values[3], float *const vector[3])
+    {
+      const __m128 zero = _mm_setzero_ps (), half = _mm_set1_ps (0.5f), two = _mm_set1_ps (2.0f);
+      const __m128 sign = _mm_set1_ps (-0.0f);
+      __m128 m[6];
+      __m128 scale = zero;
+      for (int k = 0; k < 6; ++k)
+      {
+        m[k] = _mm_loadu_ps (in[k]);
+        scale = _mm_max_ps (scale, _mm_andnot_ps (sign, m[k]));
+      }
+      scale = select (_mm_cmple_ps (scale, _mm_set1_ps (std::numeric_limits<float>::min ())), _mm_set1_ps (1.0f), scale);
+      for (int k = 0; k < 6; ++k)
+        m[k] = _mm_div_ps (m[k], scale);
+      const __m128 &m00 = m[0], &m01 = m[1], &m02 = m[2], &m11 = m[3], &m12 = m[4], &m22 = m[5];
+
+      // Characteristic equation x^3 - c2*x^2 + c1*x - c0 = 0
+      const __m128 c0 = _mm_sub_ps (_mm_sub_ps (_mm_sub_ps (_mm_add_ps (
+                          _mm_mul_ps (_mm_mul_ps (m00, m11), m22),
+                          _mm_mul_ps (two, _mm_mul_ps (_mm_mul_ps (m01, m02), m12))),
+                          _mm_mul_ps (_mm_mul_ps (m00, m12), m12)),
+                          _mm_mul_ps (_mm_mul_ps (m11, m02), m02)),
+                          _mm_mul_ps (_mm_mul_ps (m22, m01), m01));
+      const __m128 c1 = _mm_sub_ps (_mm_add_ps (_mm_sub_ps (_mm_add_ps (_mm_sub_ps (
+                          _mm_mul_ps (m00, m11), _mm_mul_ps (m01, m01)),
+                          _mm_mul_ps (m00, m22)), _mm_mul_ps (m02, m02)),
+                          _mm_mul_ps (m11, m22)), _mm_mul_ps (m12, m12));
+      const __m128 c2 = _mm_add_ps (_mm_add_ps (m00, m11), m22);
+
+      // Roots of the cubic
+      const __m128 inv3 = _mm_set1_ps (1.0f / 3.0f);
+      const __m128 c2_over_3 = _mm_mul_ps (c2, inv3);
+      const __m128 a_over_3 = _mm_min_ps (_mm_mul_ps (_mm_sub_ps (c1, _mm_mul_ps (c2, c2_over_3)), inv3), zero);
+      const __m128 half_b = _mm_mul_ps (half, _mm_add_ps (c0, _mm_mul_ps (c2_over_3,
+                              _mm_sub_ps (_mm_mul_ps (_mm_mul_ps (two, c2_over_3), c2_over_3), c1))));
+      const __m128 q = _mm_min_ps (_mm_add_ps (_mm_mul_ps (half_b, half_b),
+                                               _mm_mul_ps (_mm_mul_ps (a_over_3, a_over_3), a_over_3)), zero);
+      const __m128 rho = _mm_sqrt_ps (_mm_sub_ps (zero, a_over_3));
+      const __m128 theta = _mm_mul_ps (atan2Positive (_mm_sqrt_ps (_mm_sub_ps (zero, q)), half_b), inv3);
+      __m128 sin_theta, cos_theta;
+      sinCosSmall (theta, sin_theta, cos_theta);
+      const __m128 sqrt3_sin = _mm_mul_ps (_mm_set1_ps (1.7320508075688772f), sin_theta);
+      const __m128 r0 = _mm_add_ps (c2_over_3, _mm_mul_ps (_mm_mul_ps (two, rho), cos_theta));
+      const __m128 r1 = _mm_sub_ps (c2_over_3, _mm_mul_ps (rho, _mm_add_ps (cos_theta, sqrt3_sin)));
+      const __m128 r2 = _mm_sub_ps (c2_over_3, _mm_mul_ps (rho, _mm_sub_ps (cos_theta, sqrt3_sin)));
+      // Sort in increasing order
+      const __m128 lo01 = _mm_min_ps (r0, r1), hi01 = _mm_max_ps (r0, r1);
+      const __m128 mid = _mm_min_ps (hi01, r2);
+      __m128 roots[3];
+      roots[2] = _mm_max_ps (hi01, r2);
+      roots[0] = _mm_min_ps (lo01, mid);
+      roots[1] = _mm_max_ps (lo01, mid);
+
+      // One root is 0 or the smallest one is not positive: solve x^2 - c2*x + c1 = 0 instead
+      const __m128 quadratic = _mm_or_ps (
+          _mm_cmplt_ps (_mm_andnot_ps (sign, c0), _mm_set1_ps (Eigen::NumTraits<float>::epsilon ())),
+          _mm_cmple_ps (roots[0], zero));
+      const __m128 sd = _mm_sqrt_ps (_mm_max_ps (_mm_sub_ps (_mm_mul_ps (c2, c2), _mm_mul_ps (_mm_set1_ps (4.0f), c1)), zero));
+      roots[0] = _mm_andnot_ps (quadratic, roots[0]);
+      roots[1] = select (quadratic, _mm_mul_ps (half, _mm_sub_ps (c2, sd)), roots[1]);
+      roots[2] = select (quadratic, _mm_mul_ps (half, _mm_add_ps (c2, sd)), roots[2]);
+      for (int k = 0; k < 3; ++k)
+        _mm_storeu_ps (values[k], _mm_mul_ps (roots[k], scale));
+
+      // Eigenvector: largest cross product of two rows of the scaled matrix minus the eigenvalue
+      const __m128 b00 = _mm_sub_ps (m00, roots[index]);
+      const __m128 b11 = _mm_sub_ps (m11, roots[index]);
+      const __m128 b22 = _mm_sub_ps (m22, roots[index]);
+      __m128 vec1[3], vec2[3], vec3[3];
+      vec1[0] = _mm_sub_ps (_mm_mul_ps (m01, m12), _mm_mul_ps (m02, b11));
+      vec1[1] = _mm_sub_ps (_mm_mul_ps (m02, m01), _mm_mul_ps (b00, m12));
+      vec1[2] = _mm_sub_ps (_mm_mul_ps (b00, b11), _mm_mul_ps (m01, m01));
+      vec2[0] = _mm_sub_ps (_mm_mul_ps (m01, b22), _mm_mul_ps (m02, m12));
+      vec2[1] = _mm_sub_ps (_mm_mul_ps (m02, m02), _mm_mul_ps (b00, b22));
+      vec2[2] = _mm_sub_ps (_mm_mul_ps (b00, m12), _mm_mul_ps (m01, m02));
+      vec3[0] = _mm_sub_ps (_mm_mul_ps (b11, b22), _mm_mul_ps (m12, m12));
+      vec3[1] = _mm_sub_ps (_mm_mul_ps (m12, m02), _mm_mul_ps (m01, b22));
+      vec3[2] = _mm_sub_ps (_mm_mul_ps (m01, m12), _mm_mul_ps (b11, m02));
+      __m128 len[3];
+      const __m128 *vecs[3] = {vec1, vec2, vec3};
+      for (int k = 0; k < 3; ++k)
+        len[k] = _mm_add_ps (_mm_add_ps (_mm_mul_ps (vecs[k][0], vecs[k][0]), _mm_mul_ps (vecs[k][1], vecs[k][1])),
+                             _mm_mul_ps (vecs[k][2], vecs[k][2]));
+      const __m128 use1 = _mm_and_ps (_mm_cmpge_ps (len[0], len[1]), _mm_cmpge_ps (len[0], len[2]));
+      const __m128 use2 = _mm_and_ps (_mm_cmpge_ps (len[1], len[0]), _mm_cmpge_ps (len[1], len[2]));
+      const __m128 length = _mm_sqrt_ps (select (use1, len[0], select (use2, len[1], len[2])));
+      for (int k = 0; k < 3; ++k)
+        _mm_storeu_ps (vector[k], _mm_div_ps (select (use1, vec1[k], select (use2, vec2[k], vec3[k])), length));
+    }
 
+    template <> inline void
+    eigen33Batch<float> (const Eigen::Matrix<float, Eigen::Dynamic, 6> &mats, int index,
+                         Eigen::Matrix<float, Eigen::Dynamic, 3> &evals,
+                         Eigen::Matrix<float, Eigen::Dynamic, 3> &evecs)
+    {
+      const int n = static_cast<int> (mats.rows ());
+      int i = 0;
+      for (; i + 4 <= n; i += 4)
+      {
+        const float *in[6];
+        for (int k = 0; k < 6; ++k)
+          in[k] = mats.col (k).data () + i;
+        float *values[3], *vector[3];
+        for (int k = 0; k < 3; ++k)
+        {
+          values[k] = evals.col (k).data () + i;
+          vector[k] = evecs.col (k).data () + i;
+        }
+        eigen33Batch4 (in, index, values, vector);
+      }
+      for (; i < n; ++i)
+        eigen33BatchRow (mats, index, i, evals, evecs);
+    }
+#endif
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+template <typename Scalar> void
+pcl::eigen33Batch (const Eigen::Matrix<Scalar, Eigen::Dynamic, 6> &mats, int index,
+                   Eigen::Matrix<Scalar, Eigen::Dynamic, 3> &evals,
+                   Eigen::Matrix<Scalar, Eigen::Dynamic, 3> &evecs)
+{
+  evals.resize (mats.rows (), 3);
+  evecs.resize (mats.rows (), 3);
+  if (index < 0 || index > 2)
+    index = 0;
+  detail::eigen33Batch (mats, index, evals, evecs);
+}
+
+#endif  //PCL_COMMON_EIGEN_IMPL_HPP_
@@ -0,0 +1,130 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Point Cloud Library (PCL) - www.pointclouds.org
+ *  Copyright (c) 2013-, Open Perception, Inc.
+ *
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder(s) nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef PCL_COMMON_IMPL_MORTON_HPP_
+#define PCL_COMMON_IMPL_MORTON_HPP_
+
+#include <pcl/common/morton.h>
+#include <pcl/common/common.h>
+#include <algorithm>
+
+///////////////////////////////////////////////////////////////////////////////////////////
+template <typename PointT> void
+pcl::computeMortonCodes (const pcl::PointCloud<PointT> &cloud, std::vector<uint64_t> &codes)
+{
+  const int nr_points = static_cast<int> (cloud.points.size ());
+  codes.resize (nr_points);
+  if (nr_points == 0)
+    return;
+
+  Eigen::Vector4f min_pt, max_pt;
+  pcl::getMinMax3D (cloud, min_pt, max_pt);
+  if (!(min_pt[0] <= max_pt[0]))
+  {
+    std::fill (codes.begin (), codes.end (), MORTON_CODE_INVALID);
+    return;
+  }
+
+  // One scale for all axes, so that the cells are cubes
+  const uint32_t max_cell = (1u << 21) - 1;
+  const double extent = (max_pt - min_pt).head<3> ().maxCoeff ();
+  const double scale = extent > 0 ? static_cast<double> (max_cell) / extent : 0.0;
+  const Eigen::Vector3d origin = min_pt.head<3> ().cast<double> ();
+  const bool is_dense = cloud.is_dense;
+
+#ifdef _OPENMP
+#pragma omp parallel for if (nr_points >= PCL_MORTON_PARALLEL_MIN_POINTS) schedule (static)
+#endif
+  for (int i = 0; i < nr_points; ++i)
+  {
+    const PointT &p = cloud.points[i];
+    if (!is_dense && (!pcl_isfinite (p.x) || !pcl_isfinite (p.y) || !pcl_isfinite (p.z)))
+    {
+      codes[i] = MORTON_CODE_INVALID;
+      continue;
+    }
+    uint32_t cell[3];
+    const Eigen::Vector3d offset = (p.getVector3fMap ().template cast<double> () - origin) * scale;
+    for (int d = 0; d < 3; ++d)
+      cell[d] = offset[d] > 0 ? std::min (static_cast<uint32_t> (offset[d]), max_cell) : 0;
+    codes[i] = encodeMortonCode (cell[0], cell[1], cell[2]);
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+template <typename PointT> void
+pcl::reorderByMortonCode (const pcl::PointCloud<PointT> &cloud_in, pcl::PointCloud<PointT> &cloud_out,
+                          std::vector<int> &permutation)
+{
+  if (&cloud_in == &cloud_out)
+  {
+    reorderByMortonCode (cloud_out, permutation);
+    return;
+  }
+
+  std::vector<uint64_t> codes;
+  computeMortonCodes (cloud_in, codes);
+  sortMortonCodes (codes, permutation);
+
+  const int nr_points = static_cast<int> (permutation.size ());
+  cloud_out.points.resize (nr_points);
+#ifdef _OPENMP
+#pragma omp parallel for if (nr_points >= PCL_MORTON_PARALLEL_MIN_POINTS) schedule (static)
+#endif
+  for (int i = 0; i < nr_points; ++i)
+    cloud_out.points[i] = cloud_in.points[permutation[i]];
+
+  cloud_out.header = cloud_in.header;
+  cloud_out.width = static_cast<uint32_t> (nr_points);
+  cloud_out.height = 1;
+  cloud_out.is_dense = cloud_in.is_dense;
+  cloud_out.sensor_origin_ = cloud_in.sensor_origin_;
+  cloud_out.sensor_orientation_ = cloud_in.sensor_orientation_;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+template <typename PointT> void
+pcl::reorderByMortonCode (pcl::PointCloud<PointT> &cloud, std::vector<int> &permutation)
+{
+  pcl::PointCloud<PointT> reordered;
+  reorderByMortonCode (static_cast<const pcl::PointCloud<PointT>&> (cloud), reordered, permutation);
+  cloud.points.swap (reordered.points);
+  cloud.width = reordered.width;
+  cloud.height = reordered.height;
+}
+
+#endif  // PCL_COMMON_IMPL_MORTON_HPP_
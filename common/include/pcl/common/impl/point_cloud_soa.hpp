@@ -0,0 +1,170 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Point Cloud Library (PCL) - www.pointclouds.org
+ *  Copyright (c) 2013-, Open Perception, Inc.
+ *
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder(s) nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef PCL_COMMON_IMPL_POINT_CLOUD_SOA_HPP_
+#define PCL_COMMON_IMPL_POINT_CLOUD_SOA_HPP_
+
+#include <pcl/common/point_cloud_soa.h>
+#include <pcl/common/io.h>
+#include <pcl/console/print.h>
+#include <cstring>
+
+namespace pcl
+{
+  namespace detail
+  {
+    /** \brief Look up the byte offsets in PointT of the requested float fields, and add
+      * them to \a soa. Unknown and non-float fields are skipped with a warning.
+      */
+    template <typename PointT> void
+    addSoAFields (const std::vector<std::string> &field_names, PointCloudSoA &soa,
+                  std::vector<std::pair<size_t, float*> > &fields)
+    {
+      std::vector<pcl::PCLPointField> point_fields;
+      pcl::getFields<PointT> (point_fields);
+      fields.clear ();
+      for (size_t i = 0; i < field_names.size (); ++i)
+      {
+        size_t j = 0;
+        while (j < point_fields.size () && point_fields[j].name != field_names[i])
+          ++j;
+        if (j == point_fields.size ())
+        {
+          PCL_WARN ("[pcl::toPointCloudSoA] Field %s does not exist in the point type, skipping.\n",
+                    field_names[i].c_str ());
+          continue;
+        }
+        if (point_fields[j].datatype != pcl::PCLPointField::FLOAT32 || point_fields[j].count != 1)
+        {
+          PCL_WARN ("[pcl::toPointCloudSoA] Field %s is not a single float, skipping.\n",
+                    field_names[i].c_str ());
+          continue;
+        }
+        fields.push_back (std::make_pair (static_cast<size_t> (point_fields[j].offset), soa.addField (field_names[i])));
+      }
+    }
+
+    /** \brief Copy the fields of \a point into position \a i of the arrays. */
+    template <typename PointT> inline void
+    copyToSoA (const PointT &point, size_t i, float *x, float *y, float *z,
+               const std::vector<std::pair<size_t, float*> > &fields)
+    {
+      x[i] = point.x;
+      y[i] = point.y;
+      z[i] = point.z;
+      const uint8_t *data = reinterpret_cast<const uint8_t*> (&point);
+      for (size_t f = 0; f < fields.size (); ++f)
+        memcpy (fields[f].second + i, data + fields[f].first, sizeof (float));
+    }
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+template <typename PointT> void
+pcl::toPointCloudSoA (const pcl::PointCloud<PointT> &cloud, PointCloudSoA &soa,
+                      const std::vector<std::string> &field_names)
+{
+  soa.clear ();
+  soa.resize (cloud.points.size ());
+  std::vector<std::pair<size_t, float*> > fields;
+  detail::addSoAFields<PointT> (field_names, soa, fields);
+
+  float *x = soa.x (), *y = soa.y (), *z = soa.z ();
+  for (size_t i = 0; i < cloud.points.size (); ++i)
+    detail::copyToSoA (cloud.points[i], i, x, y, z, fields);
+
+  soa.header = cloud.header;
+  soa.width = cloud.width;
+  soa.height = cloud.height;
+  soa.is_dense = cloud.is_dense;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+template <typename PointT> void
+pcl::toPointCloudSoA (const pcl::PointCloud<PointT> &cloud, const std::vector<int> &indices,
+                      PointCloudSoA &soa, const std::vector<std::string> &field_names)
+{
+  soa.clear ();
+  soa.resize (indices.size ());
+  std::vector<std::pair<size_t, float*> > fields;
+  detail::addSoAFields<PointT> (field_names, soa, fields);
+
+  float *x = soa.x (), *y = soa.y (), *z = soa.z ();
+  for (size_t i = 0; i < indices.size (); ++i)
+    detail::copyToSoA (cloud.points[indices[i]], i, x, y, z, fields);
+
+  soa.header = cloud.header;
+  soa.is_dense = cloud.is_dense;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+template <typename PointT> void
+pcl::fromPointCloudSoA (const PointCloudSoA &soa, pcl::PointCloud<PointT> &cloud)
+{
+  if (cloud.points.size () != soa.size ())
+    cloud.points.resize (soa.size ());
+
+  // Only the additional fields which exist in PointT are written back
+  std::vector<pcl::PCLPointField> point_fields;
+  pcl::getFields<PointT> (point_fields);
+  std::vector<std::pair<size_t, const float*> > fields;
+  for (size_t i = 0; i < point_fields.size (); ++i)
+  {
+    const float *values = soa.getField (point_fields[i].name);
+    if (values && point_fields[i].datatype == pcl::PCLPointField::FLOAT32)
+      fields.push_back (std::make_pair (static_cast<size_t> (point_fields[i].offset), values));
+  }
+
+  const float *x = soa.x (), *y = soa.y (), *z = soa.z ();
+  for (size_t i = 0; i < soa.size (); ++i)
+  {
+    PointT &point = cloud.points[i];
+    point.x = x[i];
+    point.y = y[i];
+    point.z = z[i];
+    uint8_t *data = reinterpret_cast<uint8_t*> (&point);
+    for (size_t f = 0; f < fields.size (); ++f)
+      memcpy (data + fields[f].first, fields[f].second + i, sizeof (float));
+  }
+
+  cloud.header = soa.header;
+  cloud.width = soa.width;
+  cloud.height = soa.height;
+  cloud.is_dense = soa.is_dense;
+}
+
+#endif  // PCL_COMMON_IMPL_POINT_CLOUD_SOA_HPP_
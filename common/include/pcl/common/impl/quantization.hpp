@@ -0,0 +1,323 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Point Cloud Library (PCL) - www.pointclouds.org
+ *  Copyright (c) 2013-, Open Perception, Inc.
+ *
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder(s) nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef PCL_COMMON_IMPL_QUANTIZATION_HPP_
+#define PCL_COMMON_IMPL_QUANTIZATION_HPP_
+
+#include <pcl/common/quantization.h>
+#include <pcl/common/common.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace pcl
+{
+  namespace detail
+  {
+    /** \brief Quantize the coordinates of the points [begin, end) of \a in into \a out. */
+    template <typename PointT, typename PointQT> inline void
+    quantizeCoordinates (const PointT *in, PointQT *out, int begin, int end, const QuantizationParameters &params)
+    {
+#if defined(__SSE2__)
+      if (hasPackedXYZ (in[0]))
+      {
+        const Eigen::Matrix4f &m = params.getInverseTransform ().matrix ();
+        const __m128 c0 = _mm_setr_ps (m (0, 0), m (1, 0), m (2, 0), 0.0f);
+        const __m128 c1 = _mm_setr_ps (m (0, 1), m (1, 1), m (2, 1), 0.0f);
+        const __m128 c2 = _mm_setr_ps (m (0, 2), m (1, 2), m (2, 2), 0.0f);
+        const __m128 c3 = _mm_setr_ps (m (0, 3), m (1, 3), m (2, 3), 0.0f);
+        const __m128 lo = _mm_set1_ps (-static_cast<float> (QUANTIZED_MAX_COORDINATE));
+        const __m128 hi = _mm_set1_ps (static_cast<float> (QUANTIZED_MAX_COORDINATE));
+        const __m128i invalid = _mm_set1_epi16 (QUANTIZED_INVALID_COORDINATE);
+        for (int i = begin; i < end; ++i)
+        {
+          const __m128 p = _mm_loadu_ps (&in[i].x);
+          __m128 q = _mm_add_ps (_mm_add_ps (_mm_mul_ps (c0, _mm_shuffle_ps (p, p, 0x00)),
+                                             _mm_mul_ps (c1, _mm_shuffle_ps (p, p, 0x55))),
+                                 _mm_add_ps (_mm_mul_ps (c2, _mm_shuffle_ps (p, p, 0xaa)), c3));
+          // q - q is NaN for NaN and Inf; max/min return their second operand if one is NaN,
+          // so NaNs pass the clamping and convert to -32768, the invalid coordinate
+          q = _mm_add_ps (q, _mm_sub_ps (q, q));
+          q = _mm_min_ps (hi, _mm_max_ps (lo, q));
+          const __m128i packed = _mm_packs_epi32 (_mm_cvtps_epi32 (q), _mm_setzero_si128 ());
+          if (_mm_movemask_epi8 (_mm_cmpeq_epi16 (packed, invalid)) & 0x3f)
+          {
+            out[i].qx = out[i].qy = out[i].qz = QUANTIZED_INVALID_COORDINATE;
+            continue;
+          }
+          out[i].qx = static_cast<int16_t> (_mm_extract_epi16 (packed, 0));
+          out[i].qy = static_cast<int16_t> (_mm_extract_epi16 (packed, 1));
+          out[i].qz = static_cast<int16_t> (_mm_extract_epi16 (packed, 2));
+        }
+        return;
+      }
+#endif
+      for (int i = begin; i < end; ++i)
+        quantizeXYZ (Eigen::Vector3f (in[i].x, in[i].y, in[i].z), params, out[i]);
+    }
+
+    /** \brief Restore the coordinates of the points [begin, end) of \a in into \a out.
+      * \return false if there is an invalid point
+      */
+    template <typename PointQT, typename PointT> inline bool
+    dequantizeCoordinates (const PointQT *in, PointT *out, int begin, int end, const Eigen::Affine3f &to_world)
+    {
+      const float nan = std::numeric_limits<float>::quiet_NaN ();
+      bool is_dense = true;
+#if defined(__SSE2__)
+      const Eigen::Matrix4f &m = to_world.matrix ();
+      const __m128 c0 = _mm_setr_ps (m (0, 0), m (1, 0), m (2, 0), 0.0f);
+      const __m128 c1 = _mm_setr_ps (m (0, 1), m (1, 1), m (2, 1), 0.0f);
+      const __m128 c2 = _mm_setr_ps (m (0, 2), m (1, 2), m (2, 2), 0.0f);
+      const __m128 c3 = _mm_setr_ps (m (0, 3), m (1, 3), m (2, 3), 0.0f);
+      for (int i = begin; i < end; ++i)
+      {
+        if (in[i].qx == QUANTIZED_INVALID_COORDINATE)
+        {
+          out[i].x = out[i].y = out[i].z = nan;
+          is_dense = false;
+          continue;
+        }
+        const __m128 p = _mm_add_ps (_mm_add_ps (_mm_mul_ps (c0, _mm_set1_ps (in[i].qx)),
+                                                 _mm_mul_ps (c1, _mm_set1_ps (in[i].qy))),
+                                     _mm_add_ps (_mm_mul_ps (c2, _mm_set1_ps (in[i].qz)), c3));
+        // Store x, y and z only, the fourth float may be a field of PointT
+        _mm_storel_pi (reinterpret_cast<__m64*> (&out[i].x), p);
+        _mm_store_ss (&out[i].z, _mm_movehl_ps (p, p));
+      }
+#else
+      for (int i = begin; i < end; ++i)
+      {
+        if (in[i].qx == QUANTIZED_INVALID_COORDINATE)
+        {
+          out[i].x = out[i].y = out[i].z = nan;
+          is_dense = false;
+          continue;
+        }
+        const Eigen::Vector3f p = to_world * Eigen::Vector3f (in[i].qx, in[i].qy, in[i].qz);
+        out[i].x = p[0]; out[i].y = p[1]; out[i].z = p[2];
+      }
+#endif
+      return (is_dense);
+    }
+
+    /** \brief Quantize the coordinates of \a cloud_in in parallel, and call \a op (in, out) for
+      * the other fields of every point.
+      */
+    template <typename PointT, typename PointQT, typename FieldOp> void
+    quantizePoints (const pcl::PointCloud<PointT> &cloud_in, const QuantizationParameters &params,
+                    pcl::PointCloud<PointQT> &cloud_out, FieldOp op)
+    {
+      const int nr_points = static_cast<int> (cloud_in.points.size ());
+      cloud_out.points.resize (nr_points);
+      cloud_out.header = cloud_in.header;
+      cloud_out.width = cloud_in.width;
+      cloud_out.height = cloud_in.height;
+      cloud_out.is_dense = cloud_in.is_dense;
+      cloud_out.sensor_origin_ = cloud_in.sensor_origin_;
+      cloud_out.sensor_orientation_ = cloud_in.sensor_orientation_;
+      if (nr_points == 0)
+        return;
+
+      const int block_size = 4096;
+      const int nr_blocks = (nr_points + block_size - 1) / block_size;
+#ifdef _OPENMP
+#pragma omp parallel for if (nr_points >= PCL_COMMON_PARALLEL_MIN_POINTS) schedule (static)
+#endif
+      for (int b = 0; b < nr_blocks; ++b)
+      {
+        const int begin = b * block_size, end = (std::min) (begin + block_size, nr_points);
+        if (op.enabled)
+          for (int i = begin; i < end; ++i)
+            op (cloud_in.points[i], cloud_out.points[i]);
+        quantizeCoordinates (&cloud_in.points[0], &cloud_out.points[0], begin, end, params);
+      }
+    }
+
+    /** \brief Restore the coordinates of \a cloud_in in parallel, and call \a op (in, out) for
+      * the other fields of every point.
+      */
+    template <typename PointQT, typename PointT, typename FieldOp> void
+    dequantizePoints (const pcl::PointCloud<PointQT> &cloud_in, const QuantizationParameters &params,
+                      pcl::PointCloud<PointT> &cloud_out, FieldOp op)
+    {
+      const int nr_points = static_cast<int> (cloud_in.points.size ());
+      cloud_out.points.resize (nr_points);
+      cloud_out.header = cloud_in.header;
+      cloud_out.width = cloud_in.width;
+      cloud_out.height = cloud_in.height;
+      cloud_out.sensor_origin_ = cloud_in.sensor_origin_;
+      cloud_out.sensor_orientation_ = cloud_in.sensor_orientation_;
+      cloud_out.is_dense = true;
+      if (nr_points == 0)
+        return;
+
+      const Eigen::Affine3f to_world = params.getTransform ();
+      const int block_size = 4096;
+      const int nr_blocks = (nr_points + block_size - 1) / block_size;
+      bool is_dense = true;
+#ifdef _OPENMP
+#pragma omp parallel for if (nr_points >= PCL_COMMON_PARALLEL_MIN_POINTS) schedule (static) reduction (&&: is_dense)
+#endif
+      for (int b = 0; b < nr_blocks; ++b)
+      {
+        const int begin = b * block_size, end = (std::min) (begin + block_size, nr_points);
+        if (op.enabled)
+          for (int i = begin; i < end; ++i)
+            op (cloud_in.points[i], cloud_out.points[i]);
+        is_dense = dequantizeCoordinates (&cloud_in.points[0], &cloud_out.points[0], begin, end, to_world) && is_dense;
+      }
+      cloud_out.is_dense = is_dense;
+    }
+
+    /** \brief No fields besides the coordinates. */
+    struct NoFieldOp
+    {
+      static const bool enabled = false;
+      template <typename PointInT, typename PointOutT> inline void
+      operator () (const PointInT&, PointOutT&) const {}
+    };
+
+    /** \brief (De)quantize the normals, curvatures and colors of the quantized type PointQT. */
+    template <typename PointQT>
+    struct NormalColorFieldOp
+    {
+      static const bool enabled = true;
+      const QuantizationParameters &params;
+
+      NormalColorFieldOp (const QuantizationParameters &p) : params (p) {}
+
+      template <typename PointT> inline void
+      operator () (const PointT &in, PointQT &out) const
+      {
+        quantizeNormal (Eigen::Vector3f (in.normal_x, in.normal_y, in.normal_z), params, out);
+        copyCurvature (in, out);
+        out.rgba = in.rgba;
+      }
+
+      template <typename PointT> inline void
+      operator () (const PointQT &in, PointT &out) const
+      {
+        const Eigen::Vector3f normal = dequantizeNormal (in, params);
+        out.normal_x = normal[0];
+        out.normal_y = normal[1];
+        out.normal_z = normal[2];
+        copyCurvature (in, out);
+        out.rgba = in.rgba;
+      }
+
+      template <typename PointT> static inline void
+      copyCurvature (const PointT &, PointXYZRGBNormalQ16 &) {}
+      template <typename PointT> static inline void
+      copyCurvature (const PointXYZRGBNormalQ16 &, PointT &) {}
+      template <typename PointT> static inline void
+      copyCurvature (const PointT &in, PointXYZRGBNormalQ32 &out) { quantizeCurvature (in.curvature, out); }
+      template <typename PointT> static inline void
+      copyCurvature (const PointXYZRGBNormalQ32 &in, PointT &out) { out.curvature = dequantizeCurvature (in); }
+    };
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+template <typename PointT> float
+pcl::computeQuantizationParameters (const pcl::PointCloud<PointT> &cloud, QuantizationParameters &params)
+{
+  Eigen::Vector4f min_pt, max_pt;
+  pcl::getMinMax3D (cloud, min_pt, max_pt);
+  if (cloud.points.empty () || !(min_pt[0] <= max_pt[0]))
+  {
+    params = QuantizationParameters ();
+    return (0.0f);
+  }
+
+  const float extent = (max_pt - min_pt).head<3> ().maxCoeff ();
+  float resolution = extent / (2.0f * static_cast<float> (QUANTIZED_MAX_COORDINATE));
+  if (!(resolution > 0.0f))
+    resolution = 1.0f;
+  params = QuantizationParameters (0.5f * (min_pt + max_pt).head<3> (), resolution);
+  return (resolution);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+template <typename PointT> void
+pcl::quantizePointCloud (const pcl::PointCloud<PointT> &cloud_in, const QuantizationParameters &params,
+                         pcl::PointCloud<PointXYZQ16> &cloud_out)
+{
+  detail::quantizePoints (cloud_in, params, cloud_out, detail::NoFieldOp ());
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+template <typename PointT> void
+pcl::quantizePointCloud (const pcl::PointCloud<PointT> &cloud_in, const QuantizationParameters &params,
+                         pcl::PointCloud<PointXYZRGBNormalQ16> &cloud_out)
+{
+  detail::quantizePoints (cloud_in, params, cloud_out, detail::NormalColorFieldOp<PointXYZRGBNormalQ16> (params));
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+template <typename PointT> void
+pcl::quantizePointCloud (const pcl::PointCloud<PointT> &cloud_in, const QuantizationParameters &params,
+                         pcl::PointCloud<PointXYZRGBNormalQ32> &cloud_out)
+{
+  detail::quantizePoints (cloud_in, params, cloud_out, detail::NormalColorFieldOp<PointXYZRGBNormalQ32> (params));
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+template <typename PointT> void
+pcl::dequantizePointCloud (const pcl::PointCloud<PointXYZQ16> &cloud_in, const QuantizationParameters &params,
+                           pcl::PointCloud<PointT> &cloud_out)
+{
+  detail::dequantizePoints (cloud_in, params, cloud_out, detail::NoFieldOp ());
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+template <typename PointT> void
+pcl::dequantizePointCloud (const pcl::PointCloud<PointXYZRGBNormalQ16> &cloud_in, const QuantizationParameters &params,
+                           pcl::PointCloud<PointT> &cloud_out)
+{
+  detail::dequantizePoints (cloud_in, params, cloud_out, detail::NormalColorFieldOp<PointXYZRGBNormalQ16> (params));
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+template <typename PointT> void
+pcl::dequantizePointCloud (const pcl::PointCloud<PointXYZRGBNormalQ32> &cloud_in, const QuantizationParameters &params,
+                           pcl::PointCloud<PointT> &cloud_out)
+{
+  detail::dequantizePoints (cloud_in, params, cloud_out, detail::NormalColorFieldOp<PointXYZRGBNormalQ32> (params));
+}
+
+#endif  // PCL_COMMON_IMPL_QUANTIZATION_HPP_
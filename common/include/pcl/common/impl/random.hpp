@@ -42,6 +42,119 @@
 
 #include <boost/version.hpp>
 #include <pcl/pcl_macros.h>
+#include <cmath>
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+inline void
+pcl::common::Xoshiro128::seed (pcl::uint64_t seed, pcl::uint64_t stream)
+{
+  // splitmix64 spreads even small or similar seeds over the whole state
+  pcl::uint64_t x = seed;
+  for (int i = 0; i < 2; ++i)
+  {
+    pcl::uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z ^= z >> 31;
+    s_[2 * i]     = static_cast<pcl::uint32_t> (z);
+    s_[2 * i + 1] = static_cast<pcl::uint32_t> (z >> 32);
+  }
+  // The all zero state is the only invalid one
+  if ((s_[0] | s_[1] | s_[2] | s_[3]) == 0)
+    s_[0] = 1;
+
+  for (pcl::uint64_t i = 0; i < stream; ++i)
+    jump ();
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+inline void
+pcl::common::Xoshiro128::jump ()
+{
+  static const pcl::uint32_t jump_polynomial[4] = { 0x8764000b, 0xf542d2d3, 0x6fa035c3, 0x77f2db5b };
+
+  pcl::uint32_t s[4] = { 0, 0, 0, 0 };
+  for (int i = 0; i < 4; ++i)
+  {
+    for (int b = 0; b < 32; ++b)
+    {
+      if (jump_polynomial[i] & (1u << b))
+      {
+        s[0] ^= s_[0];
+        s[1] ^= s_[1];
+        s[2] ^= s_[2];
+        s[3] ^= s_[3];
+      }
+      (*this) ();
+    }
+  }
+  s_[0] = s[0];
+  s_[1] = s[1];
+  s_[2] = s[2];
+  s_[3] = s[3];
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+inline double
+pcl::common::Xoshiro128::nextNormal ()
+{
+  // Box-Muller, 1 - u keeps the logarithm argument in (0, 1]
+  const double u = 1.0 - nextDouble ();
+  const double v = nextDouble ();
+  return (std::sqrt (-2.0 * std::log (u)) * std::cos (2.0 * M_PI * v));
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+inline void
+pcl::common::Xoshiro128::generate (pcl::uint32_t *out, size_t n)
+{
+  // Work on a local copy of the state so that it stays in registers
+  Xoshiro128 rng (*this);
+  for (size_t i = 0; i < n; ++i)
+    out[i] = rng ();
+  *this = rng;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+inline void
+pcl::common::Xoshiro128::generateBounded (pcl::uint32_t *out, size_t n, pcl::uint32_t bound)
+{
+  Xoshiro128 rng (*this);
+  for (size_t i = 0; i < n; ++i)
+    out[i] = rng.nextBounded (bound);
+  *this = rng;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+inline void
+pcl::common::Xoshiro128::generateUniform (float *out, size_t n, float lower, float upper)
+{
+  Xoshiro128 rng (*this);
+  const float scale = (upper - lower) * (1.0f / 16777216.0f);
+  for (size_t i = 0; i < n; ++i)
+    out[i] = lower + static_cast<float> (rng () >> 8) * scale;
+  *this = rng;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////
+inline void
+pcl::common::Xoshiro128::generateNormal (float *out, size_t n, float mean, float sigma)
+{
+  Xoshiro128 rng (*this);
+  const float two_pi = static_cast<float> (2.0 * M_PI);
+  size_t i = 0;
+  for (; i + 1 < n; i += 2)
+  {
+    const float u = 1.0f - rng.nextFloat ();
+    const float v = rng.nextFloat ();
+    const float r = sigma * std::sqrt (-2.0f * std::log (u));
+    out[i]     = mean + r * std::cos (two_pi * v);
+    out[i + 1] = mean + r * std::sin (two_pi * v);
+  }
+  if (i < n)
+    out[i] = mean + sigma * static_cast<float> (rng.nextNormal ());
+  *this = rng;
+}
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////
 template <typename T>
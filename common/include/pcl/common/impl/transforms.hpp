@@ -37,6 +37,182 @@
  *
  */
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(__AVX__)
+#include <immintrin.h>
+#endif
+
+/** \brief Clouds with at least this many points are transformed by all OpenMP
+  * threads. Only used when the including code is compiled with OpenMP.
+  */
+#ifndef PCL_TRANSFORMS_PARALLEL_MIN_POINTS
+#define PCL_TRANSFORMS_PARALLEL_MIN_POINTS 100000
+#endif
+
+namespace pcl
+{
+  namespace detail
+  {
+    /** \brief Applies a 4x4 matrix to the xyz coordinates (se3) or to the normal
+      * (so3) of a point, given as a pointer to its first component. Only the
+      * three components are read and written, so src and tgt may alias.
+      *
+      * The generic version is the plain scalar code. The float specialization
+      * uses SSE2 and the double specialization AVX when the compiler targets
+      * them; both multiply and add in the same order and precision as the
+      * scalar code, see transformPointCloud for the resulting tolerance.
+      */
+    template <typename Scalar>
+    struct Transformer
+    {
+      const Eigen::Matrix<Scalar, 4, 4> &tf;
+
+      Transformer (const Eigen::Matrix<Scalar, 4, 4> &transform) : tf (transform) {}
+
+      inline void
+      se3 (const float *src, float *tgt) const
+      {
+        const Scalar p0 = src[0], p1 = src[1], p2 = src[2];
+        tgt[0] = static_cast<float> (tf (0, 0) * p0 + tf (0, 1) * p1 + tf (0, 2) * p2 + tf (0, 3));
+        tgt[1] = static_cast<float> (tf (1, 0) * p0 + tf (1, 1) * p1 + tf (1, 2) * p2 + tf (1, 3));
+        tgt[2] = static_cast<float> (tf (2, 0) * p0 + tf (2, 1) * p1 + tf (2, 2) * p2 + tf (2, 3));
+      }
+
+      inline void
+      so3 (const float *src, float *tgt) const
+      {
+        const Scalar p0 = src[0], p1 = src[1], p2 = src[2];
+        tgt[0] = static_cast<float> (tf (0, 0) * p0 + tf (0, 1) * p1 + tf (0, 2) * p2);
+        tgt[1] = static_cast<float> (tf (1, 0) * p0 + tf (1, 1) * p1 + tf (1, 2) * p2);
+        tgt[2] = static_cast<float> (tf (2, 0) * p0 + tf (2, 1) * p1 + tf (2, 2) * p2);
+      }
+    };
+
+#if defined(__SSE2__)
+    template <>
+    struct Transformer<float>
+    {
+      /** \brief The columns of the matrix, c[3] being the translation */
+      __m128 c[4];
+
+      Transformer (const Eigen::Matrix4f &tf)
+      {
+        for (int i = 0; i < 4; ++i)
+          c[i] = _mm_set_ps (tf (3, i), tf (2, i), tf (1, i), tf (0, i));
+      }
+
+      inline void
+      store (const __m128 &p, float *tgt) const
+      {
+        _mm_storel_pi (reinterpret_cast<__m64*> (tgt), p);
+        _mm_store_ss (tgt + 2, _mm_movehl_ps (p, p));
+      }
+
+      inline void
+      se3 (const float *src, float *tgt) const
+      {
+        const __m128 p0 = _mm_mul_ps (c[0], _mm_set1_ps (src[0]));
+        const __m128 p1 = _mm_mul_ps (c[1], _mm_set1_ps (src[1]));
+        const __m128 p2 = _mm_mul_ps (c[2], _mm_set1_ps (src[2]));
+        store (_mm_add_ps (_mm_add_ps (_mm_add_ps (p0, p1), p2), c[3]), tgt);
+      }
+
+      inline void
+      so3 (const float *src, float *tgt) const
+      {
+        const __m128 p0 = _mm_mul_ps (c[0], _mm_set1_ps (src[0]));
+        const __m128 p1 = _mm_mul_ps (c[1], _mm_set1_ps (src[1]));
+        const __m128 p2 = _mm_mul_ps (c[2], _mm_set1_ps (src[2]));
+        store (_mm_add_ps (_mm_add_ps (p0, p1), p2), tgt);
+      }
+    };
+#endif
+
+#if defined(__AVX__)
+    template <>
+    struct Transformer<double>
+    {
+      /** \brief The columns of the matrix, c[3] being the translation */
+      __m256d c[4];
+
+      Transformer (const Eigen::Matrix4d &tf)
+      {
+        for (int i = 0; i < 4; ++i)
+          c[i] = _mm256_set_pd (tf (3, i), tf (2, i), tf (1, i), tf (0, i));
+      }
+
+      inline void
+      store (const __m256d &p, float *tgt) const
+      {
+        const __m128 f = _mm256_cvtpd_ps (p);
+        _mm_storel_pi (reinterpret_cast<__m64*> (tgt), f);
+        _mm_store_ss (tgt + 2, _mm_movehl_ps (f, f));
+      }
+
+      inline void
+      se3 (const float *src, float *tgt) const
+      {
+        const __m256d p0 = _mm256_mul_pd (c[0], _mm256_set1_pd (src[0]));
+        const __m256d p1 = _mm256_mul_pd (c[1], _mm256_set1_pd (src[1]));
+        const __m256d p2 = _mm256_mul_pd (c[2], _mm256_set1_pd (src[2]));
+        store (_mm256_add_pd (_mm256_add_pd (_mm256_add_pd (p0, p1), p2), c[3]), tgt);
+      }
+
+      inline void
+      so3 (const float *src, float *tgt) const
+      {
+        const __m256d p0 = _mm256_mul_pd (c[0], _mm256_set1_pd (src[0]));
+        const __m256d p1 = _mm256_mul_pd (c[1], _mm256_set1_pd (src[1]));
+        const __m256d p2 = _mm256_mul_pd (c[2], _mm256_set1_pd (src[2]));
+        store (_mm256_add_pd (_mm256_add_pd (p0, p1), p2), tgt);
+      }
+    };
+#endif
+
+    /** \brief Transforms the xyz coordinates of nr_points points in place. Points
+      * with a non-finite coordinate are left untouched if check_finite is set.
+      * Large clouds are split across the OpenMP threads.
+      */
+    template <typename PointT, typename Scalar> void
+    transformPointsXYZ (PointT *points, int nr_points, bool check_finite,
+                        const Eigen::Matrix<Scalar, 4, 4> &transform)
+    {
+      const Transformer<Scalar> tf (transform);
+#ifdef _OPENMP
+#pragma omp parallel for if (nr_points >= PCL_TRANSFORMS_PARALLEL_MIN_POINTS) schedule (static)
+#endif
+      for (int i = 0; i < nr_points; ++i)
+      {
+        PointT &p = points[i];
+        if (check_finite && (!pcl_isfinite (p.x) || !pcl_isfinite (p.y) || !pcl_isfinite (p.z)))
+          continue;
+        tf.se3 (&p.x, &p.x);
+      }
+    }
+
+    /** \brief As transformPointsXYZ, also rotating the normals */
+    template <typename PointT, typename Scalar> void
+    transformPointsWithNormals (PointT *points, int nr_points, bool check_finite,
+                                const Eigen::Matrix<Scalar, 4, 4> &transform)
+    {
+      const Transformer<Scalar> tf (transform);
+#ifdef _OPENMP
+#pragma omp parallel for if (nr_points >= PCL_TRANSFORMS_PARALLEL_MIN_POINTS) schedule (static)
+#endif
+      for (int i = 0; i < nr_points; ++i)
+      {
+        PointT &p = points[i];
+        if (check_finite && (!pcl_isfinite (p.x) || !pcl_isfinite (p.y) || !pcl_isfinite (p.z)))
+          continue;
+        tf.se3 (&p.x, &p.x);
+        tf.so3 (&p.normal_x, &p.normal_x);
+      }
+    }
+  }
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////
 template <typename PointT, typename Scalar> void
 pcl::transformPointCloud (const pcl::PointCloud<PointT> &cloud_in, 
@@ -55,36 +231,14 @@ pcl::transformPointCloud (const pcl::PointCloud<PointT> &cloud_in,
     cloud_out.sensor_orientation_ = cloud_in.sensor_orientation_;
     cloud_out.sensor_origin_      = cloud_in.sensor_origin_;
   }
+  if (cloud_out.points.empty ())
+    return;
 
-  if (cloud_in.is_dense)
-  {
-    // If the dataset is dense, simply transform it!
-    for (size_t i = 0; i < cloud_out.points.size (); ++i)
-    {
-      //cloud_out.points[i].getVector3fMap () = transform * cloud_in.points[i].getVector3fMap ();
-      Eigen::Matrix<Scalar, 3, 1> pt (cloud_in[i].x, cloud_in[i].y, cloud_in[i].z);
-      cloud_out[i].x = static_cast<float> (transform (0, 0) * pt.coeffRef (0) + transform (0, 1) * pt.coeffRef (1) + transform (0, 2) * pt.coeffRef (2) + transform (0, 3));
-      cloud_out[i].y = static_cast<float> (transform (1, 0) * pt.coeffRef (0) + transform (1, 1) * pt.coeffRef (1) + transform (1, 2) * pt.coeffRef (2) + transform (1, 3));
-      cloud_out[i].z = static_cast<float> (transform (2, 0) * pt.coeffRef (0) + transform (2, 1) * pt.coeffRef (1) + transform (2, 2) * pt.coeffRef (2) + transform (2, 3));
-    }
-  }
-  else
-  {
-    // Dataset might contain NaNs and Infs, so check for them first,
-    // otherwise we get errors during the multiplication (?)
-    for (size_t i = 0; i < cloud_out.points.size (); ++i)
-    {
-      if (!pcl_isfinite (cloud_in.points[i].x) || 
-          !pcl_isfinite (cloud_in.points[i].y) || 
-          !pcl_isfinite (cloud_in.points[i].z))
-        continue;
-      //cloud_out.points[i].getVector3fMap () = transform * cloud_in.points[i].getVector3fMap ();
-      Eigen::Matrix<Scalar, 3, 1> pt (cloud_in[i].x, cloud_in[i].y, cloud_in[i].z);
-      cloud_out[i].x = static_cast<float> (transform (0, 0) * pt.coeffRef (0) + transform (0, 1) * pt.coeffRef (1) + transform (0, 2) * pt.coeffRef (2) + transform (0, 3));
-      cloud_out[i].y = static_cast<float> (transform (1, 0) * pt.coeffRef (0) + transform (1, 1) * pt.coeffRef (1) + transform (1, 2) * pt.coeffRef (2) + transform (1, 3));
-      cloud_out[i].z = static_cast<float> (transform (2, 0) * pt.coeffRef (0) + transform (2, 1) * pt.coeffRef (1) + transform (2, 2) * pt.coeffRef (2) + transform (2, 3));
-    }
-  }
+  // Dataset might contain NaNs and Infs, so check for them first,
+  // otherwise we get errors during the multiplication (?)
+  detail::transformPointsXYZ<PointT, Scalar> (&cloud_out.points[0],
+                                              static_cast<int> (cloud_out.points.size ()),
+                                              !cloud_in.is_dense, transform.matrix ());
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -103,39 +257,15 @@ pcl::transformPointCloud (const pcl::PointCloud<PointT> &cloud_in,
   cloud_out.points.resize (npts);
   cloud_out.sensor_orientation_ = cloud_in.sensor_orientation_;
   cloud_out.sensor_origin_      = cloud_in.sensor_origin_;
+  if (npts == 0)
+    return;
 
-  if (cloud_in.is_dense)
-  {
-    // If the dataset is dense, simply transform it!
-    for (size_t i = 0; i < npts; ++i)
-    {
-      // Copy fields first, then transform xyz data
-      //cloud_out.points[i] = cloud_in.points[indices[i]]; 
-      //cloud_out.points[i].getVector3fMap () = transform*cloud_out.points[i].getVector3fMap ();
-      Eigen::Matrix<Scalar, 3, 1> pt (cloud_in[indices[i]].x, cloud_in[indices[i]].y, cloud_in[indices[i]].z);
-      cloud_out[i].x = static_cast<float> (transform (0, 0) * pt.coeffRef (0) + transform (0, 1) * pt.coeffRef (1) + transform (0, 2) * pt.coeffRef (2) + transform (0, 3));
-      cloud_out[i].y = static_cast<float> (transform (1, 0) * pt.coeffRef (0) + transform (1, 1) * pt.coeffRef (1) + transform (1, 2) * pt.coeffRef (2) + transform (1, 3));
-      cloud_out[i].z = static_cast<float> (transform (2, 0) * pt.coeffRef (0) + transform (2, 1) * pt.coeffRef (1) + transform (2, 2) * pt.coeffRef (2) + transform (2, 3));
-    }
-  }
-  else
-  {
-    // Dataset might contain NaNs and Infs, so check for them first,
-    // otherwise we get errors during the multiplication (?)
-    for (size_t i = 0; i < npts; ++i)
-    {
-      if (!pcl_isfinite (cloud_in.points[indices[i]].x) || 
-          !pcl_isfinite (cloud_in.points[indices[i]].y) || 
-          !pcl_isfinite (cloud_in.points[indices[i]].z))
-        continue;
-      //cloud_out.points[i] = cloud_in.points[indices[i]]; 
-      //cloud_out.points[i].getVector3fMap () = transform*cloud_out.points[i].getVector3fMap ();
-      Eigen::Matrix<Scalar, 3, 1> pt (cloud_in[indices[i]].x, cloud_in[indices[i]].y, cloud_in[indices[i]].z);
-      cloud_out[i].x = static_cast<float> (transform (0, 0) * pt.coeffRef (0) + transform (0, 1) * pt.coeffRef (1) + transform (0, 2) * pt.coeffRef (2) + transform (0, 3));
-      cloud_out[i].y = static_cast<float> (transform (1, 0) * pt.coeffRef (0) + transform (1, 1) * pt.coeffRef (1) + transform (1, 2) * pt.coeffRef (2) + transform (1, 3));
-      cloud_out[i].z = static_cast<float> (transform (2, 0) * pt.coeffRef (0) + transform (2, 1) * pt.coeffRef (1) + transform (2, 2) * pt.coeffRef (2) + transform (2, 3));
-    }
-  }
+  // Copy fields first, then transform xyz data
+  for (size_t i = 0; i < npts; ++i)
+    cloud_out.points[i] = cloud_in.points[indices[i]];
+  detail::transformPointsXYZ<PointT, Scalar> (&cloud_out.points[0],
+                                              static_cast<int> (npts), !cloud_in.is_dense,
+                                              transform.matrix ());
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -156,50 +286,14 @@ pcl::transformPointCloudWithNormals (const pcl::PointCloud<PointT> &cloud_in,
     cloud_out.sensor_orientation_ = cloud_in.sensor_orientation_;
     cloud_out.sensor_origin_      = cloud_in.sensor_origin_;
   }
+  if (cloud_out.points.empty ())
+    return;
 
+  // Normals are only rotated; no SVD is involved as the linear part is used as is.
   // If the data is dense, we don't need to check for NaN
-  if (cloud_in.is_dense)
-  {
-    for (size_t i = 0; i < cloud_out.points.size (); ++i)
-    {
-      //cloud_out.points[i].getVector3fMap() = transform * cloud_in.points[i].getVector3fMap ();
-      Eigen::Matrix<Scalar, 3, 1> pt (cloud_in[i].x, cloud_in[i].y, cloud_in[i].z);
-      cloud_out[i].x = static_cast<float> (transform (0, 0) * pt.coeffRef (0) + transform (0, 1) * pt.coeffRef (1) + transform (0, 2) * pt.coeffRef (2) + transform (0, 3));
-      cloud_out[i].y = static_cast<float> (transform (1, 0) * pt.coeffRef (0) + transform (1, 1) * pt.coeffRef (1) + transform (1, 2) * pt.coeffRef (2) + transform (1, 3));
-      cloud_out[i].z = static_cast<float> (transform (2, 0) * pt.coeffRef (0) + transform (2, 1) * pt.coeffRef (1) + transform (2, 2) * pt.coeffRef (2) + transform (2, 3));
-
-      // Rotate normals (WARNING: transform.rotation () uses SVD internally!)
-      //cloud_out.points[i].getNormalVector3fMap() = transform.rotation () * cloud_in.points[i].getNormalVector3fMap ();
-      Eigen::Matrix<Scalar, 3, 1> nt (cloud_in[i].normal_x, cloud_in[i].normal_y, cloud_in[i].normal_z);
-      cloud_out[i].normal_x = static_cast<float> (transform (0, 0) * nt.coeffRef (0) + transform (0, 1) * nt.coeffRef (1) + transform (0, 2) * nt.coeffRef (2));
-      cloud_out[i].normal_y = static_cast<float> (transform (1, 0) * nt.coeffRef (0) + transform (1, 1) * nt.coeffRef (1) + transform (1, 2) * nt.coeffRef (2));
-      cloud_out[i].normal_z = static_cast<float> (transform (2, 0) * nt.coeffRef (0) + transform (2, 1) * nt.coeffRef (1) + transform (2, 2) * nt.coeffRef (2));
-    }
-  }
-  // Dataset might contain NaNs and Infs, so check for them first.
-  else
-  {
-    for (size_t i = 0; i < cloud_out.points.size (); ++i)
-    {
-      if (!pcl_isfinite (cloud_in.points[i].x) || 
-          !pcl_isfinite (cloud_in.points[i].y) || 
-          !pcl_isfinite (cloud_in.points[i].z))
-        continue;
-
-      //cloud_out.points[i].getVector3fMap() = transform * cloud_in.points[i].getVector3fMap ();
-      Eigen::Matrix<Scalar, 3, 1> pt (cloud_in[i].x, cloud_in[i].y, cloud_in[i].z);
-      cloud_out[i].x = static_cast<float> (transform (0, 0) * pt.coeffRef (0) + transform (0, 1) * pt.coeffRef (1) + transform (0, 2) * pt.coeffRef (2) + transform (0, 3));
-      cloud_out[i].y = static_cast<float> (transform (1, 0) * pt.coeffRef (0) + transform (1, 1) * pt.coeffRef (1) + transform (1, 2) * pt.coeffRef (2) + transform (1, 3));
-      cloud_out[i].z = static_cast<float> (transform (2, 0) * pt.coeffRef (0) + transform (2, 1) * pt.coeffRef (1) + transform (2, 2) * pt.coeffRef (2) + transform (2, 3));
-
-      // Rotate normals
-      //cloud_out.points[i].getNormalVector3fMap() = transform.rotation () * cloud_in.points[i].getNormalVector3fMap ();
-      Eigen::Matrix<Scalar, 3, 1> nt (cloud_in[i].normal_x, cloud_in[i].normal_y, cloud_in[i].normal_z);
-      cloud_out[i].normal_x = static_cast<float> (transform (0, 0) * nt.coeffRef (0) + transform (0, 1) * nt.coeffRef (1) + transform (0, 2) * nt.coeffRef (2));
-      cloud_out[i].normal_y = static_cast<float> (transform (1, 0) * nt.coeffRef (0) + transform (1, 1) * nt.coeffRef (1) + transform (1, 2) * nt.coeffRef (2));
-      cloud_out[i].normal_z = static_cast<float> (transform (2, 0) * nt.coeffRef (0) + transform (2, 1) * nt.coeffRef (1) + transform (2, 2) * nt.coeffRef (2));
-    }
-  }
+  detail::transformPointsWithNormals<PointT, Scalar> (&cloud_out.points[0],
+                                                      static_cast<int> (cloud_out.points.size ()),
+                                                      !cloud_in.is_dense, transform.matrix ());
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -218,50 +312,15 @@ pcl::transformPointCloudWithNormals (const pcl::PointCloud<PointT> &cloud_in,
   cloud_out.points.resize (npts);
   cloud_out.sensor_orientation_ = cloud_in.sensor_orientation_;
   cloud_out.sensor_origin_      = cloud_in.sensor_origin_;
+  if (npts == 0)
+    return;
 
-  // If the data is dense, we don't need to check for NaN
-  if (cloud_in.is_dense)
-  {
-    for (size_t i = 0; i < cloud_out.points.size (); ++i)
-    {
-      //cloud_out.points[i].getVector3fMap() = transform * cloud_in.points[i].getVector3fMap ();
-      Eigen::Matrix<Scalar, 3, 1> pt (cloud_in[indices[i]].x, cloud_in[indices[i]].y, cloud_in[indices[i]].z);
-      cloud_out[i].x = static_cast<float> (transform (0, 0) * pt.coeffRef (0) + transform (0, 1) * pt.coeffRef (1) + transform (0, 2) * pt.coeffRef (2) + transform (0, 3));
-      cloud_out[i].y = static_cast<float> (transform (1, 0) * pt.coeffRef (0) + transform (1, 1) * pt.coeffRef (1) + transform (1, 2) * pt.coeffRef (2) + transform (1, 3));
-      cloud_out[i].z = static_cast<float> (transform (2, 0) * pt.coeffRef (0) + transform (2, 1) * pt.coeffRef (1) + transform (2, 2) * pt.coeffRef (2) + transform (2, 3));
-
-      // Rotate normals
-      //cloud_out.points[i].getNormalVector3fMap() = transform.rotation () * cloud_in.points[i].getNormalVector3fMap ();
-      Eigen::Matrix<Scalar, 3, 1> nt (cloud_in[indices[i]].normal_x, cloud_in[indices[i]].normal_y, cloud_in[indices[i]].normal_z);
-      cloud_out[i].normal_x = static_cast<float> (transform (0, 0) * nt.coeffRef (0) + transform (0, 1) * nt.coeffRef (1) + transform (0, 2) * nt.coeffRef (2));
-      cloud_out[i].normal_y = static_cast<float> (transform (1, 0) * nt.coeffRef (0) + transform (1, 1) * nt.coeffRef (1) + transform (1, 2) * nt.coeffRef (2));
-      cloud_out[i].normal_z = static_cast<float> (transform (2, 0) * nt.coeffRef (0) + transform (2, 1) * nt.coeffRef (1) + transform (2, 2) * nt.coeffRef (2));
-    }
-  }
-  // Dataset might contain NaNs and Infs, so check for them first.
-  else
-  {
-    for (size_t i = 0; i < cloud_out.points.size (); ++i)
-    {
-      if (!pcl_isfinite (cloud_in.points[indices[i]].x) || 
-          !pcl_isfinite (cloud_in.points[indices[i]].y) || 
-          !pcl_isfinite (cloud_in.points[indices[i]].z))
-        continue;
-
-      //cloud_out.points[i].getVector3fMap() = transform * cloud_in.points[i].getVector3fMap ();
-      Eigen::Matrix<Scalar, 3, 1> pt (cloud_in[indices[i]].x, cloud_in[indices[i]].y, cloud_in[indices[i]].z);
-      cloud_out[i].x = static_cast<float> (transform (0, 0) * pt.coeffRef (0) + transform (0, 1) * pt.coeffRef (1) + transform (0, 2) * pt.coeffRef (2) + transform (0, 3));
-      cloud_out[i].y = static_cast<float> (transform (1, 0) * pt.coeffRef (0) + transform (1, 1) * pt.coeffRef (1) + transform (1, 2) * pt.coeffRef (2) + transform (1, 3));
-      cloud_out[i].z = static_cast<float> (transform (2, 0) * pt.coeffRef (0) + transform (2, 1) * pt.coeffRef (1) + transform (2, 2) * pt.coeffRef (2) + transform (2, 3));
-
-      // Rotate normals
-      //cloud_out.points[i].getNormalVector3fMap() = transform.rotation () * cloud_in.points[i].getNormalVector3fMap ();
-      Eigen::Matrix<Scalar, 3, 1> nt (cloud_in[indices[i]].normal_x, cloud_in[indices[i]].normal_y, cloud_in[indices[i]].normal_z);
-      cloud_out[i].normal_x = static_cast<float> (transform (0, 0) * nt.coeffRef (0) + transform (0, 1) * nt.coeffRef (1) + transform (0, 2) * nt.coeffRef (2));
-      cloud_out[i].normal_y = static_cast<float> (transform (1, 0) * nt.coeffRef (0) + transform (1, 1) * nt.coeffRef (1) + transform (1, 2) * nt.coeffRef (2));
-      cloud_out[i].normal_z = static_cast<float> (transform (2, 0) * nt.coeffRef (0) + transform (2, 1) * nt.coeffRef (1) + transform (2, 2) * nt.coeffRef (2));
-    }
-  }
+  // Copy fields first, then transform xyz data and normals
+  for (size_t i = 0; i < npts; ++i)
+    cloud_out.points[i] = cloud_in.points[indices[i]];
+  detail::transformPointsWithNormals<PointT, Scalar> (&cloud_out.points[0],
+                                                      static_cast<int> (npts), !cloud_in.is_dense,
+                                                      transform.matrix ());
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////
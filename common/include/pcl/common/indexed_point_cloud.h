@@ -0,0 +1,130 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Point Cloud Library (PCL) - www.pointclouds.org
+ *  Copyright (c) 2013-, Open Perception, Inc.
+ *
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder(s) nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef PCL_COMMON_INDEXED_POINT_CLOUD_H_
+#define PCL_COMMON_INDEXED_POINT_CLOUD_H_
+
+#include <vector>
+#include <limits>
+#include <pcl/point_cloud.h>
+#include <pcl/common/io.h>
+
+namespace pcl
+{
+  /** \brief A subset of a point cloud given by a shared cloud and the indices of its points,
+    * e.g. the output of a filter, without copying the points.
+    *
+    * The view keeps the cloud and the indices alive. Consumers that need a contiguous cloud call
+    * \ref materialize; consumers that accept indices (setInputCloud + setIndices) use
+    * \ref getCloud and \ref getIndices directly.
+    * \ingroup common
+    */
+  template <typename PointT>
+  class IndexedPointCloud
+  {
+    public:
+      typedef pcl::PointCloud<PointT> Cloud;
+      typedef typename Cloud::ConstPtr CloudConstPtr;
+      typedef boost::shared_ptr<std::vector<int> > IndicesPtr;
+      typedef boost::shared_ptr<const std::vector<int> > IndicesConstPtr;
+
+      /** \brief Empty view. */
+      IndexedPointCloud () : cloud_ (new Cloud), indices_ (new std::vector<int>) {}
+
+      /** \brief Constructor.
+        * \param[in] cloud the point cloud
+        * \param[in] indices the indices of the points of \a cloud in the view
+        */
+      IndexedPointCloud (const CloudConstPtr &cloud, const IndicesConstPtr &indices)
+        : cloud_ (cloud), indices_ (indices)
+      {}
+
+      /** \brief Get the point cloud the indices refer to. */
+      inline const CloudConstPtr&
+      getCloud () const { return (cloud_); }
+
+      /** \brief Get the indices of the points in the view. */
+      inline const IndicesConstPtr&
+      getIndices () const { return (indices_); }
+
+      /** \brief Number of points in the view. */
+      inline size_t
+      size () const { return (indices_->size ()); }
+
+      /** \brief Whether the view has no points. */
+      inline bool
+      empty () const { return (indices_->empty ()); }
+
+      /** \brief The i-th point of the view. */
+      inline const PointT&
+      operator[] (size_t i) const { return (cloud_->points[(*indices_)[i]]); }
+
+      /** \brief Copy the points of the view into a contiguous, unorganized cloud.
+        * \param[out] output the resultant point cloud
+        */
+      inline void
+      materialize (Cloud &output) const
+      {
+        pcl::copyPointCloud (*cloud_, *indices_, output);
+      }
+
+      /** \brief Copy the cloud, keeping its organized structure, and set the coordinates of the
+        * points which are not in the view to \a value, like filters with setKeepOrganized (true).
+        * \param[out] output the resultant point cloud
+        * \param[in] value the value of the coordinates of the points not in the view
+        */
+      void
+      materializeOrganized (Cloud &output, float value = std::numeric_limits<float>::quiet_NaN ()) const
+      {
+        output = *cloud_;
+        std::vector<bool> keep (cloud_->points.size (), false);
+        for (size_t i = 0; i < indices_->size (); ++i)
+          keep[(*indices_)[i]] = true;
+        for (size_t i = 0; i < keep.size (); ++i)
+          if (!keep[i])
+            output.points[i].x = output.points[i].y = output.points[i].z = value;
+        if (!pcl_isfinite (value) && indices_->size () < keep.size ())
+          output.is_dense = false;
+      }
+
+    private:
+      CloudConstPtr cloud_;
+      IndicesConstPtr indices_;
+  };
+}
+
+#endif  // PCL_COMMON_INDEXED_POINT_CLOUD_H_
@@ -0,0 +1,135 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Point Cloud Library (PCL) - www.pointclouds.org
+ *  Copyright (c) 2013-, Open Perception, Inc.
+ *
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder(s) nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef PCL_COMMON_MORTON_H_
+#define PCL_COMMON_MORTON_H_
+
+#include <vector>
+#include <pcl/pcl_macros.h>
+#include <pcl/point_cloud.h>
+
+/** \brief Number of points from which the Morton codes are computed and the points are
+  * permuted with OpenMP.
+  */
+#ifndef PCL_MORTON_PARALLEL_MIN_POINTS
+#define PCL_MORTON_PARALLEL_MIN_POINTS 100000
+#endif
+
+namespace pcl
+{
+  namespace detail
+  {
+    /** \brief Insert two zero bits after each of the lower 21 bits of \a v. */
+    inline uint64_t
+    spreadMortonBits (uint64_t v)
+    {
+      v &= 0x1fffffULL;
+      v = (v | v << 32) & 0x1f00000000ffffULL;
+      v = (v | v << 16) & 0x1f0000ff0000ffULL;
+      v = (v | v << 8)  & 0x100f00f00f00f00fULL;
+      v = (v | v << 4)  & 0x10c30c30c30c30c3ULL;
+      v = (v | v << 2)  & 0x1249249249249249ULL;
+      return (v);
+    }
+  }
+
+  /** \brief Key given to points with non-finite coordinates. It is larger than every valid
+    * 63-bit Morton code, so these points are sorted to the end.
+    */
+  const uint64_t MORTON_CODE_INVALID = 1ULL << 63;
+
+  /** \brief Interleave the bits of three 21-bit cell coordinates into a 63-bit Morton
+    * (Z-order) code, x in the lowest bit.
+    * \param[in] x the cell coordinate on the x axis, in [0, 2^21)
+    * \param[in] y the cell coordinate on the y axis, in [0, 2^21)
+    * \param[in] z the cell coordinate on the z axis, in [0, 2^21)
+    * \ingroup common
+    */
+  inline uint64_t
+  encodeMortonCode (uint32_t x, uint32_t y, uint32_t z)
+  {
+    return (detail::spreadMortonBits (x) | detail::spreadMortonBits (y) << 1 | detail::spreadMortonBits (z) << 2);
+  }
+
+  /** \brief Compute the 63-bit Morton code of every point. The bounding cube of the finite
+    * points is divided into 2^21 cells per axis; points with NaN or Inf coordinates get
+    * \ref MORTON_CODE_INVALID.
+    * \param[in] cloud the input point cloud
+    * \param[out] codes the resultant Morton codes, one per point
+    * \ingroup common
+    */
+  template <typename PointT> void
+  computeMortonCodes (const pcl::PointCloud<PointT> &cloud, std::vector<uint64_t> &codes);
+
+  /** \brief Sort Morton codes with a stable least significant digit radix sort.
+    * \param[in,out] codes the codes to sort
+    * \param[out] permutation permutation[i] is the position in the unsorted \a codes of
+    * the i-th sorted code
+    * \ingroup common
+    */
+  PCL_EXPORTS void
+  sortMortonCodes (std::vector<uint64_t> &codes, std::vector<int> &permutation);
+
+  /** \brief Reorder a point cloud along the Morton (Z-order) curve, so that points which
+    * are close in space are also close in memory. Neighborhood searches on the result
+    * touch fewer cache lines than on clouds stored in scan order.
+    *
+    * Whole points are moved, so all fields are kept. Points with the same code keep their
+    * relative order and invalid points are moved to the end. The output is unorganized
+    * (height 1).
+    * \param[in] cloud_in the input point cloud
+    * \param[out] cloud_out the reordered point cloud
+    * \param[out] permutation point i of \a cloud_out is point permutation[i] of \a cloud_in;
+    * use it to map indices computed on the reordered cloud back to the input
+    * \ingroup common
+    */
+  template <typename PointT> void
+  reorderByMortonCode (const pcl::PointCloud<PointT> &cloud_in, pcl::PointCloud<PointT> &cloud_out,
+                       std::vector<int> &permutation);
+
+  /** \brief Reorder a point cloud along the Morton (Z-order) curve, in place.
+    * \param[in,out] cloud the point cloud to reorder
+    * \param[out] permutation the new point i was point permutation[i] before
+    * \ingroup common
+    */
+  template <typename PointT> void
+  reorderByMortonCode (pcl::PointCloud<PointT> &cloud, std::vector<int> &permutation);
+}
+
+#include <pcl/common/impl/morton.hpp>
+
+#endif  // PCL_COMMON_MORTON_H_
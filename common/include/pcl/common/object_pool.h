@@ -0,0 +1,152 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Point Cloud Library (PCL) - www.pointclouds.org
+ *  Copyright (c) 2013-, Open Perception, Inc.
+ *
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder(s) nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef PCL_COMMON_OBJECT_POOL_H_
+#define PCL_COMMON_OBJECT_POOL_H_
+
+#include <vector>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include <pcl/pcl_macros.h>
+#include <pcl/point_cloud.h>
+#include <pcl/PointIndices.h>
+
+namespace pcl
+{
+  namespace detail
+  {
+    /** \brief Bring an object returned to a pcl::ObjectPool into its empty state,
+      * keeping allocated memory. Objects without an overload are reused as they are.
+      */
+    template <typename T> inline void
+    recycle (T &)
+    {
+    }
+
+    template <typename PointT> inline void
+    recycle (pcl::PointCloud<PointT> &cloud)
+    {
+      cloud.points.clear ();
+      cloud.width = cloud.height = 0;
+      cloud.is_dense = true;
+    }
+
+    inline void
+    recycle (pcl::PointIndices &indices)
+    {
+      indices.indices.clear ();
+    }
+  }
+
+  /** \brief Pool of reusable objects, e.g. the output clouds and indices of a
+    * pipeline running at a fixed frame rate.
+    *
+    * acquire () returns an object which is not used by anybody else; once all its
+    * shared pointers are gone it becomes available again. Point clouds and point
+    * indices are handed out empty but keep their capacity, so that filling them with
+    * a similar number of points as in the previous frame does not allocate.
+    *
+    * \code
+    * pcl::ObjectPool<pcl::PointCloud<pcl::PointXYZ> > clouds;
+    * while (grabbing)
+    * {
+    *   pcl::PointCloud<pcl::PointXYZ>::Ptr filtered = clouds.acquire ();
+    *   voxel_grid.filter (*filtered);
+    *   ...
+    * }
+    * \endcode
+    *
+    * acquire () is thread safe.
+    * \ingroup common
+    */
+  template <typename T>
+  class ObjectPool
+  {
+    public:
+      typedef boost::shared_ptr<T> Ptr;
+
+      ObjectPool () : mutex_ (), objects_ () {}
+
+      /** \brief Get an unused object, allocating a new one only if all objects of
+        * the pool are in use.
+        */
+      Ptr
+      acquire ()
+      {
+        boost::mutex::scoped_lock lock (mutex_);
+        // Objects are only handed out here, so an object referenced by the pool
+        // alone cannot be acquired concurrently
+        for (size_t i = 0; i < objects_.size (); ++i)
+          if (objects_[i].unique ())
+          {
+            detail::recycle (*objects_[i]);
+            return (objects_[i]);
+          }
+        objects_.push_back (Ptr (new T));
+        return (objects_.back ());
+      }
+
+      /** \brief Number of objects created by the pool. */
+      size_t
+      size () const
+      {
+        boost::mutex::scoped_lock lock (mutex_);
+        return (objects_.size ());
+      }
+
+      /** \brief Free all objects which are not in use. */
+      void
+      shrink ()
+      {
+        boost::mutex::scoped_lock lock (mutex_);
+        std::vector<Ptr> used;
+        for (size_t i = 0; i < objects_.size (); ++i)
+          if (!objects_[i].unique ())
+            used.push_back (objects_[i]);
+        objects_.swap (used);
+      }
+
+    private:
+      ObjectPool (const ObjectPool&);
+      ObjectPool& operator = (const ObjectPool&);
+
+      mutable boost::mutex mutex_;
+      std::vector<Ptr> objects_;
+  };
+}
+
+#endif  // PCL_COMMON_OBJECT_POOL_H_
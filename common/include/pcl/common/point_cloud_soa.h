@@ -0,0 +1,253 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Point Cloud Library (PCL) - www.pointclouds.org
+ *  Copyright (c) 2013-, Open Perception, Inc.
+ *
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder(s) nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef PCL_COMMON_POINT_CLOUD_SOA_H_
+#define PCL_COMMON_POINT_CLOUD_SOA_H_
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <pcl/pcl_macros.h>
+#include <pcl/point_cloud.h>
+#include <pcl/PCLHeader.h>
+
+namespace pcl
+{
+  /** \brief Structure-of-arrays copy of a point cloud.
+    *
+    * The x, y and z coordinates are stored as three contiguous float arrays
+    * in a single buffer, each of them 16 byte aligned, so that vectorized code
+    * can process several points per instruction without gathering. Compared
+    * to the padded PointXYZ layout this needs 12 instead of 16 bytes per point.
+    * Additional scalar float fields (e.g. "intensity" or "curvature") can be
+    * kept next to the coordinates, see \ref addField.
+    *
+    * The coordinates can be accessed without copying as a N x 3 Eigen matrix
+    * through \ref getMatrixXfMap. Converting back into a pcl::PointCloud is
+    * a copy, but \ref fromPointCloudSoA only overwrites the stored fields, so a
+    * cloud can be converted, processed and written back in place.
+    *
+    * \ingroup common
+    */
+  class PCL_EXPORTS PointCloudSoA
+  {
+    public:
+      typedef std::vector<float, Eigen::aligned_allocator<float> > FieldArray;
+      typedef Eigen::Map<Eigen::Matrix<float, Eigen::Dynamic, 3>, Eigen::Aligned, Eigen::OuterStride<> > MatrixMap;
+      typedef Eigen::Map<const Eigen::Matrix<float, Eigen::Dynamic, 3>, Eigen::Aligned, Eigen::OuterStride<> > ConstMatrixMap;
+
+      typedef boost::shared_ptr<PointCloudSoA> Ptr;
+      typedef boost::shared_ptr<const PointCloudSoA> ConstPtr;
+
+      /** \brief Empty constructor. */
+      PointCloudSoA () : header (), width (0), height (0), is_dense (true),
+                         size_ (0), stride_ (0), xyz_ (), fields_ ()
+      {}
+
+      /** \brief Number of points. */
+      inline size_t
+      size () const { return (size_); }
+
+      /** \brief True if no points are stored. */
+      inline bool
+      empty () const { return (size_ == 0); }
+
+      /** \brief Resize the cloud to \a n points. The values of existing points are kept,
+        * new points are set to 0. Sets width to \a n and height to 1.
+        * \param[in] n the new number of points
+        */
+      void
+      resize (size_t n);
+
+      /** \brief Remove all points and all additional fields. */
+      void
+      clear ();
+
+      /** \brief Distance in floats between the start of the x, y and z arrays. It is a
+        * multiple of 4, the padding after the last point of each array is zero.
+        */
+      inline size_t
+      stride () const { return (stride_); }
+
+      inline float* x () { return (xyz_.empty () ? NULL : &xyz_[0]); }
+      inline float* y () { return (xyz_.empty () ? NULL : &xyz_[stride_]); }
+      inline float* z () { return (xyz_.empty () ? NULL : &xyz_[2 * stride_]); }
+      inline const float* x () const { return (xyz_.empty () ? NULL : &xyz_[0]); }
+      inline const float* y () const { return (xyz_.empty () ? NULL : &xyz_[stride_]); }
+      inline const float* z () const { return (xyz_.empty () ? NULL : &xyz_[2 * stride_]); }
+
+      /** \brief The coordinates as a size () x 3 column-major matrix, without copying. */
+      inline MatrixMap
+      getMatrixXfMap ()
+      {
+        return (MatrixMap (x (), size_, 3, Eigen::OuterStride<> (stride_)));
+      }
+
+      /** \brief The coordinates as a size () x 3 column-major matrix, without copying. */
+      inline ConstMatrixMap
+      getMatrixXfMap () const
+      {
+        return (ConstMatrixMap (x (), size_, 3, Eigen::OuterStride<> (stride_)));
+      }
+
+      /** \brief Add an additional float field of the current size, or return the
+        * existing one of the same name. Pointers to fields and coordinates are
+        * invalidated by \ref resize.
+        * \param[in] name the name of the field, as reported by pcl::getFieldsList
+        * \return a pointer to the size () values of the field
+        */
+      float*
+      addField (const std::string &name);
+
+      /** \brief Get an additional field by name.
+        * \param[in] name the name of the field
+        * \return a pointer to the values of the field, or NULL if it was not added
+        */
+      float*
+      getField (const std::string &name);
+
+      /** \brief Get an additional field by name.
+        * \param[in] name the name of the field
+        * \return a pointer to the values of the field, or NULL if it was not added
+        */
+      const float*
+      getField (const std::string &name) const;
+
+      /** \brief The names of the additional fields, in the order they were added. */
+      std::vector<std::string>
+      getFieldNames () const;
+
+      /** \brief The point cloud header, see pcl::PointCloud. */
+      pcl::PCLHeader header;
+
+      /** \brief The width of the point cloud, see pcl::PointCloud. */
+      uint32_t width;
+
+      /** \brief The height of the point cloud, see pcl::PointCloud. */
+      uint32_t height;
+
+      /** \brief True if no points are invalid (e.g., have NaN or Inf values). */
+      bool is_dense;
+
+    private:
+      /** \brief Number of points. */
+      size_t size_;
+
+      /** \brief Offset of the y and z arrays in xyz_. */
+      size_t stride_;
+
+      /** \brief x, y and z arrays, each padded to stride_ floats. */
+      FieldArray xyz_;
+
+      /** \brief Additional fields and their names. */
+      std::vector<std::pair<std::string, FieldArray> > fields_;
+  };
+
+  /** \brief Copy a point cloud into structure-of-arrays form. The buffers of \a soa are reused.
+    * \param[in] cloud the input point cloud
+    * \param[out] soa the resultant structure-of-arrays cloud
+    * \param[in] field_names additional float fields of PointT to copy; fields which do not
+    * exist in PointT or are not single FLOAT32 values are skipped with a warning
+    * \ingroup common
+    */
+  template <typename PointT> void
+  toPointCloudSoA (const pcl::PointCloud<PointT> &cloud, PointCloudSoA &soa,
+                   const std::vector<std::string> &field_names = std::vector<std::string> ());
+
+  /** \brief Copy a subset of a point cloud into structure-of-arrays form. Point i of
+    * \a soa is point indices[i] of \a cloud.
+    * \param[in] cloud the input point cloud
+    * \param[in] indices the indices of the points to copy
+    * \param[out] soa the resultant structure-of-arrays cloud
+    * \param[in] field_names additional float fields of PointT to copy
+    * \ingroup common
+    */
+  template <typename PointT> void
+  toPointCloudSoA (const pcl::PointCloud<PointT> &cloud, const std::vector<int> &indices,
+                   PointCloudSoA &soa,
+                   const std::vector<std::string> &field_names = std::vector<std::string> ());
+
+  /** \brief Copy a structure-of-arrays cloud back into a point cloud. If \a cloud already
+    * has soa.size () points, only the coordinates and the additional fields of \a soa
+    * that exist in PointT are overwritten, all other fields are kept.
+    * \param[in] soa the structure-of-arrays cloud
+    * \param[out] cloud the resultant point cloud
+    * \ingroup common
+    */
+  template <typename PointT> void
+  fromPointCloudSoA (const PointCloudSoA &soa, pcl::PointCloud<PointT> &cloud);
+
+  /** \brief Get the minimum and maximum values on each of the 3 (x-y-z) dimensions.
+    * Non-finite points are skipped if the cloud is not dense.
+    * \param[in] soa the structure-of-arrays cloud
+    * \param[out] min_pt the resultant minimum bounds
+    * \param[out] max_pt the resultant maximum bounds
+    * \ingroup common
+    */
+  PCL_EXPORTS void
+  getMinMax3D (const PointCloudSoA &soa, Eigen::Vector4f &min_pt, Eigen::Vector4f &max_pt);
+
+  /** \brief Get the points inside the axis-aligned box given by \a min_pt and \a max_pt
+    * (bounds included). Points with NaN coordinates are never inside.
+    * \param[in] soa the structure-of-arrays cloud
+    * \param[in] min_pt the minimum bounds
+    * \param[in] max_pt the maximum bounds
+    * \param[out] indices the indices of the points inside the box, in increasing order
+    * \return the number of points inside the box
+    * \ingroup common
+    */
+  PCL_EXPORTS int
+  getPointsInBox (const PointCloudSoA &soa, const Eigen::Vector4f &min_pt,
+                  const Eigen::Vector4f &max_pt, std::vector<int> &indices);
+
+  /** \brief Compute the squared euclidean distances between a query point and the points
+    * [begin, end) of a structure-of-arrays cloud. Non-finite points yield NaN or Inf.
+    * \param[in] soa the structure-of-arrays cloud
+    * \param[in] begin index of the first point
+    * \param[in] end index one past the last point
+    * \param[in] query the query point
+    * \param[out] distances end - begin resultant squared distances
+    * \ingroup common
+    */
+  PCL_EXPORTS void
+  getSquaredDistances (const PointCloudSoA &soa, size_t begin, size_t end,
+                       const Eigen::Vector3f &query, float *distances);
+}
+
+#include <pcl/common/impl/point_cloud_soa.hpp>
+
+#endif  // PCL_COMMON_POINT_CLOUD_SOA_H_
@@ -0,0 +1,222 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Point Cloud Library (PCL) - www.pointclouds.org
+ *  Copyright (c) 2013-, Open Perception, Inc.
+ *
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder(s) nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef PCL_COMMON_POINT_CLOUD_VIEW_H_
+#define PCL_COMMON_POINT_CLOUD_VIEW_H_
+
+#include <pcl/conversions.h>
+#include <boost/type_traits/alignment_of.hpp>
+#include <stdexcept>
+
+namespace pcl
+{
+  /** \brief Read-only, zero-copy view of the points of a pcl::PCLPointCloud2 as PointT.
+    *
+    * When the binary layout of a PCLPointCloud2 matches PointT (same fields at the same
+    * offsets, a point_step of sizeof (PointT), no row padding and suitably aligned data),
+    * fromPCLPointCloud2 would only memcpy the blob. PointCloudView instead interprets the
+    * data buffer of the message in place, so that typed access costs nothing:
+    *
+    * \code
+    * pcl::PointCloudView<pcl::PointXYZ> view (msg);
+    * if (view.isValid ())
+    *   for (size_t i = 0; i < view.size (); ++i)
+    *     process (view[i]);
+    * else
+    * {
+    *   pcl::PointCloud<pcl::PointXYZ> cloud;
+    *   pcl::fromPCLPointCloud2 (msg, cloud);
+    * }
+    * \endcode
+    *
+    * \note The view refers to the data of the message: the message must outlive the view,
+    * and its data must not be resized or reallocated while the view is in use.
+    * \ingroup common
+    */
+  template <typename PointT>
+  class PointCloudView
+  {
+    public:
+      typedef PointT PointType;
+      typedef const PointT* const_iterator;
+
+      /** \brief Empty constructor, the view is not valid until setInputCloud succeeds. */
+      PointCloudView () :
+        header (), width (0), height (0), is_dense (true), points_ (NULL), valid_ (false)
+      {}
+
+      /** \brief Create a view of the points of msg, check isValid () before using it.
+        * \param[in] msg the PCLPointCloud2 whose data is viewed
+        */
+      explicit PointCloudView (const pcl::PCLPointCloud2 &msg) :
+        header (), width (0), height (0), is_dense (true), points_ (NULL), valid_ (false)
+      {
+        setInputCloud (msg);
+      }
+
+      /** \brief Check whether the data of msg can be viewed as PointT without conversion.
+        * \param[in] msg the PCLPointCloud2 to check
+        */
+      static bool
+      isCompatible (const pcl::PCLPointCloud2 &msg)
+      {
+        if (msg.point_step != sizeof (PointT) || msg.row_step != msg.point_step * msg.width ||
+            msg.data.size () < static_cast<size_t> (msg.row_step) * msg.height)
+          return (false);
+        if (!msg.data.empty () &&
+            reinterpret_cast<size_t> (&msg.data[0]) % boost::alignment_of<PointT>::value != 0)
+          return (false);
+
+        // All fields of PointT have to be serialized exactly where the struct has them
+        std::vector<pcl::PCLPointField> own_fields;
+        for_each_type<typename traits::fieldList<PointT>::type> (detail::FieldAdder<PointT> (own_fields));
+        if (detail::sameFields (own_fields, msg.fields))
+          return (true);
+        boost::shared_ptr<const MsgFieldMap> own_map = detail::getCachedMapping<PointT> (own_fields);
+        boost::shared_ptr<const MsgFieldMap> field_map = detail::getCachedMapping<PointT> (msg.fields);
+        return (detail::isIdentityMapping (*field_map) && detail::isIdentityMapping (*own_map) &&
+                (*field_map)[0].size == (*own_map)[0].size);
+      }
+
+      /** \brief View the points of msg.
+        * \param[in] msg the PCLPointCloud2 whose data is viewed
+        * \return false (and an invalid, empty view) if the layout of msg does not match PointT
+        */
+      bool
+      setInputCloud (const pcl::PCLPointCloud2 &msg)
+      {
+        valid_ = isCompatible (msg);
+        if (!valid_)
+        {
+          header = pcl::PCLHeader ();
+          width = height = 0;
+          is_dense = true;
+          points_ = NULL;
+          return (false);
+        }
+        header = msg.header;
+        width = msg.width;
+        height = msg.height;
+        is_dense = msg.is_dense == 1;
+        points_ = msg.data.empty () ? NULL : reinterpret_cast<const PointT*> (&msg.data[0]);
+        return (true);
+      }
+
+      /** \brief Whether the view refers to the data of a compatible PCLPointCloud2. */
+      inline bool
+      isValid () const { return (valid_); }
+
+      /** \brief Return whether the viewed cloud is organized (e.g., arranged in a structured grid). */
+      inline bool
+      isOrganized () const { return (height > 1); }
+
+      inline size_t
+      size () const { return (static_cast<size_t> (width) * height); }
+
+      inline bool
+      empty () const { return (size () == 0); }
+
+      inline const_iterator
+      begin () const { return (points_); }
+
+      inline const_iterator
+      end () const { return (points_ + size ()); }
+
+      inline const PointT&
+      operator[] (size_t n) const { return (points_[n]); }
+
+      /** \brief Return the point at position n, throwing if n is out of range. */
+      inline const PointT&
+      at (size_t n) const
+      {
+        if (n >= size ())
+          throw std::out_of_range ("PointCloudView::at: index out of range");
+        return (points_[n]);
+      }
+
+      /** \brief Obtain the point given by the (column, row) coordinates. Only works on organized
+        * datasets (those that have height != 1).
+        * \param[in] column the column coordinate
+        * \param[in] row the row coordinate
+        */
+      inline const PointT&
+      at (int column, int row) const
+      {
+        if (height > 1)
+          return (points_[row * width + column]);
+        else
+          throw IsNotDenseException ("Can't use 2D indexing with a unorganized point cloud");
+      }
+
+      /** \brief Obtain the point given by the (column, row) coordinates. Only works on organized
+        * datasets (those that have height != 1).
+        * \param[in] column the column coordinate
+        * \param[in] row the row coordinate
+        */
+      inline const PointT&
+      operator () (size_t column, size_t row) const
+      {
+        return (points_[row * width + column]);
+      }
+
+      inline const PointT&
+      front () const { return (points_[0]); }
+
+      inline const PointT&
+      back () const { return (points_[size () - 1]); }
+
+      /** \brief The point cloud header of the viewed message. */
+      pcl::PCLHeader header;
+
+      /** \brief The point cloud width (if organized as an image-structure). */
+      uint32_t width;
+      /** \brief The point cloud height (if organized as an image-structure). */
+      uint32_t height;
+
+      /** \brief True if no points are invalid (e.g., have NaN or Inf values). */
+      bool is_dense;
+
+    private:
+      /** \brief The points, inside the data of the viewed message. */
+      const PointT *points_;
+
+      /** \brief Whether the viewed message is compatible with PointT. */
+      bool valid_;
+  };
+}
+
+#endif  //#ifndef PCL_COMMON_POINT_CLOUD_VIEW_H_
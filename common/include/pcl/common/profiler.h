@@ -0,0 +1,243 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Point Cloud Library (PCL) - www.pointclouds.org
+ *  Copyright (c) 2013-, Open Perception, Inc.
+ *
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder(s) nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef PCL_COMMON_PROFILER_H_
+#define PCL_COMMON_PROFILER_H_
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <pcl/pcl_macros.h>
+
+/**
+  * \file pcl/common/profiler.h
+  * Aggregate timings of named, nested scopes over calls and threads, and export
+  * them as JSON or Chrome trace (chrome://tracing) files.
+  *
+  * The PCL_PROFILE_* macros only record something if PCL is configured with
+  * PCL_ENABLE_PROFILING; otherwise they expand to nothing. The registry itself is
+  * always available. With profiling enabled, the library records Feature::compute,
+  * Filter::filter and Registration::align under the class name of the algorithm
+  * (e.g. "NormalEstimation"), as well as "SACSegmentation::segment",
+  * "KdTreeFLANN::nearestKSearch", "KdTreeFLANN::radiusSearch" and every pcl::ScopeTime.
+  *
+  * \code
+  * void
+  * process (const pcl::PointCloud<pcl::PointXYZ>::ConstPtr &cloud)
+  * {
+  *   PCL_PROFILE_SCOPE ("process");
+  *   PCL_PROFILE_COUNTER ("points", cloud->size ());
+  *   // nested scopes, e.g. Filter::filter and KdTreeFLANN::radiusSearch, are
+  *   // recorded as "process/Filter::filter" etc.
+  * }
+  * ...
+  * pcl::profiling::Registry::getInstance ().saveJSON ("profile.json");
+  * \endcode
+  * \ingroup common
+  */
+
+namespace pcl
+{
+  namespace profiling
+  {
+    /** \brief Monotonic time in nanoseconds, with an arbitrary origin. */
+    PCL_EXPORTS uint64_t
+    getTimeNanoseconds ();
+
+    /** \brief Timings of one scope path, merged over all threads. */
+    struct ScopeStatistics
+    {
+      /** \brief Names of the enclosing scopes and of the scope itself, separated by '/'. */
+      std::string path;
+      uint64_t count;
+      double total_ms;
+      double min_ms;
+      double max_ms;
+      double mean_ms;
+      /** \brief Median and 99th percentile, estimated from a logarithmic histogram
+        * with four bins per power of two (relative error below 12%).
+        */
+      double p50_ms;
+      double p99_ms;
+    };
+
+    namespace detail
+    {
+      class ThreadProfile;
+    }
+
+    /** \brief Process wide profiling registry.
+      *
+      * Every thread records into its own profile, which is created on the first
+      * scope it enters. Recording does not synchronize with other recording threads;
+      * each profile has a mutex which is only contended while the registry is read
+      * (\ref getStatistics, \ref saveJSON, ...) or reset.
+      * \ingroup common
+      */
+    class PCL_EXPORTS Registry
+    {
+      public:
+        /** \brief The registry of the process. */
+        static Registry&
+        getInstance ();
+
+        /** \brief Enable or disable recording at runtime (enabled by default). */
+        void
+        setEnabled (bool enabled);
+
+        /** \brief True if scopes and counters are recorded. */
+        bool
+        isEnabled () const;
+
+        /** \brief Also keep every single scope execution for \ref saveChromeTrace
+          * (disabled by default).
+          * \param[in] enabled true to record trace events
+          * \param[in] max_events_per_thread events beyond this number are dropped
+          */
+        void
+        setTraceEnabled (bool enabled, size_t max_events_per_thread = 1000000);
+
+        /** \brief Enter a scope of the calling thread.
+          * \param[in] name the name of the scope
+          * \return the profile of the thread, to be passed to \ref endScope, or NULL
+          * if recording is disabled
+          */
+        detail::ThreadProfile*
+        beginScope (const char *name);
+
+        /** \brief Leave the innermost scope of a thread.
+          * \param[in] profile the value returned by the matching \ref beginScope
+          * \param[in] start_ns the time at which the scope was entered
+          */
+        void
+        endScope (detail::ThreadProfile *profile, uint64_t start_ns);
+
+        /** \brief Add \a value to the counter \a name of the calling thread. */
+        void
+        addToCounter (const char *name, int64_t value);
+
+        /** \brief Get the timings of all scopes, merged over threads, sorted by path. */
+        void
+        getStatistics (std::vector<ScopeStatistics> &statistics) const;
+
+        /** \brief Get all counters, summed over threads, sorted by name. */
+        void
+        getCounters (std::vector<std::pair<std::string, int64_t> > &counters) const;
+
+        /** \brief Remove all recorded timings, counters and trace events. Scopes which
+          * are open while resetting are recorded when they are left.
+          */
+        void
+        reset ();
+
+        /** \brief Write the scope statistics and counters as JSON.
+          * \param[in] file_name the output file
+          * \return true on success
+          */
+        bool
+        saveJSON (const std::string &file_name) const;
+
+        /** \brief Write the recorded trace events in the Chrome trace event format,
+          * which can be loaded by chrome://tracing or Perfetto. Requires
+          * \ref setTraceEnabled.
+          * \param[in] file_name the output file
+          * \return true on success
+          */
+        bool
+        saveChromeTrace (const std::string &file_name) const;
+
+      private:
+        Registry ();
+        Registry (const Registry&);
+        Registry& operator = (const Registry&);
+        ~Registry ();
+
+        /** \brief The profile of the calling thread, created on first use. */
+        detail::ThreadProfile*
+        getThreadProfile ();
+
+        struct Impl;
+        Impl *impl_;
+    };
+
+    /** \brief Records the time between its construction and destruction as a scope.
+      * Use it through PCL_PROFILE_SCOPE.
+      * \ingroup common
+      */
+    class ScopedEvent
+    {
+      public:
+        explicit ScopedEvent (const char *name)
+          : profile_ (Registry::getInstance ().beginScope (name))
+          , start_ns_ (profile_ ? getTimeNanoseconds () : 0)
+        {}
+
+        ~ScopedEvent ()
+        {
+          if (profile_)
+            Registry::getInstance ().endScope (profile_, start_ns_);
+        }
+
+      private:
+        ScopedEvent (const ScopedEvent&);
+        ScopedEvent& operator = (const ScopedEvent&);
+
+        detail::ThreadProfile *profile_;
+        uint64_t start_ns_;
+    };
+  }
+}
+
+#define PCL_PROFILE_CONCAT_IMPL(a, b) a ## b
+#define PCL_PROFILE_CONCAT(a, b) PCL_PROFILE_CONCAT_IMPL (a, b)
+
+#ifdef PCL_ENABLE_PROFILING
+/** \brief Record the rest of the enclosing block as scope \a name. */
+# define PCL_PROFILE_SCOPE(name) \
+  pcl::profiling::ScopedEvent PCL_PROFILE_CONCAT (pcl_profile_scope_, __LINE__) (name)
+/** \brief Record the rest of the enclosing function as a scope named after it. */
+# define PCL_PROFILE_FUNCTION() PCL_PROFILE_SCOPE (__FUNCTION__)
+/** \brief Add \a value to the counter \a name. */
+# define PCL_PROFILE_COUNTER(name, value) \
+  pcl::profiling::Registry::getInstance ().addToCounter ((name), static_cast<int64_t> (value))
+#else
+# define PCL_PROFILE_SCOPE(name)
+# define PCL_PROFILE_FUNCTION()
+# define PCL_PROFILE_COUNTER(name, value)
+#endif
+
+#endif  // PCL_COMMON_PROFILER_H_
@@ -0,0 +1,197 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Point Cloud Library (PCL) - www.pointclouds.org
+ *  Copyright (c) 2013-, Open Perception, Inc.
+ *
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder(s) nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef PCL_COMMON_QUANTIZATION_H_
+#define PCL_COMMON_QUANTIZATION_H_
+
+#include <pcl/point_cloud.h>
+#include <pcl/point_types_quantized.h>
+#include <pcl/point_representation.h>
+
+namespace pcl
+{
+  /** \brief Compute the quantization parameters that fit the bounding cube of the finite points
+    * of a cloud into the 16-bit fixed-point range, with the same resolution on all axes.
+    * \param[in] cloud the input point cloud
+    * \param[out] params the resultant quantization parameters
+    * \return the resolution, i.e., the size of one quantization step; the maximum quantization
+    * error is half of it. Returns 0 and sets \a params to the identity if no point is finite.
+    * \ingroup common
+    */
+  template <typename PointT> float
+  computeQuantizationParameters (const pcl::PointCloud<PointT> &cloud, QuantizationParameters &params);
+
+  /** \brief Get the parameters of a quantized cloud after a rigid or affine transformation. The
+    * quantized points (and their normals, which are stored in the quantized frame) stay the same,
+    * so transforming a quantized cloud costs O(1).
+    * \param[in] params the quantization parameters of the cloud
+    * \param[in] transform the transformation to apply to the cloud
+    * \ingroup common
+    */
+  inline QuantizationParameters
+  transformQuantizationParameters (const QuantizationParameters &params, const Eigen::Affine3f &transform)
+  {
+    return (QuantizationParameters (transform * params.getTransform ()));
+  }
+
+  /** \brief Quantize the coordinates of a point cloud. Points with NaN or Inf coordinates become
+    * invalid points, points outside of the range of \a params are clamped to it.
+    * \param[in] cloud_in the input point cloud
+    * \param[in] params the quantization parameters, see \ref computeQuantizationParameters
+    * \param[out] cloud_out the resultant quantized point cloud
+    * \ingroup common
+    */
+  template <typename PointT> void
+  quantizePointCloud (const pcl::PointCloud<PointT> &cloud_in, const QuantizationParameters &params,
+                      pcl::PointCloud<PointXYZQ16> &cloud_out);
+
+  /** \brief Quantize the coordinates, normals and colors of a point cloud.
+    * \param[in] cloud_in the input point cloud, with the fields of PointXYZRGBNormal
+    * \param[in] params the quantization parameters, see \ref computeQuantizationParameters
+    * \param[out] cloud_out the resultant quantized point cloud
+    * \ingroup common
+    */
+  template <typename PointT> void
+  quantizePointCloud (const pcl::PointCloud<PointT> &cloud_in, const QuantizationParameters &params,
+                      pcl::PointCloud<PointXYZRGBNormalQ16> &cloud_out);
+
+  /** \brief Quantize the coordinates, normals, curvatures and colors of a point cloud.
+    * \param[in] cloud_in the input point cloud, with the fields of PointXYZRGBNormal
+    * \param[in] params the quantization parameters, see \ref computeQuantizationParameters
+    * \param[out] cloud_out the resultant quantized point cloud
+    * \ingroup common
+    */
+  template <typename PointT> void
+  quantizePointCloud (const pcl::PointCloud<PointT> &cloud_in, const QuantizationParameters &params,
+                      pcl::PointCloud<PointXYZRGBNormalQ32> &cloud_out);
+
+  /** \brief Restore the coordinates of a quantized point cloud. Invalid points get NaN coordinates.
+    * \param[in] cloud_in the quantized point cloud
+    * \param[in] params the quantization parameters of \a cloud_in
+    * \param[out] cloud_out the resultant point cloud, with at least the fields x, y and z
+    * \ingroup common
+    */
+  template <typename PointT> void
+  dequantizePointCloud (const pcl::PointCloud<PointXYZQ16> &cloud_in, const QuantizationParameters &params,
+                        pcl::PointCloud<PointT> &cloud_out);
+
+  /** \brief Restore the coordinates, normals and colors of a quantized point cloud. The curvature
+    * is not stored in this type and is left at its default value.
+    * \param[in] cloud_in the quantized point cloud
+    * \param[in] params the quantization parameters of \a cloud_in
+    * \param[out] cloud_out the resultant point cloud, with the fields of PointXYZRGBNormal
+    * \ingroup common
+    */
+  template <typename PointT> void
+  dequantizePointCloud (const pcl::PointCloud<PointXYZRGBNormalQ16> &cloud_in, const QuantizationParameters &params,
+                        pcl::PointCloud<PointT> &cloud_out);
+
+  /** \brief Restore the coordinates, normals, curvatures and colors of a quantized point cloud.
+    * \param[in] cloud_in the quantized point cloud
+    * \param[in] params the quantization parameters of \a cloud_in
+    * \param[out] cloud_out the resultant point cloud, with the fields of PointXYZRGBNormal
+    * \ingroup common
+    */
+  template <typename PointT> void
+  dequantizePointCloud (const pcl::PointCloud<PointXYZRGBNormalQ32> &cloud_in, const QuantizationParameters &params,
+                        pcl::PointCloud<PointT> &cloud_out);
+
+  /** \brief Point representation that dequantizes the coordinates of quantized points on the fly,
+    * so that search structures such as KdTreeFLANN work directly on quantized clouds:
+    * \code
+    * pcl::KdTreeFLANN<pcl::PointXYZQ16> tree;
+    * tree.setPointRepresentation (boost::make_shared<pcl::QuantizedPointRepresentation<pcl::PointXYZQ16> > (params));
+    * tree.setInputCloud (quantized_cloud);
+    * \endcode
+    * \ingroup common
+    */
+  template <typename PointQT>
+  class QuantizedPointRepresentation : public PointRepresentation<PointQT>
+  {
+    using PointRepresentation<PointQT>::nr_dimensions_;
+    using PointRepresentation<PointQT>::trivial_;
+
+    public:
+      typedef boost::shared_ptr<QuantizedPointRepresentation<PointQT> > Ptr;
+      typedef boost::shared_ptr<const QuantizedPointRepresentation<PointQT> > ConstPtr;
+
+      /** \brief Constructor.
+        * \param[in] params the quantization parameters of the clouds to represent
+        */
+      QuantizedPointRepresentation (const QuantizationParameters &params = QuantizationParameters ()) :
+        params_ (params)
+      {
+        nr_dimensions_ = 3;
+        trivial_ = false;
+      }
+
+      virtual ~QuantizedPointRepresentation () {}
+
+      /** \brief Set the quantization parameters of the clouds to represent. */
+      inline void
+      setQuantizationParameters (const QuantizationParameters &params) { params_ = params; }
+
+      /** \brief Get the quantization parameters of the clouds to represent. */
+      inline const QuantizationParameters&
+      getQuantizationParameters () const { return (params_); }
+
+      virtual void
+      copyToFloatArray (const PointQT &p, float *out) const
+      {
+        const Eigen::Vector3f xyz = dequantizeXYZ (p, params_);
+        out[0] = xyz[0];
+        out[1] = xyz[1];
+        out[2] = xyz[2];
+      }
+
+      virtual bool
+      isValid (const PointQT &p) const
+      {
+        return (p.qx != QUANTIZED_INVALID_COORDINATE);
+      }
+
+    private:
+      QuantizationParameters params_;
+
+    public:
+      EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+  };
+}
+
+#include <pcl/common/impl/quantization.hpp>
+
+#endif  // PCL_COMMON_QUANTIZATION_H_
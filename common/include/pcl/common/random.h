@@ -49,6 +49,7 @@
 #include <boost/random/variate_generator.hpp>
 #include <boost/random/normal_distribution.hpp>
 #include <boost/random/mersenne_twister.hpp>
+#include <cstddef>
 #include <pcl/pcl_macros.h>
 
 namespace pcl 
@@ -76,6 +77,179 @@ namespace pcl
       typedef boost::normal_distribution<T> type;
     };
 
+    /** \brief Xoshiro128 is a small and fast pseudo random number engine implementing the
+      * xoshiro128** algorithm of Blackman and Vigna. The state is four 32 bit words (period
+      * 2^128 - 1) which are initialized from a 64 bit seed through splitmix64.
+      *
+      * Contrary to the global rand (), every engine owns its state, so concurrent threads
+      * each drawing from their own engine need no locking. Independent, non overlapping
+      * streams for parallel code are obtained with \ref jump or by passing a stream index
+      * to the constructor: stream i starts i * 2^64 draws after stream 0 of the same seed.
+      *
+      * The class models the Boost/STL uniform random number generator concept and can be
+      * plugged into boost::variate_generator. For the hot loops of sampling algorithms it
+      * also offers unbiased bounded integers and bulk generation into buffers.
+      *
+      * \code
+      * pcl::common::Xoshiro128 rng (seed, omp_get_thread_num ());
+      * int index = static_cast<int> (rng.nextBounded (n));   // uniform in [0, n)
+      * \endcode
+      * \ingroup common
+      */
+    class Xoshiro128
+    {
+      public:
+        typedef pcl::uint32_t result_type;
+#ifndef BOOST_NO_INCLASS_MEMBER_INITIALIZATION
+        static const bool has_fixed_range = false;
+#else
+        enum { has_fixed_range = false };
+#endif
+
+        /** \brief Constructor.
+          * \param[in] seed the engine seed
+          * \param[in] stream index of the independent stream to use for this seed, e.g. the thread number
+          */
+        explicit Xoshiro128 (pcl::uint64_t seed = 12345u, pcl::uint64_t stream = 0)
+        {
+          this->seed (seed, stream);
+        }
+
+        /** \brief Reset the engine state.
+          * \param[in] seed the engine seed
+          * \param[in] stream index of the independent stream to use for this seed
+          * \note selecting stream i costs i jumps of 128 draws each, so streams are meant to be
+          * indexed by small numbers such as a thread or worker id.
+          */
+        void
+        seed (pcl::uint64_t seed, pcl::uint64_t stream = 0);
+
+        /** \brief Advance the engine by 2^64 draws. Calling jump () on copies of an engine
+          * gives up to 2^64 non overlapping subsequences for parallel computations.
+          */
+        void
+        jump ();
+
+        /** \return a copy of this engine moved to its \a index-th stream, i.e. advanced by
+          * \a index times 2^64 draws. The engine itself is not modified.
+          */
+        Xoshiro128
+        getStream (unsigned int index) const
+        {
+          Xoshiro128 stream (*this);
+          for (unsigned int i = 0; i < index; ++i)
+            stream.jump ();
+          return (stream);
+        }
+
+        /** \return the smallest value returned by the engine. */
+        result_type
+        min () const { return (0); }
+
+        /** \return the largest value returned by the engine. */
+        result_type
+        max () const { return (0xffffffffu); }
+
+        /** \return the next 32 bit random number. */
+        inline result_type
+        operator () ()
+        {
+          const pcl::uint32_t result = rotl (s_[1] * 5u, 7) * 9u;
+          const pcl::uint32_t t = s_[1] << 9;
+          s_[2] ^= s_[0];
+          s_[3] ^= s_[1];
+          s_[1] ^= s_[2];
+          s_[0] ^= s_[3];
+          s_[2] ^= t;
+          s_[3] = rotl (s_[3], 11);
+          return (result);
+        }
+
+        /** \return a uniformly distributed integer in [0, bound), without the modulo bias of
+          * rand () % bound (Lemire's multiply and reject method). \a bound must be positive.
+          */
+        inline pcl::uint32_t
+        nextBounded (pcl::uint32_t bound)
+        {
+          pcl::uint64_t m = static_cast<pcl::uint64_t> ((*this) ()) * bound;
+          pcl::uint32_t low = static_cast<pcl::uint32_t> (m);
+          if (low < bound)
+          {
+            const pcl::uint32_t threshold = (0u - bound) % bound;
+            while (low < threshold)
+            {
+              m = static_cast<pcl::uint64_t> ((*this) ()) * bound;
+              low = static_cast<pcl::uint32_t> (m);
+            }
+          }
+          return (static_cast<pcl::uint32_t> (m >> 32));
+        }
+
+        /** \return a uniformly distributed float in [0, 1). */
+        inline float
+        nextFloat ()
+        {
+          return (static_cast<float> ((*this) () >> 8) * (1.0f / 16777216.0f));
+        }
+
+        /** \return a uniformly distributed double in [0, 1) with full 53 bit resolution. */
+        inline double
+        nextDouble ()
+        {
+          const pcl::uint64_t high = (*this) () >> 5;
+          const pcl::uint64_t low = (*this) () >> 6;
+          return (static_cast<double> ((high << 26) | low) * (1.0 / 9007199254740992.0));
+        }
+
+        /** \return a normally distributed double with mean 0 and standard deviation 1. */
+        double
+        nextNormal ();
+
+        /** \brief Fill a buffer with raw 32 bit random numbers.
+          * \param[out] out the buffer to fill
+          * \param[in] n number of values to generate
+          */
+        void
+        generate (pcl::uint32_t *out, size_t n);
+
+        /** \brief Fill a buffer with integers uniformly distributed in [0, bound).
+          * \param[out] out the buffer to fill
+          * \param[in] n number of values to generate
+          * \param[in] bound the exclusive upper bound, must be positive
+          */
+        void
+        generateBounded (pcl::uint32_t *out, size_t n, pcl::uint32_t bound);
+
+        /** \brief Fill a buffer with floats uniformly distributed in [lower, upper).
+          * \param[out] out the buffer to fill
+          * \param[in] n number of values to generate
+          * \param[in] lower the lower bound
+          * \param[in] upper the upper bound
+          */
+        void
+        generateUniform (float *out, size_t n, float lower = 0.0f, float upper = 1.0f);
+
+        /** \brief Fill a buffer with normally distributed floats. Values are produced in pairs
+          * by the Box-Muller transform, so this is about twice as fast as calling \ref nextNormal.
+          * \param[out] out the buffer to fill
+          * \param[in] n number of values to generate
+          * \param[in] mean the mean of the distribution
+          * \param[in] sigma the standard deviation of the distribution
+          */
+        void
+        generateNormal (float *out, size_t n, float mean = 0.0f, float sigma = 1.0f);
+
+      private:
+        static inline pcl::uint32_t
+        rotl (pcl::uint32_t x, int k)
+        {
+          return ((x << k) | (x >> (32 - k)));
+        }
+
+        /** \brief The engine state, never all zero. */
+        pcl::uint32_t s_[4];
+    };
+
     /** \brief UniformGenerator class generates a random number from range [min, max] at each run picked
       * according to a uniform distribution i.e eaach number within [min, max] has almost the same 
       * probability of being drawn.
@@ -140,7 +314,7 @@ namespace pcl
         run () { return (generator_ ()); }
 
       private:
-        typedef boost::mt19937 EngineType;
+        typedef Xoshiro128 EngineType;
         typedef typename uniform_distribution<T>::type DistributionType;
         /// parameters
         Parameters parameters_;
@@ -214,7 +388,7 @@ namespace pcl
         inline T 
         run () { return (generator_ ()); }
 
-        typedef boost::mt19937 EngineType;
+        typedef Xoshiro128 EngineType;
         typedef typename normal_distribution<T>::type DistributionType;
         /// parameters
         Parameters parameters_;
@@ -35,34 +35,364 @@
 #ifndef __PCL_SYNCHRONIZER__
 #define __PCL_SYNCHRONIZER__
 
+#include <map>
+#include <vector>
+#include <algorithm>
+#include <boost/array.hpp>
+#include <boost/function.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <pcl/pcl_macros.h>
+#include <pcl/common/profiler.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
 namespace pcl
 {
-  /** /brief This template class synchronizes two data streams of different types.
-   *         The data can be added using add0 and add1 methods which expects also a timestamp of type unsigned long.
-   *         If two matching data objects are found, registered callback functions are invoked with the objects and the time stamps.
+  /** \brief What a Synchronizer does with new data when the queue of its stream is full. */
+  enum SynchronizerDropPolicy
+  {
+    /** \brief Drop the oldest queued data of the stream. If another thread is publishing at
+      * that moment, the new data is dropped instead.
+      */
+    SYNCHRONIZER_DROP_OLDEST,
+    /** \brief Drop the new data. */
+    SYNCHRONIZER_DROP_NEWEST
+  };
+
+  /** \brief Counters and timings of a Synchronizer. */
+  struct SynchronizerStatistics
+  {
+    struct Stream
+    {
+      Stream () : received (0), dropped (0), discarded (0), queued (0) {}
+
+      /** \brief Number of data objects added to the stream. */
+      size_t received;
+      /** \brief Number of data objects dropped because the queue was full. */
+      size_t dropped;
+      /** \brief Number of data objects skipped because a closer match was found. */
+      size_t discarded;
+      /** \brief Number of data objects currently waiting for a match. */
+      size_t queued;
+    };
+
+    SynchronizerStatistics () : streams (), published (0), mean_latency (0), max_latency (0), mean_skew (0), max_skew (0) {}
+
+    std::vector<Stream> streams;
+    /** \brief Number of matched sets passed to the callbacks. */
+    size_t published;
+    /** \brief Mean and maximum time in seconds from the arrival of the oldest object of a set to its publication. */
+    double mean_latency;
+    double max_latency;
+    /** \brief Mean and maximum difference between the largest and smallest time stamp of a set. */
+    double mean_skew;
+    unsigned long max_skew;
+  };
+
+  namespace detail
+  {
+    /** \brief Type of the unused streams of a Synchronizer. */
+    struct SynchronizerNoStream {};
+
+    /** \brief Load a value written by another thread with storeRelease. */
+    inline size_t
+    loadAcquire (const volatile size_t &value)
+    {
+#if defined(__clang__) || (defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 7)))
+      return (__atomic_load_n (&value, __ATOMIC_ACQUIRE));
+#elif defined(__GNUC__)
+      const size_t result = value;
+      __sync_synchronize ();
+      return (result);
+#else
+      // Volatile accesses have acquire and release semantics with MSVC
+      const size_t result = value;
+      _ReadWriteBarrier ();
+      return (result);
+#endif
+    }
+
+    /** \brief Store a value read by another thread with loadAcquire. */
+    inline void
+    storeRelease (volatile size_t &value, size_t new_value)
+    {
+#if defined(__clang__) || (defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 7)))
+      __atomic_store_n (&value, new_value, __ATOMIC_RELEASE);
+#elif defined(__GNUC__)
+      __sync_synchronize ();
+      value = new_value;
+#else
+      _ReadWriteBarrier ();
+      value = new_value;
+#endif
+    }
+
+    /** \brief Full memory barrier. */
+    inline void
+    memoryFence ()
+    {
+#if defined(__clang__) || (defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 7)))
+      __atomic_thread_fence (__ATOMIC_SEQ_CST);
+#elif defined(__GNUC__)
+      __sync_synchronize ();
+#else
+      _mm_mfence ();
+#endif
+    }
+
+    /** \brief Bounded lock-free queue of time stamped data for one producer and one consumer
+      * thread. push is only called by the producer; size, at and pop only by the consumer.
+      */
+    template <typename T>
+    class SPSCRingBuffer
+    {
+      public:
+        struct Item
+        {
+          Item () : data (), stamp (0), enqueue_ns (0) {}
+
+          T data;
+          unsigned long stamp;
+          uint64_t enqueue_ns;
+        };
+
+        /** \brief Constructor.
+          * \param[in] capacity the minimum number of items, rounded up to a power of two
+          */
+        explicit SPSCRingBuffer (size_t capacity) : items_ (), mask_ (0), head_ (0), tail_ (0)
+        {
+          size_t size = 1;
+          while (size < capacity)
+            size <<= 1;
+          items_.resize (size);
+          mask_ = size - 1;
+        }
+
+        /** \brief Maximum number of queued items. */
+        inline size_t
+        capacity () const { return (items_.size ()); }
+
+        /** \brief Append an item. Returns false if the queue is full. */
+        inline bool
+        push (const T &data, unsigned long stamp, uint64_t enqueue_ns)
+        {
+          const size_t tail = tail_;
+          if (tail - loadAcquire (head_) == items_.size ())
+            return (false);
+          Item &item = items_[tail & mask_];
+          item.data = data;
+          item.stamp = stamp;
+          item.enqueue_ns = enqueue_ns;
+          storeRelease (tail_, tail + 1);
+          return (true);
+        }
+
+        /** \brief Number of queued items. */
+        inline size_t
+        size () const { return (loadAcquire (tail_) - head_); }
+
+        /** \brief The i-th queued item, 0 being the oldest. */
+        inline const Item&
+        at (size_t i) const { return (items_[(head_ + i) & mask_]); }
+
+        /** \brief Remove the oldest item. */
+        inline void
+        pop ()
+        {
+          const size_t head = head_;
+          // Release the data (e.g. a shared_ptr to a frame) before the slot is reused
+          items_[head & mask_].data = T ();
+          storeRelease (head_, head + 1);
+        }
+
+      private:
+        std::vector<Item> items_;
+        size_t mask_;
+        /** \brief Keep the indices of the consumer and the producer on separate cache lines. */
+        char padding0_[64];
+        volatile size_t head_;
+        char padding1_[64];
+        volatile size_t tail_;
+    };
+
+    /** \brief Type independent access to the queue of a Synchronizer stream, for the consumer. */
+    class SynchronizerStreamBase
+    {
+      public:
+        SynchronizerStreamBase () : received (0), dropped (0), discarded (0) {}
+        virtual ~SynchronizerStreamBase () {}
+
+        virtual size_t
+        size () const = 0;
+
+        virtual unsigned long
+        getStamp (size_t i) const = 0;
+
+        virtual uint64_t
+        getEnqueueTime () const = 0;
+
+        virtual void
+        pop () = 0;
+
+        /** \brief Counters written by the producer only. */
+        volatile size_t received;
+        volatile size_t dropped;
+        /** \brief Counter written by the consumer only. */
+        size_t discarded;
+    };
+
+    template <typename T>
+    class SynchronizerStream : public SynchronizerStreamBase
+    {
+      public:
+        explicit SynchronizerStream (size_t capacity) : buffer (capacity) {}
+
+        virtual size_t
+        size () const { return (buffer.size ()); }
+
+        virtual unsigned long
+        getStamp (size_t i) const { return (buffer.at (i).stamp); }
+
+        virtual uint64_t
+        getEnqueueTime () const { return (buffer.at (0).enqueue_ns); }
+
+        virtual void
+        pop () { buffer.pop (); }
+
+        inline const T&
+        front () const { return (buffer.at (0).data); }
+
+        SPSCRingBuffer<T> buffer;
+    };
+
+    /** \brief Number of streams and callback signature of a Synchronizer. With more than two
+      * streams the callbacks get the time stamps as an array.
+      */
+    template <typename T1, typename T2, typename T3, typename T4, typename T5, typename T6>
+    struct SynchronizerTraits
+    {
+      static const int nr_streams = 6;
+      typedef boost::function<void (T1, T2, T3, T4, T5, T6, const boost::array<unsigned long, 6>&)> CallbackFunction;
+
+      static void
+      invoke (const CallbackFunction &cb, const T1 &d1, const T2 &d2, const T3 &d3, const T4 &d4, const T5 &d5,
+              const T6 &d6, const unsigned long *stamps)
+      {
+        boost::array<unsigned long, 6> s;
+        std::copy (stamps, stamps + 6, s.begin ());
+        cb (d1, d2, d3, d4, d5, d6, s);
+      }
+    };
+
+    template <typename T1, typename T2, typename T3, typename T4, typename T5>
+    struct SynchronizerTraits<T1, T2, T3, T4, T5, SynchronizerNoStream>
+    {
+      static const int nr_streams = 5;
+      typedef boost::function<void (T1, T2, T3, T4, T5, const boost::array<unsigned long, 5>&)> CallbackFunction;
+
+      static void
+      invoke (const CallbackFunction &cb, const T1 &d1, const T2 &d2, const T3 &d3, const T4 &d4, const T5 &d5,
+              const SynchronizerNoStream &, const unsigned long *stamps)
+      {
+        boost::array<unsigned long, 5> s;
+        std::copy (stamps, stamps + 5, s.begin ());
+        cb (d1, d2, d3, d4, d5, s);
+      }
+    };
+
+    template <typename T1, typename T2, typename T3, typename T4>
+    struct SynchronizerTraits<T1, T2, T3, T4, SynchronizerNoStream, SynchronizerNoStream>
+    {
+      static const int nr_streams = 4;
+      typedef boost::function<void (T1, T2, T3, T4, const boost::array<unsigned long, 4>&)> CallbackFunction;
+
+      static void
+      invoke (const CallbackFunction &cb, const T1 &d1, const T2 &d2, const T3 &d3, const T4 &d4,
+              const SynchronizerNoStream &, const SynchronizerNoStream &, const unsigned long *stamps)
+      {
+        boost::array<unsigned long, 4> s;
+        std::copy (stamps, stamps + 4, s.begin ());
+        cb (d1, d2, d3, d4, s);
+      }
+    };
+
+    template <typename T1, typename T2, typename T3>
+    struct SynchronizerTraits<T1, T2, T3, SynchronizerNoStream, SynchronizerNoStream, SynchronizerNoStream>
+    {
+      static const int nr_streams = 3;
+      typedef boost::function<void (T1, T2, T3, const boost::array<unsigned long, 3>&)> CallbackFunction;
+
+      static void
+      invoke (const CallbackFunction &cb, const T1 &d1, const T2 &d2, const T3 &d3, const SynchronizerNoStream &,
+              const SynchronizerNoStream &, const SynchronizerNoStream &, const unsigned long *stamps)
+      {
+        boost::array<unsigned long, 3> s;
+        std::copy (stamps, stamps + 3, s.begin ());
+        cb (d1, d2, d3, s);
+      }
+    };
+
+    template <typename T1, typename T2>
+    struct SynchronizerTraits<T1, T2, SynchronizerNoStream, SynchronizerNoStream, SynchronizerNoStream, SynchronizerNoStream>
+    {
+      static const int nr_streams = 2;
+      typedef boost::function<void (T1, T2, unsigned long, unsigned long)> CallbackFunction;
+
+      static void
+      invoke (const CallbackFunction &cb, const T1 &d1, const T2 &d2, const SynchronizerNoStream &,
+              const SynchronizerNoStream &, const SynchronizerNoStream &, const SynchronizerNoStream &,
+              const unsigned long *stamps)
+      {
+        cb (d1, d2, stamps[0], stamps[1]);
+      }
+    };
+  }
+
+  /** \brief This template class synchronizes two to six data streams of different types.
+   *         The data can be added using the add0 ... add5 methods which expect also a timestamp of type unsigned long.
+   *         If matching data objects are found, registered callback functions are invoked with the objects and the time stamps.
    *         The only assumption of the timestamp is, that they are in the same unit, linear and strictly monotonic increasing.
    *         If filtering is desired, e.g. thresholding of time differences, the user can do that in the callback method.
-   *         This class is thread safe.
-   * /ingroup common
+   *
+   *         A set is matched to the newest of the oldest objects of all streams: every other stream contributes the
+   *         object closest in time to it, as soon as the next object of that stream shows that no closer one will come.
+   *
+   *         Each stream is queued in a bounded lock-free ring buffer, so adding data never blocks and memory does not
+   *         grow when a stream stalls; full queues are handled according to the SynchronizerDropPolicy. Each stream
+   *         must be fed by one thread at a time. Matching and the callbacks run in the thread of one of the add calls,
+   *         never concurrently. This class is thread safe.
+   *
+   *         With two streams the callbacks have the signature void (T1, T2, unsigned long, unsigned long); with more
+   *         streams they get the data objects followed by a boost::array with the time stamps.
+   * \ingroup common
    */
-  template <typename T1, typename T2>
+  template <typename T1, typename T2, typename T3 = detail::SynchronizerNoStream, typename T4 = detail::SynchronizerNoStream,
+            typename T5 = detail::SynchronizerNoStream, typename T6 = detail::SynchronizerNoStream>
   class Synchronizer
   {
-    typedef std::pair<unsigned long, T1> T1Stamped;
-    typedef std::pair<unsigned long, T2> T2Stamped;
-    boost::mutex mutex1_;
-    boost::mutex mutex2_;
-    boost::mutex publish_mutex_;
-    std::deque<T1Stamped> queueT1;
-    std::deque<T2Stamped> queueT2;
-
-    typedef boost::function<void(T1, T2, unsigned long, unsigned long) > CallbackFunction;
+    typedef detail::SynchronizerTraits<T1, T2, T3, T4, T5, T6> Traits;
+    typedef detail::SynchronizerNoStream NoStream;
 
-    std::map<int, CallbackFunction> cb_;
-    int callback_counter;
   public:
+    typedef typename Traits::CallbackFunction CallbackFunction;
 
-    Synchronizer () : mutex1_ (), mutex2_ (), publish_mutex_ (), queueT1 (), queueT2 (), cb_ (), callback_counter (0) { };
+    /** \brief Constructor.
+      * \param[in] capacity the maximum number of objects queued per stream, rounded up to a power of two
+      * \param[in] drop_policy what to do with new objects when the queue of their stream is full
+      */
+    Synchronizer (size_t capacity = 64, SynchronizerDropPolicy drop_policy = SYNCHRONIZER_DROP_OLDEST)
+      : stream0_ (capacity), stream1_ (capacity)
+      , stream2_ (Traits::nr_streams > 2 ? capacity : 1), stream3_ (Traits::nr_streams > 3 ? capacity : 1)
+      , stream4_ (Traits::nr_streams > 4 ? capacity : 1), stream5_ (Traits::nr_streams > 5 ? capacity : 1)
+      , drop_policy_ (drop_policy), pending_ (0), publish_mutex_ (), cb_ (), callback_counter (0)
+      , published_ (0), latency_sum_ns_ (0), latency_max_ns_ (0), skew_sum_ (0), skew_max_ (0)
+    {
+      streams_[0] = &stream0_; streams_[1] = &stream1_; streams_[2] = &stream2_;
+      streams_[3] = &stream3_; streams_[4] = &stream4_; streams_[5] = &stream5_;
+    }
 
     int
     addCallback (const CallbackFunction& callback)
@@ -80,99 +410,207 @@ namespace pcl
     }
 
     void
-    add0 (const T1& t, unsigned long time)
+    add0 (const T1& t, unsigned long time) { add (stream0_, t, time); }
+
+    void
+    add1 (const T2& t, unsigned long time) { add (stream1_, t, time); }
+
+    void
+    add2 (const T3& t, unsigned long time)
     {
-      mutex1_.lock ();
-      queueT1.push_back (T1Stamped (time, t));
-      mutex1_.unlock ();
-      publish ();
+      BOOST_STATIC_ASSERT (Traits::nr_streams > 2);
+      add (stream2_, t, time);
     }
 
     void
-    add1 (const T2& t, unsigned long time)
+    add3 (const T4& t, unsigned long time)
     {
-      mutex2_.lock ();
-      queueT2.push_back (T2Stamped (time, t));
-      mutex2_.unlock ();
-      publish ();
+      BOOST_STATIC_ASSERT (Traits::nr_streams > 3);
+      add (stream3_, t, time);
     }
 
-  private:
+    void
+    add4 (const T5& t, unsigned long time)
+    {
+      BOOST_STATIC_ASSERT (Traits::nr_streams > 4);
+      add (stream4_, t, time);
+    }
 
     void
-    publishData ()
+    add5 (const T6& t, unsigned long time)
     {
-      boost::unique_lock<boost::mutex> lock1 (mutex1_);
-      boost::unique_lock<boost::mutex> lock2 (mutex2_);
+      BOOST_STATIC_ASSERT (Traits::nr_streams > 5);
+      add (stream5_, t, time);
+    }
+
+    /** \brief Number of synchronized streams. */
+    inline int
+    getNumberOfStreams () const { return (Traits::nr_streams); }
+
+    /** \brief Maximum number of objects queued per stream. */
+    inline size_t
+    getCapacity () const { return (stream0_.buffer.capacity ()); }
+
+    /** \brief Get the counters of the streams and the latency of the published sets. Waits for
+      * running callbacks to return.
+      */
+    SynchronizerStatistics
+    getStatistics ()
+    {
+      boost::unique_lock<boost::mutex> publish_lock (publish_mutex_);
+      SynchronizerStatistics stats;
+      stats.streams.resize (Traits::nr_streams);
+      for (int s = 0; s < Traits::nr_streams; ++s)
+      {
+        stats.streams[s].received = detail::loadAcquire (streams_[s]->received);
+        stats.streams[s].dropped = detail::loadAcquire (streams_[s]->dropped);
+        stats.streams[s].discarded = streams_[s]->discarded;
+        stats.streams[s].queued = streams_[s]->size ();
+      }
+      stats.published = published_;
+      if (published_ > 0)
+      {
+        stats.mean_latency = static_cast<double> (latency_sum_ns_) * 1e-9 / static_cast<double> (published_);
+        stats.mean_skew = skew_sum_ / static_cast<double> (published_);
+      }
+      stats.max_latency = static_cast<double> (latency_max_ns_) * 1e-9;
+      stats.max_skew = skew_max_;
+      return (stats);
+    }
 
-      for (typename std::map<int, CallbackFunction>::iterator cb = cb_.begin (); cb != cb_.end (); ++cb)
+  private:
+
+    template <typename T> void
+    add (detail::SynchronizerStream<T> &stream, const T& t, unsigned long time)
+    {
+      const uint64_t now = profiling::getTimeNanoseconds ();
+      detail::storeRelease (stream.received, stream.received + 1);
+      if (!stream.buffer.push (t, time, now))
       {
-        if (!cb->second.empty ())
+        bool pushed = false;
+        // Only the consumer may pop, so become the consumer for the moment
+        if (drop_policy_ == SYNCHRONIZER_DROP_OLDEST && publish_mutex_.try_lock ())
         {
-          cb->second.operator()(queueT1.front ().second, queueT2.front ().second, queueT1.front ().first, queueT2.front ().first);
+          stream.buffer.pop ();
+          pushed = stream.buffer.push (t, time, now);
+          publish_mutex_.unlock ();
         }
+        detail::storeRelease (stream.dropped, stream.dropped + 1);
+        if (!pushed)
+          return;
       }
-
-      queueT1.pop_front ();
-      queueT2.pop_front ();
+      publish ();
     }
 
     void
     publish ()
     {
-      // only one publish call at once allowed
-      boost::unique_lock<boost::mutex> publish_lock (publish_mutex_);
-
-      boost::unique_lock<boost::mutex> lock1 (mutex1_);
-      if (queueT1.empty ())
-        return;
-      T1Stamped t1 = queueT1.front ();
-      lock1.unlock ();
-
-      boost::unique_lock<boost::mutex> lock2 (mutex2_);
-      if (queueT2.empty ())
-        return;
-      T2Stamped t2 = queueT2.front ();
-      lock2.unlock ();
-
-      bool do_publish = false;
+      // Producers never wait for each other: if a publish is running, it is asked to run again
+      detail::storeRelease (pending_, 1);
+      detail::memoryFence ();
+      while (publish_mutex_.try_lock ())
+      {
+        detail::storeRelease (pending_, 0);
+        detail::memoryFence ();
+        publishMatches ();
+        publish_mutex_.unlock ();
+        detail::memoryFence ();
+        if (!detail::loadAcquire (pending_))
+          break;
+      }
+    }
 
-      if (t1.first <= t2.first)
-      { // iterate over queue1
-        lock1.lock ();
-        while (queueT1.size () > 1 && queueT1[1].first <= t2.first)
-          queueT1.pop_front ();
+    void
+    publishMatches ()
+    {
+      for (;;)
+      {
+        // The newest of the oldest objects of all streams is the reference
+        unsigned long reference = 0;
+        for (int s = 0; s < Traits::nr_streams; ++s)
+        {
+          if (streams_[s]->size () == 0)
+            return;
+          reference = (std::max) (reference, streams_[s]->getStamp (0));
+        }
 
-        if (queueT1.size () > 1)
-        { // we have at least 2 measurements; first in past and second in future -> find out closer one!
-          if ( (t2.first << 1) > (queueT1[0].first + queueT1[1].first) )
-            queueT1.pop_front ();
+        bool ready = true;
+        for (int s = 0; s < Traits::nr_streams; ++s)
+        {
+          detail::SynchronizerStreamBase &stream = *streams_[s];
+          while (stream.size () > 1 && stream.getStamp (1) <= reference)
+          {
+            stream.pop ();
+            ++stream.discarded;
+          }
+          if (stream.getStamp (0) < reference)
+          {
+            if (stream.size () > 1)
+            { // we have at least 2 measurements; first in past and second in future -> find out closer one!
+              if (reference - stream.getStamp (0) > stream.getStamp (1) - reference)
+              {
+                stream.pop ();
+                ++stream.discarded;
+              }
+            }
+            else
+              ready = false;
+          }
+        }
+        if (!ready)
+          return;
 
-          do_publish = true;
+        unsigned long stamps[6] = {0, 0, 0, 0, 0, 0};
+        uint64_t oldest_ns = streams_[0]->getEnqueueTime ();
+        for (int s = 0; s < Traits::nr_streams; ++s)
+        {
+          stamps[s] = streams_[s]->getStamp (0);
+          oldest_ns = (std::min) (oldest_ns, streams_[s]->getEnqueueTime ());
         }
-        lock1.unlock ();
-      }
-      else
-      { // iterate over queue2
-        lock2.lock ();
-        while (queueT2.size () > 1 && (queueT2[1].first <= t1.first) )
-          queueT2.pop_front ();
-
-        if (queueT2.size () > 1)
-        { // we have at least 2 measurements; first in past and second in future -> find out closer one!
-          if ( (t1.first << 1) > queueT2[0].first + queueT2[1].first )
-            queueT2.pop_front ();
-
-          do_publish = true;
+        for (typename std::map<int, CallbackFunction>::iterator cb = cb_.begin (); cb != cb_.end (); ++cb)
+        {
+          if (!cb->second.empty ())
+            Traits::invoke (cb->second, stream0_.front (), stream1_.front (), stream2_.front (), stream3_.front (),
+                            stream4_.front (), stream5_.front (), stamps);
         }
-        lock2.unlock ();
-      }
+        for (int s = 0; s < Traits::nr_streams; ++s)
+          streams_[s]->pop ();
 
-      if (do_publish)
-        publishData ();
+        const uint64_t now = profiling::getTimeNanoseconds ();
+        const uint64_t latency = now > oldest_ns ? now - oldest_ns : 0;
+        const unsigned long skew = *std::max_element (stamps, stamps + Traits::nr_streams) -
+                                   *std::min_element (stamps, stamps + Traits::nr_streams);
+        ++published_;
+        latency_sum_ns_ += latency;
+        latency_max_ns_ = (std::max) (latency_max_ns_, latency);
+        skew_sum_ += static_cast<double> (skew);
+        skew_max_ = (std::max) (skew_max_, skew);
+      }
     }
+
+    detail::SynchronizerStream<T1> stream0_;
+    detail::SynchronizerStream<T2> stream1_;
+    detail::SynchronizerStream<T3> stream2_;
+    detail::SynchronizerStream<T4> stream3_;
+    detail::SynchronizerStream<T5> stream4_;
+    detail::SynchronizerStream<T6> stream5_;
+    detail::SynchronizerStreamBase *streams_[6];
+
+    SynchronizerDropPolicy drop_policy_;
+    /** \brief Set when new data arrived while a publish was running. */
+    volatile size_t pending_;
+    /** \brief Held by the consumer: while matching, calling callbacks, and when changing callbacks. */
+    boost::mutex publish_mutex_;
+
+    std::map<int, CallbackFunction> cb_;
+    int callback_counter;
+
+    size_t published_;
+    uint64_t latency_sum_ns_;
+    uint64_t latency_max_ns_;
+    double skew_sum_;
+    unsigned long skew_max_;
   } ;
 } // namespace
 
 #endif // __PCL_SYNCHRONIZER__
-
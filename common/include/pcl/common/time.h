@@ -46,6 +46,7 @@
 #include <cmath>
 #include <string>
 #include <boost/date_time/posix_time/posix_time.hpp>
+#include <pcl/common/profiler.h>
 
 /**
   * \file pcl/common/time.h
@@ -109,31 +110,52 @@ namespace pcl
     * }
     * \endcode
     *
+    * If PCL is configured with PCL_ENABLE_PROFILING, the scope is also recorded
+    * in pcl::profiling::Registry under its title.
+    *
     * \ingroup common
     */
   class ScopeTime : public StopWatch
   {
     public:
       inline ScopeTime (const char* title) : 
-        title_ (std::string (title))
+        title_ (std::string (title)), profile_ (NULL), profile_start_ns_ (0)
       {
         start_time_ = boost::posix_time::microsec_clock::local_time ();
+        beginProfile ();
       }
 
       inline ScopeTime () :
-        title_ (std::string (""))
+        title_ (std::string ("")), profile_ (NULL), profile_start_ns_ (0)
       {
         start_time_ = boost::posix_time::microsec_clock::local_time ();
+        beginProfile ();
       }
 
       inline ~ScopeTime ()
       {
         double val = this->getTime ();
         std::cerr << title_ << " took " << val << "ms.\n";
+#ifdef PCL_ENABLE_PROFILING
+        if (profile_)
+          profiling::Registry::getInstance ().endScope (profile_, profile_start_ns_);
+#endif
       }
 
     private:
+      inline void
+      beginProfile ()
+      {
+#ifdef PCL_ENABLE_PROFILING
+        profile_ = profiling::Registry::getInstance ().beginScope (title_.c_str ());
+        if (profile_)
+          profile_start_ns_ = profiling::getTimeNanoseconds ();
+#endif
+      }
+
       std::string title_;
+      profiling::detail::ThreadProfile *profile_;
+      uint64_t profile_start_ns_;
   };
 
 
@@ -52,6 +52,14 @@ namespace pcl
     * \param[out] cloud_out the resultant output point cloud
     * \param[in] transform an affine transformation (typically a rigid transformation)
     * \note Can be used with cloud_in equal to cloud_out
+    * \note Points are transformed with SSE2 (float) or AVX (double) when the
+    * compiler targets them, and by all OpenMP threads for clouds of at least
+    * PCL_TRANSFORMS_PARALLEL_MIN_POINTS points when compiled with OpenMP. The
+    * vectorized code performs the same multiplications and additions in the same
+    * order as the scalar code, so results are identical unless the compiler
+    * contracts the scalar code into fused multiply-adds; each coordinate then
+    * differs by at most 4 * epsilon * (|t_0| |x| + |t_1| |y| + |t_2| |z| + |t_3|)
+    * for the matrix row t and the input point (x, y, z).
     * \ingroup common
     */
   template <typename PointT, typename Scalar> void 
@@ -67,6 +75,25 @@ namespace pcl
     return (transformPointCloud<PointT, float> (cloud_in, cloud_out, transform));
   }
 
+  /** \brief Apply an affine transform defined by an Eigen Transform in place
+    * \param[in,out] cloud the point cloud to transform
+    * \param[in] transform an affine transformation (typically a rigid transformation)
+    * \ingroup common
+    */
+  template <typename PointT, typename Scalar> void 
+  transformPointCloud (pcl::PointCloud<PointT> &cloud, 
+                       const Eigen::Transform<Scalar, 3, Eigen::Affine> &transform)
+  {
+    return (transformPointCloud<PointT, Scalar> (cloud, cloud, transform));
+  }
+
+  template <typename PointT> void 
+  transformPointCloud (pcl::PointCloud<PointT> &cloud, 
+                       const Eigen::Affine3f &transform)
+  {
+    return (transformPointCloud<PointT, float> (cloud, cloud, transform));
+  }
+
   /** \brief Apply an affine transform defined by an Eigen Transform
     * \param[in] cloud_in the input point cloud
     * \param[in] indices the set of point indices to use from the input point cloud
@@ -133,6 +160,24 @@ namespace pcl
     return (transformPointCloudWithNormals<PointT, float> (cloud_in, cloud_out, transform));
   }
 
+  /** \brief Transform a point cloud and rotate its normals using an Eigen transform, in place.
+    * \param[in,out] cloud the point cloud to transform
+    * \param[in] transform an affine transformation (typically a rigid transformation)
+    */
+  template <typename PointT, typename Scalar> void 
+  transformPointCloudWithNormals (pcl::PointCloud<PointT> &cloud, 
+                                  const Eigen::Transform<Scalar, 3, Eigen::Affine> &transform)
+  {
+    return (transformPointCloudWithNormals<PointT, Scalar> (cloud, cloud, transform));
+  }
+
+  template <typename PointT> void 
+  transformPointCloudWithNormals (pcl::PointCloud<PointT> &cloud, 
+                                  const Eigen::Affine3f &transform)
+  {
+    return (transformPointCloudWithNormals<PointT, float> (cloud, cloud, transform));
+  }
+
   /** \brief Transform a point cloud and rotate its normals using an Eigen transform.
     * \param[in] cloud_in the input point cloud
     * \param[in] indices the set of point indices to use from the input point cloud
@@ -203,6 +248,26 @@ namespace pcl
     return (transformPointCloud<PointT, float> (cloud_in, cloud_out, transform));
   }
 
+  /** \brief Apply a rigid transform defined by a 4x4 matrix in place
+    * \param[in,out] cloud the point cloud to transform
+    * \param[in] transform a rigid transformation 
+    * \ingroup common
+    */
+  template <typename PointT, typename Scalar> void 
+  transformPointCloud (pcl::PointCloud<PointT> &cloud, 
+                       const Eigen::Matrix<Scalar, 4, 4> &transform)
+  {
+    Eigen::Transform<Scalar, 3, Eigen::Affine> t (transform);
+    return (transformPointCloud<PointT, Scalar> (cloud, cloud, t));
+  }
+
+  template <typename PointT> void 
+  transformPointCloud (pcl::PointCloud<PointT> &cloud, 
+                       const Eigen::Matrix4f &transform)
+  {
+    return (transformPointCloud<PointT, float> (cloud, transform));
+  }
+
   /** \brief Apply a rigid transform defined by a 4x4 matrix
     * \param[in] cloud_in the input point cloud
     * \param[in] indices the set of point indices to use from the input point cloud
@@ -53,6 +53,20 @@
 #include <pcl/exceptions.h>
 #include <pcl/console/print.h>
 #include <boost/foreach.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include <algorithm>
+#include <list>
+
+/** \brief Number of points from which fromPCLPointCloud2 copies the point data with OpenMP. */
+#ifndef PCL_CONVERSIONS_PARALLEL_MIN_POINTS
+#define PCL_CONVERSIONS_PARALLEL_MIN_POINTS 100000
+#endif
+
+/** \brief Number of field layouts for which the field map of each point type is cached. */
+#ifndef PCL_CONVERSIONS_MAPPING_CACHE_SIZE
+#define PCL_CONVERSIONS_MAPPING_CACHE_SIZE 8
+#endif
 
 namespace pcl
 {
@@ -150,6 +164,85 @@ namespace pcl
     }
   }
 
+  namespace detail
+  {
+    /** \brief Check whether two lists of fields describe the same binary layout. */
+    inline bool
+    sameFields (const std::vector<pcl::PCLPointField>& a, const std::vector<pcl::PCLPointField>& b)
+    {
+      if (a.size () != b.size ())
+        return (false);
+      for (size_t i = 0; i < a.size (); ++i)
+        if (a[i].offset != b[i].offset || a[i].datatype != b[i].datatype ||
+            a[i].count != b[i].count || a[i].name != b[i].name)
+          return (false);
+      return (true);
+    }
+
+    /** \brief Get the field map from msg_fields to PointT, as created by createMapping.
+      * The maps of the last PCL_CONVERSIONS_MAPPING_CACHE_SIZE layouts are kept per point type,
+      * so that streams of clouds with the same layout build (and warn about) their map only once.
+      */
+    template<typename PointT> boost::shared_ptr<const MsgFieldMap>
+    getCachedMapping (const std::vector<pcl::PCLPointField>& msg_fields)
+    {
+      typedef std::pair<std::vector<pcl::PCLPointField>, boost::shared_ptr<const MsgFieldMap> > CacheEntry;
+      static std::list<CacheEntry> cache;
+      static boost::mutex cache_mutex;
+
+      boost::mutex::scoped_lock lock (cache_mutex);
+      for (typename std::list<CacheEntry>::iterator it = cache.begin (); it != cache.end (); ++it)
+      {
+        if (sameFields (it->first, msg_fields))
+        {
+          // Keep the most recently used layouts at the front
+          cache.splice (cache.begin (), cache, it);
+          return (cache.front ().second);
+        }
+      }
+
+      boost::shared_ptr<MsgFieldMap> field_map (new MsgFieldMap);
+      createMapping<PointT> (msg_fields, *field_map);
+      cache.push_front (CacheEntry (msg_fields, field_map));
+      if (cache.size () > PCL_CONVERSIONS_MAPPING_CACHE_SIZE)
+        cache.pop_back ();
+      return (field_map);
+    }
+
+    /** \brief Check whether field_map copies whole points, i.e. whether the serialized points of a
+      * PCLPointCloud2 with a point_step of sizeof (PointT) can be copied (or used) as they are.
+      */
+    inline bool
+    isIdentityMapping (const MsgFieldMap& field_map)
+    {
+      return (field_map.size () == 1 &&
+              field_map[0].serialized_offset == 0 &&
+              field_map[0].struct_offset == 0);
+    }
+
+    /** \brief Copy the field runs of field_map from one serialized point to one struct point.
+      * The run sizes of the common point types are dispatched to fixed size memcpy's, which the
+      * compiler turns into plain loads and stores.
+      */
+    inline void
+    copyFieldRuns (const MsgFieldMap& field_map, const uint8_t* msg_data, uint8_t* cloud_data)
+    {
+      for (MsgFieldMap::const_iterator it = field_map.begin (); it != field_map.end (); ++it)
+      {
+        const uint8_t* src = msg_data + it->serialized_offset;
+        uint8_t* dst = cloud_data + it->struct_offset;
+        switch (it->size)
+        {
+          case 4:  memcpy (dst, src, 4); break;
+          case 8:  memcpy (dst, src, 8); break;
+          case 12: memcpy (dst, src, 12); break;
+          case 16: memcpy (dst, src, 16); break;
+          default: memcpy (dst, src, it->size); break;
+        }
+      }
+    }
+  } // namespace detail
+
   /** \brief Convert a PCLPointCloud2 binary data blob into a pcl::PointCloud<T> object using a field_map.
     * \param[in] msg the PCLPointCloud2 binary blob
     * \param[out] cloud the resultant pcl::PointCloud<T>
@@ -176,20 +269,31 @@ namespace pcl
     // Copy point data
     uint32_t num_points = msg.width * msg.height;
     cloud.points.resize (num_points);
+    if (num_points == 0)
+      return;
     uint8_t* cloud_data = reinterpret_cast<uint8_t*>(&cloud.points[0]);
+    const uint8_t* msg_data = &msg.data[0];
+
+    // Large clouds are copied in blocks of points, in parallel
+    const int block_size = 4096;
+    const int nr_blocks = static_cast<int> ((num_points + block_size - 1) / block_size);
 
     // Check if we can copy adjacent points in a single memcpy
-    if (field_map.size() == 1 &&
-        field_map[0].serialized_offset == 0 &&
-        field_map[0].struct_offset == 0 &&
-        msg.point_step == sizeof(PointT))
+    if (detail::isIdentityMapping (field_map) && msg.point_step == sizeof(PointT))
     {
       uint32_t cloud_row_step = static_cast<uint32_t> (sizeof (PointT) * cloud.width);
-      const uint8_t* msg_data = &msg.data[0];
       // Should usually be able to copy all rows at once
       if (msg.row_step == cloud_row_step)
       {
-        memcpy (cloud_data, msg_data, msg.data.size ());
+#ifdef _OPENMP
+#pragma omp parallel for if (num_points >= PCL_CONVERSIONS_PARALLEL_MIN_POINTS) schedule (static)
+#endif
+        for (int b = 0; b < nr_blocks; ++b)
+        {
+          const size_t begin = static_cast<size_t> (b) * block_size;
+          const size_t end = std::min (static_cast<size_t> (num_points), begin + block_size);
+          memcpy (cloud_data + begin * sizeof (PointT), msg_data + begin * sizeof (PointT), (end - begin) * sizeof (PointT));
+        }
       }
       else
       {
@@ -201,17 +305,23 @@ namespace pcl
     else
     {
       // If not, memcpy each group of contiguous fields separately
-      for (uint32_t row = 0; row < msg.height; ++row)
+#ifdef _OPENMP
+#pragma omp parallel for if (num_points >= PCL_CONVERSIONS_PARALLEL_MIN_POINTS) schedule (static)
+#endif
+      for (int b = 0; b < nr_blocks; ++b)
       {
-        const uint8_t* row_data = &msg.data[row * msg.row_step];
-        for (uint32_t col = 0; col < msg.width; ++col)
+        const uint32_t begin = static_cast<uint32_t> (b) * block_size;
+        const uint32_t end = std::min (num_points, begin + block_size);
+        uint32_t row = begin / msg.width, col = begin % msg.width;
+        for (uint32_t i = begin; i < end; ++i)
         {
-          const uint8_t* msg_data = row_data + col * msg.point_step;
-          BOOST_FOREACH (const detail::FieldMapping& mapping, field_map)
+          detail::copyFieldRuns (field_map, msg_data + row * msg.row_step + col * msg.point_step,
+                                 cloud_data + i * sizeof (PointT));
+          if (++col == msg.width)
           {
-            memcpy (cloud_data + mapping.struct_offset, msg_data + mapping.serialized_offset, mapping.size);
+            col = 0;
+            ++row;
           }
-          cloud_data += sizeof (PointT);
         }
       }
     }
@@ -224,9 +334,8 @@ namespace pcl
   template<typename PointT> void
   fromPCLPointCloud2 (const pcl::PCLPointCloud2& msg, pcl::PointCloud<PointT>& cloud)
   {
-    MsgFieldMap field_map;
-    createMapping<PointT> (msg.fields, field_map);
-    fromPCLPointCloud2 (msg, cloud, field_map);
+    boost::shared_ptr<const MsgFieldMap> field_map = detail::getCachedMapping<PointT> (msg.fields);
+    fromPCLPointCloud2 (msg, cloud, *field_map);
   }
 
   /** \brief Convert a pcl::PointCloud<T> object to a PCLPointCloud2 binary data blob.
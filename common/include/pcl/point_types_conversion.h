@@ -40,9 +40,327 @@
 #define PCL_TYPE_CONVERSIONS_H
 
 #include <limits>
+#include <cmath>
+#include <algorithm>
+#include <pcl/point_types.h>
+#include <pcl/point_cloud.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/** \brief Number of points from which the bulk color conversions run with OpenMP. */
+#ifndef PCL_COLOR_CONVERSION_PARALLEL_MIN_POINTS
+#define PCL_COLOR_CONVERSION_PARALLEL_MIN_POINTS 100000
+#endif
 
 namespace pcl
 {
+  namespace detail
+  {
+    /** \brief Conversion of 8-bit RGB to HSV, with the results of PointXYZRGBtoXYZHSV. */
+    struct HSVConversion
+    {
+      static inline void
+      convert (int r, int g, int b, float &h, float &s, float &v)
+      {
+        const int max = (std::max) (r, (std::max) (g, b));
+        const int min = (std::min) (r, (std::min) (g, b));
+        v = static_cast<float> (max) / 255.f;
+        if (max == 0)
+        {
+          s = h = 0.f;
+          return;
+        }
+        const float diff = static_cast<float> (max - min);
+        s = diff / static_cast<float> (max);
+        if (min == max)
+        {
+          h = 0.f;
+          return;
+        }
+        if      (max == r) h = 60.f * (      static_cast<float> (g - b) / diff);
+        else if (max == g) h = 60.f * (2.f + static_cast<float> (b - r) / diff);
+        else               h = 60.f * (4.f + static_cast<float> (r - g) / diff);
+        if (h < 0.f) h += 360.f;
+      }
+
+#if defined(__SSE2__)
+      static inline void
+      convert (__m128i ri, __m128i gi, __m128i bi, __m128 &h, __m128 &s, __m128 &v)
+      {
+        const __m128 r = _mm_cvtepi32_ps (ri), g = _mm_cvtepi32_ps (gi), b = _mm_cvtepi32_ps (bi);
+        const __m128 zero = _mm_setzero_ps ();
+        const __m128 max = _mm_max_ps (r, _mm_max_ps (g, b));
+        const __m128 min = _mm_min_ps (r, _mm_min_ps (g, b));
+        const __m128 diff = _mm_sub_ps (max, min);
+        v = _mm_div_ps (max, _mm_set1_ps (255.f));
+        // Lanes that divide by zero are masked out below
+        s = _mm_and_ps (_mm_div_ps (diff, max), _mm_cmpneq_ps (max, zero));
+
+        // Select the numerator and the sector first, so that one division serves all cases;
+        // adding a sector of 0 is exact, so the results equal the scalar ones
+        const __m128 is_r = _mm_cmpeq_ps (max, r);
+        const __m128 is_g = _mm_andnot_ps (is_r, _mm_cmpeq_ps (max, g));
+        const __m128 is_b = _mm_andnot_ps (_mm_or_ps (is_r, is_g), _mm_castsi128_ps (_mm_set1_epi32 (-1)));
+        const __m128 numerator = _mm_or_ps (_mm_and_ps (is_r, _mm_sub_ps (g, b)),
+                                            _mm_or_ps (_mm_and_ps (is_g, _mm_sub_ps (b, r)), _mm_and_ps (is_b, _mm_sub_ps (r, g))));
+        const __m128 sector = _mm_or_ps (_mm_and_ps (is_g, _mm_set1_ps (2.f)), _mm_and_ps (is_b, _mm_set1_ps (4.f)));
+        __m128 hue = _mm_mul_ps (_mm_set1_ps (60.f), _mm_add_ps (sector, _mm_div_ps (numerator, diff)));
+        hue = _mm_add_ps (hue, _mm_and_ps (_mm_cmplt_ps (hue, zero), _mm_set1_ps (360.f)));
+        h = _mm_and_ps (hue, _mm_cmpneq_ps (diff, zero));
+      }
+#endif
+    };
+
+    /** \brief Conversion of 8-bit RGB to intensity, with the weights of PointRGBtoI. Only the
+      * first output is set.
+      */
+    struct IntensityConversion
+    {
+      static inline void
+      convert (int r, int g, int b, float &intensity, float &, float &)
+      {
+        intensity = 0.299f * static_cast<float> (r) + 0.587f * static_cast<float> (g) + 0.114f * static_cast<float> (b);
+      }
+
+#if defined(__SSE2__)
+      static inline void
+      convert (__m128i r, __m128i g, __m128i b, __m128 &intensity, __m128 &, __m128 &)
+      {
+        intensity = _mm_add_ps (_mm_add_ps (_mm_mul_ps (_mm_set1_ps (0.299f), _mm_cvtepi32_ps (r)),
+                                            _mm_mul_ps (_mm_set1_ps (0.587f), _mm_cvtepi32_ps (g))),
+                                _mm_mul_ps (_mm_set1_ps (0.114f), _mm_cvtepi32_ps (b)));
+      }
+#endif
+    };
+
+    /** \brief Table of the linear values of the 8-bit sRGB components. */
+    struct SRGBToLinearTable
+    {
+      SRGBToLinearTable ()
+      {
+        for (int i = 0; i < 256; ++i)
+        {
+          const double c = static_cast<double> (i) / 255.0;
+          values[i] = static_cast<float> (c <= 0.04045 ? c / 12.92 : std::pow ((c + 0.055) / 1.055, 2.4));
+        }
+      }
+
+      float values[256];
+    };
+
+    inline const float*
+    getSRGBToLinearTable ()
+    {
+      static const SRGBToLinearTable table;
+      return (table.values);
+    }
+
+    /** \brief Conversion of 8-bit sRGB to CIE L*a*b* (D65 white point), L in [0, 100]. */
+    struct LabConversion
+    {
+      static inline float
+      f (float t)
+      {
+        return (t > 0.008856f ? powf (t, 1.0f / 3.0f) : 7.787f * t + 16.0f / 116.0f);
+      }
+
+      static inline void
+      convert (int r, int g, int b, float &l, float &a, float &b_out)
+      {
+        const float *linear = getSRGBToLinearTable ();
+        const float lr = linear[r], lg = linear[g], lb = linear[b];
+        const float fx = f ((0.412453f * lr + 0.357580f * lg + 0.180423f * lb) / 0.950456f);
+        const float fy = f ( 0.212671f * lr + 0.715160f * lg + 0.072169f * lb);
+        const float fz = f ((0.019334f * lr + 0.119193f * lg + 0.950227f * lb) / 1.088754f);
+        l = 116.0f * fy - 16.0f;
+        a = 500.0f * (fx - fy);
+        b_out = 200.0f * (fy - fz);
+      }
+
+#if defined(__SSE2__)
+      static inline __m128
+      f (__m128 t)
+      {
+        // Cube root: initial guess from the exponent bits, then Newton iterations
+        const __m128 third = _mm_set1_ps (1.0f / 3.0f);
+        const __m128 bits = _mm_cvtepi32_ps (_mm_castps_si128 (t));
+        __m128 x = _mm_castsi128_ps (_mm_add_epi32 (_mm_cvttps_epi32 (_mm_mul_ps (bits, third)), _mm_set1_epi32 (709921077)));
+        for (int i = 0; i < 3; ++i)
+          x = _mm_mul_ps (third, _mm_add_ps (_mm_add_ps (x, x), _mm_div_ps (t, _mm_mul_ps (x, x))));
+        const __m128 linear = _mm_add_ps (_mm_mul_ps (_mm_set1_ps (7.787f), t), _mm_set1_ps (16.0f / 116.0f));
+        const __m128 mask = _mm_cmpgt_ps (t, _mm_set1_ps (0.008856f));
+        return (_mm_or_ps (_mm_and_ps (mask, x), _mm_andnot_ps (mask, linear)));
+      }
+
+      static inline void
+      convert (__m128i r, __m128i g, __m128i b, __m128 &l, __m128 &a, __m128 &b_out)
+      {
+        const float *linear = getSRGBToLinearTable ();
+        int ri[4], gi[4], bi[4];
+        _mm_storeu_si128 (reinterpret_cast<__m128i*> (ri), r);
+        _mm_storeu_si128 (reinterpret_cast<__m128i*> (gi), g);
+        _mm_storeu_si128 (reinterpret_cast<__m128i*> (bi), b);
+        const __m128 lr = _mm_setr_ps (linear[ri[0]], linear[ri[1]], linear[ri[2]], linear[ri[3]]);
+        const __m128 lg = _mm_setr_ps (linear[gi[0]], linear[gi[1]], linear[gi[2]], linear[gi[3]]);
+        const __m128 lb = _mm_setr_ps (linear[bi[0]], linear[bi[1]], linear[bi[2]], linear[bi[3]]);
+        const __m128 x = _mm_mul_ps (_mm_add_ps (_mm_add_ps (_mm_mul_ps (_mm_set1_ps (0.412453f), lr),
+                                                             _mm_mul_ps (_mm_set1_ps (0.357580f), lg)),
+                                                 _mm_mul_ps (_mm_set1_ps (0.180423f), lb)),
+                                     _mm_set1_ps (1.0f / 0.950456f));
+        const __m128 y = _mm_add_ps (_mm_add_ps (_mm_mul_ps (_mm_set1_ps (0.212671f), lr),
+                                                 _mm_mul_ps (_mm_set1_ps (0.715160f), lg)),
+                                     _mm_mul_ps (_mm_set1_ps (0.072169f), lb));
+        const __m128 z = _mm_mul_ps (_mm_add_ps (_mm_add_ps (_mm_mul_ps (_mm_set1_ps (0.019334f), lr),
+                                                             _mm_mul_ps (_mm_set1_ps (0.119193f), lg)),
+                                                 _mm_mul_ps (_mm_set1_ps (0.950227f), lb)),
+                                     _mm_set1_ps (1.0f / 1.088754f));
+        const __m128 fx = f (x), fy = f (y), fz = f (z);
+        l = _mm_sub_ps (_mm_mul_ps (_mm_set1_ps (116.0f), fy), _mm_set1_ps (16.0f));
+        a = _mm_mul_ps (_mm_set1_ps (500.0f), _mm_sub_ps (fx, fy));
+        b_out = _mm_mul_ps (_mm_set1_ps (200.0f), _mm_sub_ps (fy, fz));
+      }
+#endif
+    };
+
+    /** \brief Writes the converted channels to caller-provided arrays; NULL arrays are skipped. */
+    struct ColorBufferWriter
+    {
+      ColorBufferWriter (float *c0, float *c1, float *c2) { out[0] = c0; out[1] = c1; out[2] = c2; }
+
+      inline void
+      operator () (int i, float v0, float v1, float v2) const
+      {
+        out[0][i] = v0;
+        if (out[1]) out[1][i] = v1;
+        if (out[2]) out[2][i] = v2;
+      }
+
+#if defined(__SSE2__)
+      inline void
+      operator () (int i, __m128 v0, __m128 v1, __m128 v2) const
+      {
+        _mm_storeu_ps (out[0] + i, v0);
+        if (out[1]) _mm_storeu_ps (out[1] + i, v1);
+        if (out[2]) _mm_storeu_ps (out[2] + i, v2);
+      }
+#endif
+
+      float *out[3];
+    };
+
+    /** \brief Writes the HSV channels and the coordinates of the input to PointXYZHSV points. */
+    template <typename PointT>
+    struct HSVPointWriter
+    {
+      HSVPointWriter (const PointT *in, PointXYZHSV *out) : in (in), out (out) {}
+
+      inline void
+      operator () (int i, float h, float s, float v) const
+      {
+        out[i].x = in[i].x; out[i].y = in[i].y; out[i].z = in[i].z;
+        out[i].h = h; out[i].s = s; out[i].v = v;
+      }
+
+#if defined(__SSE2__)
+      inline void
+      operator () (int i, __m128 h, __m128 s, __m128 v) const
+      {
+        float hs[4], ss[4], vs[4];
+        _mm_storeu_ps (hs, h);
+        _mm_storeu_ps (ss, s);
+        _mm_storeu_ps (vs, v);
+        for (int k = 0; k < 4; ++k)
+          (*this) (i + k, hs[k], ss[k], vs[k]);
+      }
+#endif
+
+      const PointT *in;
+      PointXYZHSV *out;
+    };
+
+    /** \brief Writes the intensity, and the coordinates of the input if PointOutT has them. */
+    template <typename PointT, typename PointOutT>
+    struct IntensityPointWriter
+    {
+      IntensityPointWriter (const PointT *in, PointOutT *out) : in (in), out (out) {}
+
+      static inline void
+      copyXYZ (const PointXYZRGB &p, PointXYZI &q) { q.x = p.x; q.y = p.y; q.z = p.z; }
+      static inline void
+      copyXYZ (const RGB &, Intensity &) {}
+
+      inline void
+      operator () (int i, float intensity, float, float) const
+      {
+        copyXYZ (in[i], out[i]);
+        out[i].intensity = intensity;
+      }
+
+#if defined(__SSE2__)
+      inline void
+      operator () (int i, __m128 intensity, __m128, __m128) const
+      {
+        float values[4];
+        _mm_storeu_ps (values, intensity);
+        for (int k = 0; k < 4; ++k)
+          (*this) (i + k, values[k], 0.f, 0.f);
+      }
+#endif
+
+      const PointT *in;
+      PointOutT *out;
+    };
+
+    /** \brief Convert the colors of the points [begin, end) four at a time. */
+    template <typename Conversion, typename PointT, typename Writer> inline void
+    convertColors (const PointT *points, int begin, int end, const Writer &write)
+    {
+      int i = begin;
+#if defined(__SSE2__)
+      const __m128i mask = _mm_set1_epi32 (0xff);
+      for (; i + 4 <= end; i += 4)
+      {
+        // Gather in registers; _mm_setr_epi32 tends to go through the stack
+        const __m128i rgba = _mm_unpacklo_epi64 (
+            _mm_unpacklo_epi32 (_mm_cvtsi32_si128 (static_cast<int> (points[i].rgba)),
+                                _mm_cvtsi32_si128 (static_cast<int> (points[i + 1].rgba))),
+            _mm_unpacklo_epi32 (_mm_cvtsi32_si128 (static_cast<int> (points[i + 2].rgba)),
+                                _mm_cvtsi32_si128 (static_cast<int> (points[i + 3].rgba))));
+        __m128 c0, c1, c2;
+        Conversion::convert (_mm_and_si128 (_mm_srli_epi32 (rgba, 16), mask),
+                             _mm_and_si128 (_mm_srli_epi32 (rgba, 8), mask),
+                             _mm_and_si128 (rgba, mask), c0, c1, c2);
+        write (i, c0, c1, c2);
+      }
+#endif
+      for (; i < end; ++i)
+      {
+        float c0, c1, c2;
+        Conversion::convert (points[i].r, points[i].g, points[i].b, c0, c1, c2);
+        write (i, c0, c1, c2);
+      }
+    }
+
+    /** \brief Convert the colors of all points, in blocks that run in parallel for large clouds. */
+    template <typename Conversion, typename PointT, typename Writer> void
+    convertColors (const pcl::PointCloud<PointT> &cloud, const Writer &write)
+    {
+      const int nr_points = static_cast<int> (cloud.points.size ());
+      if (nr_points == 0)
+        return;
+      // Build the table of LabConversion before the threads read it
+      getSRGBToLinearTable ();
+      const int block_size = 4096;
+      const int nr_blocks = (nr_points + block_size - 1) / block_size;
+#ifdef _OPENMP
+#pragma omp parallel for if (nr_points >= PCL_COLOR_CONVERSION_PARALLEL_MIN_POINTS) schedule (static)
+#endif
+      for (int b = 0; b < nr_blocks; ++b)
+        convertColors<Conversion> (&cloud.points[0], b * block_size, (std::min) ((b + 1) * block_size, nr_points), write);
+    }
+  }
+
   // r,g,b, i values are from 0 to 1
   // h = [0,360]
   // s, v values are from 0 to 1
@@ -246,12 +564,11 @@ namespace pcl
   {
     out.width   = in.width;
     out.height  = in.height;
-    for (size_t i = 0; i < in.points.size (); i++)
-    {
-      Intensity p;
-      PointRGBtoI (in.points[i], p);
-      out.points.push_back (p);
-    }
+    out.points.resize (in.points.size ());
+    if (in.points.empty ())
+      return;
+    detail::convertColors<detail::IntensityConversion> (
+        in, detail::IntensityPointWriter<RGB, Intensity> (&in.points[0], &out.points[0]));
   }
 
   /** \brief Convert a RGB point cloud to a Intensity
@@ -300,12 +617,11 @@ namespace pcl
   {
     out.width   = in.width;
     out.height  = in.height;
-    for (size_t i = 0; i < in.points.size (); i++)
-    {
-      PointXYZHSV p;
-      PointXYZRGBtoXYZHSV (in.points[i], p);
-      out.points.push_back (p);
-    }
+    out.points.resize (in.points.size ());
+    if (in.points.empty ())
+      return;
+    detail::convertColors<detail::HSVConversion> (
+        in, detail::HSVPointWriter<PointXYZRGB> (&in.points[0], &out.points[0]));
   }
 
   /** \brief Convert a XYZRGB point cloud to a XYZHSV
@@ -318,12 +634,11 @@ namespace pcl
   {
     out.width   = in.width;
     out.height  = in.height;
-    for (size_t i = 0; i < in.points.size (); i++)
-    {
-      PointXYZHSV p;
-      PointXYZRGBAtoXYZHSV (in.points[i], p);
-      out.points.push_back (p);
-    }
+    out.points.resize (in.points.size ());
+    if (in.points.empty ())
+      return;
+    detail::convertColors<detail::HSVConversion> (
+        in, detail::HSVPointWriter<PointXYZRGBA> (&in.points[0], &out.points[0]));
   }
 
   /** \brief Convert a XYZRGB point cloud to a XYZI
@@ -336,12 +651,48 @@ namespace pcl
   {
     out.width   = in.width;
     out.height  = in.height;
-    for (size_t i = 0; i < in.points.size (); i++)
-    {
-      PointXYZI p;
-      PointXYZRGBtoXYZI (in.points[i], p);
-      out.points.push_back (p);
-    }
+    out.points.resize (in.points.size ());
+    if (in.points.empty ())
+      return;
+    detail::convertColors<detail::IntensityConversion> (
+        in, detail::IntensityPointWriter<PointXYZRGB, PointXYZI> (&in.points[0], &out.points[0]));
+  }
+
+  /** \brief Compute the HSV colors of a point cloud, with the results of PointXYZRGBtoXYZHSV.
+    * Large clouds are converted in parallel.
+    * \param[in] in the input point cloud, with the field rgb or rgba
+    * \param[out] h the hue of each point, in [0, 360); an array of in.points.size () floats
+    * \param[out] s the saturation of each point, in [0, 1]; an array of in.points.size () floats, or NULL
+    * \param[out] v the value of each point, in [0, 1]; an array of in.points.size () floats, or NULL
+    */
+  template <typename PointT> inline void
+  PointCloudRGBtoHSV (const PointCloud<PointT> &in, float *h, float *s, float *v)
+  {
+    detail::convertColors<detail::HSVConversion> (in, detail::ColorBufferWriter (h, s, v));
+  }
+
+  /** \brief Compute the intensities of a point cloud, with the weights of PointRGBtoI.
+    * Large clouds are converted in parallel.
+    * \param[in] in the input point cloud, with the field rgb or rgba
+    * \param[out] intensity the intensity of each point, in [0, 255]; an array of in.points.size () floats
+    */
+  template <typename PointT> inline void
+  PointCloudRGBtoIntensity (const PointCloud<PointT> &in, float *intensity)
+  {
+    detail::convertColors<detail::IntensityConversion> (in, detail::ColorBufferWriter (intensity, NULL, NULL));
+  }
+
+  /** \brief Compute the CIE L*a*b* colors of a point cloud, assuming sRGB colors and a D65 white
+    * point. Large clouds are converted in parallel.
+    * \param[in] in the input point cloud, with the field rgb or rgba
+    * \param[out] l the lightness of each point, in [0, 100]; an array of in.points.size () floats
+    * \param[out] a the a* component of each point; an array of in.points.size () floats
+    * \param[out] b the b* component of each point; an array of in.points.size () floats
+    */
+  template <typename PointT> inline void
+  PointCloudRGBtoLab (const PointCloud<PointT> &in, float *l, float *a, float *b)
+  {
+    detail::convertColors<detail::LabConversion> (in, detail::ColorBufferWriter (l, a, b));
   }
 
   /** \brief Convert registered Depth image and RGB image to PointCloudXYZRGBA
@@ -0,0 +1,385 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Point Cloud Library (PCL) - www.pointclouds.org
+ *  Copyright (c) 2013-, Open Perception, Inc.
+ *
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder(s) nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef PCL_POINT_TYPES_QUANTIZED_H_
+#define PCL_POINT_TYPES_QUANTIZED_H_
+
+#include <pcl/pcl_macros.h>
+#include <pcl/register_point_struct.h>
+#include <Eigen/Geometry>
+#include <limits>
+#include <ostream>
+
+/**
+  * \file pcl/point_types_quantized.h
+  * Compact point types that store quantized coordinates, normals and colors, together with the
+  * accessors that quantize and dequantize them.
+  * \ingroup common
+  */
+
+namespace pcl
+{
+  /** \brief The quantized coordinate marking an invalid (e.g., NaN) point. */
+  const int16_t QUANTIZED_INVALID_COORDINATE = -32768;
+
+  /** \brief The largest absolute value of a valid quantized coordinate. */
+  const int16_t QUANTIZED_MAX_COORDINATE = 32767;
+
+  /** \brief The parameters that map the 16-bit fixed-point coordinates of a quantized point cloud
+    * to 3D space: a point with quantized coordinates q is at getTransform () * q.
+    *
+    * The transform usually is a translation to the center of the cloud followed by a scaling with
+    * the resolution (see \ref computeQuantizationParameters), but it can hold any affine transform,
+    * so that transforming a quantized cloud only needs a new set of parameters. Normals are encoded
+    * in the quantized frame as well.
+    * \ingroup common
+    */
+  class QuantizationParameters
+  {
+    public:
+      /** \brief Identity transform: the quantized coordinates are the coordinates in meters. */
+      QuantizationParameters () :
+        transform_ (Eigen::Affine3f::Identity ()), inverse_transform_ (Eigen::Affine3f::Identity ()),
+        normal_to_world_ (Eigen::Matrix3f::Identity ()), normal_to_quantized_ (Eigen::Matrix3f::Identity ())
+      {}
+
+      /** \brief Quantize with the given resolution around an origin.
+        * \param[in] origin the point that gets the quantized coordinates (0, 0, 0)
+        * \param[in] resolution the size of one quantization step in each dimension
+        */
+      QuantizationParameters (const Eigen::Vector3f &origin, float resolution) :
+        transform_ (), inverse_transform_ (), normal_to_world_ (), normal_to_quantized_ ()
+      {
+        setTransform (Eigen::Translation3f (origin) * Eigen::Scaling (resolution));
+      }
+
+      /** \brief Quantize with an arbitrary transform from quantized coordinates to 3D space.
+        * \param[in] transform the transform from quantized coordinates to 3D space
+        */
+      explicit QuantizationParameters (const Eigen::Affine3f &transform) :
+        transform_ (), inverse_transform_ (), normal_to_world_ (), normal_to_quantized_ ()
+      {
+        setTransform (transform);
+      }
+
+      /** \brief Set the transform from quantized coordinates to 3D space. */
+      inline void
+      setTransform (const Eigen::Affine3f &transform)
+      {
+        transform_ = transform;
+        inverse_transform_ = transform.inverse ();
+        // Normals transform with the inverse transpose of the linear part
+        normal_to_world_ = transform.linear ().inverse ().transpose ();
+        normal_to_quantized_ = transform.linear ().transpose ();
+      }
+
+      /** \brief Get the transform from quantized coordinates to 3D space. */
+      inline const Eigen::Affine3f&
+      getTransform () const { return (transform_); }
+
+      /** \brief Get the transform from 3D space to quantized coordinates. */
+      inline const Eigen::Affine3f&
+      getInverseTransform () const { return (inverse_transform_); }
+
+      /** \brief Get the matrix that maps normals of the quantized frame to (unnormalized) 3D normals. */
+      inline const Eigen::Matrix3f&
+      getNormalToWorld () const { return (normal_to_world_); }
+
+      /** \brief Get the matrix that maps 3D normals to (unnormalized) normals of the quantized frame. */
+      inline const Eigen::Matrix3f&
+      getNormalToQuantized () const { return (normal_to_quantized_); }
+
+    private:
+      Eigen::Affine3f transform_;
+      Eigen::Affine3f inverse_transform_;
+      Eigen::Matrix3f normal_to_world_;
+      Eigen::Matrix3f normal_to_quantized_;
+
+    public:
+      EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+  };
+
+  /** \brief A point with 16-bit fixed-point coordinates (6 bytes), see \ref QuantizationParameters.
+    * \ingroup common
+    */
+  struct PointXYZQ16
+  {
+    int16_t qx;
+    int16_t qy;
+    int16_t qz;
+
+    inline PointXYZQ16 () : qx (0), qy (0), qz (0) {}
+  };
+
+  /** \brief A point with 16-bit fixed-point coordinates, an octahedral-encoded normal of
+    * 2 x 8 bits and a packed RGBA color (12 bytes instead of the 48 of PointXYZRGBNormal).
+    * The normal has an angular error below 1 degree.
+    * \ingroup common
+    */
+  struct PointXYZRGBNormalQ16
+  {
+    int16_t qx;
+    int16_t qy;
+    int16_t qz;
+    uint16_t normal_oct;
+    union
+    {
+      struct
+      {
+        uint8_t b;
+        uint8_t g;
+        uint8_t r;
+        uint8_t a;
+      };
+      uint32_t rgba;
+    };
+
+    inline PointXYZRGBNormalQ16 () : qx (0), qy (0), qz (0), normal_oct (0), rgba (0) {}
+  };
+
+  /** \brief A point with 16-bit fixed-point coordinates, a 16-bit fixed-point curvature, an
+    * octahedral-encoded normal of 2 x 16 bits and a packed RGBA color (16 bytes instead of the 48
+    * of PointXYZRGBNormal). The normal has an angular error below 0.01 degrees.
+    * \ingroup common
+    */
+  struct PointXYZRGBNormalQ32
+  {
+    int16_t qx;
+    int16_t qy;
+    int16_t qz;
+    uint16_t curvature_q;
+    uint32_t normal_oct;
+    union
+    {
+      struct
+      {
+        uint8_t b;
+        uint8_t g;
+        uint8_t r;
+        uint8_t a;
+      };
+      uint32_t rgba;
+    };
+
+    inline PointXYZRGBNormalQ32 () : qx (0), qy (0), qz (0), curvature_q (0), normal_oct (0), rgba (0) {}
+  };
+
+  inline std::ostream&
+  operator << (std::ostream& os, const PointXYZQ16& p)
+  {
+    os << "(" << p.qx << "," << p.qy << "," << p.qz << ")";
+    return (os);
+  }
+
+  inline std::ostream&
+  operator << (std::ostream& os, const PointXYZRGBNormalQ16& p)
+  {
+    os << "(" << p.qx << "," << p.qy << "," << p.qz << " - " << p.normal_oct << " - "
+       << static_cast<int> (p.r) << "," << static_cast<int> (p.g) << "," << static_cast<int> (p.b) << ")";
+    return (os);
+  }
+
+  inline std::ostream&
+  operator << (std::ostream& os, const PointXYZRGBNormalQ32& p)
+  {
+    os << "(" << p.qx << "," << p.qy << "," << p.qz << " - " << p.normal_oct << " - " << p.curvature_q << " - "
+       << static_cast<int> (p.r) << "," << static_cast<int> (p.g) << "," << static_cast<int> (p.b) << ")";
+    return (os);
+  }
+
+  /** \brief Encode a normal with octahedral mapping into two fixed-point components of Bits bits each.
+    * Zero and non-finite normals get the code of all ones, which is never produced for valid normals.
+    * \param[in] normal the normal to encode, it does not need to be normalized
+    * \ingroup common
+    */
+  template <int Bits> inline uint32_t
+  encodeOctahedralNormal (const Eigen::Vector3f &normal)
+  {
+    const uint32_t max_value = (1u << Bits) - 1;
+    const uint32_t invalid = (max_value << Bits) | max_value;
+    const float l1 = fabsf (normal[0]) + fabsf (normal[1]) + fabsf (normal[2]);
+    if (!pcl_isfinite (l1) || l1 == 0.0f)
+      return (invalid);
+
+    float u = normal[0] / l1, v = normal[1] / l1;
+    if (normal[2] < 0.0f)
+    {
+      // Fold the lower hemisphere over the diagonals of the octahedron
+      const float folded_u = (1.0f - fabsf (v)) * (u >= 0.0f ? 1.0f : -1.0f);
+      const float folded_v = (1.0f - fabsf (u)) * (v >= 0.0f ? 1.0f : -1.0f);
+      u = folded_u;
+      v = folded_v;
+    }
+    const uint32_t code_u = static_cast<uint32_t> (pcl_lrintf ((u * 0.5f + 0.5f) * static_cast<float> (max_value)));
+    const uint32_t code_v = static_cast<uint32_t> (pcl_lrintf ((v * 0.5f + 0.5f) * static_cast<float> (max_value)));
+    const uint32_t code = (code_v << Bits) | code_u;
+    // The (1, 1) corner is reserved; the (-1, -1) corner is the same direction (0, 0, -1)
+    return (code == invalid ? 0 : code);
+  }
+
+  /** \brief Decode a normal encoded by encodeOctahedralNormal. Returns a unit normal, or NaNs for
+    * the invalid code.
+    * \param[in] code the encoded normal
+    * \ingroup common
+    */
+  template <int Bits> inline Eigen::Vector3f
+  decodeOctahedralNormal (uint32_t code)
+  {
+    const uint32_t max_value = (1u << Bits) - 1;
+    if (code == ((max_value << Bits) | max_value))
+      return (Eigen::Vector3f::Constant (std::numeric_limits<float>::quiet_NaN ()));
+
+    float u = static_cast<float> (code & max_value) / static_cast<float> (max_value) * 2.0f - 1.0f;
+    float v = static_cast<float> ((code >> Bits) & max_value) / static_cast<float> (max_value) * 2.0f - 1.0f;
+    const float w = 1.0f - fabsf (u) - fabsf (v);
+    if (w < 0.0f)
+    {
+      const float unfolded_u = (1.0f - fabsf (v)) * (u >= 0.0f ? 1.0f : -1.0f);
+      const float unfolded_v = (1.0f - fabsf (u)) * (v >= 0.0f ? 1.0f : -1.0f);
+      u = unfolded_u;
+      v = unfolded_v;
+    }
+    return (Eigen::Vector3f (u, v, w).normalized ());
+  }
+
+  /** \brief Get the 3D position of a quantized point, or NaNs if the point is invalid.
+    * \param[in] point a point with the fields qx, qy and qz
+    * \param[in] params the quantization parameters of the cloud of the point
+    * \ingroup common
+    */
+  template <typename PointQT> inline Eigen::Vector3f
+  dequantizeXYZ (const PointQT &point, const QuantizationParameters &params)
+  {
+    if (point.qx == QUANTIZED_INVALID_COORDINATE)
+      return (Eigen::Vector3f::Constant (std::numeric_limits<float>::quiet_NaN ()));
+    return (params.getTransform () * Eigen::Vector3f (point.qx, point.qy, point.qz));
+  }
+
+  /** \brief Set the quantized coordinates of a point. Non-finite positions give an invalid point,
+    * positions outside of the range of the parameters are clamped to it.
+    * \param[in] xyz the 3D position
+    * \param[in] params the quantization parameters of the cloud of the point
+    * \param[out] point a point with the fields qx, qy and qz
+    * \ingroup common
+    */
+  template <typename PointQT> inline void
+  quantizeXYZ (const Eigen::Vector3f &xyz, const QuantizationParameters &params, PointQT &point)
+  {
+    const Eigen::Vector3f q = params.getInverseTransform () * xyz;
+    if (!pcl_isfinite (q[0]) || !pcl_isfinite (q[1]) || !pcl_isfinite (q[2]))
+    {
+      point.qx = point.qy = point.qz = QUANTIZED_INVALID_COORDINATE;
+      return;
+    }
+    const float limit = static_cast<float> (QUANTIZED_MAX_COORDINATE);
+    point.qx = static_cast<int16_t> (pcl_lrintf ((std::min) (limit, (std::max) (-limit, q[0]))));
+    point.qy = static_cast<int16_t> (pcl_lrintf ((std::min) (limit, (std::max) (-limit, q[1]))));
+    point.qz = static_cast<int16_t> (pcl_lrintf ((std::min) (limit, (std::max) (-limit, q[2]))));
+  }
+
+  /** \brief Get the 3D normal of a quantized point, or NaNs if it has none. */
+  inline Eigen::Vector3f
+  dequantizeNormal (const PointXYZRGBNormalQ16 &point, const QuantizationParameters &params)
+  {
+    return ((params.getNormalToWorld () * decodeOctahedralNormal<8> (point.normal_oct)).normalized ());
+  }
+
+  /** \brief Get the 3D normal of a quantized point, or NaNs if it has none. */
+  inline Eigen::Vector3f
+  dequantizeNormal (const PointXYZRGBNormalQ32 &point, const QuantizationParameters &params)
+  {
+    return ((params.getNormalToWorld () * decodeOctahedralNormal<16> (point.normal_oct)).normalized ());
+  }
+
+  /** \brief Set the normal of a quantized point from a 3D normal. */
+  inline void
+  quantizeNormal (const Eigen::Vector3f &normal, const QuantizationParameters &params, PointXYZRGBNormalQ16 &point)
+  {
+    point.normal_oct = static_cast<uint16_t> (encodeOctahedralNormal<8> (params.getNormalToQuantized () * normal));
+  }
+
+  /** \brief Set the normal of a quantized point from a 3D normal. */
+  inline void
+  quantizeNormal (const Eigen::Vector3f &normal, const QuantizationParameters &params, PointXYZRGBNormalQ32 &point)
+  {
+    point.normal_oct = encodeOctahedralNormal<16> (params.getNormalToQuantized () * normal);
+  }
+
+  /** \brief Get the curvature of a quantized point, or NaN if it has none. */
+  inline float
+  dequantizeCurvature (const PointXYZRGBNormalQ32 &point)
+  {
+    if (point.curvature_q == 0xffff)
+      return (std::numeric_limits<float>::quiet_NaN ());
+    return (static_cast<float> (point.curvature_q) / 65534.0f);
+  }
+
+  /** \brief Set the curvature of a quantized point. Curvatures are clamped to [0, 1]. */
+  inline void
+  quantizeCurvature (float curvature, PointXYZRGBNormalQ32 &point)
+  {
+    if (!pcl_isfinite (curvature))
+      point.curvature_q = 0xffff;
+    else
+      point.curvature_q = static_cast<uint16_t> (pcl_lrintf ((std::min) (1.0f, (std::max) (0.0f, curvature)) * 65534.0f));
+  }
+}
+
+POINT_CLOUD_REGISTER_POINT_STRUCT (pcl::PointXYZQ16,
+    (int16_t, qx, qx)
+    (int16_t, qy, qy)
+    (int16_t, qz, qz)
+)
+
+POINT_CLOUD_REGISTER_POINT_STRUCT (pcl::PointXYZRGBNormalQ16,
+    (int16_t, qx, qx)
+    (int16_t, qy, qy)
+    (int16_t, qz, qz)
+    (uint16_t, normal_oct, normal_oct)
+    (uint32_t, rgba, rgba)
+)
+
+POINT_CLOUD_REGISTER_POINT_STRUCT (pcl::PointXYZRGBNormalQ32,
+    (int16_t, qx, qx)
+    (int16_t, qy, qy)
+    (int16_t, qz, qz)
+    (uint16_t, curvature_q, curvature_q)
+    (uint32_t, normal_oct, normal_oct)
+    (uint32_t, rgba, rgba)
+)
+
+#endif  //#ifndef PCL_POINT_TYPES_QUANTIZED_H_
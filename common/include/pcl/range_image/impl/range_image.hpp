@@ -233,24 +233,49 @@ RangeImage::doZBuffer (const PointCloudType& point_cloud, float noise_level, flo
   const typename pcl::PointCloud<PointType2>::VectorType &points2 = point_cloud.points;
   
   unsigned int size = width*height;
-  int* counters = new int[size];
-  ERASE_ARRAY (counters, size);
+  scratch_.zbuffer_counters.assign (size, 0);
+  int* counters = size > 0 ? &scratch_.zbuffer_counters[0] : NULL;
   
   top=height; right=-1; bottom=-1; left=width;
   
-  float x_real, y_real, range_of_current_point;
-  int x, y;
-  for (typename pcl::PointCloud<PointType2>::VectorType::const_iterator it=points2.begin (); it!=points2.end (); ++it)
+  // Project all points in parallel first. Points that do not make it into the image get a NaN range.
+  // The z-buffer itself is then filled in the order of the cloud, so that the averaging of close
+  // ranges and the interpolation of empty neighbors do not depend on the number of threads.
+  int no_of_points = static_cast<int> (points2.size ());
+  scratch_.zbuffer_projections.resize (3*no_of_points);
+  float* projections = no_of_points > 0 ? &scratch_.zbuffer_projections[0] : NULL;
+  # pragma omp parallel for num_threads (max_no_of_threads) default (shared) schedule (static)
+  for (int point_idx=0; point_idx<no_of_points; ++point_idx)
   {
-    if (!isFinite (*it))  // Check for NAN etc
+    float* projection = projections + 3*point_idx;
+    projection[2] = std::numeric_limits<float>::quiet_NaN ();
+    const PointType2& point = points2[point_idx];
+    if (!isFinite (point))  // Check for NAN etc
       continue;
-    Vector3fMapConst current_point = it->getVector3fMap ();
     
-    this->getImagePoint (current_point, x_real, y_real, range_of_current_point);
+    float x_real, y_real, range_of_current_point;
+    int x, y;
+    this->getImagePoint (point.getVector3fMap (), x_real, y_real, range_of_current_point);
     this->real2DToInt2D (x_real, y_real, x, y);
     
     if (range_of_current_point < min_range|| !isInImage (x, y))
       continue;
+    projection[0] = x_real;
+    projection[1] = y_real;
+    projection[2] = range_of_current_point;
+  }
+  
+  float x_real, y_real, range_of_current_point;
+  int x, y;
+  for (int point_idx=0; point_idx<no_of_points; ++point_idx)
+  {
+    const float* projection = projections + 3*point_idx;
+    range_of_current_point = projection[2];
+    if (pcl_isnan (range_of_current_point))
+      continue;
+    x_real = projection[0];
+    y_real = projection[1];
+    this->real2DToInt2D (x_real, y_real, x, y);
     //std::cout << " ("<<current_point[0]<<", "<<current_point[1]<<", "<<current_point[2]<<") falls into pixel "<<x<<","<<y<<".\n";
     
     // Do some minor interpolation by checking the three closest neighbors to the point, that are not filled yet.
@@ -318,8 +343,6 @@ RangeImage::doZBuffer (const PointCloudType& point_cloud, float noise_level, flo
       range_at_image_point += (range_of_current_point-range_at_image_point)/counter;
     }
   }
-  
-  delete[] counters;
 }
 
 /////////////////////////////////////////////////////////////////////////
@@ -781,6 +781,20 @@ namespace pcl
       PointWithRange unobserved_point;         /**< This point is used to be able to return
                                                 *   a reference to a non-existing point */
       
+      /** Temporary memory of doZBuffer and cropImage, kept to reuse it for the next image.
+        * It is neither copied nor assigned together with the range image. */
+      struct ScratchBuffers
+      {
+        ScratchBuffers () : zbuffer_counters (), zbuffer_projections (), crop_points () {}
+        ScratchBuffers (const ScratchBuffers&) : zbuffer_counters (), zbuffer_projections (), crop_points () {}
+        ScratchBuffers& operator= (const ScratchBuffers&) { return (*this); }
+        
+        std::vector<int> zbuffer_counters;       /**< Per pixel point counters of doZBuffer */
+        std::vector<float> zbuffer_projections;  /**< Image position and range of every input point of doZBuffer */
+        VectorType crop_points;                  /**< The points before the last cropImage */
+      };
+      ScratchBuffers scratch_;
+      
       // =====PROTECTED METHODS=====
 
 
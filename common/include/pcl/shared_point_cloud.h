@@ -0,0 +1,139 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Point Cloud Library (PCL) - www.pointclouds.org
+ *  Copyright (c) 2013-, Open Perception, Inc.
+ *
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder(s) nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef PCL_SHARED_POINT_CLOUD_H_
+#define PCL_SHARED_POINT_CLOUD_H_
+
+#include <pcl/point_cloud.h>
+
+namespace pcl
+{
+  /** \brief Copy-on-write handle to a point cloud.
+    *
+    * Copies of a SharedPointCloud, and the pointers returned by \ref getConstPtr, share one
+    * buffer of points. The points are copied only when a handle asks for write access while the
+    * buffer is still shared, so a frame passed through a graph of consumers is copied only by
+    * the consumers that modify it:
+    * \code
+    * pcl::SharedPointCloud<pcl::PointXYZ> frame (cloud_ptr);
+    * filter.setInputCloud (frame.getConstPtr ());      // no copy
+    * pcl::SharedPointCloud<pcl::PointXYZ> mine = frame; // no copy
+    * mine.getWritable ().points[0].x = 0;               // copies, frame is unchanged
+    * \endcode
+    *
+    * Handles are not synchronized: one handle must not be used from several threads at once,
+    * but different handles to the same buffer may.
+    * \ingroup common
+    */
+  template <typename PointT>
+  class SharedPointCloud
+  {
+    public:
+      typedef pcl::PointCloud<PointT> Cloud;
+      typedef typename Cloud::Ptr CloudPtr;
+      typedef typename Cloud::ConstPtr CloudConstPtr;
+
+      /** \brief Empty cloud. */
+      SharedPointCloud () : cloud_ (new Cloud) {}
+
+      /** \brief Take over a cloud without copying it. The cloud must not be modified through
+        * other pointers afterwards.
+        * \param[in] cloud the cloud to share
+        */
+      explicit SharedPointCloud (const CloudPtr &cloud) : cloud_ (cloud ? cloud : CloudPtr (new Cloud)) {}
+
+      /** \brief Read access to the cloud. */
+      inline const Cloud&
+      operator* () const { return (*cloud_); }
+
+      /** \brief Read access to the cloud. */
+      inline const Cloud*
+      operator-> () const { return (cloud_.get ()); }
+
+      /** \brief Get a pointer to the shared cloud, e.g. for setInputCloud. The points are not
+        * copied; they stay valid and unchanged as long as the pointer is held.
+        */
+      inline CloudConstPtr
+      getConstPtr () const { return (cloud_); }
+
+      /** \brief Write access to the cloud. The points are copied first if the buffer is shared
+        * with other handles or with pointers returned by \ref getConstPtr.
+        */
+      inline Cloud&
+      getWritable ()
+      {
+        if (!cloud_.unique ())
+          cloud_.reset (new Cloud (*cloud_));
+        return (*cloud_);
+      }
+
+      /** \brief Exchange the contents of the handle with a plain cloud, without copying points
+        * unless the buffer of the handle is shared.
+        * \param[in,out] cloud the cloud to exchange the contents with
+        */
+      inline void
+      swap (Cloud &cloud)
+      {
+        Cloud &own = getWritable ();
+        own.points.swap (cloud.points);
+        std::swap (own.header, cloud.header);
+        std::swap (own.width, cloud.width);
+        std::swap (own.height, cloud.height);
+        std::swap (own.is_dense, cloud.is_dense);
+        std::swap (own.sensor_origin_, cloud.sensor_origin_);
+        std::swap (own.sensor_orientation_, cloud.sensor_orientation_);
+        detail::getMapping (own).swap (detail::getMapping (cloud));
+      }
+
+      /** \brief Whether the buffer is shared with other handles or pointers. */
+      inline bool
+      isShared () const { return (!cloud_.unique ()); }
+
+      /** \brief Number of points. */
+      inline size_t
+      size () const { return (cloud_->points.size ()); }
+
+      /** \brief Whether the cloud has no points. */
+      inline bool
+      empty () const { return (cloud_->points.empty ()); }
+
+    private:
+      CloudPtr cloud_;
+  };
+}
+
+#endif  //#ifndef PCL_SHARED_POINT_CLOUD_H_
@@ -0,0 +1,89 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Point Cloud Library (PCL) - www.pointclouds.org
+ *  Copyright (c) 2013-, Open Perception, Inc.
+ *
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder(s) nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <pcl/common/morton.h>
+
+///////////////////////////////////////////////////////////////////////////////////////////
+void
+pcl::sortMortonCodes (std::vector<uint64_t> &codes, std::vector<int> &permutation)
+{
+  const size_t nr_codes = codes.size ();
+  permutation.resize (nr_codes);
+  for (size_t i = 0; i < nr_codes; ++i)
+    permutation[i] = static_cast<int> (i);
+  if (nr_codes < 2)
+    return;
+
+  // 6 passes of 11 bits cover the 63-bit codes and MORTON_CODE_INVALID
+  const int digit_bits = 11;
+  const int nr_buckets = 1 << digit_bits;
+  const int nr_passes = 6;
+
+  // All histograms in one pass over the codes
+  std::vector<size_t> histograms (nr_passes * nr_buckets, 0);
+  for (size_t i = 0; i < nr_codes; ++i)
+    for (int pass = 0; pass < nr_passes; ++pass)
+      ++histograms[pass * nr_buckets + ((codes[i] >> (pass * digit_bits)) & (nr_buckets - 1))];
+
+  std::vector<uint64_t> codes_tmp (nr_codes);
+  std::vector<int> permutation_tmp (nr_codes);
+  for (int pass = 0; pass < nr_passes; ++pass)
+  {
+    size_t *histogram = &histograms[pass * nr_buckets];
+    const int shift = pass * digit_bits;
+
+    // Skip digits which are the same for all codes, e.g. the high bits of small clouds
+    if (histogram[(codes[0] >> shift) & (nr_buckets - 1)] == nr_codes)
+      continue;
+
+    size_t offset = 0;
+    for (int b = 0; b < nr_buckets; ++b)
+    {
+      const size_t count = histogram[b];
+      histogram[b] = offset;
+      offset += count;
+    }
+    for (size_t i = 0; i < nr_codes; ++i)
+    {
+      const size_t dst = histogram[(codes[i] >> shift) & (nr_buckets - 1)]++;
+      codes_tmp[dst] = codes[i];
+      permutation_tmp[dst] = permutation[i];
+    }
+    codes.swap (codes_tmp);
+    permutation.swap (permutation_tmp);
+  }
+}
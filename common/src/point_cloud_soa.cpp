@@ -0,0 +1,256 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Point Cloud Library (PCL) - www.pointclouds.org
+ *  Copyright (c) 2013-, Open Perception, Inc.
+ *
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder(s) nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <pcl/common/point_cloud_soa.h>
+#include <algorithm>
+#include <cfloat>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+///////////////////////////////////////////////////////////////////////////////////////////
+void
+pcl::PointCloudSoA::resize (size_t n)
+{
+  const size_t stride = (n + 3) & ~static_cast<size_t> (3);
+  if (stride != stride_)
+  {
+    FieldArray xyz (3 * stride, 0.0f);
+    const size_t keep = std::min (n, size_);
+    for (size_t d = 0; d < 3; ++d)
+      std::copy (xyz_.begin () + d * stride_, xyz_.begin () + d * stride_ + keep, xyz.begin () + d * stride);
+    xyz_.swap (xyz);
+  }
+  else
+  {
+    // Keep the padding zero when shrinking within the same stride
+    for (size_t d = 0; d < 3; ++d)
+      for (size_t i = n; i < size_; ++i)
+        xyz_[d * stride_ + i] = 0.0f;
+  }
+  for (size_t f = 0; f < fields_.size (); ++f)
+  {
+    fields_[f].second.resize (n);
+    fields_[f].second.resize (stride, 0.0f);
+  }
+  size_ = n;
+  stride_ = stride;
+  width = static_cast<uint32_t> (n);
+  height = 1;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+void
+pcl::PointCloudSoA::clear ()
+{
+  xyz_.clear ();
+  fields_.clear ();
+  size_ = stride_ = 0;
+  width = height = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+float*
+pcl::PointCloudSoA::addField (const std::string &name)
+{
+  float *values = getField (name);
+  if (values)
+    return (values);
+  fields_.push_back (std::make_pair (name, FieldArray (stride_, 0.0f)));
+  return (fields_.back ().second.empty () ? NULL : &fields_.back ().second[0]);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+float*
+pcl::PointCloudSoA::getField (const std::string &name)
+{
+  for (size_t f = 0; f < fields_.size (); ++f)
+    if (fields_[f].first == name)
+      return (fields_[f].second.empty () ? NULL : &fields_[f].second[0]);
+  return (NULL);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+const float*
+pcl::PointCloudSoA::getField (const std::string &name) const
+{
+  for (size_t f = 0; f < fields_.size (); ++f)
+    if (fields_[f].first == name)
+      return (fields_[f].second.empty () ? NULL : &fields_[f].second[0]);
+  return (NULL);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+std::vector<std::string>
+pcl::PointCloudSoA::getFieldNames () const
+{
+  std::vector<std::string> names (fields_.size ());
+  for (size_t f = 0; f < fields_.size (); ++f)
+    names[f] = fields_[f].first;
+  return (names);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+void
+pcl::getMinMax3D (const PointCloudSoA &soa, Eigen::Vector4f &min_pt, Eigen::Vector4f &max_pt)
+{
+  const float *x = soa.x (), *y = soa.y (), *z = soa.z ();
+  const size_t n = soa.size ();
+  float min_p[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+  float max_p[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+  size_t i = 0;
+#if defined(__SSE2__)
+  __m128 min_x = _mm_set1_ps (FLT_MAX), min_y = min_x, min_z = min_x;
+  __m128 max_x = _mm_set1_ps (-FLT_MAX), max_y = max_x, max_z = max_x;
+  for (; i + 4 <= n; i += 4)
+  {
+    __m128 px = _mm_load_ps (x + i), py = _mm_load_ps (y + i), pz = _mm_load_ps (z + i);
+    __m128 lo_x = px, lo_y = py, lo_z = pz, hi_x = px, hi_y = py, hi_z = pz;
+    if (!soa.is_dense)
+    {
+      // v - v is 0 for finite values and NaN for NaN and Inf
+      const __m128 zero = _mm_setzero_ps ();
+      const __m128 valid = _mm_and_ps (_mm_and_ps (_mm_cmpeq_ps (_mm_sub_ps (px, px), zero),
+                                                   _mm_cmpeq_ps (_mm_sub_ps (py, py), zero)),
+                                       _mm_cmpeq_ps (_mm_sub_ps (pz, pz), zero));
+      const __m128 big = _mm_andnot_ps (valid, _mm_set1_ps (FLT_MAX));
+      const __m128 small = _mm_andnot_ps (valid, _mm_set1_ps (-FLT_MAX));
+      lo_x = _mm_or_ps (_mm_and_ps (valid, px), big);
+      lo_y = _mm_or_ps (_mm_and_ps (valid, py), big);
+      lo_z = _mm_or_ps (_mm_and_ps (valid, pz), big);
+      hi_x = _mm_or_ps (_mm_and_ps (valid, px), small);
+      hi_y = _mm_or_ps (_mm_and_ps (valid, py), small);
+      hi_z = _mm_or_ps (_mm_and_ps (valid, pz), small);
+    }
+    min_x = _mm_min_ps (min_x, lo_x); max_x = _mm_max_ps (max_x, hi_x);
+    min_y = _mm_min_ps (min_y, lo_y); max_y = _mm_max_ps (max_y, hi_y);
+    min_z = _mm_min_ps (min_z, lo_z); max_z = _mm_max_ps (max_z, hi_z);
+  }
+  float lo[3][4], hi[3][4];
+  _mm_storeu_ps (lo[0], min_x); _mm_storeu_ps (lo[1], min_y); _mm_storeu_ps (lo[2], min_z);
+  _mm_storeu_ps (hi[0], max_x); _mm_storeu_ps (hi[1], max_y); _mm_storeu_ps (hi[2], max_z);
+  for (int d = 0; d < 3; ++d)
+    for (int l = 0; l < 4; ++l)
+    {
+      min_p[d] = std::min (min_p[d], lo[d][l]);
+      max_p[d] = std::max (max_p[d], hi[d][l]);
+    }
+#endif
+  for (; i < n; ++i)
+  {
+    if (!soa.is_dense && (!pcl_isfinite (x[i]) || !pcl_isfinite (y[i]) || !pcl_isfinite (z[i])))
+      continue;
+    min_p[0] = std::min (min_p[0], x[i]); max_p[0] = std::max (max_p[0], x[i]);
+    min_p[1] = std::min (min_p[1], y[i]); max_p[1] = std::max (max_p[1], y[i]);
+    min_p[2] = std::min (min_p[2], z[i]); max_p[2] = std::max (max_p[2], z[i]);
+  }
+  // Same homogeneous coordinate as getMinMax3D on a point cloud: 1 if any point was valid
+  const bool found = min_p[0] <= max_p[0];
+  min_pt = Eigen::Vector4f (min_p[0], min_p[1], min_p[2], found ? 1.0f : FLT_MAX);
+  max_pt = Eigen::Vector4f (max_p[0], max_p[1], max_p[2], found ? 1.0f : -FLT_MAX);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+int
+pcl::getPointsInBox (const PointCloudSoA &soa, const Eigen::Vector4f &min_pt,
+                     const Eigen::Vector4f &max_pt, std::vector<int> &indices)
+{
+  const float *x = soa.x (), *y = soa.y (), *z = soa.z ();
+  const size_t n = soa.size ();
+  indices.resize (n);
+  int l = 0;
+  size_t i = 0;
+#if defined(__SSE2__)
+  const __m128 lo_x = _mm_set1_ps (min_pt[0]), lo_y = _mm_set1_ps (min_pt[1]), lo_z = _mm_set1_ps (min_pt[2]);
+  const __m128 hi_x = _mm_set1_ps (max_pt[0]), hi_y = _mm_set1_ps (max_pt[1]), hi_z = _mm_set1_ps (max_pt[2]);
+  for (; i + 4 <= n; i += 4)
+  {
+    const __m128 px = _mm_load_ps (x + i), py = _mm_load_ps (y + i), pz = _mm_load_ps (z + i);
+    // Ordered comparisons are false for NaN
+    __m128 inside = _mm_and_ps (_mm_cmpge_ps (px, lo_x), _mm_cmple_ps (px, hi_x));
+    inside = _mm_and_ps (inside, _mm_and_ps (_mm_cmpge_ps (py, lo_y), _mm_cmple_ps (py, hi_y)));
+    inside = _mm_and_ps (inside, _mm_and_ps (_mm_cmpge_ps (pz, lo_z), _mm_cmple_ps (pz, hi_z)));
+    int mask = _mm_movemask_ps (inside);
+    while (mask)
+    {
+      const int lane = (mask & 1) ? 0 : (mask & 2) ? 1 : (mask & 4) ? 2 : 3;
+      indices[l++] = static_cast<int> (i) + lane;
+      mask &= mask - 1;
+    }
+  }
+#endif
+  for (; i < n; ++i)
+  {
+    if (x[i] >= min_pt[0] && x[i] <= max_pt[0] &&
+        y[i] >= min_pt[1] && y[i] <= max_pt[1] &&
+        z[i] >= min_pt[2] && z[i] <= max_pt[2])
+      indices[l++] = static_cast<int> (i);
+  }
+  indices.resize (l);
+  return (l);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+void
+pcl::getSquaredDistances (const PointCloudSoA &soa, size_t begin, size_t end,
+                          const Eigen::Vector3f &query, float *distances)
+{
+  const float *x = soa.x (), *y = soa.y (), *z = soa.z ();
+  size_t i = begin;
+#if defined(__SSE2__)
+  // Scalar head up to the next aligned block
+  for (; i < end && (i & 3); ++i)
+  {
+    const float dx = x[i] - query[0], dy = y[i] - query[1], dz = z[i] - query[2];
+    distances[i - begin] = dx * dx + dy * dy + dz * dz;
+  }
+  const __m128 qx = _mm_set1_ps (query[0]), qy = _mm_set1_ps (query[1]), qz = _mm_set1_ps (query[2]);
+  for (; i + 4 <= end; i += 4)
+  {
+    const __m128 dx = _mm_sub_ps (_mm_load_ps (x + i), qx);
+    const __m128 dy = _mm_sub_ps (_mm_load_ps (y + i), qy);
+    const __m128 dz = _mm_sub_ps (_mm_load_ps (z + i), qz);
+    _mm_storeu_ps (distances + (i - begin),
+                   _mm_add_ps (_mm_add_ps (_mm_mul_ps (dx, dx), _mm_mul_ps (dy, dy)), _mm_mul_ps (dz, dz)));
+  }
+#endif
+  for (; i < end; ++i)
+  {
+    const float dx = x[i] - query[0], dy = y[i] - query[1], dz = z[i] - query[2];
+    distances[i - begin] = dx * dx + dy * dy + dz * dz;
+  }
+}
@@ -0,0 +1,531 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Point Cloud Library (PCL) - www.pointclouds.org
+ *  Copyright (c) 2013-, Open Perception, Inc.
+ *
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder(s) nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <pcl/common/profiler.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/tss.hpp>
+#if defined(_WIN32)
+# include <windows.h>
+#elif defined(__APPLE__)
+# include <mach/mach_time.h>
+#else
+# include <time.h>
+#endif
+
+///////////////////////////////////////////////////////////////////////////////////////////
+uint64_t
+pcl::profiling::getTimeNanoseconds ()
+{
+#if defined(_WIN32)
+  static LARGE_INTEGER frequency = { 0 };
+  if (frequency.QuadPart == 0)
+    QueryPerformanceFrequency (&frequency);
+  LARGE_INTEGER counter;
+  QueryPerformanceCounter (&counter);
+  return (static_cast<uint64_t> (static_cast<double> (counter.QuadPart) * 1e9 / static_cast<double> (frequency.QuadPart)));
+#elif defined(__APPLE__)
+  static mach_timebase_info_data_t timebase = { 0, 0 };
+  if (timebase.denom == 0)
+    mach_timebase_info (&timebase);
+  return (mach_absolute_time () * timebase.numer / timebase.denom);
+#else
+  timespec now;
+  clock_gettime (CLOCK_MONOTONIC, &now);
+  return (static_cast<uint64_t> (now.tv_sec) * 1000000000ULL + static_cast<uint64_t> (now.tv_nsec));
+#endif
+}
+
+namespace pcl
+{
+  namespace profiling
+  {
+    namespace detail
+    {
+      /** \brief Number of histogram bins: four per power of two of the duration in ns. */
+      const int HISTOGRAM_BINS = 256;
+
+      inline int
+      getHistogramBin (uint64_t ns)
+      {
+        if (ns < 4)
+          return (static_cast<int> (ns));
+        int exponent = 63;
+        while (!(ns >> exponent))
+          --exponent;
+        return (4 * (exponent - 1) + static_cast<int> ((ns >> (exponent - 2)) & 3));
+      }
+
+      /** \brief Center of the durations in ns which fall into \a bin. */
+      inline double
+      getHistogramBinCenter (int bin)
+      {
+        if (bin < 4)
+          return (bin);
+        const int exponent = bin / 4 + 1;
+        return ((4 + bin % 4 + 0.5) * std::pow (2.0, exponent - 2));
+      }
+
+      struct ScopeNode
+      {
+        ScopeNode (const char *node_name, ScopeNode *parent_node)
+          : name (node_name), parent (parent_node), children ()
+          , count (0), total_ns (0), min_ns (std::numeric_limits<uint64_t>::max ()), max_ns (0)
+          , histogram (HISTOGRAM_BINS, 0)
+        {}
+
+        ~ScopeNode ()
+        {
+          for (size_t c = 0; c < children.size (); ++c)
+            delete children[c];
+        }
+
+        void
+        clear ()
+        {
+          count = total_ns = max_ns = 0;
+          min_ns = std::numeric_limits<uint64_t>::max ();
+          std::fill (histogram.begin (), histogram.end (), 0);
+          for (size_t c = 0; c < children.size (); ++c)
+            children[c]->clear ();
+        }
+
+        std::string name;
+        ScopeNode *parent;
+        std::vector<ScopeNode*> children;
+        uint64_t count;
+        uint64_t total_ns;
+        uint64_t min_ns;
+        uint64_t max_ns;
+        std::vector<uint64_t> histogram;
+      };
+
+      struct TraceEvent
+      {
+        const ScopeNode *node;
+        uint64_t start_ns;
+        uint64_t duration_ns;
+      };
+
+      /** \brief Everything recorded by one thread. Only the owning thread modifies it,
+        * under \a mutex, so that the registry can read it concurrently.
+        */
+      class ThreadProfile
+      {
+        public:
+          explicit ThreadProfile (int thread_id)
+            : id (thread_id), mutex (), root ("", NULL), current (&root)
+            , counters (), events (), dropped_events (0)
+          {}
+
+          int id;
+          boost::mutex mutex;
+          ScopeNode root;
+          ScopeNode *current;
+          std::vector<std::pair<std::string, int64_t> > counters;
+          std::vector<TraceEvent> events;
+          size_t dropped_events;
+      };
+
+      /** \brief Profiles are owned by the registry and outlive their threads. */
+      inline void
+      keepThreadProfile (ThreadProfile*) {}
+
+      inline std::string
+      escapeJSON (const std::string &text)
+      {
+        std::string escaped;
+        escaped.reserve (text.size ());
+        for (size_t i = 0; i < text.size (); ++i)
+        {
+          const char c = text[i];
+          if (c == '"' || c == '\\')
+          {
+            escaped += '\\';
+            escaped += c;
+          }
+          else if (static_cast<unsigned char> (c) < 0x20)
+            escaped += ' ';
+          else
+            escaped += c;
+        }
+        return (escaped);
+      }
+
+      inline std::string
+      getPath (const ScopeNode *node)
+      {
+        std::string path = node->name;
+        for (node = node->parent; node && node->parent; node = node->parent)
+          path = node->name + "/" + path;
+        return (path);
+      }
+
+      struct MergedScope
+      {
+        MergedScope () : count (0), total_ns (0), min_ns (std::numeric_limits<uint64_t>::max ()), max_ns (0),
+                         histogram (HISTOGRAM_BINS, 0) {}
+        uint64_t count, total_ns, min_ns, max_ns;
+        std::vector<uint64_t> histogram;
+      };
+
+      void
+      mergeScopes (const ScopeNode *node, std::map<std::string, MergedScope> &merged)
+      {
+        for (size_t c = 0; c < node->children.size (); ++c)
+        {
+          const ScopeNode *child = node->children[c];
+          if (child->count > 0)
+          {
+            MergedScope &scope = merged[getPath (child)];
+            scope.count += child->count;
+            scope.total_ns += child->total_ns;
+            scope.min_ns = std::min (scope.min_ns, child->min_ns);
+            scope.max_ns = std::max (scope.max_ns, child->max_ns);
+            for (int b = 0; b < HISTOGRAM_BINS; ++b)
+              scope.histogram[b] += child->histogram[b];
+          }
+          mergeScopes (child, merged);
+        }
+      }
+
+      inline double
+      getQuantile (const std::vector<uint64_t> &histogram, uint64_t count, double quantile)
+      {
+        const uint64_t rank = std::max<uint64_t> (1, static_cast<uint64_t> (std::ceil (quantile * static_cast<double> (count))));
+        uint64_t seen = 0;
+        for (int b = 0; b < HISTOGRAM_BINS; ++b)
+        {
+          seen += histogram[b];
+          if (seen >= rank)
+            return (getHistogramBinCenter (b));
+        }
+        return (0);
+      }
+    }
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+struct pcl::profiling::Registry::Impl
+{
+  Impl () : enabled (true), trace_enabled (false), max_events_per_thread (1000000),
+            origin_ns (getTimeNanoseconds ()), mutex (), profiles (),
+            thread_profile (&detail::keepThreadProfile)
+  {}
+
+  bool enabled;
+  bool trace_enabled;
+  size_t max_events_per_thread;
+  uint64_t origin_ns;
+  /** \brief Protects profiles. */
+  mutable boost::mutex mutex;
+  std::vector<detail::ThreadProfile*> profiles;
+  boost::thread_specific_ptr<detail::ThreadProfile> thread_profile;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////
+pcl::profiling::Registry&
+pcl::profiling::Registry::getInstance ()
+{
+  // Never destroyed, so that threads which outlive main can still record
+  static Registry *registry = new Registry;
+  return (*registry);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+pcl::profiling::Registry::Registry () : impl_ (new Impl)
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+pcl::profiling::Registry::~Registry ()
+{
+  for (size_t p = 0; p < impl_->profiles.size (); ++p)
+    delete impl_->profiles[p];
+  delete impl_;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+void
+pcl::profiling::Registry::setEnabled (bool enabled)
+{
+  impl_->enabled = enabled;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+bool
+pcl::profiling::Registry::isEnabled () const
+{
+  return (impl_->enabled);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+void
+pcl::profiling::Registry::setTraceEnabled (bool enabled, size_t max_events_per_thread)
+{
+  impl_->trace_enabled = enabled;
+  impl_->max_events_per_thread = max_events_per_thread;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+pcl::profiling::detail::ThreadProfile*
+pcl::profiling::Registry::getThreadProfile ()
+{
+  detail::ThreadProfile *profile = impl_->thread_profile.get ();
+  if (!profile)
+  {
+    boost::mutex::scoped_lock lock (impl_->mutex);
+    profile = new detail::ThreadProfile (static_cast<int> (impl_->profiles.size ()));
+    impl_->profiles.push_back (profile);
+    impl_->thread_profile.reset (profile);
+  }
+  return (profile);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+pcl::profiling::detail::ThreadProfile*
+pcl::profiling::Registry::beginScope (const char *name)
+{
+  if (!impl_->enabled)
+    return (NULL);
+  if (!name || !*name)
+    name = "(unnamed)";
+  detail::ThreadProfile *profile = getThreadProfile ();
+
+  // Only this thread adds children, so they can be searched without locking
+  std::vector<detail::ScopeNode*> &children = profile->current->children;
+  for (size_t c = 0; c < children.size (); ++c)
+    if (children[c]->name == name)
+    {
+      profile->current = children[c];
+      return (profile);
+    }
+
+  boost::mutex::scoped_lock lock (profile->mutex);
+  children.push_back (new detail::ScopeNode (name, profile->current));
+  profile->current = children.back ();
+  return (profile);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+void
+pcl::profiling::Registry::endScope (detail::ThreadProfile *profile, uint64_t start_ns)
+{
+  const uint64_t duration_ns = getTimeNanoseconds () - start_ns;
+  boost::mutex::scoped_lock lock (profile->mutex);
+  detail::ScopeNode *node = profile->current;
+  ++node->count;
+  node->total_ns += duration_ns;
+  node->min_ns = std::min (node->min_ns, duration_ns);
+  node->max_ns = std::max (node->max_ns, duration_ns);
+  ++node->histogram[detail::getHistogramBin (duration_ns)];
+  if (impl_->trace_enabled)
+  {
+    if (profile->events.size () < impl_->max_events_per_thread)
+    {
+      detail::TraceEvent event = { node, start_ns, duration_ns };
+      profile->events.push_back (event);
+    }
+    else
+      ++profile->dropped_events;
+  }
+  if (node->parent)
+    profile->current = node->parent;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+void
+pcl::profiling::Registry::addToCounter (const char *name, int64_t value)
+{
+  if (!impl_->enabled)
+    return;
+  detail::ThreadProfile *profile = getThreadProfile ();
+  boost::mutex::scoped_lock lock (profile->mutex);
+  for (size_t c = 0; c < profile->counters.size (); ++c)
+    if (profile->counters[c].first == name)
+    {
+      profile->counters[c].second += value;
+      return;
+    }
+  profile->counters.push_back (std::make_pair (std::string (name), value));
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+void
+pcl::profiling::Registry::getStatistics (std::vector<ScopeStatistics> &statistics) const
+{
+  std::map<std::string, detail::MergedScope> merged;
+  {
+    boost::mutex::scoped_lock lock (impl_->mutex);
+    for (size_t p = 0; p < impl_->profiles.size (); ++p)
+    {
+      boost::mutex::scoped_lock profile_lock (impl_->profiles[p]->mutex);
+      detail::mergeScopes (&impl_->profiles[p]->root, merged);
+    }
+  }
+
+  statistics.clear ();
+  statistics.reserve (merged.size ());
+  for (std::map<std::string, detail::MergedScope>::const_iterator it = merged.begin (); it != merged.end (); ++it)
+  {
+    const detail::MergedScope &scope = it->second;
+    ScopeStatistics stats;
+    stats.path = it->first;
+    stats.count = scope.count;
+    stats.total_ms = static_cast<double> (scope.total_ns) * 1e-6;
+    stats.min_ms = static_cast<double> (scope.min_ns) * 1e-6;
+    stats.max_ms = static_cast<double> (scope.max_ns) * 1e-6;
+    stats.mean_ms = stats.total_ms / static_cast<double> (scope.count);
+    stats.p50_ms = detail::getQuantile (scope.histogram, scope.count, 0.5) * 1e-6;
+    stats.p99_ms = detail::getQuantile (scope.histogram, scope.count, 0.99) * 1e-6;
+    statistics.push_back (stats);
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+void
+pcl::profiling::Registry::getCounters (std::vector<std::pair<std::string, int64_t> > &counters) const
+{
+  std::map<std::string, int64_t> merged;
+  {
+    boost::mutex::scoped_lock lock (impl_->mutex);
+    for (size_t p = 0; p < impl_->profiles.size (); ++p)
+    {
+      boost::mutex::scoped_lock profile_lock (impl_->profiles[p]->mutex);
+      const std::vector<std::pair<std::string, int64_t> > &thread_counters = impl_->profiles[p]->counters;
+      for (size_t c = 0; c < thread_counters.size (); ++c)
+        merged[thread_counters[c].first] += thread_counters[c].second;
+    }
+  }
+  counters.assign (merged.begin (), merged.end ());
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+void
+pcl::profiling::Registry::reset ()
+{
+  boost::mutex::scoped_lock lock (impl_->mutex);
+  for (size_t p = 0; p < impl_->profiles.size (); ++p)
+  {
+    detail::ThreadProfile *profile = impl_->profiles[p];
+    boost::mutex::scoped_lock profile_lock (profile->mutex);
+    // The scope tree is kept, since open scopes still point into it
+    profile->root.clear ();
+    for (size_t c = 0; c < profile->counters.size (); ++c)
+      profile->counters[c].second = 0;
+    profile->events.clear ();
+    profile->dropped_events = 0;
+  }
+  impl_->origin_ns = getTimeNanoseconds ();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+bool
+pcl::profiling::Registry::saveJSON (const std::string &file_name) const
+{
+  std::vector<ScopeStatistics> statistics;
+  std::vector<std::pair<std::string, int64_t> > counters;
+  getStatistics (statistics);
+  getCounters (counters);
+
+  std::ofstream file (file_name.c_str ());
+  if (!file)
+    return (false);
+  file << std::setprecision (9);
+  file << "{\n  \"scopes\": [";
+  for (size_t s = 0; s < statistics.size (); ++s)
+  {
+    const ScopeStatistics &stats = statistics[s];
+    file << (s ? ",\n" : "\n")
+         << "    {\"path\": \"" << detail::escapeJSON (stats.path) << "\""
+         << ", \"count\": " << stats.count
+         << ", \"total_ms\": " << stats.total_ms
+         << ", \"mean_ms\": " << stats.mean_ms
+         << ", \"min_ms\": " << stats.min_ms
+         << ", \"max_ms\": " << stats.max_ms
+         << ", \"p50_ms\": " << stats.p50_ms
+         << ", \"p99_ms\": " << stats.p99_ms << "}";
+  }
+  file << "\n  ],\n  \"counters\": {";
+  for (size_t c = 0; c < counters.size (); ++c)
+    file << (c ? ",\n" : "\n") << "    \"" << detail::escapeJSON (counters[c].first) << "\": " << counters[c].second;
+  file << "\n  }\n}\n";
+  return (file.good ());
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+bool
+pcl::profiling::Registry::saveChromeTrace (const std::string &file_name) const
+{
+  std::ofstream file (file_name.c_str ());
+  if (!file)
+    return (false);
+  file << std::fixed << std::setprecision (3);
+  file << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+  bool first = true;
+  boost::mutex::scoped_lock lock (impl_->mutex);
+  for (size_t p = 0; p < impl_->profiles.size (); ++p)
+  {
+    const detail::ThreadProfile *profile = impl_->profiles[p];
+    boost::mutex::scoped_lock profile_lock (impl_->profiles[p]->mutex);
+    file << (first ? "\n" : ",\n")
+         << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << profile->id
+         << ", \"args\": {\"name\": \"thread " << profile->id << "\"}}";
+    first = false;
+    for (size_t e = 0; e < profile->events.size (); ++e)
+    {
+      const detail::TraceEvent &event = profile->events[e];
+      // Events of scopes entered before the last reset start before the origin
+      const double start_us = (static_cast<double> (event.start_ns) - static_cast<double> (impl_->origin_ns)) * 1e-3;
+      file << ",\n{\"name\": \"" << detail::escapeJSON (event.node->name) << "\", \"cat\": \"pcl\", \"ph\": \"X\""
+           << ", \"ts\": " << start_us << ", \"dur\": " << static_cast<double> (event.duration_ns) * 1e-3
+           << ", \"pid\": 1, \"tid\": " << profile->id << "}";
+    }
+    if (profile->dropped_events > 0)
+      file << ",\n{\"name\": \"dropped events\", \"ph\": \"i\", \"s\": \"t\", \"ts\": 0, \"pid\": 1, \"tid\": "
+           << profile->id << ", \"args\": {\"count\": " << profile->dropped_events << "}}";
+  }
+  file << "\n]}\n";
+  return (file.good ());
+}
@@ -240,31 +240,32 @@ RangeImage::cropImage (int borderSize, int top, int right, int bottom, int left)
   } 
   left-=borderSize; top-=borderSize; right+=borderSize; bottom+=borderSize;
   
-  // Create copy without copying the old points - vector::swap only copies a few pointers, not the content
-  PointCloud<PointWithRange>::VectorType tmpPoints;
-  points.swap (tmpPoints);
-  RangeImage oldRangeImage = *this;
-  tmpPoints.swap (oldRangeImage.points);
+  // Swap the old points out instead of copying them. The buffer of the previous crop is reused.
+  VectorType& old_points = scratch_.crop_points;
+  points.swap (old_points);
+  int old_width = static_cast<int> (width), old_height = static_cast<int> (height);
   
   width = right-left+1; height = bottom-top+1;
-  image_offset_x_ = left+oldRangeImage.image_offset_x_;
-  image_offset_y_ = top+oldRangeImage.image_offset_y_;
+  image_offset_x_ += left;
+  image_offset_y_ += top;
   points.resize (width*height);
   
-  //std::cout << oldRangeImage.width<<"x"<<oldRangeImage.height<<" -> "<<width<<"x"<<height<<"\n";
+  //std::cout << old_width<<"x"<<old_height<<" -> "<<width<<"x"<<height<<"\n";
   
   // Copy points
-  for (int y=0, oldY=top; y< static_cast<int> (height); ++y,++oldY) 
+  # pragma omp parallel for num_threads (max_no_of_threads) default (shared) schedule (static)
+  for (int y=0; y< static_cast<int> (height); ++y) 
   {
+    int oldY = top + y;
     for (int x=0, oldX=left; x< static_cast<int> (width); ++x,++oldX) 
     {
       PointWithRange& currentPoint = points[y*width + x];
-      if (oldX<0 || oldX>= static_cast<int> (oldRangeImage.width) || oldY<0 || oldY>= static_cast<int> (oldRangeImage.height)) 
+      if (oldX<0 || oldX>= old_width || oldY<0 || oldY>= old_height) 
       {
         currentPoint = unobserved_point;
         continue;
       }
-      currentPoint = oldRangeImage.points[oldY*oldRangeImage.width + oldX];
+      currentPoint = old_points[oldY*old_width + oldX];
     }
   }
 }
@@ -273,6 +274,7 @@ RangeImage::cropImage (int borderSize, int top, int right, int bottom, int left)
 void 
 RangeImage::recalculate3DPointPositions () 
 {
+  # pragma omp parallel for num_threads (max_no_of_threads) default (shared) schedule (static)
   for (int y = 0; y < static_cast<int> (height); ++y) 
   {
     for (int x = 0; x < static_cast<int> (width); ++x) 
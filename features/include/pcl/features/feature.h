@@ -131,7 +131,7 @@ namespace pcl
         feature_name_ (), search_method_surface_ (),
         surface_(), tree_(),
         search_parameter_(0), search_radius_(0), k_(0),
-        fake_surface_(false)
+        fake_surface_(false), nn_indices_ (), nn_dists_ ()
       {}
             
       /** \brief Empty destructor */
@@ -256,6 +256,12 @@ namespace pcl
       /** \brief If no surface is given, we use the input PointCloud as the surface. */
       bool fake_surface_;
 
+      /** \brief Neighbor buffers of the serial computeFeature implementations, kept between
+        * calls to compute for the reason given at pcl::Filter::nn_indices_.
+        */
+      std::vector<int> nn_indices_;
+      std::vector<float> nn_dists_;
+
       /** \brief Search for k-nearest neighbors using the spatial locator from
         * \a setSearchmethod, and the given surface from \a setSearchSurface.
         * \param[in] index the index of the query point
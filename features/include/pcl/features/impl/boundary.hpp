@@ -118,8 +118,10 @@ pcl::BoundaryEstimation<PointInT, PointNT, PointOutT>::computeFeature (PointClou
 {
   // Allocate enough space to hold the results
   // \note This resize is irrelevant for a radiusSearch ().
-  std::vector<int> nn_indices (k_);
-  std::vector<float> nn_dists (k_);
+  std::vector<int> &nn_indices = this->nn_indices_;
+  std::vector<float> &nn_dists = this->nn_dists_;
+  nn_indices.resize (k_);
+  nn_dists.resize (k_);
 
   Eigen::Vector4f u = Eigen::Vector4f::Zero (), v = Eigen::Vector4f::Zero ();
 
@@ -42,6 +42,7 @@
 #define PCL_FEATURES_IMPL_FEATURE_H_
 
 #include <pcl/search/pcl_search.h>
+#include <pcl/common/profiler.h>
 
 //////////////////////////////////////////////////////////////////////////////////////////////
 inline void
@@ -188,6 +189,7 @@ pcl::Feature<PointInT, PointOutT>::deinitCompute ()
 template <typename PointInT, typename PointOutT> void
 pcl::Feature<PointInT, PointOutT>::compute (PointCloudOut &output)
 {
+  PCL_PROFILE_SCOPE (feature_name_.c_str ());
   if (!initCompute ())
   {
     output.width = output.height = 0;
@@ -176,8 +176,10 @@ pcl::FPFHEstimation<PointInT, PointNT, PointOutT>::computeSPFHSignatures (std::v
 {
   // Allocate enough space to hold the NN search results
   // \note This resize is irrelevant for a radiusSearch ().
-  std::vector<int> nn_indices (k_);
-  std::vector<float> nn_dists (k_);
+  std::vector<int> &nn_indices = this->nn_indices_;
+  std::vector<float> &nn_dists = this->nn_dists_;
+  nn_indices.resize (k_);
+  nn_dists.resize (k_);
 
   std::set<int> spfh_indices;
   spfh_hist_lookup.resize (surface_->points.size ());
@@ -235,8 +237,10 @@ pcl::FPFHEstimation<PointInT, PointNT, PointOutT>::computeFeature (PointCloudOut
 {
   // Allocate enough space to hold the NN search results
   // \note This resize is irrelevant for a radiusSearch ().
-  std::vector<int> nn_indices (k_);
-  std::vector<float> nn_dists (k_);
+  std::vector<int> &nn_indices = this->nn_indices_;
+  std::vector<float> &nn_dists = this->nn_dists_;
+  nn_indices.resize (k_);
+  nn_dists.resize (k_);
 
   std::vector<int> spfh_hist_lookup;
   computeSPFHSignatures (spfh_hist_lookup, hist_f1_, hist_f2_, hist_f3_);
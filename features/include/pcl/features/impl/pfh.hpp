@@ -165,8 +165,10 @@ pcl::PFHEstimation<PointInT, PointNT, PointOutT>::computeFeature (PointCloudOut
 
   // Allocate enough space to hold the results
   // \note This resize is irrelevant for a radiusSearch ().
-  std::vector<int> nn_indices (k_);
-  std::vector<float> nn_dists (k_);
+  std::vector<int> &nn_indices = this->nn_indices_;
+  std::vector<float> &nn_dists = this->nn_dists_;
+  nn_indices.resize (k_);
+  nn_dists.resize (k_);
 
   output.is_dense = true;
   // Save a few cycles by not checking every point for NaN/Inf values if the cloud is set to dense
@@ -45,6 +45,7 @@
 #include <pcl/filters/boost.h>
 #include <cfloat>
 #include <pcl/PointIndices.h>
+#include <pcl/common/profiler.h>
 
 namespace pcl
 {
@@ -101,7 +102,9 @@ namespace pcl
       Filter (bool extract_removed_indices = false) : 
         removed_indices_ (new std::vector<int>),
         filter_name_ (),
-        extract_removed_indices_ (extract_removed_indices)
+        extract_removed_indices_ (extract_removed_indices),
+        nn_indices_ (),
+        nn_dists_ ()
       {
       }
 
@@ -130,6 +133,7 @@ namespace pcl
       inline void
       filter (PointCloud &output)
       {
+        PCL_PROFILE_SCOPE (filter_name_.c_str ());
         if (!initCompute ())
           return;
 
@@ -162,6 +166,14 @@ namespace pcl
       /** \brief Set to true if we want to return the indices of the removed points. */
       bool extract_removed_indices_;
 
+      /** \brief Neighbor indices and squared distances of the current query point, used by
+        * filters based on neighborhood searches in place of local vectors. They are kept between
+        * calls to filter, so that a pipeline running frame after frame reuses the buffers of
+        * previous calls instead of reallocating them.
+        */
+      std::vector<int> nn_indices_;
+      std::vector<float> nn_dists_;
+
       /** \brief Abstract filter method. 
         *
         * The implementation needs to set output.{points, width, height, is_dense}.
@@ -41,6 +41,7 @@
 #define PCL_FILTERS_FILTER_INDICES_H_
 
 #include <pcl/filters/filter.h>
+#include <pcl/common/indexed_point_cloud.h>
 
 namespace pcl
 {
@@ -120,6 +121,24 @@ namespace pcl
         deinitCompute ();
       }
 
+      /** \brief Calls the filtering method and returns a view of the input cloud with the indices of the points
+        * that pass, without copying any points. Use IndexedPointCloud::materializeOrganized for an output like
+        * the one of \a setKeepOrganized (true).
+        * \param[out] output the view of the filtered points; it keeps the input cloud alive
+        */
+      inline void
+      filter (IndexedPointCloud<PointT> &output)
+      {
+        if (!initCompute ())
+          return;
+
+        boost::shared_ptr<std::vector<int> > indices (new std::vector<int>);
+        applyFilter (*indices);
+
+        deinitCompute ();
+        output = IndexedPointCloud<PointT> (input_, indices);
+      }
+
       /** \brief Set whether the regular conditions for points filtering should apply, or the inverted conditions.
         * \param[in] negative false = normal filter behavior (default), true = inverted behavior.
         */
@@ -169,6 +188,7 @@ namespace pcl
       }
 
     protected:
+      using Filter<PointT>::input_;
       using Filter<PointT>::initCompute;
       using Filter<PointT>::deinitCompute;
       using Filter<PointT>::applyFilter;
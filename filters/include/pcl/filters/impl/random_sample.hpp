@@ -110,7 +110,7 @@ pcl::RandomSample<PointT>::applyFilter (std::vector<int> &indices)
       removed_indices_->resize (static_cast<size_t> (N - sample_size));
 
     // Set random seed so derived indices are the same each time the filter runs
-    std::srand (seed_);
+    rng_.seed (seed_);
 
     // Algorithm A
     unsigned top = N - sample_size;
@@ -138,7 +138,7 @@ pcl::RandomSample<PointT>::applyFilter (std::vector<int> &indices)
       N--;
     }
 
-    index += N * static_cast<unsigned> (unifRand ());
+    index += rng_.nextBounded (N);
     if (extract_removed_indices_)
       added[index] = true;
     indices[i++] = (*indices_)[index++];
@@ -39,6 +39,7 @@
 #define PCL_FILTERS_RANDOM_SUBSAMPLE_H_
 
 #include <pcl/filters/filter_indices.h>
+#include <pcl/common/random.h>
 #include <time.h>
 #include <limits.h>
 
@@ -78,7 +79,8 @@ namespace pcl
       RandomSample (bool extract_removed_indices = false) : 
         FilterIndices<PointT> (extract_removed_indices),
         sample_ (UINT_MAX), 
-        seed_ (static_cast<unsigned int> (time (NULL)))
+        seed_ (static_cast<unsigned int> (time (NULL))),
+        rng_ ()
       {
         filter_name_ = "RandomSample";
       }
@@ -123,6 +125,8 @@ namespace pcl
       unsigned int sample_;
       /** \brief Random number seed. */
       unsigned int seed_;
+      /** \brief Random number generator, reseeded with \a seed_ on every call to applyFilter. */
+      pcl::common::Xoshiro128 rng_;
 
       /** \brief Sample of point indices into a separate PointCloud
         * \param output the resultant point cloud
@@ -136,14 +140,11 @@ namespace pcl
       void
       applyFilter (std::vector<int> &indices);
 
-      /** \brief Return a random number fast using a LCG (Linear Congruential Generator) algorithm.
-        * See http://software.intel.com/en-us/articles/fast-random-number-generator-on-the-intel-pentiumr-4-processor/ for more information.
-        */
+      /** \brief Return a random number uniformly distributed in [0, 1). */
       inline float
       unifRand ()
       {
-        return (static_cast<float>(rand () / double (RAND_MAX)));
-        //return (((214013 * seed_ + 2531011) >> 16) & 0x7FFF);
+        return (rng_.nextFloat ());
       }
   };
 
@@ -167,7 +168,7 @@ namespace pcl
       typedef boost::shared_ptr<const RandomSample<pcl::PCLPointCloud2> > ConstPtr;
   
       /** \brief Empty constructor. */
-      RandomSample () : sample_ (UINT_MAX), seed_ (static_cast<unsigned int> (time (NULL)))
+      RandomSample () : sample_ (UINT_MAX), seed_ (static_cast<unsigned int> (time (NULL))), rng_ ()
       {
         filter_name_ = "RandomSample";
       }
@@ -212,6 +213,8 @@ namespace pcl
       unsigned int sample_;
       /** \brief Random number seed. */
       unsigned int seed_;
+      /** \brief Random number generator, reseeded with \a seed_ on every call to applyFilter. */
+      pcl::common::Xoshiro128 rng_;
 
       /** \brief Sample of point indices into a separate PointCloud
         * \param output the resultant point cloud
@@ -225,14 +228,11 @@ namespace pcl
       void
       applyFilter (std::vector<int> &indices);
 
-      /** \brief Return a random number fast using a LCG (Linear Congruential Generator) algorithm.
-        * See http://software.intel.com/en-us/articles/fast-random-number-generator-on-the-intel-pentiumr-4-processor/ for more information.
-        */
+      /** \brief Return a random number uniformly distributed in [0, 1). */
       inline float
       unifRand ()
       {
-        return (static_cast<float> (rand () / double (RAND_MAX)));
-        //return (((214013 * seed_ + 2531011) >> 16) & 0x7FFF);
+        return (rng_.nextFloat ());
       }
    };
 }
@@ -99,7 +99,8 @@ namespace pcl
         FilterIndices<PointT>::FilterIndices (extract_removed_indices),
         searcher_ (),
         mean_k_ (1),
-        std_mul_ (0.0)
+        std_mul_ (0.0),
+        distances_ ()
       {
         filter_name_ = "StatisticalOutlierRemoval";
       }
@@ -186,6 +187,9 @@ namespace pcl
       /** \brief Standard deviations threshold (i.e., points outside of 
         * \f$ \mu \pm \sigma \cdot std\_mul \f$ will be marked as outliers). */
       double std_mul_;
+
+      /** \brief Mean neighbor distance of every point, kept between calls to filter. */
+      std::vector<float> distances_;
   };
 
   /** \brief @b StatisticalOutlierRemoval uses point neighborhood statistics to filter outlier data. For more
@@ -49,6 +49,7 @@
 void
 pcl::Filter<pcl::PCLPointCloud2>::filter (PCLPointCloud2 &output)
 {
+  PCL_PROFILE_SCOPE (filter_name_.c_str ());
   if (!initCompute ())
     return;
 
@@ -64,7 +64,7 @@ pcl::RandomSample<pcl::PCLPointCloud2>::applyFilter (PCLPointCloud2 &output)
     output.height = 1;
 
     // Set random seed so derived indices are the same each time the filter runs
-    std::srand (seed_);
+    rng_.seed (seed_);
 
     unsigned top = N - sample_;
     unsigned i = 0;
@@ -88,7 +88,7 @@ pcl::RandomSample<pcl::PCLPointCloud2>::applyFilter (PCLPointCloud2 &output)
       N--;
     }
 
-    index += N * static_cast<unsigned> (unifRand ());
+    index += rng_.nextBounded (N);
     memcpy (&output.data[i++ * output.point_step], &input_->data[index++ * output.point_step], output.point_step);
 
     output.width = sample_;
@@ -113,7 +113,7 @@ pcl::RandomSample<pcl::PCLPointCloud2>::applyFilter (std::vector<int> &indices)
     indices.resize (sample_);
 
     // Set random seed so derived indices are the same each time the filter runs
-    std::srand (seed_);
+    rng_.seed (seed_);
 
     unsigned top = N - sample_;
     unsigned i = 0;
@@ -137,7 +137,7 @@ pcl::RandomSample<pcl::PCLPointCloud2>::applyFilter (std::vector<int> &indices)
       N--;
     }
 
-    index += N * static_cast<unsigned> (unifRand ());
+    index += rng_.nextBounded (N);
     indices[i++] = (*indices_)[index++];
   }
 }
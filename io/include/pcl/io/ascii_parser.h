@@ -0,0 +1,231 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Point Cloud Library (PCL) - www.pointclouds.org
+ *  Copyright (c) 2013-, Open Perception, Inc.
+ *
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder(s) nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef PCL_IO_ASCII_PARSER_H_
+#define PCL_IO_ASCII_PARSER_H_
+
+#include <pcl/pcl_macros.h>
+#include <pcl/PCLPointField.h>
+#include <boost/cstdint.hpp>
+#include <string>
+#include <vector>
+
+namespace pcl
+{
+  namespace io
+  {
+    /** \brief Locale independent parsing of the decimal floating point number at the beginning of
+      * [begin, end), in the syntax of strtod without hexadecimal floats, infinities and NaNs.
+      * Numbers whose significant digits form an integer of at most 2^53 and whose decimal
+      * exponent is at most 22 in magnitude are converted with a single correctly rounded
+      * operation and without any library call; the others fall back to a correctly rounded
+      * slow path.
+      * \param[in] begin the first character of the number
+      * \param[in] end one past the last character that may be part of the number
+      * \param[out] value the parsed number
+      * \return the first character after the number, or \a begin if no number could be parsed
+      * \ingroup io
+      */
+    PCL_EXPORTS const char*
+    parseFloatingPoint (const char *begin, const char *end, double &value);
+
+    /** \brief Locale independent parsing of the (optionally signed) decimal integer at the
+      * beginning of [begin, end). Values beyond the range of 64 bit integers saturate.
+      * \param[in] begin the first character of the number
+      * \param[in] end one past the last character that may be part of the number
+      * \param[out] value the parsed number
+      * \return the first character after the number, or \a begin if no number could be parsed
+      * \ingroup io
+      */
+    PCL_EXPORTS const char*
+    parseInteger (const char *begin, const char *end, boost::int64_t &value);
+
+    /** \brief ASCIIPointParser converts text with one point per line into the binary point
+      * layout of a pcl::PCLPointCloud2. This is the engine behind the ASCII mode of
+      * pcl::PCDReader and behind pcl::ASCIIReader.
+      *
+      * The input is split into newline aligned chunks which are parsed in parallel with
+      * OpenMP. A first pass counts the point lines of every chunk so that each chunk can then
+      * write its points directly at their final place in the output buffer. Numbers are read
+      * with \ref parseFloatingPoint and \ref parseInteger, which do not depend on the global
+      * locale and do not allocate.
+      *
+      * Empty lines, and lines starting with the comment character if one is set, are ignored.
+      * What happens with the other lines depends on the \ref LinePolicy.
+      *
+      * FLOAT32 values are parsed as double and then rounded to float. In rare cases close to
+      * the middle of two floats this double rounding gives a result one unit in the last place
+      * away from the correctly rounded one, just like atof followed by a cast.
+      * \ingroup io
+      */
+    class PCL_EXPORTS ASCIIPointParser
+    {
+      public:
+        /** \brief Where the value of one column of a line is stored in the point. */
+        struct Column
+        {
+          Column (boost::uint32_t offset_ = 0, boost::uint8_t datatype_ = 0)
+            : offset (offset_), datatype (datatype_)
+          {}
+
+          /** \brief Byte offset of the value in the point. */
+          boost::uint32_t offset;
+          /** \brief One of the pcl::PCLPointField types, or 0 to skip the column. */
+          boost::uint8_t datatype;
+        };
+
+        /** \brief How lines that do not match the columns are treated. */
+        enum LinePolicy
+        {
+          /** \brief The rules of the PCD format: values beyond the last column are ignored, a
+            * line with missing values is an error, the token "nan" gives a NaN (and a non dense
+            * cloud), malformed numbers are read from their longest numeric prefix, or as 0, and
+            * integers out of the range of their field wrap around. */
+          STRICT_LINES,
+          /** \brief Lines whose number of values differs from the number of columns, or which
+            * contain a value that is not a number or an integer out of the range of its field,
+            * are skipped. */
+          SKIP_INVALID_LINES
+        };
+
+        /** \brief Empty constructor. Separators are space, tab and carriage return, there is no
+          * comment character and the policy is STRICT_LINES.
+          */
+        ASCIIPointParser ();
+
+        /** \brief Set the columns of a line, in order. */
+        inline void
+        setColumns (const std::vector<Column> &columns) { columns_ = columns; }
+
+        /** \brief Set the columns from the fields of a PCD file: one column per element of every
+          * field, at the field offset, and skipped columns for padding fields named "_".
+          * \param[in] fields the fields of the point cloud
+          */
+        void
+        setColumns (const std::vector<pcl::PCLPointField> &fields);
+
+        /** \brief Get the columns of a line. */
+        inline const std::vector<Column>&
+        getColumns () const { return (columns_); }
+
+        /** \brief Set the characters separating the values of a line. Consecutive separators
+          * count as one.
+          */
+        void
+        setSeparators (const std::string &separators);
+
+        /** \brief Set the character starting a comment line, or 0 for none. */
+        inline void
+        setCommentCharacter (char comment) { comment_ = comment; }
+
+        /** \brief Set how invalid lines are treated. */
+        inline void
+        setLinePolicy (LinePolicy policy) { policy_ = policy; }
+
+        /** \brief Set the number of threads to use, 0 (default) lets OpenMP decide. */
+        inline void
+        setNumberOfThreads (unsigned int nr_threads = 0) { threads_ = nr_threads; }
+
+        /** \brief Parse the points stored in memory.
+          * \param[in] begin the first character of the text
+          * \param[in] end one past the last character of the text
+          * \param[in] point_step the size of a point in bytes
+          * \param[in] max_points the maximum number of points to read; following points are ignored
+          * \param[out] data the points; resized to the number of points read times \a point_step
+          * \param[out] is_dense set to false if a NaN value was read, left untouched otherwise
+          * \return the number of points read, or -1 on error: a short line with STRICT_LINES, or
+          * more than INT_MAX point lines
+          */
+        int
+        parse (const char *begin, const char *end, boost::uint32_t point_step, size_t max_points,
+               std::vector<boost::uint8_t> &data, bool &is_dense) const;
+
+        /** \brief Parse the points of a file, which is memory mapped for the time of the call.
+          * \param[in] file_name the name of the file
+          * \param[in] offset the position of the first point line in the file
+          * \param[in] point_step the size of a point in bytes
+          * \param[in] max_points the maximum number of points to read; following points are ignored
+          * \param[out] data the points; resized to the number of points read times \a point_step
+          * \param[out] is_dense set to false if a NaN value was read, left untouched otherwise
+          * \return the number of points read, or -1 on error
+          */
+        int
+        parseFile (const std::string &file_name, size_t offset, boost::uint32_t point_step, size_t max_points,
+                   std::vector<boost::uint8_t> &data, bool &is_dense) const;
+
+        /** \brief Find the end of the first \a nr_lines point lines of [begin, end), i.e. where
+          * parsing continues after reading \a nr_lines points with the STRICT_LINES policy.
+          * \param[in] begin the first character of the text
+          * \param[in] end one past the last character of the text
+          * \param[in] nr_lines the number of point lines to skip
+          * \return the first character after the skipped lines, or \a end if there are fewer
+          */
+        const char*
+        skipLines (const char *begin, const char *end, size_t nr_lines) const;
+
+      private:
+        struct Chunk;
+
+        /** \brief Count the point lines in [begin, end). */
+        size_t
+        countLines (const char *begin, const char *end) const;
+
+        /** \brief Parse the point lines of a chunk into data, starting at its first point. */
+        void
+        parseChunk (Chunk &chunk, boost::uint32_t point_step, boost::uint8_t *data) const;
+
+        /** \brief Parse one line into a point. \return false if the line is invalid. */
+        bool
+        parseLine (const char *begin, const char *end, boost::uint8_t *point, bool &is_dense) const;
+
+        /** \brief Find the next non empty, non comment line at or after \a p and trim it.
+          * \return false if there is none before \a end.
+          */
+        bool
+        nextLine (const char *&p, const char *end, const char *&line_begin, const char *&line_end) const;
+
+        std::vector<Column> columns_;
+        /** \brief Lookup table of the separator characters. */
+        bool separator_[256];
+        char comment_;
+        LinePolicy policy_;
+        unsigned int threads_;
+    };
+  }
+}
+
+#endif  //#ifndef PCL_IO_ASCII_PARSER_H_
@@ -0,0 +1,252 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Point Cloud Library (PCL) - www.pointclouds.org
+ *  Copyright (c) 2013-, Open Perception, Inc.
+ *
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder(s) nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef PCL_IO_ASYNC_PCD_WRITER_H_
+#define PCL_IO_ASYNC_PCD_WRITER_H_
+
+#include <pcl/point_cloud.h>
+#include <pcl/PCLPointCloud2.h>
+#include <pcl/io/pcd_io.h>
+#include <pcl/io/boost.h>
+#include <deque>
+#include <string>
+
+namespace pcl
+{
+  namespace io
+  {
+    /** \brief AsyncPCDWriter saves point clouds to PCD files on a pool of background threads,
+      * so that recording at sensor rate never stalls the acquisition thread.
+      *
+      * write () only stores the shared pointer of the cloud in a bounded queue and returns
+      * immediately: the point data is neither copied nor serialized by the caller. When the
+      * queue is full the configured OverflowPolicy decides whether the new or the oldest cloud
+      * is discarded; the caller is never made to wait for the disk. The clouds must therefore
+      * not be modified after they have been handed over.
+      *
+      * Usage example:
+      * \code
+      * pcl::io::AsyncPCDWriter writer (64, 2);
+      * writer.setFormat (pcl::io::AsyncPCDWriter::BINARY_COMPRESSED);
+      * ...
+      * // inside the grabber callback
+      * writer.write<pcl::PointXYZRGBA> (file_name, cloud);
+      * ...
+      * writer.flush ();
+      * \endcode
+      * \ingroup io
+      */
+    class PCL_EXPORTS AsyncPCDWriter
+    {
+      public:
+        /** \brief PCD data format used for the files. */
+        enum Format
+        {
+          /** \brief uncompressed binary data, the cheapest to write */
+          BINARY,
+          /** \brief LZF compressed binary data, see PCDWriter::writeBinaryCompressed */
+          BINARY_COMPRESSED,
+          /** \brief LZF compressed data in independent chunks, see PCDWriter::writeBinaryCompressedChunked */
+          BINARY_COMPRESSED_CHUNKED
+        };
+
+        /** \brief What to do with a cloud that does not fit in the queue anymore. */
+        enum OverflowPolicy
+        {
+          /** \brief discard the oldest queued cloud to make room for the new one */
+          DROP_OLDEST,
+          /** \brief reject the new cloud and keep the queued ones */
+          DROP_NEWEST
+        };
+
+        /** \brief Counters describing the throughput of the writer and the pressure on its queue. */
+        struct Statistics
+        {
+          Statistics ()
+            : accepted (0), written (0), dropped (0), failed (0)
+            , queue_size (0), max_queue_size (0)
+            , total_write_time (0.0), max_write_time (0.0)
+          {}
+
+          /** \brief number of clouds that were accepted into the queue */
+          unsigned long accepted;
+          /** \brief number of files written successfully */
+          unsigned long written;
+          /** \brief number of clouds discarded because the queue was full */
+          unsigned long dropped;
+          /** \brief number of clouds whose file could not be written */
+          unsigned long failed;
+          /** \brief number of clouds currently waiting in the queue */
+          size_t queue_size;
+          /** \brief largest number of clouds that waited in the queue at the same time */
+          size_t max_queue_size;
+          /** \brief accumulated time spent writing files, in milliseconds */
+          double total_write_time;
+          /** \brief longest time spent writing a single file, in milliseconds */
+          double max_write_time;
+        };
+
+        /** \brief Constructor. Starts the writer threads.
+          * \param[in] capacity the maximum number of clouds waiting to be written (at least 1)
+          * \param[in] nr_threads the number of writer threads, 0 uses one per hardware thread
+          */
+        AsyncPCDWriter (size_t capacity = 16, unsigned int nr_threads = 1);
+
+        /** \brief Destructor. Writes all queued clouds to disk and stops the writer threads. */
+        ~AsyncPCDWriter ();
+
+        /** \brief Queue a cloud for writing. Never blocks on disk I/O.
+          * \param[in] file_name the output file name
+          * \param[in] cloud the point cloud, which must not be modified afterwards
+          * \return true if the cloud was queued, false if it was dropped
+          */
+        template <typename PointT> bool
+        write (const std::string &file_name, const typename pcl::PointCloud<PointT>::ConstPtr &cloud);
+
+        /** \brief Queue a cloud for writing. Never blocks on disk I/O.
+          * \param[in] file_name the output file name
+          * \param[in] cloud the point cloud data message, which must not be modified afterwards
+          * \param[in] origin the sensor acquisition origin
+          * \param[in] orientation the sensor acquisition orientation
+          * \return true if the cloud was queued, false if it was dropped
+          */
+        bool
+        write (const std::string &file_name, const pcl::PCLPointCloud2::ConstPtr &cloud,
+               const Eigen::Vector4f &origin = Eigen::Vector4f::Zero (),
+               const Eigen::Quaternionf &orientation = Eigen::Quaternionf::Identity ());
+
+        /** \brief Block until every cloud queued so far has been written (or has failed). */
+        void
+        flush ();
+
+        /** \brief Get a consistent snapshot of the writer statistics. */
+        Statistics
+        getStatistics () const;
+
+        /** \brief Reset all counters except the current queue size. */
+        void
+        resetStatistics ();
+
+        /** \brief Set the format used for clouds queued from now on (default: BINARY). */
+        void
+        setFormat (Format format);
+
+        /** \brief Get the format used for newly queued clouds. */
+        Format
+        getFormat () const;
+
+        /** \brief Set the policy applied when the queue is full (default: DROP_OLDEST). */
+        void
+        setOverflowPolicy (OverflowPolicy policy);
+
+        /** \brief Get the policy applied when the queue is full. */
+        OverflowPolicy
+        getOverflowPolicy () const;
+
+        /** \brief Synchronize every file with the disk (msync) before the writer moves on to the
+          * next one, see PCDWriter::setMapSynchronization. Makes recordings survive a crash of the
+          * machine at the cost of write throughput. Default: false.
+          * \param[in] sync set to true to synchronize each file
+          */
+        void
+        setMapSynchronization (bool sync);
+
+        /** \brief Get the maximum number of clouds waiting to be written. */
+        inline size_t
+        getCapacity () const { return (capacity_); }
+
+        /** \brief Get the number of writer threads. */
+        inline unsigned int
+        getNumberOfThreads () const { return (threads_); }
+
+      private:
+        /** \brief Writes one cloud with the given writer and format, returns 0 on success. */
+        typedef boost::function<int (pcl::PCDWriter &, Format)> WriteFunction;
+
+        struct Job
+        {
+          std::string file_name;
+          WriteFunction write;
+          Format format;
+        };
+
+        /** \brief Append a job to the queue, applying the overflow policy. */
+        bool
+        enqueue (const std::string &file_name, const WriteFunction &write);
+
+        /** \brief Main loop of the writer threads. */
+        void
+        run ();
+
+        template <typename PointT> static int
+        writeCloud (pcl::PCDWriter &writer, Format format, const std::string &file_name,
+                    const typename pcl::PointCloud<PointT>::ConstPtr &cloud);
+
+        /** \brief Unaligned sensor pose, safe to store inside a WriteFunction. */
+        typedef Eigen::Matrix<float, 4, 1, Eigen::DontAlign> Origin;
+        typedef Eigen::Quaternion<float, Eigen::DontAlign> Orientation;
+
+        static int
+        writeBlob (pcl::PCDWriter &writer, Format format, const std::string &file_name,
+                   const pcl::PCLPointCloud2::ConstPtr &cloud,
+                   const Origin &origin, const Orientation &orientation);
+
+        AsyncPCDWriter (const AsyncPCDWriter&);
+        AsyncPCDWriter& operator = (const AsyncPCDWriter&);
+
+        std::deque<Job> queue_;
+        size_t capacity_;
+        unsigned int threads_;
+        Format format_;
+        OverflowPolicy policy_;
+        bool map_synchronization_;
+        Statistics stats_;
+        /** \brief Number of jobs queued or being written. */
+        size_t pending_;
+        bool done_;
+
+        mutable boost::mutex mutex_;
+        boost::condition_variable job_available_;
+        boost::condition_variable idle_;
+        boost::thread_group workers_;
+    };
+  }
+}
+
+#include <pcl/io/impl/async_pcd_writer.hpp>
+
+#endif  //#ifndef PCL_IO_ASYNC_PCD_WRITER_H_
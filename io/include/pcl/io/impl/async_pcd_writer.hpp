@@ -0,0 +1,65 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Point Cloud Library (PCL) - www.pointclouds.org
+ *  Copyright (c) 2013-, Open Perception, Inc.
+ *
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder(s) nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef PCL_IO_ASYNC_PCD_WRITER_IMPL_HPP_
+#define PCL_IO_ASYNC_PCD_WRITER_IMPL_HPP_
+
+///////////////////////////////////////////////////////////////////////////////////////////
+template <typename PointT> bool
+pcl::io::AsyncPCDWriter::write (const std::string &file_name,
+                                const typename pcl::PointCloud<PointT>::ConstPtr &cloud)
+{
+  return (enqueue (file_name, boost::bind (&AsyncPCDWriter::writeCloud<PointT>, _1, _2, file_name, cloud)));
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+template <typename PointT> int
+pcl::io::AsyncPCDWriter::writeCloud (pcl::PCDWriter &writer, Format format, const std::string &file_name,
+                                     const typename pcl::PointCloud<PointT>::ConstPtr &cloud)
+{
+  switch (format)
+  {
+    case BINARY_COMPRESSED:
+      return (writer.writeBinaryCompressed<PointT> (file_name, *cloud));
+    case BINARY_COMPRESSED_CHUNKED:
+      return (writer.writeBinaryCompressedChunked<PointT> (file_name, *cloud));
+    default:
+      return (writer.writeBinary<PointT> (file_name, *cloud));
+  }
+}
+
+#endif  //#ifndef PCL_IO_ASYNC_PCD_WRITER_IMPL_HPP_
@@ -455,6 +455,21 @@ pcl::PCDWriter::writeBinaryCompressed (const std::string &file_name,
   return (0);
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename PointT> int
+pcl::PCDWriter::writeBinaryCompressedChunked (const std::string &file_name, 
+                                              const pcl::PointCloud<PointT> &cloud)
+{
+  if (cloud.points.empty ())
+  {
+    throw pcl::IOException ("[pcl::PCDWriter::writeBinaryCompressedChunked] Input point cloud has no data!");
+    return (-1);
+  }
+  pcl::PCLPointCloud2 blob;
+  pcl::toPCLPointCloud2 (cloud, blob);
+  return (writeBinaryCompressedChunked (file_name, blob, cloud.sensor_origin_, cloud.sensor_orientation_));
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 template <typename PointT> int
 pcl::PCDWriter::writeASCII (const std::string &file_name, const pcl::PointCloud<PointT> &cloud, 
@@ -917,5 +932,46 @@ pcl::PCDWriter::writeASCII (const std::string &file_name,
   return (0);
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename PointT> int
+pcl::PCDStreamReader<PointT>::open (const std::string &file_name, const int offset)
+{
+  // Opening with all fields only parses the header, which gives the fields of the file
+  if (open (file_name, std::vector<std::string> (), offset) < 0)
+    return (-1);
+  const std::vector<pcl::PCLPointField> file_fields = getFields ();
+
+  // Read only the fields of PointT which the file has
+  std::vector<pcl::PCLPointField> fields;
+  pcl::getFields<PointT> (fields);
+  std::vector<std::string> field_names;
+  for (size_t i = 0; i < fields.size (); ++i)
+    for (size_t j = 0; j < file_fields.size (); ++j)
+      if (file_fields[j].name == fields[i].name)
+      {
+        field_names.push_back (fields[i].name);
+        break;
+      }
+  if (field_names.empty ())
+  {
+    PCL_ERROR ("[pcl::PCDStreamReader::open] File %s has none of the fields of the point type!\n", file_name.c_str ());
+    close ();
+    return (-1);
+  }
+  return (open (file_name, field_names, offset));
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename PointT> bool
+pcl::PCDStreamReader<PointT>::next (pcl::PointCloud<PointT> &batch)
+{
+  if (read (blob_, batch_size_) <= 0)
+    return (false);
+  pcl::fromPCLPointCloud2 (blob_, batch);
+  batch.sensor_origin_ = getOrigin ();
+  batch.sensor_orientation_ = getOrientation ();
+  return (true);
+}
+
 #endif  //#ifndef PCL_IO_PCD_IO_H_
 
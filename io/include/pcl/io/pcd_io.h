@@ -53,7 +53,7 @@ namespace pcl
   {
     public:
       /** Empty constructor */
-      PCDReader () : FileReader () {}
+      PCDReader () : FileReader (), threads_ (0) {}
       /** Empty destructor */
       ~PCDReader () {}
 
@@ -98,7 +98,8 @@ namespace pcl
         * \param[out] origin the sensor acquisition origin (only for > PCD_V7 - null if not present)
         * \param[out] orientation the sensor acquisition orientation (only for > PCD_V7 - identity if not present)
         * \param[out] pcd_version the PCD version of the file (i.e., PCD_V6, PCD_V7)
-        * \param[out] data_type the type of data (0 = ASCII, 1 = Binary, 2 = Binary compressed) 
+        * \param[out] data_type the type of data (0 = ASCII, 1 = Binary, 2 = Binary compressed,
+        * 3 = Binary compressed in independent chunks)
         * \param[out] data_idx the offset of cloud data within the file
         * \param[in] offset the offset of where to expect the PCD Header in the
         * file (optional parameter). One usage example for setting the offset
@@ -186,6 +187,49 @@ namespace pcl
       int 
       read (const std::string &file_name, pcl::PCLPointCloud2 &cloud, const int offset = 0);
 
+      /** \brief Read a contiguous range of points from a PCD file into a pcl/PCLPointCloud2,
+        * holding the points [first_point, first_point + nr_points). A range of whole rows of an
+        * organized cloud stays organized, any other range gives an unorganized cloud (height 1).
+        * See PCDStreamReaderBase for what is read from disk in each data mode.
+        * \param[in] file_name the name of the file containing the actual PointCloud data
+        * \param[out] cloud the resultant PointCloud message read from disk
+        * \param[in] first_point the index of the first point to read
+        * \param[in] nr_points the number of points to read, clamped to the end of the cloud
+        * \param[in] offset the offset of where to expect the PCD Header in the file
+        *
+        * \return
+        *  * < 0 (-1) on error
+        *  * == 0 on success
+        */
+      int
+      readRange (const std::string &file_name, pcl::PCLPointCloud2 &cloud,
+                 unsigned int first_point, unsigned int nr_points, const int offset = 0);
+
+      /** \brief Read a subset of the fields of a contiguous range of points from a PCD file into a
+        * pcl/PCLPointCloud2. The fields are packed in the given order, so that reading "x y z" of
+        * a cloud with many fields only needs memory for x, y and z.
+        * \param[in] file_name the name of the file containing the actual PointCloud data
+        * \param[out] cloud the resultant PointCloud message read from disk
+        * \param[in] field_names the names of the fields to read; all fields if empty
+        * \param[in] first_point the index of the first point to read
+        * \param[in] nr_points the number of points to read, clamped to the end of the cloud
+        * \param[in] offset the offset of where to expect the PCD Header in the file
+        *
+        * \return
+        *  * < 0 (-1) on error, e.g. if one of the fields is not in the file
+        *  * == 0 on success
+        */
+      int
+      readRange (const std::string &file_name, pcl::PCLPointCloud2 &cloud,
+                 const std::vector<std::string> &field_names,
+                 unsigned int first_point, unsigned int nr_points, const int offset = 0);
+
+      /** \brief Set the number of threads used to decompress binary_compressed_chunked files.
+        * \param[in] nr_threads the number of threads, 0 (default) lets OpenMP decide
+        */
+      inline void
+      setNumberOfThreads (unsigned int nr_threads = 0) { threads_ = nr_threads; }
+
       /** \brief Read a point cloud data from any PCD file, and convert it to the given template format.
         * \param[in] file_name the name of the file containing the actual PointCloud data
         * \param[out] cloud the resultant PointCloud message read from disk
@@ -215,6 +259,213 @@ namespace pcl
       }
 
       EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    private:
+      /** \brief Read the header of a PCD file, as readHeader, but size cloud.data for the points
+        * only if \a allocate_data is set. PCDStreamReaderBase reads headers of files larger than
+        * the available memory this way.
+        */
+      int
+      parseHeader (const std::string &file_name, pcl::PCLPointCloud2 &cloud,
+                   Eigen::Vector4f &origin, Eigen::Quaternionf &orientation, int &pcd_version,
+                   int &data_type, unsigned int &data_idx, const int offset, bool allocate_data);
+
+      /** \brief The number of threads used for decompression, 0 lets OpenMP decide. */
+      unsigned int threads_;
+
+      friend class PCDStreamReaderBase;
+  };
+
+  /** \brief Sequential or random access reader for the points of a PCD file, which reads a
+    * subset of the fields of a range of points at a time. The memory it needs is bounded by
+    * the number of points requested, whatever the size of the file:
+    *  - binary data is copied straight from a memory mapping of the file;
+    *  - binary_compressed_chunked data is decompressed one chunk at a time, and only for the
+    *    chunks overlapping the requested points;
+    *  - ascii data is parsed from the current line on, only for the requested points;
+    *  - binary_compressed data is a single LZF block that cannot be decompressed partially, so
+    *    the stored fields of all points are decompressed once, on the first read, and kept.
+    *
+    * See PCDStreamReader for a reader returning batches of pcl::PointCloud.
+    * \ingroup io
+    */
+  class PCL_EXPORTS PCDStreamReaderBase
+  {
+    public:
+      /** \brief Where a field of the file goes in the points read. */
+      struct FieldCopy
+      {
+        /** \brief Offset of the field in a point of binary data. */
+        size_t src_offset;
+        /** \brief Size per point of the fields stored before this one in compressed data, which
+          * store their values for all points of a chunk one after the other. */
+        size_t plane_offset;
+        /** \brief Size of the field in bytes (all its elements). */
+        size_t size;
+        /** \brief Offset of the field in the points read. */
+        size_t dst_offset;
+      };
+
+      /** \brief Empty constructor. */
+      PCDStreamReaderBase ();
+
+      /** \brief Destructor. */
+      virtual ~PCDStreamReaderBase () {}
+
+      /** \brief Read the header of a PCD file and prepare to read its points from the first one.
+        * \param[in] file_name the name of the file
+        * \param[in] field_names the names of the fields to read, in the order they are packed in
+        * the points read; all fields, in the layout of the file, if empty
+        * \param[in] offset the offset of where to expect the PCD Header in the file
+        * \return 0 on success, -1 on error (e.g. if one of the fields is not in the file)
+        */
+      int
+      open (const std::string &file_name,
+            const std::vector<std::string> &field_names = std::vector<std::string> (),
+            const int offset = 0);
+
+      /** \brief Close the file and release the memory held for it. */
+      void
+      close ();
+
+      /** \brief Return true if a file is open. */
+      inline bool
+      isOpen () const { return (!file_name_.empty ()); }
+
+      /** \brief Get the number of points of the file. */
+      inline unsigned int
+      getNumberOfPoints () const { return (header_.width * header_.height); }
+
+      /** \brief Get the index of the point the next read starts with. */
+      inline unsigned int
+      getPosition () const { return (position_); }
+
+      /** \brief Get the width and height of the cloud in the file. */
+      inline unsigned int
+      getWidth () const { return (header_.width); }
+      inline unsigned int
+      getHeight () const { return (header_.height); }
+
+      /** \brief Get the sensor acquisition origin and orientation stored in the file. */
+      inline const Eigen::Vector4f&
+      getOrigin () const { return (origin_); }
+      inline const Eigen::Quaternionf&
+      getOrientation () const { return (orientation_); }
+
+      /** \brief Get the fields of the points read. */
+      inline const std::vector<pcl::PCLPointField>&
+      getFields () const { return (fields_); }
+
+      /** \brief Get the header of the file, with the fields as they are stored. Its data is
+        * always empty: no memory is allocated for the points of the file.
+        */
+      inline const pcl::PCLPointCloud2&
+      getHeader () const { return (header_); }
+
+      /** \brief Set the index of the point the next read starts with.
+        * \return 0 on success, -1 if the point is beyond the end of the cloud or no file is open
+        */
+      int
+      seek (unsigned int point);
+
+      /** \brief Read the next points, from the current position on, and move past them. A range
+        * of whole rows of an organized cloud stays organized, other ranges give a cloud of height 1.
+        * \param[out] cloud the points read
+        * \param[in] nr_points the number of points to read, clamped to the end of the cloud
+        * \return the number of points read (0 at the end of the cloud), or -1 on error
+        */
+      int
+      read (pcl::PCLPointCloud2 &cloud, unsigned int nr_points);
+
+      /** \brief Set the number of threads used to decompress binary_compressed_chunked files.
+        * \param[in] nr_threads the number of threads, 0 (default) lets OpenMP decide
+        */
+      inline void
+      setNumberOfThreads (unsigned int nr_threads = 0) { threads_ = nr_threads; }
+
+      EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    private:
+      /** \brief Copying would duplicate the decompressed data. */
+      PCDStreamReaderBase (const PCDStreamReaderBase&);
+      PCDStreamReaderBase&
+      operator = (const PCDStreamReaderBase&);
+
+      /** \brief The file and its header, with the fields as they are stored. */
+      std::string file_name_;
+      pcl::PCLPointCloud2 header_;
+      Eigen::Vector4f origin_;
+      Eigen::Quaternionf orientation_;
+      int data_type_;
+      unsigned int data_idx_;
+
+      /** \brief The fields of the points read and how to get them from the stored ones. */
+      std::vector<pcl::PCLPointField> fields_;
+      std::vector<FieldCopy> copies_;
+      unsigned int point_step_;
+
+      /** \brief The index of the next point to read. */
+      unsigned int position_;
+      /** \brief The offset in the file of the next point line, for ascii data. */
+      size_t line_idx_;
+      /** \brief The decompressed fields of all points, for binary_compressed data. */
+      std::vector<char> planes_;
+      unsigned int threads_;
+  };
+
+  /** \brief Reads a PCD file in consecutive batches of pcl::PointCloud, so that filters can run
+    * over files that do not fit in memory. Only the fields of \a PointT which the file has are
+    * read. Example:
+    * \code
+    * pcl::PCDStreamReader<pcl::PointXYZ> reader (100000);
+    * pcl::PointCloud<pcl::PointXYZ> batch;
+    * if (reader.open ("scan.pcd") == 0)
+    *   while (reader.next (batch))
+    *     process (batch);
+    * \endcode
+    * \ingroup io
+    */
+  template <typename PointT>
+  class PCDStreamReader : public PCDStreamReaderBase
+  {
+    public:
+      using PCDStreamReaderBase::open;
+      using PCDStreamReaderBase::read;
+
+      /** \brief Constructor.
+        * \param[in] batch_size the number of points of the batches returned by next ()
+        */
+      PCDStreamReader (unsigned int batch_size = 65536)
+        : PCDStreamReaderBase (), batch_size_ (batch_size > 0 ? batch_size : 1), blob_ ()
+      {}
+
+      /** \brief Open a PCD file to read the fields of \a PointT it has.
+        * \param[in] file_name the name of the file
+        * \param[in] offset the offset of where to expect the PCD Header in the file
+        * \return 0 on success, -1 on error
+        */
+      int
+      open (const std::string &file_name, const int offset = 0);
+
+      /** \brief Read the next batch of points: getBatchSize () points, fewer at the end of the cloud.
+        * \param[out] batch the points read
+        * \return false at the end of the cloud or on error
+        */
+      bool
+      next (pcl::PointCloud<PointT> &batch);
+
+      /** \brief Set the number of points of the batches. */
+      inline void
+      setBatchSize (unsigned int batch_size) { batch_size_ = batch_size > 0 ? batch_size : 1; }
+
+      /** \brief Get the number of points of the batches. */
+      inline unsigned int
+      getBatchSize () const { return (batch_size_); }
+
+    private:
+      unsigned int batch_size_;
+      /** \brief Reused between batches to avoid reallocations. */
+      pcl::PCLPointCloud2 blob_;
   };
 
   /** \brief Point Cloud Data (PCD) file format writer.
@@ -224,7 +475,7 @@ namespace pcl
   class PCL_EXPORTS PCDWriter : public FileWriter
   {
     public:
-      PCDWriter() : FileWriter(), map_synchronization_(false) {}
+      PCDWriter() : FileWriter(), map_synchronization_(false), chunk_size_ (65536), threads_ (0) {}
       ~PCDWriter() {}
 
       /** \brief Set whether mmap() synchornization via msync() is desired before munmap() calls. 
@@ -241,6 +492,26 @@ namespace pcl
         map_synchronization_ = sync;
       }
 
+      /** \brief Set the number of points compressed together in a binary_compressed_chunked file.
+        * Smaller chunks make reading point ranges cheaper, larger ones compress slightly better.
+        * Default: 65536
+        * \param[in] nr_points the number of points per chunk (at least 1)
+        */
+      void
+      setChunkSize (unsigned int nr_points)
+      {
+        chunk_size_ = nr_points > 0 ? nr_points : 1;
+      }
+
+      /** \brief Set the number of threads used to compress binary_compressed_chunked files.
+        * \param[in] nr_threads the number of threads, 0 (default) lets OpenMP decide
+        */
+      void
+      setNumberOfThreads (unsigned int nr_threads = 0)
+      {
+        threads_ = nr_threads;
+      }
+
       /** \brief Generate the header of a PCD file format
         * \param[in] cloud the point cloud data message
         * \param[in] origin the sensor acquisition origin
@@ -324,6 +595,21 @@ namespace pcl
                              const Eigen::Vector4f &origin = Eigen::Vector4f::Zero (), 
                              const Eigen::Quaternionf &orientation = Eigen::Quaternionf::Identity ());
 
+      /** \brief Save point cloud data to a PCD file containing n-D points, in BINARY_COMPRESSED_CHUNKED
+        * format. Like BINARY_COMPRESSED, but the points are split in chunks of setChunkSize () points
+        * which are transposed and LZF compressed independently, in parallel. An index of the chunks
+        * follows the DATA line, so that readers can decompress in parallel and seek to point ranges.
+        * Readers that only know BINARY_COMPRESSED fail on these files with a decompression error.
+        * \param[in] file_name the output file name
+        * \param[in] cloud the point cloud data message
+        * \param[in] origin the sensor acquisition origin
+        * \param[in] orientation the sensor acquisition orientation
+        */
+      int 
+      writeBinaryCompressedChunked (const std::string &file_name, const pcl::PCLPointCloud2 &cloud,
+                                    const Eigen::Vector4f &origin = Eigen::Vector4f::Zero (), 
+                                    const Eigen::Quaternionf &orientation = Eigen::Quaternionf::Identity ());
+
       /** \brief Save point cloud data to a PCD file containing n-D points
         * \param[in] file_name the output file name
         * \param[in] cloud the point cloud data message
@@ -393,6 +679,14 @@ namespace pcl
       writeBinaryCompressed (const std::string &file_name, 
                              const pcl::PointCloud<PointT> &cloud);
 
+      /** \brief Save point cloud data to a binary compressed chunked PCD file
+        * \param[in] file_name the output file name
+        * \param[in] cloud the point cloud data message
+        */
+      template <typename PointT> int 
+      writeBinaryCompressedChunked (const std::string &file_name, 
+                                    const pcl::PointCloud<PointT> &cloud);
+
       /** \brief Save point cloud data to a PCD file containing n-D points, in BINARY format
         * \param[in] file_name the output file name
         * \param[in] cloud the point cloud data message
@@ -495,6 +789,12 @@ namespace pcl
     private:
       /** \brief Set to true if msync() should be called before munmap(). Prevents data loss on NFS systems. */
       bool map_synchronization_;
+
+      /** \brief The number of points per chunk of binary_compressed_chunked files. */
+      unsigned int chunk_size_;
+
+      /** \brief The number of threads used for compression, 0 lets OpenMP decide. */
+      unsigned int threads_;
   };
 
   namespace io
@@ -674,6 +974,21 @@ namespace pcl
       return (w.writeBinaryCompressed<PointT> (file_name, cloud));
     }
 
+    /**
+      * \brief Templated version for saving point cloud data to a PCD file
+      * containing a specific given cloud format. This method will write a binary file compressed
+      * in independent chunks, which can be decompressed in parallel.
+      * \param[in] file_name the output file name
+      * \param[in] cloud the point cloud data message
+      * \ingroup io
+      */
+    template<typename PointT> inline int
+    savePCDFileBinaryCompressedChunked (const std::string &file_name, const pcl::PointCloud<PointT> &cloud)
+    {
+      PCDWriter w;
+      return (w.writeBinaryCompressedChunked<PointT> (file_name, cloud));
+    }
+
   }
 }
 
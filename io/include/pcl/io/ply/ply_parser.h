@@ -92,6 +92,18 @@ namespace pcl
           typedef boost::function<void (const std::string&)> comment_callback_type;
           typedef boost::function<void (const std::string&)> obj_info_callback_type;
           typedef boost::function<bool ()> end_header_callback_type;
+
+          /** Receives a block of records of an element of a binary file at once, in host byte
+            * order, instead of one callback per property value. The arguments are the records,
+            * their number and the byte offset of each record in the block. The offsets are NULL
+            * if the element has no list properties, its records then follow each other without
+            * gaps. Returning false aborts parsing with a parse error.
+            */
+          typedef boost::function<bool (const char*, std::size_t, const std::size_t*)> element_records_callback_type;
+          /** Called with the element name and the names of its properties once the header has
+            * been read. Returning an empty function keeps the per property callbacks for the element.
+            */
+          typedef boost::function<element_records_callback_type (const std::string&, const std::vector<std::string>&)> element_records_definition_callback_type;
          
           typedef boost::function<void ()> begin_element_callback_type;
           typedef boost::function<void ()> end_element_callback_type;
@@ -301,12 +313,22 @@ namespace pcl
           inline void
           end_header_callback (const end_header_callback_type& end_header_callback);
 
+          inline void
+          element_records_definition_callback (const element_records_definition_callback_type& element_records_definition_callback);
+
+          /** Set the number of threads used to byte swap the records of binary files,
+            * 0 (default) lets OpenMP decide.
+            */
+          inline void
+          number_of_threads (unsigned int number_of_threads);
+
           typedef int flags_type;
           enum flags { };
 
           ply_parser (flags_type flags = 0) : 
             flags_ (flags), 
             comment_callback_ (), obj_info_callback_ (), end_header_callback_ (), 
+            element_records_definition_callback_ (), number_of_threads_ (0),
             line_number_ (0), current_element_ ()
           {}
               
@@ -317,10 +339,15 @@ namespace pcl
             
           struct property
           {
-            property (const std::string& name) : name (name) {}
+            property (const std::string& name, std::size_t value_size, std::size_t list_size_size = 0) 
+              : name (name), value_size (value_size), list_size_size (list_size_size) {}
             virtual ~property () {}
             virtual bool parse (class ply_parser& ply_parser, format_type format, std::istream& istream) = 0;
             std::string name;
+            /** Binary size of the value, or of each list element for list properties. */
+            std::size_t value_size;
+            /** Binary size of the list size, 0 for scalar properties. */
+            std::size_t list_size_size;
           };
             
           template <typename ScalarType>
@@ -329,7 +356,7 @@ namespace pcl
             typedef ScalarType scalar_type;
             typedef typename scalar_property_callback_type<scalar_type>::type callback_type;
             scalar_property (const std::string& name, callback_type callback)
-              : property (name)
+              : property (name, sizeof (scalar_type))
               , callback (callback)
             {}
             bool parse (class ply_parser& ply_parser, 
@@ -353,7 +380,7 @@ namespace pcl
                            begin_callback_type begin_callback, 
                            element_callback_type element_callback, 
                            end_callback_type end_callback)
-              : property (name)
+              : property (name, sizeof (scalar_type), sizeof (size_type))
               , begin_callback (begin_callback)
               , element_callback (element_callback)
               , end_callback (end_callback)
@@ -406,6 +433,8 @@ namespace pcl
           comment_callback_type comment_callback_;
           obj_info_callback_type obj_info_callback_;
           end_header_callback_type end_header_callback_;
+          element_records_definition_callback_type element_records_definition_callback_;
+          unsigned int number_of_threads_;
           
           template <typename ScalarType> inline void 
           parse_scalar_property_definition (const std::string& property_name);
@@ -425,6 +454,13 @@ namespace pcl
                                const typename list_property_element_callback_type<SizeType, ScalarType>::type& list_property_element_callback, 
                                const typename list_property_end_callback_type<SizeType, ScalarType>::type& list_property_end_callback);
             
+          /** Read the records of a binary element in blocks and hand them to \a element_records_callback. */
+          bool
+          parse_element_records (const element& element, 
+                                 format_type format, 
+                                 std::istream& istream, 
+                                 const element_records_callback_type& element_records_callback);
+
           std::size_t line_number_;
           element* current_element_;
       };
@@ -493,6 +529,16 @@ inline void pcl::io::ply::ply_parser::end_header_callback (const end_header_call
   end_header_callback_ = end_header_callback;
 }
 
+inline void pcl::io::ply::ply_parser::element_records_definition_callback (const element_records_definition_callback_type& element_records_definition_callback)
+{
+  element_records_definition_callback_ = element_records_definition_callback;
+}
+
+inline void pcl::io::ply::ply_parser::number_of_threads (unsigned int number_of_threads)
+{
+  number_of_threads_ = number_of_threads;
+}
+
 template <typename ScalarType>
 inline void pcl::io::ply::ply_parser::parse_scalar_property_definition (const std::string& property_name)
 {
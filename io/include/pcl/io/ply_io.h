@@ -96,6 +96,10 @@ namespace pcl
         , rgb_offset_before_ (0)
         , do_resize_ (false)
         , polygons_ (0)
+        , vertex_properties_ ()
+        , vertex_record_size_ (0)
+        , face_vertex_indices_ (false)
+        , threads_ (0)
       {}
 
       PLYReader (const PLYReader &p)
@@ -111,6 +115,10 @@ namespace pcl
         , rgb_offset_before_ (0)
         , do_resize_ (false)
         , polygons_ (0)
+        , vertex_properties_ ()
+        , vertex_record_size_ (0)
+        , face_vertex_indices_ (false)
+        , threads_ (0)
       {
         *this = p;
       }
@@ -122,6 +130,7 @@ namespace pcl
         orientation_ = p.orientation_;
         range_grid_ = p.range_grid_;
         polygons_ = p.polygons_;
+        threads_ = p.threads_;
         return (*this);
       }
 
@@ -243,6 +252,12 @@ namespace pcl
       int
       read (const std::string &file_name, pcl::PolygonMesh &mesh, const int offset = 0);
 
+      /** \brief Set the number of threads used to convert the vertices and faces of binary files.
+        * \param[in] nr_threads the number of threads, 0 (default) lets OpenMP decide
+        */
+      inline void
+      setNumberOfThreads (unsigned int nr_threads = 0) { threads_ = nr_threads; }
+
     private:
       ::pcl::io::ply::ply_parser parser_;
 
@@ -513,6 +528,41 @@ namespace pcl
       void
       faceEndCallback ();
 
+      /** Callback function choosing the elements of binary files which are read in blocks
+        * of records rather than one property value at a time.
+        * param[in] element_name element name
+        * param[in] property_names names of the element properties
+        */
+      ::pcl::io::ply::ply_parser::element_records_callback_type
+      elementRecordsDefinitionCallback (const std::string& element_name, const std::vector<std::string>& property_names);
+
+      /** Callback function copying a block of vertex records into the cloud
+        * param[in] records the records, in host byte order
+        * param[in] count the number of records
+        */
+      bool
+      vertexRecordsCallback (const char* records, std::size_t count);
+
+      /** Callback function appending a block of face records to the polygons
+        * param[in] records the records, in host byte order
+        * param[in] count the number of records
+        * param[in] offsets the offset of each record in \a records
+        */
+      bool
+      faceRecordsCallback (const char* records, std::size_t count, const std::size_t* offsets);
+
+      /** Record how the next scalar property of binary vertex records is stored in the points.
+        * param[in] kind the conversion applied to the property
+        * param[in] size the size of the property in the file
+        * param[in] offset the offset of the property in the points
+        */
+      void
+      addVertexProperty (int kind, size_t size, size_t offset);
+
+      /** Offset of the packed color field of the points */
+      size_t
+      getColorOffset () const;
+
       /// origin
       Eigen::Vector4f origin_;
 
@@ -529,6 +579,21 @@ namespace pcl
       bool do_resize_;
       //face element artifact
       std::vector<pcl::Vertices> *polygons_;
+
+      /** Conversion of a scalar property of binary vertex records to the point fields */
+      struct VertexProperty
+      {
+        enum { COPY, RED, GREEN, BLUE, ALPHA, INTENSITY };
+        int kind;
+        size_t record_offset;
+        size_t point_offset;
+        size_t size;
+      };
+      //binary vertex and face records artifacts
+      std::vector<VertexProperty> vertex_properties_;
+      size_t vertex_record_size_;
+      bool face_vertex_indices_;
+      unsigned int threads_;
     public:
       EIGEN_MAKE_ALIGNED_OPERATOR_NEW
   };
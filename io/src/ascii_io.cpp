@@ -36,11 +36,13 @@
  */
 
 #include <pcl/io/ascii_io.h>
+#include <pcl/io/ascii_parser.h>
 #include <istream>
 #include <fstream>
 #include <boost/filesystem.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/cstdint.hpp>
+#include <limits>
 
 //////////////////////////////////////////////////////////////////////////////
 pcl::ASCIIReader::ASCIIReader ()
@@ -139,40 +141,30 @@ pcl::ASCIIReader::read (
   unsigned int data_idx;
   if (this->readHeader (file_name, cloud, origin, orientation, file_version, data_type, data_idx, offset) < 0) 
     return (-1);
-  cloud.data.resize (cloud.height * cloud.width * cloud.point_step);
 
-  std::string line;
-  std::fstream ifile (file_name.c_str (), std::fstream::in);
-
-  int total=0;
-
-  uint8_t* data = &cloud.data[0];
-  while (std::getline (ifile, line))
+  // The values of a line are packed in the order of the fields
+  std::vector<pcl::io::ASCIIPointParser::Column> columns;
+  uint32_t field_offset = 0;
+  for (size_t i = 0; i < fields_.size (); i++)
   {
-    boost::algorithm::trim (line);
-    if (line.find_first_not_of ("#") != 0) 
-      continue;   //skip comment lines
-
-   std::vector<std::string> tokens;
-   boost::algorithm::split (tokens, line,boost::algorithm::is_any_of (sep_chars_), boost::algorithm::token_compress_on);
+    columns.push_back (pcl::io::ASCIIPointParser::Column (field_offset, fields_[i].datatype));
+    field_offset += typeSize (fields_[i].datatype);
+  }
 
-   if (tokens.size () != fields_.size ()) 
-     continue;
+  pcl::io::ASCIIPointParser parser;
+  parser.setColumns (columns);
+  parser.setSeparators (sep_chars_);
+  parser.setCommentCharacter ('#');
+  parser.setLinePolicy (pcl::io::ASCIIPointParser::SKIP_INVALID_LINES);
+  bool is_dense = true;
+  int total = parser.parseFile (file_name, 0, cloud.point_step, std::numeric_limits<size_t>::max (),
+                                cloud.data, is_dense);
+  if (total < 0)
+    return (-1);
 
-   uint32_t offset = 0;
-   try
-   {
-     for (int i = 0; i < fields_.size (); i++) 
-       offset += parse (tokens[i], fields_[i], data + offset);
-   }
-   catch (std::exception& /*e*/)
-   {
-     continue;
-   }
-   data += offset;
-   total++;
-  }
-  cloud.data.resize (total * cloud.point_step);
+  cloud.is_dense = is_dense;
+  cloud.width = total;
+  cloud.height = 1;
   return (cloud.width * cloud.height);
 }
 
@@ -0,0 +1,644 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Point Cloud Library (PCL) - www.pointclouds.org
+ *  Copyright (c) 2013-, Open Perception, Inc.
+ *
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder(s) nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <pcl/io/ascii_parser.h>
+#include <pcl/common/io.h>
+#include <pcl/console/print.h>
+#include <algorithm>
+#include <cstring>
+#include <cerrno>
+#include <limits>
+#include <locale>
+#include <sstream>
+#include <fcntl.h>
+
+#ifdef _WIN32
+# include <io.h>
+# include <windows.h>
+# define pcl_open                    _open
+# define pcl_close(fd)               _close(fd)
+# define pcl_lseek(fd,offset,origin) _lseek(fd,offset,origin)
+#else
+# include <sys/mman.h>
+# include <unistd.h>
+# define pcl_open                    open
+# define pcl_close(fd)               close(fd)
+# define pcl_lseek(fd,offset,origin) lseek(fd,offset,origin)
+#endif
+
+#ifdef _OPENMP
+# include <omp.h>
+#endif
+
+namespace
+{
+  /** \brief Powers of ten which are exactly representable as doubles. */
+  const double pow10_table[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+  /** \brief Chunks are at least this large so that small files are not split across threads. */
+  const size_t min_chunk_size = 1 << 20;
+
+  inline bool
+  isDigit (char c)
+  {
+    return (c >= '0' && c <= '9');
+  }
+
+  inline bool
+  isSpace (char c)
+  {
+    return (c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f');
+  }
+
+  /** \brief Case insensitive test whether [begin, end) starts with the lower case word. */
+  inline bool
+  startsWith (const char *begin, const char *end, const char *word)
+  {
+    for (; *word; ++word, ++begin)
+      if (begin == end || (*begin | 0x20) != *word)
+        return (false);
+    return (true);
+  }
+
+  /** \brief Parse an optionally signed "inf", "infinity" or "nan" (case insensitive) at the
+    * beginning of [begin, end). \return the first character after it, or begin if there is none.
+    */
+  const char*
+  parseSpecialValue (const char *begin, const char *end, double &value)
+  {
+    const char *p = begin;
+    bool negative = false;
+    if (p != end && (*p == '+' || *p == '-'))
+      negative = (*p++ == '-');
+    if (startsWith (p, end, "nan"))
+    {
+      value = std::numeric_limits<double>::quiet_NaN ();
+      return (p + 3);
+    }
+    if (startsWith (p, end, "inf"))
+    {
+      value = negative ? -std::numeric_limits<double>::infinity () : std::numeric_limits<double>::infinity ();
+      return (startsWith (p, end, "infinity") ? p + 8 : p + 3);
+    }
+    return (begin);
+  }
+
+  template <typename T> inline void
+  storeValue (boost::uint8_t *target, T value)
+  {
+    memcpy (target, &value, sizeof (T));
+  }
+
+  /** \brief Store an integer, rejecting values out of the range of the field type when
+    * \a check_range is true. Otherwise such values wrap around like the integer conversion of
+    * the former PCD reader did, e.g. 256 is stored as 0 in an UINT8 field.
+    */
+  template <typename T> inline bool
+  storeInteger (boost::uint8_t *target, boost::int64_t value, bool check_range)
+  {
+    if (check_range &&
+        (value < static_cast<boost::int64_t> (std::numeric_limits<T>::min ()) ||
+         value > static_cast<boost::int64_t> (std::numeric_limits<T>::max ())))
+      return (false);
+    storeValue<T> (target, static_cast<T> (value));
+    return (true);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+const char*
+pcl::io::parseFloatingPoint (const char *begin, const char *end, double &value)
+{
+  const char *p = begin;
+  bool negative = false;
+  if (p != end && (*p == '+' || *p == '-'))
+    negative = (*p++ == '-');
+
+  // Accumulate up to 19 significant digits, which always fit in 64 bits
+  boost::uint64_t mantissa = 0;
+  int digits = 0, exponent = 0;
+  bool any_digit = false, truncated = false;
+  for (; p != end && isDigit (*p); ++p)
+  {
+    any_digit = true;
+    if (digits < 19)
+    {
+      mantissa = mantissa * 10 + static_cast<unsigned> (*p - '0');
+      if (mantissa != 0)
+        ++digits;
+    }
+    else
+    {
+      ++exponent;
+      truncated |= (*p != '0');
+    }
+  }
+  if (p != end && *p == '.')
+  {
+    ++p;
+    for (; p != end && isDigit (*p); ++p)
+    {
+      any_digit = true;
+      if (digits < 19)
+      {
+        mantissa = mantissa * 10 + static_cast<unsigned> (*p - '0');
+        if (mantissa != 0)
+          ++digits;
+        --exponent;
+      }
+      else
+        truncated |= (*p != '0');
+    }
+  }
+  if (!any_digit)
+    return (begin);
+
+  // The exponent is only consumed if it has at least one digit
+  if (p != end && (*p == 'e' || *p == 'E'))
+  {
+    const char *q = p + 1;
+    bool negative_exponent = false;
+    if (q != end && (*q == '+' || *q == '-'))
+      negative_exponent = (*q++ == '-');
+    if (q != end && isDigit (*q))
+    {
+      int e = 0;
+      for (; q != end && isDigit (*q); ++q)
+        if (e < 100000)
+          e = e * 10 + (*q - '0');
+      exponent += negative_exponent ? -e : e;
+      p = q;
+    }
+  }
+
+  double result;
+  if (mantissa == 0)
+    result = 0.0;
+  else if (!truncated && mantissa <= (static_cast<boost::uint64_t> (1) << 53) && exponent >= -22 && exponent <= 22)
+  {
+    // Both the mantissa and the power of ten are exact doubles, so a single correctly
+    // rounded operation gives the correctly rounded result
+    result = static_cast<double> (mantissa);
+    if (exponent < 0)
+      result /= pow10_table[-exponent];
+    else
+      result *= pow10_table[exponent];
+  }
+  else if (exponent + digits > 310)
+    result = std::numeric_limits<double>::infinity ();
+  else if (exponent + digits < -330)
+    result = 0.0;
+  else
+  {
+    // Rare slow path: let the classic locale do the correct rounding
+    std::istringstream is (std::string (begin, p));
+    is.imbue (std::locale::classic ());
+    is >> result;
+    value = result;
+    return (p);
+  }
+  value = negative ? -result : result;
+  return (p);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+const char*
+pcl::io::parseInteger (const char *begin, const char *end, boost::int64_t &value)
+{
+  const char *p = begin;
+  bool negative = false;
+  if (p != end && (*p == '+' || *p == '-'))
+    negative = (*p++ == '-');
+
+  const char *digits_begin = p;
+  const boost::uint64_t limit = negative ? static_cast<boost::uint64_t> (std::numeric_limits<boost::int64_t>::max ()) + 1
+                                         : static_cast<boost::uint64_t> (std::numeric_limits<boost::int64_t>::max ());
+  boost::uint64_t magnitude = 0;
+  for (; p != end && isDigit (*p); ++p)
+  {
+    const unsigned digit = static_cast<unsigned> (*p - '0');
+    if (magnitude > (limit - digit) / 10)
+      magnitude = limit;
+    else
+      magnitude = magnitude * 10 + digit;
+  }
+  if (p == digits_begin)
+    return (begin);
+
+  if (negative)
+    value = (magnitude == limit) ? std::numeric_limits<boost::int64_t>::min () : -static_cast<boost::int64_t> (magnitude);
+  else
+    value = static_cast<boost::int64_t> (magnitude);
+  return (p);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+/** \brief A newline aligned part of the text and the result of parsing it. */
+struct pcl::io::ASCIIPointParser::Chunk
+{
+  Chunk () : begin (NULL), end (NULL), first_point (0), nr_lines (0), max_lines (0), nr_points (0),
+             is_dense (true), error_begin (NULL), error_end (NULL)
+  {}
+
+  const char *begin;
+  const char *end;
+  /** \brief Index of the first point of the chunk in the output. */
+  size_t first_point;
+  /** \brief Number of point lines in the chunk. */
+  size_t nr_lines;
+  /** \brief Number of point lines to parse, smaller than nr_lines for the chunk hitting max_points. */
+  size_t max_lines;
+  /** \brief Number of points written, smaller than max_lines if invalid lines were skipped. */
+  size_t nr_points;
+  bool is_dense;
+  /** \brief The first invalid line in STRICT_LINES mode, or NULL. */
+  const char *error_begin;
+  const char *error_end;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+pcl::io::ASCIIPointParser::ASCIIPointParser ()
+  : columns_ ()
+  , comment_ (0)
+  , policy_ (STRICT_LINES)
+  , threads_ (0)
+{
+  setSeparators (" \t\r");
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+void
+pcl::io::ASCIIPointParser::setColumns (const std::vector<pcl::PCLPointField> &fields)
+{
+  columns_.clear ();
+  for (size_t d = 0; d < fields.size (); ++d)
+  {
+    // Padding fields inherited from binary data are present in the text but not read
+    const bool skip = (fields[d].name == "_");
+    const boost::uint32_t size = pcl::getFieldSize (fields[d].datatype);
+    for (boost::uint32_t c = 0; c < fields[d].count; ++c)
+      columns_.push_back (Column (fields[d].offset + c * size, skip ? 0 : fields[d].datatype));
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+void
+pcl::io::ASCIIPointParser::setSeparators (const std::string &separators)
+{
+  std::fill (separator_, separator_ + 256, false);
+  for (size_t i = 0; i < separators.size (); ++i)
+    separator_[static_cast<unsigned char> (separators[i])] = true;
+  // Lines always end at a newline
+  separator_[static_cast<unsigned char> ('\n')] = true;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+bool
+pcl::io::ASCIIPointParser::nextLine (const char *&p, const char *end,
+                                     const char *&line_begin, const char *&line_end) const
+{
+  while (p < end)
+  {
+    const char *eol = static_cast<const char*> (memchr (p, '\n', end - p));
+    if (!eol)
+      eol = end;
+    line_begin = p;
+    line_end = eol;
+    p = (eol == end) ? end : eol + 1;
+
+    while (line_begin != line_end && isSpace (*line_begin))
+      ++line_begin;
+    while (line_end != line_begin && isSpace (line_end[-1]))
+      --line_end;
+    if (line_begin == line_end || (comment_ && *line_begin == comment_))
+      continue;
+    return (true);
+  }
+  return (false);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+size_t
+pcl::io::ASCIIPointParser::countLines (const char *begin, const char *end) const
+{
+  size_t nr_lines = 0;
+  const char *line_begin, *line_end;
+  while (nextLine (begin, end, line_begin, line_end))
+    ++nr_lines;
+  return (nr_lines);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+const char*
+pcl::io::ASCIIPointParser::skipLines (const char *begin, const char *end, size_t nr_lines) const
+{
+  const char *line_begin, *line_end;
+  for (size_t line = 0; line < nr_lines && nextLine (begin, end, line_begin, line_end); ++line)
+    ;
+  return (begin);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+bool
+pcl::io::ASCIIPointParser::parseLine (const char *begin, const char *end,
+                                      boost::uint8_t *point, bool &is_dense) const
+{
+  const bool strict = (policy_ == STRICT_LINES);
+  const size_t nr_columns = columns_.size ();
+  size_t column = 0;
+  const char *p = begin;
+
+  // Tokens are separated by runs of separators, as boost::split with token_compress_on does
+  while (true)
+  {
+    const char *token_begin = p;
+    while (p != end && !separator_[static_cast<unsigned char> (*p)])
+      ++p;
+    const char *token_end = p;
+
+    if (column < nr_columns && columns_[column].datatype != 0)
+    {
+      boost::uint8_t *target = point + columns_[column].offset;
+      const boost::uint8_t datatype = columns_[column].datatype;
+      const bool is_float = (datatype == pcl::PCLPointField::FLOAT32 || datatype == pcl::PCLPointField::FLOAT64);
+
+      if (strict && token_end - token_begin == 3 && memcmp (token_begin, "nan", 3) == 0)
+      {
+        // Integer fields have no NaN, they read 0
+        if (datatype == pcl::PCLPointField::FLOAT32)
+          storeValue<float> (target, std::numeric_limits<float>::quiet_NaN ());
+        else if (datatype == pcl::PCLPointField::FLOAT64)
+          storeValue<double> (target, std::numeric_limits<double>::quiet_NaN ());
+        else
+          memset (target, 0, pcl::getFieldSize (datatype));
+        is_dense = false;
+      }
+      else if (is_float)
+      {
+        double value = 0.0;
+        const char *parsed = parseFloatingPoint (token_begin, token_end, value);
+        if (parsed == token_begin)
+          parsed = parseSpecialValue (token_begin, token_end, value);
+        if (parsed == token_begin)
+          value = 0.0;
+        if (!strict && (parsed == token_begin || parsed != token_end))
+          return (false);
+        if (pcl_isnan (value))
+          is_dense = false;
+        if (datatype == pcl::PCLPointField::FLOAT32)
+          storeValue<float> (target, static_cast<float> (value));
+        else
+          storeValue<double> (target, value);
+      }
+      else
+      {
+        boost::int64_t value = 0;
+        const char *parsed = parseInteger (token_begin, token_end, value);
+        if (!strict && (parsed == token_begin || parsed != token_end))
+          return (false);
+        if (parsed == token_begin)
+        {
+          // Like atof: a fractional number without integer part, e.g. ".5"
+          double fallback = 0.0;
+          if (parseFloatingPoint (token_begin, token_end, fallback) != token_begin)
+            value = static_cast<boost::int64_t> (fallback);
+        }
+        bool in_range = true;
+        switch (datatype)
+        {
+          case pcl::PCLPointField::INT8:   in_range = storeInteger<boost::int8_t> (target, value, !strict); break;
+          case pcl::PCLPointField::UINT8:  in_range = storeInteger<boost::uint8_t> (target, value, !strict); break;
+          case pcl::PCLPointField::INT16:  in_range = storeInteger<boost::int16_t> (target, value, !strict); break;
+          case pcl::PCLPointField::UINT16: in_range = storeInteger<boost::uint16_t> (target, value, !strict); break;
+          case pcl::PCLPointField::INT32:  in_range = storeInteger<boost::int32_t> (target, value, !strict); break;
+          case pcl::PCLPointField::UINT32: in_range = storeInteger<boost::uint32_t> (target, value, !strict); break;
+          default: break;
+        }
+        if (!in_range)
+          return (false);
+      }
+    }
+    ++column;
+    if (!strict && column > nr_columns)
+      return (false);
+
+    if (p == end)
+      break;
+    // A trailing separator run is followed by an empty token
+    while (p != end && separator_[static_cast<unsigned char> (*p)])
+      ++p;
+  }
+  return (strict ? column >= nr_columns : column == nr_columns);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+void
+pcl::io::ASCIIPointParser::parseChunk (Chunk &chunk, boost::uint32_t point_step, boost::uint8_t *data) const
+{
+  const char *p = chunk.begin;
+  const char *line_begin, *line_end;
+  boost::uint8_t *point = data + chunk.first_point * point_step;
+  for (size_t line = 0; line < chunk.max_lines && nextLine (p, chunk.end, line_begin, line_end); ++line)
+  {
+    if (parseLine (line_begin, line_end, point, chunk.is_dense))
+    {
+      point += point_step;
+      ++chunk.nr_points;
+    }
+    else if (policy_ == STRICT_LINES)
+    {
+      chunk.error_begin = line_begin;
+      chunk.error_end = line_end;
+      return;
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+int
+pcl::io::ASCIIPointParser::parse (const char *begin, const char *end, boost::uint32_t point_step, size_t max_points,
+                                  std::vector<boost::uint8_t> &data, bool &is_dense) const
+{
+  if (columns_.empty () || point_step == 0 || begin >= end || max_points == 0)
+  {
+    data.clear ();
+    return (0);
+  }
+
+#ifdef _OPENMP
+  const unsigned int nr_threads = threads_ ? threads_ : static_cast<unsigned int> (omp_get_max_threads ());
+#else
+  const unsigned int nr_threads = 1;
+#endif
+
+  // Split the text into newline aligned chunks, a few per thread for load balancing
+  const size_t length = static_cast<size_t> (end - begin);
+  const size_t nr_chunks = std::max<size_t> (1, std::min<size_t> (length / min_chunk_size, 4 * nr_threads));
+  std::vector<Chunk> chunks (nr_chunks);
+  const char *chunk_begin = begin;
+  for (size_t k = 0; k < nr_chunks; ++k)
+  {
+    const char *chunk_end = end;
+    if (k + 1 < nr_chunks)
+    {
+      chunk_end = std::max (chunk_begin, begin + (k + 1) * (length / nr_chunks));
+      const char *eol = static_cast<const char*> (memchr (chunk_end, '\n', end - chunk_end));
+      chunk_end = eol ? eol + 1 : end;
+    }
+    chunks[k].begin = chunk_begin;
+    chunks[k].end = chunk_end;
+    chunk_begin = chunk_end;
+  }
+
+  // First pass: count the point lines of every chunk
+  const int nr_chunks_i = static_cast<int> (nr_chunks);
+#ifdef _OPENMP
+#pragma omp parallel for num_threads (nr_threads) schedule (dynamic, 1)
+#endif
+  for (int k = 0; k < nr_chunks_i; ++k)
+    chunks[k].nr_lines = countLines (chunks[k].begin, chunks[k].end);
+
+  // Skipped lines are only known after parsing, so in that mode all lines are parsed and the
+  // points beyond max_points dropped afterwards
+  const size_t max_lines = (policy_ == STRICT_LINES) ? max_points : std::numeric_limits<size_t>::max ();
+  size_t nr_lines = 0;
+  for (size_t k = 0; k < nr_chunks; ++k)
+  {
+    chunks[k].first_point = nr_lines;
+    chunks[k].max_lines = (nr_lines >= max_lines) ? 0 : std::min (chunks[k].nr_lines, max_lines - nr_lines);
+    nr_lines += chunks[k].nr_lines;
+  }
+  nr_lines = std::min (nr_lines, max_lines);
+  if (nr_lines > static_cast<size_t> (std::numeric_limits<int>::max ()))
+  {
+    PCL_ERROR ("[pcl::io::ASCIIPointParser::parse] %lu point lines exceed the %d points that can be returned!\n",
+               static_cast<unsigned long> (nr_lines), std::numeric_limits<int>::max ());
+    data.clear ();
+    return (-1);
+  }
+  data.resize (nr_lines * point_step);
+  if (nr_lines == 0)
+    return (0);
+
+  // Second pass: parse every chunk straight to its place in the output
+#ifdef _OPENMP
+#pragma omp parallel for num_threads (nr_threads) schedule (dynamic, 1)
+#endif
+  for (int k = 0; k < nr_chunks_i; ++k)
+    parseChunk (chunks[k], point_step, &data[0]);
+
+  size_t nr_points = 0;
+  for (size_t k = 0; k < nr_chunks && nr_points < max_points; ++k)
+  {
+    if (chunks[k].error_begin)
+    {
+      const std::string line (chunks[k].error_begin, std::min<size_t> (chunks[k].error_end - chunks[k].error_begin, 256));
+      PCL_ERROR ("[pcl::io::ASCIIPointParser::parse] Line '%s' has less than the %lu values expected!\n",
+                 line.c_str (), static_cast<unsigned long> (columns_.size ()));
+      return (-1);
+    }
+    if (!chunks[k].is_dense)
+      is_dense = false;
+    chunks[k].nr_points = std::min (chunks[k].nr_points, max_points - nr_points);
+    // Close the gaps left by skipped lines
+    if (nr_points != chunks[k].first_point && chunks[k].nr_points > 0)
+      memmove (&data[nr_points * point_step], &data[chunks[k].first_point * point_step], chunks[k].nr_points * point_step);
+    nr_points += chunks[k].nr_points;
+  }
+  data.resize (nr_points * point_step);
+  return (static_cast<int> (nr_points));
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+int
+pcl::io::ASCIIPointParser::parseFile (const std::string &file_name, size_t offset, boost::uint32_t point_step,
+                                      size_t max_points, std::vector<boost::uint8_t> &data, bool &is_dense) const
+{
+  int fd = pcl_open (file_name.c_str (), O_RDONLY);
+  if (fd == -1)
+  {
+    PCL_ERROR ("[pcl::io::ASCIIPointParser::parseFile] Failure to open file %s\n", file_name.c_str ());
+    return (-1);
+  }
+
+  // Seek to the end of file to get the filesize
+  off_t file_size = pcl_lseek (fd, 0, SEEK_END);
+  if (file_size < 0)
+  {
+    pcl_close (fd);
+    PCL_ERROR ("[pcl::io::ASCIIPointParser::parseFile] lseek errno: %d strerror: %s\n", errno, strerror (errno));
+    return (-1);
+  }
+  if (static_cast<size_t> (file_size) <= offset)
+  {
+    pcl_close (fd);
+    data.clear ();
+    return (0);
+  }
+
+#ifdef _WIN32
+  HANDLE fm = CreateFileMapping ((HANDLE) _get_osfhandle (fd), NULL, PAGE_READONLY, 0, 0, NULL);
+  char *map = static_cast<char*> (MapViewOfFile (fm, FILE_MAP_READ, 0, 0, 0));
+  if (map == NULL)
+  {
+    CloseHandle (fm);
+    pcl_close (fd);
+    PCL_ERROR ("[pcl::io::ASCIIPointParser::parseFile] Error mapping view of file, %s\n", file_name.c_str ());
+    return (-1);
+  }
+#else
+  char *map = static_cast<char*> (mmap (0, file_size, PROT_READ, MAP_SHARED, fd, 0));
+  if (map == reinterpret_cast<char*> (-1))    // MAP_FAILED
+  {
+    pcl_close (fd);
+    PCL_ERROR ("[pcl::io::ASCIIPointParser::parseFile] Error preparing mmap for file %s.\n", file_name.c_str ());
+    return (-1);
+  }
+#endif
+
+  int res = parse (map + offset, map + file_size, point_step, max_points, data, is_dense);
+
+#ifdef _WIN32
+  UnmapViewOfFile (map);
+  CloseHandle (fm);
+#else
+  munmap (map, file_size);
+#endif
+  pcl_close (fd);
+  return (res);
+}
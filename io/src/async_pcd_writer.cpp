@@ -0,0 +1,250 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Point Cloud Library (PCL) - www.pointclouds.org
+ *  Copyright (c) 2013-, Open Perception, Inc.
+ *
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder(s) nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <pcl/io/async_pcd_writer.h>
+#include <pcl/common/time.h>
+#include <pcl/console/print.h>
+#include <algorithm>
+
+///////////////////////////////////////////////////////////////////////////////////////////
+pcl::io::AsyncPCDWriter::AsyncPCDWriter (size_t capacity, unsigned int nr_threads)
+  : queue_ ()
+  , capacity_ (capacity > 0 ? capacity : 1)
+  , threads_ (nr_threads > 0 ? nr_threads : std::max (boost::thread::hardware_concurrency (), 1u))
+  , format_ (BINARY)
+  , policy_ (DROP_OLDEST)
+  , map_synchronization_ (false)
+  , stats_ ()
+  , pending_ (0)
+  , done_ (false)
+  , mutex_ ()
+  , job_available_ ()
+  , idle_ ()
+  , workers_ ()
+{
+  for (unsigned int i = 0; i < threads_; ++i)
+    workers_.create_thread (boost::bind (&AsyncPCDWriter::run, this));
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+pcl::io::AsyncPCDWriter::~AsyncPCDWriter ()
+{
+  {
+    boost::mutex::scoped_lock lock (mutex_);
+    done_ = true;
+  }
+  job_available_.notify_all ();
+  workers_.join_all ();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+bool
+pcl::io::AsyncPCDWriter::write (const std::string &file_name, const pcl::PCLPointCloud2::ConstPtr &cloud,
+                                const Eigen::Vector4f &origin, const Eigen::Quaternionf &orientation)
+{
+  return (enqueue (file_name, boost::bind (&AsyncPCDWriter::writeBlob, _1, _2, file_name, cloud,
+                                           Origin (origin), Orientation (orientation))));
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+void
+pcl::io::AsyncPCDWriter::flush ()
+{
+  boost::mutex::scoped_lock lock (mutex_);
+  while (pending_ > 0)
+    idle_.wait (lock);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+pcl::io::AsyncPCDWriter::Statistics
+pcl::io::AsyncPCDWriter::getStatistics () const
+{
+  boost::mutex::scoped_lock lock (mutex_);
+  Statistics stats = stats_;
+  stats.queue_size = queue_.size ();
+  return (stats);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+void
+pcl::io::AsyncPCDWriter::resetStatistics ()
+{
+  boost::mutex::scoped_lock lock (mutex_);
+  stats_ = Statistics ();
+  stats_.max_queue_size = queue_.size ();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+void
+pcl::io::AsyncPCDWriter::setFormat (Format format)
+{
+  boost::mutex::scoped_lock lock (mutex_);
+  format_ = format;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+pcl::io::AsyncPCDWriter::Format
+pcl::io::AsyncPCDWriter::getFormat () const
+{
+  boost::mutex::scoped_lock lock (mutex_);
+  return (format_);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+void
+pcl::io::AsyncPCDWriter::setOverflowPolicy (OverflowPolicy policy)
+{
+  boost::mutex::scoped_lock lock (mutex_);
+  policy_ = policy;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+pcl::io::AsyncPCDWriter::OverflowPolicy
+pcl::io::AsyncPCDWriter::getOverflowPolicy () const
+{
+  boost::mutex::scoped_lock lock (mutex_);
+  return (policy_);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+void
+pcl::io::AsyncPCDWriter::setMapSynchronization (bool sync)
+{
+  boost::mutex::scoped_lock lock (mutex_);
+  map_synchronization_ = sync;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+bool
+pcl::io::AsyncPCDWriter::enqueue (const std::string &file_name, const WriteFunction &write)
+{
+  // The dropped job is released after the lock, so that freeing its cloud does not hold up
+  // the writer threads
+  Job dropped;
+  {
+    boost::mutex::scoped_lock lock (mutex_);
+    if (queue_.size () >= capacity_)
+    {
+      ++stats_.dropped;
+      if (policy_ == DROP_NEWEST)
+        return (false);
+      dropped = queue_.front ();
+      queue_.pop_front ();
+      --pending_;
+    }
+
+    Job job;
+    job.file_name = file_name;
+    job.write = write;
+    job.format = format_;
+    queue_.push_back (job);
+    ++pending_;
+    ++stats_.accepted;
+    stats_.max_queue_size = std::max (stats_.max_queue_size, queue_.size ());
+  }
+  job_available_.notify_one ();
+  return (true);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+void
+pcl::io::AsyncPCDWriter::run ()
+{
+  pcl::PCDWriter writer;
+  // Several files are compressed concurrently already, do not oversubscribe the cores
+  if (threads_ > 1)
+    writer.setNumberOfThreads (1);
+
+  while (true)
+  {
+    Job job;
+    {
+      boost::mutex::scoped_lock lock (mutex_);
+      while (queue_.empty () && !done_)
+        job_available_.wait (lock);
+      // Only leave once the queue has been drained
+      if (queue_.empty ())
+        return;
+      job = queue_.front ();
+      queue_.pop_front ();
+      writer.setMapSynchronization (map_synchronization_);
+    }
+
+    pcl::StopWatch watch;
+    int res = -1;
+    try
+    {
+      res = job.write (writer, job.format);
+    }
+    catch (const std::exception &e)
+    {
+      PCL_ERROR ("[pcl::io::AsyncPCDWriter] Could not write %s: %s\n", job.file_name.c_str (), e.what ());
+    }
+    double elapsed = watch.getTime ();
+    // Release the cloud before reporting the job as done
+    job = Job ();
+
+    boost::mutex::scoped_lock lock (mutex_);
+    if (res == 0)
+      ++stats_.written;
+    else
+      ++stats_.failed;
+    stats_.total_write_time += elapsed;
+    stats_.max_write_time = std::max (stats_.max_write_time, elapsed);
+    if (--pending_ == 0)
+      idle_.notify_all ();
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+int
+pcl::io::AsyncPCDWriter::writeBlob (pcl::PCDWriter &writer, Format format, const std::string &file_name,
+                                    const pcl::PCLPointCloud2::ConstPtr &cloud,
+                                    const Origin &origin, const Orientation &orientation)
+{
+  Eigen::Vector4f aligned_origin (origin);
+  Eigen::Quaternionf aligned_orientation (orientation);
+  switch (format)
+  {
+    case BINARY_COMPRESSED:
+      return (writer.writeBinaryCompressed (file_name, *cloud, aligned_origin, aligned_orientation));
+    case BINARY_COMPRESSED_CHUNKED:
+      return (writer.writeBinaryCompressedChunked (file_name, *cloud, aligned_origin, aligned_orientation));
+    default:
+      return (writer.writeBinary (file_name, *cloud, aligned_origin, aligned_orientation));
+  }
+}
@@ -37,13 +37,16 @@
  *
  */
 
+#include <algorithm>
 #include <fstream>
 #include <fcntl.h>
+#include <limits>
 #include <string>
 #include <stdlib.h>
 #include <pcl/io/boost.h>
 #include <pcl/common/io.h>
 #include <pcl/io/pcd_io.h>
+#include <pcl/io/ascii_parser.h>
 #include <pcl/io/lzf.h>
 #include <pcl/console/time.h>
 
@@ -64,6 +67,271 @@
 #endif
 #include <boost/version.hpp>
 
+#ifdef _OPENMP
+# include <omp.h>
+#endif
+
+namespace
+{
+  /** \brief Start of the data section of binary_compressed_chunked files, after the compressed
+    * and uncompressed sizes that binary_compressed files start with. The leading 0 is an LZF
+    * literal run that is cut short, so readers which take these files for binary_compressed ones
+    * fail to decompress them instead of returning garbage.
+    */
+  const char chunked_magic[8] = { '\0', 'P', 'C', 'D', 'C', 'H', 'K', '\1' };
+
+  /** \brief Sizes of the fixed part of the data section and of one entry of the chunk index. */
+  const size_t chunked_preamble_size = 24;
+  const size_t chunked_entry_size = 16;
+
+  /** \brief Collect the fields which are stored in compressed files (all but the "_" padding)
+    * and the number of bytes they take per point.
+    */
+  size_t
+  getCompressedFields (const std::vector<pcl::PCLPointField> &cloud_fields,
+                       std::vector<pcl::PCLPointField> &fields, std::vector<size_t> &fields_sizes)
+  {
+    size_t fsize = 0;
+    fields.clear ();
+    fields_sizes.clear ();
+    for (size_t i = 0; i < cloud_fields.size (); ++i)
+    {
+      if (cloud_fields[i].name == "_")
+        continue;
+      fields.push_back (cloud_fields[i]);
+      fields_sizes.push_back (cloud_fields[i].count * pcl::getFieldSize (cloud_fields[i].datatype));
+      fsize += fields_sizes.back ();
+    }
+    return (fsize);
+  }
+
+  inline unsigned int
+  getNumberOfThreads (unsigned int threads)
+  {
+#ifdef _OPENMP
+    return (threads ? threads : static_cast<unsigned int> (omp_get_max_threads ()));
+#else
+    (void) threads;
+    return (1);
+#endif
+  }
+
+  /** \brief Copy the fields of the points [begin, end) out of transposed (xxyyzz) data holding
+    * \a plane_points points from \a plane_first on, to the points of \a out starting at \a first_point.
+    */
+  void
+  unpackPlanes (const char *planes, size_t plane_first, size_t plane_points,
+                const std::vector<pcl::PCDStreamReaderBase::FieldCopy> &copies,
+                size_t begin, size_t end, size_t first_point, size_t point_step, pcl::uint8_t *out)
+  {
+    for (size_t j = 0; j < copies.size (); ++j)
+    {
+      const char *plane = planes + copies[j].plane_offset * plane_points + (begin - plane_first) * copies[j].size;
+      pcl::uint8_t *target = out + (begin - first_point) * point_step + copies[j].dst_offset;
+      for (size_t i = begin; i < end; ++i, plane += copies[j].size, target += point_step)
+        memcpy (target, plane, copies[j].size);
+    }
+  }
+
+  /** \brief Decompress the points [first_point, first_point + nr_points) of the data section of a
+    * binary_compressed_chunked file into \a out. Only the chunks overlapping the range are
+    * decompressed, in parallel, one chunk per thread at a time.
+    * \return 0 on success, -1 if the data section is corrupt
+    */
+  int
+  decompressChunks (const char *data, size_t data_size, const pcl::PCLPointCloud2 &header,
+                    const std::vector<pcl::PCDStreamReaderBase::FieldCopy> &copies, size_t point_step,
+                    size_t first_point, size_t nr_points, unsigned int nr_threads, pcl::uint8_t *out)
+  {
+    if (data_size < chunked_preamble_size || memcmp (data + 8, chunked_magic, sizeof (chunked_magic)) != 0)
+    {
+      PCL_ERROR ("[pcl::PCDReader::read] Invalid binary_compressed_chunked data section!\n");
+      return (-1);
+    }
+    unsigned int chunk_size, nr_chunks;
+    memcpy (&chunk_size, &data[16], sizeof (unsigned int));
+    memcpy (&nr_chunks, &data[20], sizeof (unsigned int));
+    const size_t total_points = static_cast<size_t> (header.width) * header.height;
+    if (chunk_size == 0 || nr_chunks != (total_points + chunk_size - 1) / chunk_size ||
+        (data_size - chunked_preamble_size) / chunked_entry_size < nr_chunks)
+    {
+      PCL_ERROR ("[pcl::PCDReader::read] Corrupt chunk index (%u chunks of %u points for %lu points)!\n",
+                 nr_chunks, chunk_size, static_cast<unsigned long> (total_points));
+      return (-1);
+    }
+    if (nr_points == 0)
+      return (0);
+
+    std::vector<pcl::PCLPointField> fields;
+    std::vector<size_t> fields_sizes;
+    const size_t fsize = getCompressedFields (header.fields, fields, fields_sizes);
+
+    const int first_chunk = static_cast<int> (first_point / chunk_size);
+    const int last_chunk = static_cast<int> ((first_point + nr_points - 1) / chunk_size);
+    std::vector<char> failed (nr_chunks, 0);
+
+#ifdef _OPENMP
+#pragma omp parallel for num_threads (nr_threads) schedule (dynamic, 1)
+#endif
+    for (int k = first_chunk; k <= last_chunk; ++k)
+    {
+      const char *entry = &data[chunked_preamble_size + k * chunked_entry_size];
+      pcl::uint64_t offset;
+      unsigned int compressed_size, uncompressed_size;
+      memcpy (&offset, &entry[0], sizeof (pcl::uint64_t));
+      memcpy (&compressed_size, &entry[8], sizeof (unsigned int));
+      memcpy (&uncompressed_size, &entry[12], sizeof (unsigned int));
+
+      const size_t chunk_begin = static_cast<size_t> (k) * chunk_size;
+      const size_t chunk_points = std::min<size_t> (chunk_size, total_points - chunk_begin);
+      if (uncompressed_size != chunk_points * fsize || offset > data_size || compressed_size > data_size - offset)
+      {
+        failed[k] = 1;
+        continue;
+      }
+
+      // Chunks which did not compress are stored as they are
+      const char *src = &data[offset];
+      std::vector<char> buffer;
+      if (compressed_size != uncompressed_size)
+      {
+        buffer.resize (uncompressed_size);
+        if (pcl::lzfDecompress (src, compressed_size, &buffer[0], uncompressed_size) != uncompressed_size)
+        {
+          failed[k] = 1;
+          continue;
+        }
+        src = &buffer[0];
+      }
+
+      // Unpack the xxyyzz of the requested points to xyz
+      unpackPlanes (src, chunk_begin, chunk_points, copies,
+                    std::max (first_point, chunk_begin), std::min (first_point + nr_points, chunk_begin + chunk_points),
+                    first_point, point_step, out);
+    }
+
+    for (int k = first_chunk; k <= last_chunk; ++k)
+    {
+      if (failed[k])
+      {
+        PCL_ERROR ("[pcl::PCDReader::read] Chunk %d of the binary_compressed_chunked data is corrupt!\n", k);
+        return (-1);
+      }
+    }
+    return (0);
+  }
+
+  /** \brief Read only memory mapping of a whole file, unmapped on destruction. */
+  class FileMapping
+  {
+    public:
+      FileMapping (const std::string &file_name)
+        : map_ (NULL), size_ (0)
+#ifdef _WIN32
+        , fm_ (NULL)
+#endif
+      {
+        int fd = pcl_open (file_name.c_str (), O_RDONLY);
+        if (fd == -1)
+        {
+          PCL_ERROR ("[pcl::PCDReader::read] Failure to open file %s\n", file_name.c_str () );
+          return;
+        }
+        off_t file_size = pcl_lseek (fd, 0, SEEK_END);
+        if (file_size <= 0)
+        {
+          pcl_close (fd);
+          PCL_ERROR ("[pcl::PCDReader::read] lseek errno: %d strerror: %s\n", errno, strerror (errno));
+          return;
+        }
+#ifdef _WIN32
+        fm_ = CreateFileMapping ((HANDLE) _get_osfhandle (fd), NULL, PAGE_READONLY, 0, 0, NULL);
+        map_ = static_cast<char*> (MapViewOfFile (fm_, FILE_MAP_READ, 0, 0, 0));
+        if (map_ == NULL)
+        {
+          CloseHandle (fm_);
+          PCL_ERROR ("[pcl::PCDReader::read] Error mapping view of file, %s\n", file_name.c_str ());
+        }
+#else
+        map_ = static_cast<char*> (mmap (0, file_size, PROT_READ, MAP_SHARED, fd, 0));
+        if (map_ == reinterpret_cast<char*> (-1))    // MAP_FAILED
+        {
+          map_ = NULL;
+          PCL_ERROR ("[pcl::PCDReader::read] Error preparing mmap for binary PCD file.\n");
+        }
+#endif
+        if (map_)
+          size_ = static_cast<size_t> (file_size);
+        pcl_close (fd);
+      }
+
+      ~FileMapping ()
+      {
+        if (!map_)
+          return;
+#ifdef _WIN32
+        UnmapViewOfFile (map_);
+        CloseHandle (fm_);
+#else
+        munmap (map_, size_);
+#endif
+      }
+
+      /** \brief The contents of the file, or NULL if it could not be mapped. */
+      const char*
+      data () const { return (map_); }
+
+      size_t
+      size () const { return (size_); }
+
+    private:
+      FileMapping (const FileMapping&);
+      FileMapping&
+      operator = (const FileMapping&);
+
+      char *map_;
+      size_t size_;
+#ifdef _WIN32
+      HANDLE fm_;
+#endif
+  };
+
+  /** \brief Check whether all the floating point values of a cloud are finite. */
+  bool
+  isCloudDense (const pcl::PCLPointCloud2 &cloud)
+  {
+    const size_t nr_points = static_cast<size_t> (cloud.width) * cloud.height;
+    for (size_t d = 0; d < cloud.fields.size (); ++d)
+    {
+      const pcl::PCLPointField &field = cloud.fields[d];
+      if (field.datatype != pcl::PCLPointField::FLOAT32 && field.datatype != pcl::PCLPointField::FLOAT64)
+        continue;
+      for (size_t i = 0; i < nr_points; ++i)
+      {
+        for (size_t c = 0; c < field.count; ++c)
+        {
+          const pcl::uint8_t *value = &cloud.data[i * cloud.point_step + field.offset];
+          if (field.datatype == pcl::PCLPointField::FLOAT32)
+          {
+            float v;
+            memcpy (&v, value + c * sizeof (float), sizeof (float));
+            if (!pcl_isfinite (v))
+              return (false);
+          }
+          else
+          {
+            double v;
+            memcpy (&v, value + c * sizeof (double), sizeof (double));
+            if (!pcl_isfinite (v))
+              return (false);
+          }
+        }
+      }
+    }
+    return (true);
+  }
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////
 void
 pcl::PCDWriter::setLockingPermissions (const std::string &file_name,
@@ -111,6 +379,27 @@ int
 pcl::PCDReader::readHeader (const std::string &file_name, pcl::PCLPointCloud2 &cloud,
                             Eigen::Vector4f &origin, Eigen::Quaternionf &orientation, 
                             int &pcd_version, int &data_type, unsigned int &data_idx, const int offset)
+{
+  return (parseHeader (file_name, cloud, origin, orientation, pcd_version, data_type, data_idx, offset, true));
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+int
+pcl::PCDReader::readHeader (const std::string &file_name, pcl::PCLPointCloud2 &cloud, const int offset)
+{
+  Eigen::Vector4f origin;
+  Eigen::Quaternionf orientation;
+  int pcd_version, data_type;
+  unsigned int data_idx;
+  return (parseHeader (file_name, cloud, origin, orientation, pcd_version, data_type, data_idx, offset, true));
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+int
+pcl::PCDReader::parseHeader (const std::string &file_name, pcl::PCLPointCloud2 &cloud,
+                             Eigen::Vector4f &origin, Eigen::Quaternionf &orientation,
+                             int &pcd_version, int &data_type, unsigned int &data_idx, const int offset,
+                             bool allocate_data)
 {
   // Default values
   data_idx = 0;
@@ -311,286 +600,10 @@ pcl::PCDReader::readHeader (const std::string &file_name, pcl::PCLPointCloud2 &c
           throw "Not enough number of elements in <VIEWPOINT>! Need 7 values (tx ty tz qw qx qy qz).";
 
         float x, y, z, w;
-        sstream >> x >> y >> z ;
-        origin      = Eigen::Vector4f (x, y, z, 0.0f);
-        sstream >> w >> x >> y >> z;
-        orientation = Eigen::Quaternionf (w, x, y, z);
-        continue;
-      }
-
-      // Get the number of points
-      if (line_type.substr (0, 6) == "POINTS")
-      {
-        sstream >> nr_points;
-        // Need to allocate: N * point_step
-        cloud.data.resize (nr_points * cloud.point_step);
-        continue;
-      }
-
-      // Read the header + comments line by line until we get to <DATA>
-      if (line_type.substr (0, 4) == "DATA")
-      {
-        data_idx = static_cast<int> (fs.tellg ());
-        if (st.at (1).substr (0, 17) == "binary_compressed")
-         data_type = 2;
-        else
-          if (st.at (1).substr (0, 6) == "binary")
-            data_type = 1;
-        continue;
-      }
-      break;
-    }
-  }
-  catch (const char *exception)
-  {
-    PCL_ERROR ("[pcl::PCDReader::readHeader] %s\n", exception);
-    fs.close ();
-    return (-1);
-  }
-
-  // Exit early: if no points have been given, there's no sense to read or check anything anymore
-  if (nr_points == 0)
-  {
-    PCL_ERROR ("[pcl::PCDReader::readHeader] No points to read\n");
-    fs.close ();
-    return (-1);
-  }
-  
-  // Compatibility with older PCD file versions
-  if (cloud.width == 0 && cloud.height == 0)
-  {
-    cloud.width  = nr_points;
-    cloud.height = 1;
-    cloud.row_step = cloud.point_step * cloud.width;      // row_step only makes sense for organized datasets
-  }
-  //assert (cloud.row_step != 0);       // If row_step = 0, either point_step was not set or width is 0
-
-  // if both height/width are not given, assume an unorganized dataset
-  if (cloud.height == 0)
-  {
-    cloud.height = 1;
-    PCL_WARN ("[pcl::PCDReader::readHeader] no HEIGHT given, setting to 1 (unorganized).\n");
-    if (cloud.width == 0)
-      cloud.width  = nr_points;
-  }
-  else
-  {
-    if (cloud.width == 0 && nr_points != 0)
-    {
-      PCL_ERROR ("[pcl::PCDReader::readHeader] HEIGHT given (%d) but no WIDTH!\n", cloud.height);
-      fs.close ();
-      return (-1);
-    }
-  }
-
-  if (int (cloud.width * cloud.height) != nr_points)
-  {
-    PCL_ERROR ("[pcl::PCDReader::readHeader] HEIGHT (%d) x WIDTH (%d) != number of points (%d)\n", cloud.height, cloud.width, nr_points);
-    fs.close ();
-    return (-1);
-  }
-
-  // Close file
-  fs.close ();
-
-  return (0);
-}
-
-///////////////////////////////////////////////////////////////////////////////////////////
-int
-pcl::PCDReader::readHeader (const std::string &file_name, pcl::PCLPointCloud2 &cloud, const int offset)
-{
-  // Default values
-  cloud.width = cloud.height = cloud.point_step = cloud.row_step = 0;
-  cloud.data.clear ();
-
-  // By default, assume that there are _no_ invalid (e.g., NaN) points
-  //cloud.is_dense = true;
-
-  int nr_points = 0;
-  std::ifstream fs;
-  std::string line;
-
-  int specified_channel_count = 0;
-
-  if (file_name == "" || !boost::filesystem::exists (file_name))
-  {
-    PCL_ERROR ("[pcl::PCDReader::readHeader] Could not find file '%s'.\n", file_name.c_str ());
-    return (-1);
-  }
-
-  // Open file in binary mode to avoid problem of 
-  // std::getline() corrupting the result of ifstream::tellg()
-  fs.open (file_name.c_str (), std::ios::binary);
-  if (!fs.is_open () || fs.fail ())
-  {
-    PCL_ERROR ("[pcl::PCDReader::readHeader] Could not open file '%s'! Error : %s\n", file_name.c_str (), strerror(errno)); 
-    fs.close ();
-    return (-1);
-  }
-
-  // Seek at the given offset
-  fs.seekg (offset, std::ios::beg);
-
-  // field_sizes represents the size of one element in a field (e.g., float = 4, char = 1)
-  // field_counts represents the number of elements in a field (e.g., x = 1, normal_x = 1, fpfh = 33)
-  std::vector<int> field_sizes, field_counts;
-  // field_types represents the type of data in a field (e.g., F = float, U = unsigned)
-  std::vector<char> field_types;
-  std::vector<std::string> st;
-
-  // Read the header and fill it in with wonderful values
-  try
-  {
-    while (!fs.eof ())
-    {
-      getline (fs, line);
-      // Ignore empty lines
-      if (line == "")
-        continue;
-
-      // Tokenize the line
-      boost::trim (line);
-      boost::split (st, line, boost::is_any_of ("\t\r "), boost::token_compress_on);
-
-      std::stringstream sstream (line);
-      sstream.imbue (std::locale::classic ());
-
-      std::string line_type;
-      sstream >> line_type;
-
-      // Ignore comments
-      if (line_type.substr (0, 1) == "#")
-        continue;
-
-      // Version numbers are not needed for now, but we are checking to see if they're there
-      if (line_type.substr (0, 7) == "VERSION")
-        continue;
-
-      // Get the field indices (check for COLUMNS too for backwards compatibility)
-      if ( (line_type.substr (0, 6) == "FIELDS") || (line_type.substr (0, 7) == "COLUMNS") )
-      {
-        specified_channel_count = static_cast<int> (st.size () - 1);
-
-        // Allocate enough memory to accommodate all fields
-        cloud.fields.resize (specified_channel_count);
-        for (int i = 0; i < specified_channel_count; ++i)
-        {
-          std::string col_type = st.at (i + 1);
-          cloud.fields[i].name = col_type;
-        }
-
-        // Default the sizes and the types of each field to float32 to avoid crashes while using older PCD files
-        int offset = 0;
-        for (int i = 0; i < specified_channel_count; ++i, offset += 4)
-        {
-          cloud.fields[i].offset   = offset;
-          cloud.fields[i].datatype = pcl::PCLPointField::FLOAT32;
-          cloud.fields[i].count    = 1;
-        }
-        cloud.point_step = offset;
-        continue;
-      }
-
-      // Get the field sizes
-      if (line_type.substr (0, 4) == "SIZE")
-      {
-        specified_channel_count = static_cast<int> (st.size () - 1);
-
-        // Allocate enough memory to accommodate all fields
-        if (specified_channel_count != static_cast<int> (cloud.fields.size ()))
-          throw "The number of elements in <SIZE> differs than the number of elements in <FIELDS>!";
-
-        // Resize to accommodate the number of values
-        field_sizes.resize (specified_channel_count);
-
-        int offset = 0;
-        for (int i = 0; i < specified_channel_count; ++i)
-        {
-          int col_type ;
-          sstream >> col_type;
-          cloud.fields[i].offset = offset;                // estimate and save the data offsets
-          offset += col_type;
-          field_sizes[i] = col_type;                      // save a temporary copy
-        }
-        cloud.point_step = offset;
-        //if (cloud.width != 0)
-          //cloud.row_step   = cloud.point_step * cloud.width;
-        continue;
-      }
-
-      // Get the field types
-      if (line_type.substr (0, 4) == "TYPE")
-      {
-        if (field_sizes.empty ())
-          throw "TYPE of FIELDS specified before SIZE in header!";
-
-        specified_channel_count = static_cast<int> (st.size () - 1);
-
-        // Allocate enough memory to accommodate all fields
-        if (specified_channel_count != static_cast<int> (cloud.fields.size ()))
-          throw "The number of elements in <TYPE> differs than the number of elements in <FIELDS>!";
-
-        // Resize to accommodate the number of values
-        field_types.resize (specified_channel_count);
-
-        for (int i = 0; i < specified_channel_count; ++i)
-        {
-          field_types[i] = st.at (i + 1).c_str ()[0];
-          cloud.fields[i].datatype = static_cast<uint8_t> (getFieldType (field_sizes[i], field_types[i]));
-        }
-        continue;
-      }
-
-      // Get the field counts
-      if (line_type.substr (0, 5) == "COUNT")
-      {
-        if (field_sizes.empty () || field_types.empty ())
-          throw "COUNT of FIELDS specified before SIZE or TYPE in header!";
-
-        specified_channel_count = static_cast<int> (st.size () - 1);
-
-        // Allocate enough memory to accommodate all fields
-        if (specified_channel_count != static_cast<int> (cloud.fields.size ()))
-          throw "The number of elements in <COUNT> differs than the number of elements in <FIELDS>!";
-
-        field_counts.resize (specified_channel_count);
-
-        int offset = 0;
-        for (int i = 0; i < specified_channel_count; ++i)
-        {
-          cloud.fields[i].offset = offset;
-          int col_count;
-          sstream >> col_count;
-          cloud.fields[i].count = col_count;
-          offset += col_count * field_sizes[i];
-        }
-        // Adjust the offset for count (number of elements)
-        cloud.point_step = offset;
-        continue;
-      }
-
-      // Get the width of the data (organized point cloud dataset)
-      if (line_type.substr (0, 5) == "WIDTH")
-      {
-        sstream >> cloud.width;
-        if (cloud.point_step != 0)
-          cloud.row_step = cloud.point_step * cloud.width;      // row_step only makes sense for organized datasets
-        continue;
-      }
-
-      // Get the height of the data (organized point cloud dataset)
-      if (line_type.substr (0, 6) == "HEIGHT")
-      {
-        sstream >> cloud.height;
-        continue;
-      }
-
-      // Check the format of the acquisition viewpoint
-      if (line_type.substr (0, 9) == "VIEWPOINT")
-      {
-        if (st.size () < 8)
-          throw "Not enough number of elements in <VIEWPOINT>! Need 7 values (tx ty tz qw qx qy qz).";
+        sstream >> x >> y >> z ;
+        origin      = Eigen::Vector4f (x, y, z, 0.0f);
+        sstream >> w >> x >> y >> z;
+        orientation = Eigen::Quaternionf (w, x, y, z);
         continue;
       }
 
@@ -599,7 +612,22 @@ pcl::PCDReader::readHeader (const std::string &file_name, pcl::PCLPointCloud2 &c
       {
         sstream >> nr_points;
         // Need to allocate: N * point_step
-        cloud.data.resize (nr_points * cloud.point_step);
+        if (allocate_data)
+          cloud.data.resize (nr_points * cloud.point_step);
+        continue;
+      }
+
+      // Read the header + comments line by line until we get to <DATA>
+      if (line_type.substr (0, 4) == "DATA")
+      {
+        data_idx = static_cast<int> (fs.tellg ());
+        if (st.at (1) == "binary_compressed_chunked")
+          data_type = 3;
+        else if (st.at (1).substr (0, 17) == "binary_compressed")
+         data_type = 2;
+        else
+          if (st.at (1).substr (0, 6) == "binary")
+            data_type = 1;
         continue;
       }
       break;
@@ -694,121 +722,26 @@ pcl::PCDReader::read (const std::string &file_name, pcl::PCLPointCloud2 &cloud,
   // if ascii
   if (data_type == 0)
   {
-    // Re-open the file (readHeader closes it)
-    std::ifstream fs;
-    fs.open (file_name.c_str ());
-    if (!fs.is_open () || fs.fail ())
+    // Memory map the file and parse the point lines in parallel
+    pcl::io::ASCIIPointParser parser;
+    parser.setColumns (cloud.fields);
+    bool is_dense = true;
+    int res = parser.parseFile (file_name, data_idx, cloud.point_step, nr_points, cloud.data, is_dense);
+    if (res < 0)
     {
-      PCL_ERROR ("[pcl::PCDReader::read] Could not open file %s.\n", file_name.c_str ());
+      PCL_ERROR ("[pcl::PCDReader::read] Could not parse the data of file %s.\n", file_name.c_str ());
       return (-1);
     }
-
-    fs.seekg (data_idx);
-
-    std::string line;
-    std::vector<std::string> st;
-
-    // Read the rest of the file
-    try
-    {
-      while (idx < nr_points && !fs.eof ())
-      {
-        getline (fs, line);
-        // Ignore empty lines
-        if (line == "")
-          continue;
-
-        // Tokenize the line
-        boost::trim (line);
-        boost::split (st, line, boost::is_any_of ("\t\r "), boost::token_compress_on);
-        
-        if (idx >= nr_points)
-        {
-          PCL_WARN ("[pcl::PCDReader::read] input file %s has more points (%d) than advertised (%d)!\n", file_name.c_str (), idx, nr_points);
-          break;
-        }
-
-        size_t total = 0;
-        // Copy data
-        for (unsigned int d = 0; d < static_cast<unsigned int> (cloud.fields.size ()); ++d)
-        {
-          // Ignore invalid padded dimensions that are inherited from binary data
-          if (cloud.fields[d].name == "_")
-          {
-            total += cloud.fields[d].count; // jump over this many elements in the string token
-            continue;
-          }
-          for (unsigned int c = 0; c < cloud.fields[d].count; ++c)
-          {
-            switch (cloud.fields[d].datatype)
-            {
-              case pcl::PCLPointField::INT8:
-              {
-                copyStringValue<pcl::traits::asType<pcl::PCLPointField::INT8>::type> (
-                    st.at (total + c), cloud, idx, d, c);
-                break;
-              }
-              case pcl::PCLPointField::UINT8:
-              {
-                copyStringValue<pcl::traits::asType<pcl::PCLPointField::UINT8>::type> (
-                    st.at (total + c), cloud, idx, d, c);
-                break;
-              }
-              case pcl::PCLPointField::INT16:
-              {
-                copyStringValue<pcl::traits::asType<pcl::PCLPointField::INT16>::type> (
-                    st.at (total + c), cloud, idx, d, c);
-                break;
-              }
-              case pcl::PCLPointField::UINT16:
-              {
-                copyStringValue<pcl::traits::asType<pcl::PCLPointField::UINT16>::type> (
-                    st.at (total + c), cloud, idx, d, c);
-                break;
-              }
-              case pcl::PCLPointField::INT32:
-              {
-                copyStringValue<pcl::traits::asType<pcl::PCLPointField::INT32>::type> (
-                    st.at (total + c), cloud, idx, d, c);
-                break;
-              }
-              case pcl::PCLPointField::UINT32:
-              {
-                copyStringValue<pcl::traits::asType<pcl::PCLPointField::UINT32>::type> (
-                    st.at (total + c), cloud, idx, d, c);
-                break;
-              }
-              case pcl::PCLPointField::FLOAT32:
-              {
-                copyStringValue<pcl::traits::asType<pcl::PCLPointField::FLOAT32>::type> (
-                    st.at (total + c), cloud, idx, d, c);
-                break;
-              }
-              case pcl::PCLPointField::FLOAT64:
-              {
-                copyStringValue<pcl::traits::asType<pcl::PCLPointField::FLOAT64>::type> (
-                    st.at (total + c), cloud, idx, d, c);
-                break;
-              }
-              default:
-                PCL_WARN ("[pcl::PCDReader::read] Incorrect field data type specified (%d)!\n",cloud.fields[d].datatype);
-                break;
-            }
-          }
-          total += cloud.fields[d].count; // jump over this many elements in the string token
-        }
-        idx++;
-      }
-    }
-    catch (const char *exception)
-    {
-      PCL_ERROR ("[pcl::PCDReader::read] %s\n", exception);
-      fs.close ();
+    cloud.is_dense = is_dense;
+    idx = static_cast<unsigned int> (res);
+  }
+  /// ---[ Binary compressed in chunks: decompressed in parallel, straight from the file mapping
+  else if (data_type == 3)
+  {
+    pcl::PCDStreamReaderBase stream;
+    stream.setNumberOfThreads (threads_);
+    if (stream.open (file_name, std::vector<std::string> (), offset) < 0 || stream.read (cloud, nr_points) < 0)
       return (-1);
-    }
-
-    // Close file
-    fs.close ();
   }
   else 
   /// ---[ Binary mode only
@@ -1052,6 +985,309 @@ pcl::PCDReader::read (const std::string &file_name, pcl::PCLPointCloud2 &cloud,
   return (0);
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int
+pcl::PCDReader::readRange (const std::string &file_name, pcl::PCLPointCloud2 &cloud,
+                           unsigned int first_point, unsigned int nr_points, const int offset)
+{
+  return (readRange (file_name, cloud, std::vector<std::string> (), first_point, nr_points, offset));
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int
+pcl::PCDReader::readRange (const std::string &file_name, pcl::PCLPointCloud2 &cloud,
+                           const std::vector<std::string> &field_names,
+                           unsigned int first_point, unsigned int nr_points, const int offset)
+{
+  pcl::PCDStreamReaderBase stream;
+  stream.setNumberOfThreads (threads_);
+  if (stream.open (file_name, field_names, offset) < 0)
+    return (-1);
+  if (first_point >= stream.getNumberOfPoints () || stream.seek (first_point) < 0)
+  {
+    PCL_ERROR ("[pcl::PCDReader::readRange] First point (%u) is beyond the %u points of %s!\n",
+               first_point, stream.getNumberOfPoints (), file_name.c_str ());
+    return (-1);
+  }
+  if (stream.read (cloud, nr_points) < 0)
+    return (-1);
+  return (0);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+pcl::PCDStreamReaderBase::PCDStreamReaderBase ()
+  : file_name_ ()
+  , header_ ()
+  , origin_ (Eigen::Vector4f::Zero ())
+  , orientation_ (Eigen::Quaternionf::Identity ())
+  , data_type_ (0)
+  , data_idx_ (0)
+  , fields_ ()
+  , copies_ ()
+  , point_step_ (0)
+  , position_ (0)
+  , line_idx_ (0)
+  , planes_ ()
+  , threads_ (0)
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int
+pcl::PCDStreamReaderBase::open (const std::string &file_name, const std::vector<std::string> &field_names,
+                                const int offset)
+{
+  close ();
+  pcl::PCDReader reader;
+  int pcd_version;
+  // Only the header: the data buffer is never sized for the points of the file
+  if (reader.parseHeader (file_name, header_, origin_, orientation_, pcd_version, data_type_, data_idx_, offset, false) < 0)
+    return (-1);
+
+  // Offsets of the fields in binary points and in the transposed compressed points
+  std::vector<size_t> plane_offsets (header_.fields.size (), 0);
+  size_t plane_offset = 0;
+  for (size_t d = 0; d < header_.fields.size (); ++d)
+  {
+    plane_offsets[d] = plane_offset;
+    if (header_.fields[d].name != "_")
+      plane_offset += header_.fields[d].count * pcl::getFieldSize (header_.fields[d].datatype);
+  }
+
+  std::vector<int> selected;
+  if (field_names.empty ())
+  {
+    // All fields, in the layout of the file
+    for (size_t d = 0; d < header_.fields.size (); ++d)
+      selected.push_back (static_cast<int> (d));
+    fields_ = header_.fields;
+    point_step_ = header_.point_step;
+  }
+  else
+  {
+    // The requested fields, packed in the requested order
+    point_step_ = 0;
+    for (size_t i = 0; i < field_names.size (); ++i)
+    {
+      int d = pcl::getFieldIndex (header_, field_names[i]);
+      if (d == -1 || field_names[i] == "_")
+      {
+        PCL_ERROR ("[pcl::PCDStreamReaderBase::open] No field %s in file %s!\n", field_names[i].c_str (), file_name.c_str ());
+        return (-1);
+      }
+      selected.push_back (d);
+      pcl::PCLPointField field = header_.fields[d];
+      field.offset = point_step_;
+      fields_.push_back (field);
+      point_step_ += field.count * pcl::getFieldSize (field.datatype);
+    }
+  }
+  for (size_t i = 0; i < selected.size (); ++i)
+  {
+    const pcl::PCLPointField &field = header_.fields[selected[i]];
+    // Padding is not stored in compressed files
+    if (field.name == "_" && (data_type_ == 2 || data_type_ == 3))
+      continue;
+    FieldCopy copy;
+    copy.src_offset = field.offset;
+    copy.plane_offset = plane_offsets[selected[i]];
+    copy.size = field.count * pcl::getFieldSize (field.datatype);
+    copy.dst_offset = fields_[i].offset;
+    copies_.push_back (copy);
+  }
+
+  file_name_ = file_name;
+  line_idx_ = data_idx_;
+  return (0);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void
+pcl::PCDStreamReaderBase::close ()
+{
+  file_name_.clear ();
+  header_ = pcl::PCLPointCloud2 ();
+  fields_.clear ();
+  copies_.clear ();
+  point_step_ = 0;
+  position_ = 0;
+  std::vector<char> ().swap (planes_);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int
+pcl::PCDStreamReaderBase::seek (unsigned int point)
+{
+  if (!isOpen () || point > getNumberOfPoints ())
+    return (-1);
+
+  if (data_type_ == 0)
+  {
+    // Lines have no fixed size: walk forward from the closest known line
+    if (point < position_)
+    {
+      position_ = 0;
+      line_idx_ = data_idx_;
+    }
+    FileMapping map (file_name_);
+    if (!map.data ())
+      return (-1);
+    pcl::io::ASCIIPointParser parser;
+    line_idx_ = parser.skipLines (map.data () + line_idx_, map.data () + map.size (), point - position_) - map.data ();
+  }
+  position_ = point;
+  return (0);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int
+pcl::PCDStreamReaderBase::read (pcl::PCLPointCloud2 &cloud, unsigned int nr_points)
+{
+  if (!isOpen ())
+  {
+    PCL_ERROR ("[pcl::PCDStreamReaderBase::read] No file open!\n");
+    return (-1);
+  }
+  const unsigned int total_points = getNumberOfPoints ();
+  nr_points = std::min (nr_points, total_points - position_);
+
+  cloud.fields = fields_;
+  cloud.point_step = point_step_;
+  cloud.is_bigendian = false;
+  cloud.data.resize (static_cast<size_t> (nr_points) * point_step_);
+  if (nr_points > 0)
+  {
+    FileMapping map (file_name_);
+    if (!map.data () || map.size () < data_idx_)
+      return (-1);
+    const char *data = map.data () + data_idx_;
+    const size_t data_size = map.size () - data_idx_;
+
+    switch (data_type_)
+    {
+      case 0:
+      {
+        // Parse only the selected columns of the next lines
+        std::vector<pcl::io::ASCIIPointParser::Column> columns;
+        for (size_t d = 0; d < header_.fields.size (); ++d)
+        {
+          const pcl::PCLPointField &field = header_.fields[d];
+          size_t i = 0;
+          while (i < fields_.size () && (field.name == "_" || fields_[i].name != field.name))
+            ++i;
+          const unsigned int size = pcl::getFieldSize (field.datatype);
+          for (unsigned int c = 0; c < field.count; ++c)
+          {
+            if (i < fields_.size ())
+              columns.push_back (pcl::io::ASCIIPointParser::Column (fields_[i].offset + c * size, field.datatype));
+            else
+              columns.push_back (pcl::io::ASCIIPointParser::Column ());
+          }
+        }
+        pcl::io::ASCIIPointParser parser;
+        parser.setColumns (columns);
+        parser.setNumberOfThreads (threads_);
+        // Find the lines of this batch first, so that the parser only scans them and not the
+        // rest of the file
+        const char *begin = map.data () + line_idx_;
+        const char *batch_end = parser.skipLines (begin, map.data () + map.size (), nr_points);
+        bool is_dense = true;
+        int res = parser.parse (begin, batch_end, point_step_, nr_points, cloud.data, is_dense);
+        if (res != static_cast<int> (nr_points))
+        {
+          PCL_ERROR ("[pcl::PCDStreamReaderBase::read] Read %d points instead of %u from %s!\n", res, nr_points, file_name_.c_str ());
+          return (-1);
+        }
+        line_idx_ = batch_end - map.data ();
+        break;
+      }
+      case 1:
+      {
+        if (data_size / header_.point_step < position_ + nr_points)
+        {
+          PCL_ERROR ("[pcl::PCDStreamReaderBase::read] File %s is too short!\n", file_name_.c_str ());
+          return (-1);
+        }
+        // Points which are read whole are copied in one go
+        bool whole_points = (point_step_ == header_.point_step);
+        size_t copied = 0;
+        for (size_t j = 0; j < copies_.size (); ++j)
+        {
+          whole_points &= (copies_[j].src_offset == copies_[j].dst_offset);
+          copied += copies_[j].size;
+        }
+        whole_points &= (copied == point_step_);
+
+        const char *src = data + static_cast<size_t> (position_) * header_.point_step;
+        if (whole_points)
+          memcpy (&cloud.data[0], src, cloud.data.size ());
+        else
+        {
+          for (size_t i = 0; i < nr_points; ++i, src += header_.point_step)
+            for (size_t j = 0; j < copies_.size (); ++j)
+              memcpy (&cloud.data[i * point_step_ + copies_[j].dst_offset], src + copies_[j].src_offset, copies_[j].size);
+        }
+        break;
+      }
+      case 2:
+      {
+        // A single LZF block: decompress all of it once and keep it for the following reads
+        if (planes_.empty ())
+        {
+          unsigned int compressed_size, uncompressed_size;
+          if (data_size < 8)
+            return (-1);
+          memcpy (&compressed_size, &data[0], sizeof (unsigned int));
+          memcpy (&uncompressed_size, &data[4], sizeof (unsigned int));
+          std::vector<pcl::PCLPointField> stored_fields;
+          std::vector<size_t> stored_sizes;
+          const size_t fsize = getCompressedFields (header_.fields, stored_fields, stored_sizes);
+          if (compressed_size > data_size - 8 || uncompressed_size != fsize * total_points)
+          {
+            PCL_ERROR ("[pcl::PCDStreamReaderBase::read] Invalid binary_compressed data in %s!\n", file_name_.c_str ());
+            return (-1);
+          }
+          planes_.resize (uncompressed_size);
+          if (pcl::lzfDecompress (&data[8], compressed_size, &planes_[0], uncompressed_size) != uncompressed_size)
+          {
+            std::vector<char> ().swap (planes_);
+            PCL_ERROR ("[pcl::PCDStreamReaderBase::read] Error decompressing the data of %s!\n", file_name_.c_str ());
+            return (-1);
+          }
+        }
+        unpackPlanes (&planes_[0], 0, total_points, copies_, position_, position_ + nr_points,
+                      position_, point_step_, &cloud.data[0]);
+        break;
+      }
+      case 3:
+      {
+        if (decompressChunks (data, data_size, header_, copies_, point_step_, position_, nr_points,
+                              getNumberOfThreads (threads_), &cloud.data[0]) < 0)
+          return (-1);
+        break;
+      }
+      default:
+        return (-1);
+    }
+  }
+
+  // Whole rows of an organized cloud stay organized
+  if (header_.height > 1 && position_ % header_.width == 0 && nr_points % header_.width == 0 && nr_points > 0)
+  {
+    cloud.width = header_.width;
+    cloud.height = nr_points / header_.width;
+  }
+  else
+  {
+    cloud.width = nr_points;
+    cloud.height = 1;
+  }
+  cloud.row_step = cloud.point_step * cloud.width;
+  cloud.is_dense = isCloudDense (cloud);
+  position_ += nr_points;
+  return (static_cast<int> (nr_points));
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 std::string
 pcl::PCDWriter::generateHeaderASCII (const pcl::PCLPointCloud2 &cloud,
@@ -1703,3 +1939,184 @@ pcl::PCDWriter::writeBinaryCompressed (const std::string &file_name, const pcl::
   return (0);
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int
+pcl::PCDWriter::writeBinaryCompressedChunked (const std::string &file_name, const pcl::PCLPointCloud2 &cloud,
+                                              const Eigen::Vector4f &origin, const Eigen::Quaternionf &orientation)
+{
+  if (cloud.data.empty ())
+  {
+    PCL_ERROR ("[pcl::PCDWriter::writeBinaryCompressedChunked] Input point cloud has no data!\n");
+    return (-1);
+  }
+  std::ostringstream oss;
+  oss.imbue (std::locale::classic ());
+  std::string header = generateHeaderBinaryCompressed (cloud, origin, orientation);
+  if (header.empty ())
+    return (-1);
+  oss << header << "DATA binary_compressed_chunked\n";
+  oss.flush ();
+  const size_t data_idx = static_cast<size_t> (oss.tellp ());
+
+  std::vector<pcl::PCLPointField> fields;
+  std::vector<size_t> fields_sizes;
+  const size_t fsize = getCompressedFields (cloud.fields, fields, fields_sizes);
+  const size_t nr_points = static_cast<size_t> (cloud.width) * cloud.height;
+  if (fsize == 0 || cloud.data.size () < nr_points * cloud.point_step)
+  {
+    PCL_ERROR ("[pcl::PCDWriter::writeBinaryCompressedChunked] Input point cloud has no fields or not enough data!\n");
+    return (-1);
+  }
+
+  // The size of every chunk must fit in the 32 bit sizes of the index
+  const size_t chunk_size = std::max<size_t> (1, std::min<size_t> (chunk_size_, std::numeric_limits<unsigned int>::max () / fsize));
+  const int nr_chunks = static_cast<int> ((nr_points + chunk_size - 1) / chunk_size);
+
+  // Transpose and compress every chunk on its own, in parallel
+  std::vector<std::vector<char> > chunks (nr_chunks);
+#ifdef _OPENMP
+#pragma omp parallel for num_threads (getNumberOfThreads (threads_)) schedule (dynamic, 1)
+#endif
+  for (int k = 0; k < nr_chunks; ++k)
+  {
+    const size_t chunk_begin = static_cast<size_t> (k) * chunk_size;
+    const size_t chunk_points = std::min (chunk_size, nr_points - chunk_begin);
+    const unsigned int uncompressed_size = static_cast<unsigned int> (chunk_points * fsize);
+
+    // Convert the XYZRGBXYZRGB structure to XXYYZZRGBRGB to aid compression
+    std::vector<char> planes (uncompressed_size);
+    char *plane = &planes[0];
+    for (size_t j = 0; j < fields.size (); ++j)
+    {
+      for (size_t i = chunk_begin; i < chunk_begin + chunk_points; ++i, plane += fields_sizes[j])
+        memcpy (plane, &cloud.data[i * cloud.point_step + fields[j].offset], fields_sizes[j]);
+    }
+
+    // A chunk that does not get smaller is stored as it is, marked by equal sizes in the index
+    chunks[k].resize (uncompressed_size);
+    unsigned int compressed_size = pcl::lzfCompress (&planes[0], uncompressed_size, &chunks[k][0], uncompressed_size - 1);
+    if (compressed_size == 0)
+      chunks[k].swap (planes);
+    else
+      chunks[k].resize (compressed_size);
+  }
+
+  // Data section: the sizes binary_compressed files start with, the magic, the chunk index, the chunks
+  const size_t index_size = chunked_preamble_size + nr_chunks * chunked_entry_size;
+  std::vector<char> index (index_size);
+  const unsigned int legacy_compressed_size = 1;
+  const unsigned int legacy_uncompressed_size = static_cast<unsigned int> (nr_points * fsize);
+  const unsigned int chunk_size_u = static_cast<unsigned int> (chunk_size), nr_chunks_u = static_cast<unsigned int> (nr_chunks);
+  memcpy (&index[0], &legacy_compressed_size, sizeof (unsigned int));
+  memcpy (&index[4], &legacy_uncompressed_size, sizeof (unsigned int));
+  memcpy (&index[8], chunked_magic, sizeof (chunked_magic));
+  memcpy (&index[16], &chunk_size_u, sizeof (unsigned int));
+  memcpy (&index[20], &nr_chunks_u, sizeof (unsigned int));
+  std::vector<size_t> chunk_offsets (nr_chunks);
+  pcl::uint64_t offset = index_size;
+  for (int k = 0; k < nr_chunks; ++k)
+  {
+    const size_t chunk_points = std::min (chunk_size, nr_points - k * chunk_size);
+    const unsigned int compressed_size = static_cast<unsigned int> (chunks[k].size ());
+    const unsigned int uncompressed_size = static_cast<unsigned int> (chunk_points * fsize);
+    char *entry = &index[chunked_preamble_size + k * chunked_entry_size];
+    memcpy (&entry[0], &offset, sizeof (pcl::uint64_t));
+    memcpy (&entry[8], &compressed_size, sizeof (unsigned int));
+    memcpy (&entry[12], &uncompressed_size, sizeof (unsigned int));
+    chunk_offsets[k] = static_cast<size_t> (offset);
+    offset += compressed_size;
+  }
+  const size_t file_size = data_idx + static_cast<size_t> (offset);
+
+#ifdef _WIN32
+  HANDLE h_native_file = CreateFile (file_name.c_str (), GENERIC_READ | GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+  if (h_native_file == INVALID_HANDLE_VALUE)
+  {
+    PCL_ERROR ("[pcl::PCDWriter::writeBinaryCompressedChunked] Error during CreateFile (%s)!\n", file_name.c_str ());
+    return (-1);
+  }
+#else
+  int fd = pcl_open (file_name.c_str (), O_RDWR | O_CREAT | O_TRUNC, static_cast<mode_t> (0600));
+  if (fd < 0)
+  {
+    PCL_ERROR ("[pcl::PCDWriter::writeBinaryCompressedChunked] Error during open (%s)!\n", file_name.c_str());
+    return (-1);
+  }
+#endif
+  // Mandatory lock file
+  boost::interprocess::file_lock file_lock;
+  setLockingPermissions (file_name, file_lock);
+
+#ifndef _WIN32
+  // Stretch the file size to the size of the data
+  off_t result = pcl_lseek (fd, file_size - 1, SEEK_SET);
+  if (result < 0)
+  {
+    pcl_close (fd);
+    resetLockingPermissions (file_name, file_lock);
+    PCL_ERROR ("[pcl::PCDWriter::writeBinaryCompressedChunked] lseek errno: %d strerror: %s\n", errno, strerror (errno));
+    return (-1);
+  }
+  // Write a bogus entry so that the new file size comes in effect
+  result = static_cast<int> (::write (fd, "", 1));
+  if (result != 1)
+  {
+    pcl_close (fd);
+    resetLockingPermissions (file_name, file_lock);
+    PCL_ERROR ("[pcl::PCDWriter::writeBinaryCompressedChunked] Error during write ()!\n");
+    return (-1);
+  }
+#endif
+
+  // Prepare the map
+#ifdef _WIN32
+  HANDLE fm = CreateFileMapping (h_native_file, NULL, PAGE_READWRITE, 0, (DWORD) file_size, NULL);
+  char *map = static_cast<char*> (MapViewOfFile (fm, FILE_MAP_READ | FILE_MAP_WRITE, 0, 0, file_size));
+  CloseHandle (fm);
+#else
+  char *map = static_cast<char*> (mmap (0, file_size, PROT_WRITE, MAP_SHARED, fd, 0));
+  if (map == reinterpret_cast<char*> (-1))    // MAP_FAILED
+  {
+    pcl_close (fd);
+    resetLockingPermissions (file_name, file_lock);
+    PCL_ERROR ("[pcl::PCDWriter::writeBinaryCompressedChunked] Error during mmap ()!\n");
+    return (-1);
+  }
+#endif
+
+  // Copy the header, the index and the chunks
+  memcpy (&map[0], oss.str ().c_str (), data_idx);
+  memcpy (&map[data_idx], &index[0], index_size);
+#ifdef _OPENMP
+#pragma omp parallel for num_threads (getNumberOfThreads (threads_))
+#endif
+  for (int k = 0; k < nr_chunks; ++k)
+    memcpy (&map[data_idx + chunk_offsets[k]], &chunks[k][0], chunks[k].size ());
+
+#ifndef _WIN32
+  // If the user set the synchronization flag on, call msync
+  if (map_synchronization_)
+    msync (map, file_size, MS_SYNC);
+#endif
+
+  // Unmap the pages of memory
+#ifdef _WIN32
+  UnmapViewOfFile (map);
+#else
+  if (munmap (map, file_size) == -1)
+  {
+    pcl_close (fd);
+    resetLockingPermissions (file_name, file_lock);
+    PCL_ERROR ("[pcl::PCDWriter::writeBinaryCompressedChunked] Error during munmap ()!\n");
+    return (-1);
+  }
+#endif
+  // Close file
+#ifdef _WIN32
+  CloseHandle (h_native_file);
+#else
+  pcl_close (fd);
+#endif
+  resetLockingPermissions (file_name, file_lock);
+  return (0);
+}
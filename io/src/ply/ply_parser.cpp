@@ -39,6 +39,86 @@
  */
 
 #include <pcl/io/ply/ply_parser.h>
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+#ifdef _OPENMP
+# include <omp.h>
+#endif
+
+namespace
+{
+  /** Size in bytes of the blocks in which the records of binary elements are read. */
+  const std::size_t records_block_size = 1 << 22;
+
+  unsigned int
+  get_number_of_threads (unsigned int threads)
+  {
+#ifdef _OPENMP
+    return (threads ? threads : static_cast<unsigned int> (omp_get_max_threads ()));
+#else
+    (void) threads;
+    return (1);
+#endif
+  }
+
+  /** Byte swap the \a size bytes value at \a value in place. */
+  inline void
+  swap_value (char* value, std::size_t size)
+  {
+    switch (size)
+    {
+      case 2: pcl::io::ply::swap_byte_order<2> (value); break;
+      case 4: pcl::io::ply::swap_byte_order<4> (value); break;
+      case 8: pcl::io::ply::swap_byte_order<8> (value); break;
+    }
+  }
+
+  /** Byte swap the values of \a count records of \a stride bytes, starting at \a data. 
+    * Swapping a single column of fixed size at a time keeps the loop free of branches.
+    */
+  template <std::size_t N> void
+  swap_column (char* data, std::size_t count, std::size_t stride, unsigned int threads)
+  {
+    (void) threads;
+#ifdef _OPENMP
+#pragma omp parallel for num_threads (threads)
+#endif
+    for (int i = 0; i < static_cast<int> (count); ++i)
+      pcl::io::ply::swap_byte_order<N> (data + static_cast<std::size_t> (i) * stride);
+  }
+
+  /** Read the \a size bytes list size at \a data, which must be 1, 2 or 4. */
+  inline std::size_t
+  read_list_size (const char* data, std::size_t size, bool swap)
+  {
+    switch (size)
+    {
+      case 1:
+        return (static_cast<unsigned char> (data[0]));
+      case 2:
+      {
+        pcl::io::ply::uint16 value;
+        std::memcpy (&value, data, sizeof (value));
+        if (swap)
+          pcl::io::ply::swap_byte_order (value);
+        return (value);
+      }
+      case 4:
+      {
+        pcl::io::ply::uint32 value;
+        std::memcpy (&value, data, sizeof (value));
+        if (swap)
+          pcl::io::ply::swap_byte_order (value);
+        return (value);
+      }
+      default:
+        assert (false);
+        return (0);
+    }
+  }
+}
 
 bool pcl::io::ply::ply_parser::parse (const std::string& filename)
 {
@@ -573,6 +653,22 @@ bool pcl::io::ply::ply_parser::parse (const std::string& filename)
          ++element_iterator)
     {
       struct element& element = *(element_iterator->get ());
+      element_records_callback_type element_records_callback;
+      if (element_records_definition_callback_ && !element.properties.empty ())
+      {
+        std::vector<std::string> property_names;
+        for (std::vector< boost::shared_ptr<property> >::const_iterator property_iterator = element.properties.begin (); 
+             property_iterator != element.properties.end (); 
+             ++property_iterator)
+          property_names.push_back ((*property_iterator)->name);
+        element_records_callback = element_records_definition_callback_ (element.name, property_names);
+      }
+      if (element_records_callback)
+      {
+        if (parse_element_records (element, format, istream, element_records_callback) == false)
+          return false;
+        continue;
+      }
       for (std::size_t element_index = 0; element_index < element.count; ++element_index)
       {
         if (element.begin_element_callback) {
@@ -605,3 +701,157 @@ bool pcl::io::ply::ply_parser::parse (const std::string& filename)
     return true;
   }
 }
+
+bool pcl::io::ply::ply_parser::parse_element_records (const element& element, 
+                                                      format_type format, 
+                                                      std::istream& istream, 
+                                                      const element_records_callback_type& element_records_callback)
+{
+  const bool swap = ((format == binary_big_endian_format) && (host_byte_order == little_endian_byte_order)) ||
+                    ((format == binary_little_endian_format) && (host_byte_order == big_endian_byte_order));
+  const unsigned int threads = get_number_of_threads (number_of_threads_);
+  const std::vector< boost::shared_ptr<property> >& properties = element.properties;
+
+  std::size_t record_size = 0;
+  bool fixed_size = true;
+  for (std::size_t p = 0; p < properties.size (); ++p)
+  {
+    if (properties[p]->list_size_size > 0)
+      fixed_size = false;
+    record_size += properties[p]->value_size;
+  }
+
+  std::vector<char> buffer;
+  std::size_t done = 0;
+
+  // Records of scalars only: read whole blocks and swap them a column at a time
+  if (fixed_size)
+  {
+    const std::size_t block_count = std::max<std::size_t> (records_block_size / record_size, 1);
+    buffer.resize (std::min (block_count, element.count) * record_size);
+    while (done < element.count)
+    {
+      const std::size_t count = std::min (block_count, element.count - done);
+      istream.read (&buffer[0], count * record_size);
+      if (!istream)
+      {
+        if (error_callback_)
+          error_callback_ (line_number_, "parse error");
+        return false;
+      }
+      if (swap)
+      {
+        std::size_t offset = 0;
+        for (std::size_t p = 0; p < properties.size (); ++p)
+        {
+          switch (properties[p]->value_size)
+          {
+            case 2: swap_column<2> (&buffer[offset], count, record_size, threads); break;
+            case 4: swap_column<4> (&buffer[offset], count, record_size, threads); break;
+            case 8: swap_column<8> (&buffer[offset], count, record_size, threads); break;
+          }
+          offset += properties[p]->value_size;
+        }
+      }
+      if (!element_records_callback (&buffer[0], count, NULL))
+      {
+        if (error_callback_)
+          error_callback_ (line_number_, "parse error");
+        return false;
+      }
+      done += count;
+    }
+    return true;
+  }
+
+  // Records with lists: locate them one after the other, then swap them in parallel
+  buffer.resize (records_block_size);
+  std::vector<std::size_t> offsets;
+  std::size_t filled = 0;
+  while (done < element.count)
+  {
+    istream.read (&buffer[filled], buffer.size () - filled);
+    filled += static_cast<std::size_t> (istream.gcount ());
+    const bool at_end = !istream;
+    istream.clear ();
+
+    offsets.clear ();
+    std::size_t record = 0;
+    while (done + offsets.size () < element.count)
+    {
+      std::size_t next = record;
+      for (std::size_t p = 0; p < properties.size () && next <= filled; ++p)
+      {
+        if (properties[p]->list_size_size > 0)
+        {
+          if (next + properties[p]->list_size_size > filled)
+          {
+            next = filled + 1;
+            break;
+          }
+          std::size_t size = read_list_size (&buffer[next], properties[p]->list_size_size, swap);
+          next += properties[p]->list_size_size + size * properties[p]->value_size;
+        }
+        else
+          next += properties[p]->value_size;
+      }
+      if (next > filled)
+        break;
+      offsets.push_back (record);
+      record = next;
+    }
+
+    if (offsets.empty ())
+    {
+      if (at_end)
+      {
+        if (error_callback_)
+          error_callback_ (line_number_, "parse error");
+        return false;
+      }
+      // A single record does not fit in the buffer
+      buffer.resize (buffer.size () * 2);
+      continue;
+    }
+
+    if (swap)
+    {
+#ifdef _OPENMP
+#pragma omp parallel for num_threads (threads)
+#endif
+      for (int i = 0; i < static_cast<int> (offsets.size ()); ++i)
+      {
+        char* value = &buffer[offsets[i]];
+        for (std::size_t p = 0; p < properties.size (); ++p)
+        {
+          std::size_t size = 1;
+          if (properties[p]->list_size_size > 0)
+          {
+            swap_value (value, properties[p]->list_size_size);
+            size = read_list_size (value, properties[p]->list_size_size, false);
+            value += properties[p]->list_size_size;
+          }
+          for (std::size_t j = 0; j < size; ++j, value += properties[p]->value_size)
+            swap_value (value, properties[p]->value_size);
+        }
+      }
+    }
+
+    if (!element_records_callback (&buffer[0], offsets.size (), &offsets[0]))
+    {
+      if (error_callback_)
+        error_callback_ (line_number_, "parse error");
+      return false;
+    }
+    done += offsets.size ();
+
+    // Keep the partial record at the end of the block for the next one
+    std::copy (buffer.begin () + record, buffer.begin () + filled, buffer.begin ());
+    filled -= record;
+  }
+
+  // Give back the bytes read beyond the element
+  if (filled > 0)
+    istream.seekg (-static_cast<std::streamoff> (filled), std::ios::cur);
+  return true;
+}
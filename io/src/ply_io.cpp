@@ -46,6 +46,24 @@
 #include <pcl/io/boost.h>
 #include <sstream>
 
+#ifdef _OPENMP
+# include <omp.h>
+#endif
+
+namespace
+{
+  unsigned int
+  getNumberOfThreads (unsigned int threads)
+  {
+#ifdef _OPENMP
+    return (threads ? threads : static_cast<unsigned int> (omp_get_max_threads ()));
+#else
+    (void) threads;
+    return (1);
+#endif
+  }
+}
+
 boost::tuple<boost::function<void ()>, boost::function<void ()> >
 pcl::PLYReader::elementDefinitionCallback (const std::string& element_name, std::size_t count)
 {
@@ -63,12 +81,16 @@ pcl::PLYReader::elementDefinitionCallback (const std::string& element_name, std:
     cloud_->point_step = 0;
     cloud_->row_step = 0;
     vertex_count_ = 0;
+    do_resize_ = false;
+    vertex_properties_.clear ();
+    vertex_record_size_ = 0;
     return (boost::tuple<boost::function<void ()>, boost::function<void ()> > (
               boost::bind (&pcl::PLYReader::vertexBeginCallback, this),
               boost::bind (&pcl::PLYReader::vertexEndCallback, this)));
   }
   else if ((element_name == "face") && polygons_)
   {
+    face_vertex_indices_ = false;
     polygons_->reserve (count);
     return (boost::tuple<boost::function<void ()>, boost::function<void ()> > (
             boost::bind (&pcl::PLYReader::faceBeginCallback, this),
@@ -111,6 +133,41 @@ pcl::PLYReader::appendScalarProperty (const std::string& name, const size_t& siz
   cloud_->point_step += static_cast<uint32_t> (pcl::getFieldSize (pcl::traits::asEnum<Scalar>::value) * size);
 }
 
+void
+pcl::PLYReader::addVertexProperty (int kind, size_t size, size_t offset)
+{
+  // Properties stored back to back in the points are copied at once
+  if (kind == VertexProperty::COPY && !vertex_properties_.empty ())
+  {
+    VertexProperty &last = vertex_properties_.back ();
+    if (last.kind == VertexProperty::COPY &&
+        last.record_offset + last.size == vertex_record_size_ &&
+        last.point_offset + last.size == offset)
+    {
+      last.size += size;
+      vertex_record_size_ += size;
+      return;
+    }
+  }
+  VertexProperty property;
+  property.kind = kind;
+  property.record_offset = vertex_record_size_;
+  property.point_offset = offset;
+  property.size = size;
+  vertex_properties_.push_back (property);
+  vertex_record_size_ += size;
+}
+
+size_t
+pcl::PLYReader::getColorOffset () const
+{
+  std::vector< ::pcl::PCLPointField>::const_reverse_iterator finder = cloud_->fields.rbegin ();
+  for (; finder != cloud_->fields.rend (); ++finder)
+    if (finder->name == "rgb" || finder->name == "rgba")
+      return (finder->offset);
+  return (0);
+}
+
 void
 pcl::PLYReader::amendProperty (const std::string& old_name, const std::string& new_name, uint8_t new_datatype)
 {
@@ -132,6 +189,7 @@ namespace pcl
   {
     if (element_name == "vertex")
     {
+      addVertexProperty (VertexProperty::COPY, sizeof (pcl::io::ply::float32), cloud_->point_step);
       appendScalarProperty<pcl::io::ply::float32> (property_name, 1);
       return (boost::bind (&pcl::PLYReader::vertexScalarPropertyCallback<pcl::io::ply::float32>, this, _1));
     }
@@ -205,21 +263,31 @@ namespace pcl
           (property_name == "diffuse_red") || (property_name == "diffuse_green") || (property_name == "diffuse_blue"))
       {
         if ((property_name == "red") || (property_name == "diffuse_red"))
+        {
           appendScalarProperty<pcl::io::ply::float32> ("rgb");
+          addVertexProperty (VertexProperty::RED, 1, getColorOffset ());
+        }
+        else if ((property_name == "green") || (property_name == "diffuse_green"))
+          addVertexProperty (VertexProperty::GREEN, 1, getColorOffset ());
+        else
+          addVertexProperty (VertexProperty::BLUE, 1, getColorOffset ());
         return boost::bind (&pcl::PLYReader::vertexColorCallback, this, property_name, _1);
       }
       else if (property_name == "alpha")
       {
         amendProperty ("rgb", "rgba", pcl::PCLPointField::UINT32);
+        addVertexProperty (VertexProperty::ALPHA, 1, getColorOffset ());
         return boost::bind (&pcl::PLYReader::vertexAlphaCallback, this, _1);
       }
       else if (property_name == "intensity")
       {
+        addVertexProperty (VertexProperty::INTENSITY, 1, cloud_->point_step);
         appendScalarProperty<pcl::io::ply::float32> (property_name);
         return boost::bind (&pcl::PLYReader::vertexIntensityCallback, this, _1);
       }
       else
       {
+        addVertexProperty (VertexProperty::COPY, 1, cloud_->point_step);
         appendScalarProperty<pcl::io::ply::uint8> (property_name);
         return boost::bind (&pcl::PLYReader::vertexScalarPropertyCallback<pcl::io::ply::uint8>, this, _1);
       }
@@ -233,6 +301,7 @@ namespace pcl
   {
     if (element_name == "vertex")
     {
+      addVertexProperty (VertexProperty::COPY, sizeof (pcl::io::ply::int32), cloud_->point_step);
       appendScalarProperty<pcl::io::ply::int32> (property_name, 1);
       return (boost::bind (&pcl::PLYReader::vertexScalarPropertyCallback<pcl::io::ply::int32>, this, _1));
     }
@@ -258,6 +327,7 @@ namespace pcl
   {
     if (element_name == "vertex")
     {
+      addVertexProperty (VertexProperty::COPY, sizeof (Scalar), cloud_->point_step);
       appendScalarProperty<Scalar> (property_name, 1);
       return (boost::bind (&pcl::PLYReader::vertexScalarPropertyCallback<Scalar>, this, _1));
     }
@@ -311,6 +381,7 @@ namespace pcl
     }
     else if ((element_name == "face") && (property_name == "vertex_indices"))
     {
+      face_vertex_indices_ = true;
       return boost::tuple<boost::function<void (pcl::io::ply::uint8)>, boost::function<void (pcl::io::ply::int32)>, boost::function<void ()> > (
         boost::bind (&pcl::PLYReader::faceVertexIndicesBeginCallback, this, _1),
         boost::bind (&pcl::PLYReader::faceVertexIndicesElementCallback, this, _1),
@@ -516,6 +587,103 @@ pcl::PLYReader::objInfoCallback (const std::string& line)
 void
 pcl::PLYReader::vertexListPropertyEndCallback () {}
 
+pcl::io::ply::ply_parser::element_records_callback_type
+pcl::PLYReader::elementRecordsDefinitionCallback (const std::string& element_name, const std::vector<std::string>& property_names)
+{
+  // Vertices made of scalars only, list properties need the per value callbacks
+  if ((element_name == "vertex") && !do_resize_ && (vertex_record_size_ > 0))
+    return (boost::bind (&pcl::PLYReader::vertexRecordsCallback, this, _1, _2));
+  else if ((element_name == "face") && polygons_ && face_vertex_indices_ &&
+           (property_names.size () == 1) && (property_names[0] == "vertex_indices"))
+    return (boost::bind (&pcl::PLYReader::faceRecordsCallback, this, _1, _2, _3));
+  else
+    return (0);
+}
+
+bool
+pcl::PLYReader::vertexRecordsCallback (const char* records, std::size_t count)
+{
+  const size_t point_step = cloud_->point_step;
+  if ((vertex_count_ + count) * point_step > cloud_->data.size ())
+  {
+    PCL_ERROR ("[pcl::PLYReader] More vertices than the %u x %u points of the cloud!\n", cloud_->width, cloud_->height);
+    return (false);
+  }
+  pcl::uint8_t *points = &cloud_->data[vertex_count_ * point_step];
+
+  // Records laid out exactly like the points
+  if ((vertex_properties_.size () == 1) && (vertex_properties_[0].kind == VertexProperty::COPY) &&
+      (vertex_record_size_ == point_step))
+  {
+    memcpy (points, records, count * point_step);
+    vertex_count_ += count;
+    return (true);
+  }
+
+  const VertexProperty *properties = &vertex_properties_[0];
+  const size_t nr_properties = vertex_properties_.size ();
+  const size_t record_size = vertex_record_size_;
+#ifdef _OPENMP
+#pragma omp parallel for num_threads (getNumberOfThreads (threads_))
+#endif
+  for (int i = 0; i < static_cast<int> (count); ++i)
+  {
+    const char *record = records + static_cast<size_t> (i) * record_size;
+    pcl::uint8_t *point = points + static_cast<size_t> (i) * point_step;
+    for (size_t p = 0; p < nr_properties; ++p)
+    {
+      const VertexProperty &property = properties[p];
+      const pcl::uint32_t value = static_cast<pcl::uint8_t> (record[property.record_offset]);
+      pcl::uint32_t rgba;
+      switch (property.kind)
+      {
+        case VertexProperty::COPY:
+          memcpy (point + property.point_offset, record + property.record_offset, property.size);
+          break;
+        case VertexProperty::RED:
+          rgba = value << 16;
+          memcpy (point + property.point_offset, &rgba, sizeof (pcl::uint32_t));
+          break;
+        case VertexProperty::GREEN:
+        case VertexProperty::BLUE:
+        case VertexProperty::ALPHA:
+          memcpy (&rgba, point + property.point_offset, sizeof (pcl::uint32_t));
+          rgba |= value << (property.kind == VertexProperty::GREEN ? 8 : property.kind == VertexProperty::ALPHA ? 24 : 0);
+          memcpy (point + property.point_offset, &rgba, sizeof (pcl::uint32_t));
+          break;
+        case VertexProperty::INTENSITY:
+        {
+          pcl::io::ply::float32 intensity = static_cast<pcl::io::ply::float32> (value);
+          memcpy (point + property.point_offset, &intensity, sizeof (pcl::io::ply::float32));
+          break;
+        }
+      }
+    }
+  }
+  vertex_count_ += count;
+  return (true);
+}
+
+bool
+pcl::PLYReader::faceRecordsCallback (const char* records, std::size_t count, const std::size_t* offsets)
+{
+  const size_t first = polygons_->size ();
+  polygons_->resize (first + count);
+  std::vector<pcl::Vertices> &polygons = *polygons_;
+#ifdef _OPENMP
+#pragma omp parallel for num_threads (getNumberOfThreads (threads_))
+#endif
+  for (int i = 0; i < static_cast<int> (count); ++i)
+  {
+    const char *record = records + offsets[i];
+    std::vector<pcl::uint32_t> &vertices = polygons[first + i].vertices;
+    vertices.resize (static_cast<pcl::io::ply::uint8> (record[0]));
+    if (!vertices.empty ())
+      memcpy (&vertices[0], record + sizeof (pcl::io::ply::uint8), vertices.size () * sizeof (pcl::io::ply::int32));
+  }
+  return (true);
+}
+
 bool
 pcl::PLYReader::parse (const std::string& istream_filename)
 {
@@ -529,6 +697,8 @@ pcl::PLYReader::parse (const std::string& istream_filename)
   ply_parser.obj_info_callback (boost::bind (&pcl::PLYReader::objInfoCallback, this, _1));
   ply_parser.element_definition_callback (boost::bind (&pcl::PLYReader::elementDefinitionCallback, this, _1, _2));
   ply_parser.end_header_callback (boost::bind (&pcl::PLYReader::endHeaderCallback, this));
+  ply_parser.element_records_definition_callback (boost::bind (&pcl::PLYReader::elementRecordsDefinitionCallback, this, _1, _2));
+  ply_parser.number_of_threads (threads_);
 
   pcl::io::ply::ply_parser::scalar_property_definition_callbacks_type scalar_property_definition_callbacks;
   pcl::io::ply::at<pcl::io::ply::float64> (scalar_property_definition_callbacks) = boost::bind (&pcl::PLYReader::scalarPropertyDefinitionCallback<pcl::io::ply::float64>, this, _1, _2);
@@ -55,7 +55,7 @@ main (int argc, char** argv)
 {
   if (argc < 4)
   {
-    std::cerr << "Syntax is: " << argv[0] << " <file_in.pcd> <file_out.pcd> 0/1/2 (ascii/binary/binary_compressed) [precision (ASCII)]" << std::endl;
+    std::cerr << "Syntax is: " << argv[0] << " <file_in.pcd> <file_out.pcd> 0/1/2/3 (ascii/binary/binary_compressed/binary_compressed_chunked) [precision (ASCII)]" << std::endl;
     return (-1);
   }
 
@@ -90,5 +90,10 @@ main (int argc, char** argv)
     std::cerr << "Saving file " << argv[2] << " as binary_compressed." << std::endl;
     w.writeBinaryCompressed (string (argv[2]), cloud, origin, orientation);
   }
+  else if (type == 3)
+  {
+    std::cerr << "Saving file " << argv[2] << " as binary_compressed_chunked." << std::endl;
+    w.writeBinaryCompressedChunked (string (argv[2]), cloud, origin, orientation);
+  }
 }
 /* ]--- */
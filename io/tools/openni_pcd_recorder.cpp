@@ -36,11 +36,9 @@
 #include <pcl/point_cloud.h>
 #include <pcl/point_types.h>
 #include <pcl/io/openni_grabber.h>
-#include <boost/thread/condition.hpp>
-#include <boost/circular_buffer.hpp>
 #include <csignal>
 #include <limits>
-#include <pcl/io/pcd_io.h>
+#include <pcl/io/async_pcd_writer.h>
 #include <pcl/console/print.h>
 #include <pcl/console/parse.h>
 #include <pcl/common/time.h> //fps calculations
@@ -95,235 +93,82 @@ const int BUFFER_SIZE = 200;
 #endif
 
 //////////////////////////////////////////////////////////////////////////////////////////
+// Hands every grabbed cloud to the asynchronous writer, the grabber thread never waits for the disk
 template <typename PointT>
-class PCDBuffer
-{
-  public:
-    PCDBuffer () {}
-
-    bool 
-    pushBack (typename PointCloud<PointT>::ConstPtr); // thread-save wrapper for push_back() method of ciruclar_buffer
-
-    typename PointCloud<PointT>::ConstPtr 
-    getFront (); // thread-save wrapper for front() method of ciruclar_buffer
-
-    inline bool 
-    isFull ()
-    {
-      boost::mutex::scoped_lock buff_lock (bmutex_);
-      return (buffer_.full ());
-    }
-
-    inline bool
-    isEmpty ()
-    {
-      boost::mutex::scoped_lock buff_lock (bmutex_);
-      return (buffer_.empty ());
-    }
-
-    inline int 
-    getSize ()
-    {
-      boost::mutex::scoped_lock buff_lock (bmutex_);
-      return (int (buffer_.size ()));
-    }
-
-    inline int 
-    getCapacity ()
-    {
-      return (int (buffer_.capacity ()));
-    }
-
-    inline void 
-    setCapacity (int buff_size)
-    {
-      boost::mutex::scoped_lock buff_lock (bmutex_);
-      buffer_.set_capacity (buff_size);
-    }
-
-  private:
-    PCDBuffer (const PCDBuffer&); // Disabled copy constructor
-    PCDBuffer& operator =(const PCDBuffer&); // Disabled assignment operator
-
-    boost::mutex bmutex_;
-    boost::condition_variable buff_empty_;
-    boost::circular_buffer<typename PointCloud<PointT>::ConstPtr> buffer_;
-};
-
-//////////////////////////////////////////////////////////////////////////////////////////
-template <typename PointT> bool 
-PCDBuffer<PointT>::pushBack (typename PointCloud<PointT>::ConstPtr cloud)
-{
-  bool retVal = false;
-  {
-    boost::mutex::scoped_lock buff_lock (bmutex_);
-    if (!buffer_.full ())
-      retVal = true;
-    buffer_.push_back (cloud);
-  }
-  buff_empty_.notify_one ();
-  return (retVal);
-}
-
-//////////////////////////////////////////////////////////////////////////////////////////
-template <typename PointT> typename PointCloud<PointT>::ConstPtr 
-PCDBuffer<PointT>::getFront ()
-{
-  typename PointCloud<PointT>::ConstPtr cloud;
-  {
-    boost::mutex::scoped_lock buff_lock (bmutex_);
-    while (buffer_.empty ())
-    {
-      if (is_done)
-        break;
-      {
-        boost::mutex::scoped_lock io_lock (io_mutex);
-        //cerr << "No data in buffer_ yet or buffer is empty." << endl;
-      }
-      buff_empty_.wait (buff_lock);
-    }
-    cloud = buffer_.front ();
-    buffer_.pop_front ();
-  }
-  return (cloud);
-}
-
-#define FPS_CALC(_WHAT_, buff) \
-do \
-{ \
-    static unsigned count = 0;\
-    static double last = getTime ();\
-    double now = getTime (); \
-    ++count; \
-    if (now - last >= 1.0) \
-    { \
-      cerr << "Average framerate("<< _WHAT_ << "): " << double(count)/double(now - last) << " Hz. Queue size: " << buff.getSize () << "\n"; \
-      count = 0; \
-      last = now; \
-    } \
-}while(false)
-
-//////////////////////////////////////////////////////////////////////////////////////////
-// Producer thread class
-template <typename PointT>
-class Producer
+class Recorder
 {
   private:
     ///////////////////////////////////////////////////////////////////////////////////////
     void 
     grabberCallBack (const typename PointCloud<PointT>::ConstPtr& cloud)
     {
-      if (!buf_.pushBack (cloud))
+      // Name the file after the acquisition time, not the time it reaches the disk
+      stringstream ss;
+      ss << "frame-" << boost::posix_time::to_iso_string (boost::posix_time::microsec_clock::local_time ()) << ".pcd";
+      if (!writer_.template write<PointT> (ss.str (), cloud))
       {
-        {
-          boost::mutex::scoped_lock io_lock (io_mutex);
-          print_warn ("Warning! Buffer was full, overwriting data!\n");
-        }
+        boost::mutex::scoped_lock io_lock (io_mutex);
+        print_warn ("Warning! Buffer was full, dropping data!\n");
       }
-      FPS_CALC ("cloud callback.", buf_);
-    }
-
-    ///////////////////////////////////////////////////////////////////////////////////////
-    void 
-    grabAndSend ()
-    {
-      OpenNIGrabber* grabber = new OpenNIGrabber ();
-      grabber->getDevice ()->setDepthOutputFormat (depth_mode_);
-
-      Grabber* interface = grabber;
-      boost::function<void (const typename PointCloud<PointT>::ConstPtr&)> f = boost::bind (&Producer::grabberCallBack, this, _1);
-      interface->registerCallback (f);
-      interface->start ();
 
-      while (true)
+      static unsigned count = 0;
+      static double last = getTime ();
+      double now = getTime ();
+      ++count;
+      if (now - last >= 1.0)
       {
-        if (is_done)
-          break;
-        boost::this_thread::sleep (boost::posix_time::seconds (1));
+        pcl::io::AsyncPCDWriter::Statistics stats = writer_.getStatistics ();
+        boost::mutex::scoped_lock io_lock (io_mutex);
+        cerr << "Average framerate(cloud callback.): " << double (count) / double (now - last) << " Hz. "
+             << "Queue size: " << stats.queue_size << " (max " << stats.max_queue_size << "), "
+             << "written: " << stats.written << ", dropped: " << stats.dropped << ", failed: " << stats.failed << "\n";
+        count = 0;
+        last = now;
       }
-      interface->stop ();
     }
 
   public:
-    Producer (PCDBuffer<PointT> &buf, openni_wrapper::OpenNIDevice::DepthMode depth_mode)
-      : buf_ (buf),
+    Recorder (OpenNIGrabber &grabber, pcl::io::AsyncPCDWriter &writer, openni_wrapper::OpenNIDevice::DepthMode depth_mode)
+      : grabber_ (grabber),
+        writer_ (writer),
         depth_mode_ (depth_mode)
     {
-      thread_.reset (new boost::thread (boost::bind (&Producer::grabAndSend, this)));
     }
 
     ///////////////////////////////////////////////////////////////////////////////////////
     void
-    stop ()
+    run ()
     {
-      thread_->join ();
-      boost::mutex::scoped_lock io_lock (io_mutex);
-      print_highlight ("Producer done.\n");
-    }
+      grabber_.getDevice ()->setDepthOutputFormat (depth_mode_);
 
-  private:
-    PCDBuffer<PointT> &buf_;
-    openni_wrapper::OpenNIDevice::DepthMode depth_mode_;
-    boost::shared_ptr<boost::thread> thread_;
-};
-
-//////////////////////////////////////////////////////////////////////////////////////////
-// Consumer thread class
-template <typename PointT>
-class Consumer
-{
-  private:
-    ///////////////////////////////////////////////////////////////////////////////////////
-    void 
-    writeToDisk (const typename PointCloud<PointT>::ConstPtr& cloud)
-    {
-      stringstream ss;
-      std::string time = boost::posix_time::to_iso_string (boost::posix_time::microsec_clock::local_time ());
-      ss << "frame-" << time << ".pcd";
-      writer_.writeBinaryCompressed (ss.str (), *cloud);
-      FPS_CALC ("cloud write.", buf_);
-    }
+      boost::function<void (const typename PointCloud<PointT>::ConstPtr&)> f = boost::bind (&Recorder::grabberCallBack, this, _1);
+      grabber_.registerCallback (f);
+      grabber_.start ();
 
-    ///////////////////////////////////////////////////////////////////////////////////////
-    // Consumer thread function
-    void 
-    receiveAndProcess ()
-    {
-      while (true)
-      {
-        if (is_done)
-          break;
-        writeToDisk (buf_.getFront ());
-      }
+      while (!is_done)
+        boost::this_thread::sleep (boost::posix_time::seconds (1));
+      grabber_.stop ();
 
       {
         boost::mutex::scoped_lock io_lock (io_mutex);
-        print_info ("Writing remaing %ld clouds in the buffer to disk...\n", buf_.getSize ());
+        print_info ("Writing remaining %lu clouds in the buffer to disk...\n", writer_.getStatistics ().queue_size);
       }
-      while (!buf_.isEmpty ())
-        writeToDisk (buf_.getFront ());
-    }
-
-  public:
-    Consumer (PCDBuffer<PointT> &buf)
-      : buf_ (buf)
-    {
-      thread_.reset (new boost::thread (boost::bind (&Consumer::receiveAndProcess, this)));
-    }
+      writer_.flush ();
 
-    ///////////////////////////////////////////////////////////////////////////////////////
-    void
-    stop ()
-    {
-      thread_->join ();
+      pcl::io::AsyncPCDWriter::Statistics stats = writer_.getStatistics ();
       boost::mutex::scoped_lock io_lock (io_mutex);
-      print_highlight ("Consumer done.\n");
+      print_highlight ("Recorder done. ");
+      print_info ("Written: "); print_value ("%lu", stats.written);
+      print_info (", dropped: "); print_value ("%lu", stats.dropped);
+      print_info (", failed: "); print_value ("%lu", stats.failed);
+      print_info (", average write time: "); print_value ("%g", stats.written + stats.failed > 0 ? stats.total_write_time / double (stats.written + stats.failed) : 0.0);
+      print_info (" ms\n");
     }
 
   private:
-    PCDBuffer<PointT> &buf_;
-    boost::shared_ptr<boost::thread> thread_;
-    PCDWriter writer_;
+    OpenNIGrabber &grabber_;
+    pcl::io::AsyncPCDWriter &writer_;
+    openni_wrapper::OpenNIDevice::DepthMode depth_mode_;
 };
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -339,7 +184,7 @@ ctrlC (int)
 int 
 main (int argc, char** argv)
 {
-  print_highlight ("PCL OpenNI Recorder for saving buffered PCD (binary compressed to disk). See %s -h for options.\n", argv[0]);
+  print_highlight ("PCL OpenNI Recorder for saving buffered PCD (binary compressed by default) to disk. See %s -h for options.\n", argv[0]);
 
   int buff_size = BUFFER_SIZE;
   
@@ -350,6 +195,10 @@ main (int argc, char** argv)
               "             -shift  = use OpenNI shift values rather than 12-bit depth\n"
               "             -buf X  = use a buffer size of X frames (default: "); 
     print_value ("%d", buff_size); print_info (")\n");
+    print_info ("             -threads X = use X writer threads (default: 1)\n"
+                "             -format X  = 0 binary, 1 binary compressed (default), 2 binary compressed chunked\n"
+                "             -sync      = synchronize every file with the disk before writing the next one\n"
+                "             -drop_new  = drop new frames instead of the oldest ones when the buffer is full\n");
     return (0);
   }
 
@@ -364,35 +213,40 @@ main (int argc, char** argv)
   else
     print_highlight ("Using default buffer size of %d frames.\n", buff_size);
 
-  print_highlight ("Starting the producer and consumer threads... Press Cltr+C to end\n");
- 
+  unsigned int nr_threads = 1;
+  if (parse_argument (argc, argv, "-threads", nr_threads) != -1)
+    print_highlight ("Using %u writer threads.\n", nr_threads);
+
+  int format = pcl::io::AsyncPCDWriter::BINARY_COMPRESSED;
+  parse_argument (argc, argv, "-format", format);
+  if (format < pcl::io::AsyncPCDWriter::BINARY || format > pcl::io::AsyncPCDWriter::BINARY_COMPRESSED_CHUNKED)
+  {
+    print_error ("Invalid format %d, see %s -h for options.\n", format, argv[0]);
+    return (-1);
+  }
+
+  pcl::io::AsyncPCDWriter writer (buff_size, nr_threads);
+  writer.setFormat (static_cast<pcl::io::AsyncPCDWriter::Format> (format));
+  writer.setMapSynchronization (find_switch (argc, argv, "-sync"));
+  if (find_switch (argc, argv, "-drop_new"))
+    writer.setOverflowPolicy (pcl::io::AsyncPCDWriter::DROP_NEWEST);
+
+  print_highlight ("Starting the recorder... Press Cltr+C to end\n");
+  signal (SIGINT, ctrlC);
+
   OpenNIGrabber grabber ("");
   if (grabber.providesCallback<OpenNIGrabber::sig_cb_openni_point_cloud_rgba> () && 
       !just_xyz)
   {
     print_highlight ("PointXYZRGBA enabled.\n");
-    PCDBuffer<PointXYZRGBA> buf;
-    buf.setCapacity (buff_size);
-    Producer<PointXYZRGBA> producer (buf, depth_mode);
-    boost::this_thread::sleep (boost::posix_time::seconds (2));
-    Consumer<PointXYZRGBA> consumer (buf);
-
-    signal (SIGINT, ctrlC);
-    producer.stop ();
-    consumer.stop ();
+    Recorder<PointXYZRGBA> recorder (grabber, writer, depth_mode);
+    recorder.run ();
   }
   else
   {
     print_highlight ("PointXYZ enabled.\n");
-    PCDBuffer<PointXYZ> buf;
-    buf.setCapacity (buff_size);
-    Producer<PointXYZ> producer (buf, depth_mode);
-    boost::this_thread::sleep (boost::posix_time::seconds (2));
-    Consumer<PointXYZ> consumer (buf);
-
-    signal (SIGINT, ctrlC);
-    producer.stop ();
-    consumer.stop ();
+    Recorder<PointXYZ> recorder (grabber, writer, depth_mode);
+    recorder.run ();
   }
   return (0);
 }
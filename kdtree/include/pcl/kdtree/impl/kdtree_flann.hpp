@@ -43,6 +43,7 @@
 #include <pcl/kdtree/kdtree_flann.h>
 #include <pcl/kdtree/flann.h>
 #include <pcl/console/print.h>
+#include <pcl/common/profiler.h>
 
 ///////////////////////////////////////////////////////////////////////////////////////////
 template <typename PointT, typename Dist>
@@ -133,6 +134,7 @@ pcl::KdTreeFLANN<PointT, Dist>::nearestKSearch (const PointT &point, int k,
                                                 std::vector<int> &k_indices, 
                                                 std::vector<float> &k_distances) const
 {
+  PCL_PROFILE_SCOPE ("KdTreeFLANN::nearestKSearch");
   assert (point_representation_->isValid (point) && "Invalid (NaN, Inf) point coordinates given to nearestKSearch!");
 
   if (k > total_nr_points_)
@@ -169,6 +171,7 @@ template <typename PointT, typename Dist> int
 pcl::KdTreeFLANN<PointT, Dist>::radiusSearch (const PointT &point, double radius, std::vector<int> &k_indices,
                                               std::vector<float> &k_sqr_dists, unsigned int max_nn) const
 {
+  PCL_PROFILE_SCOPE ("KdTreeFLANN::radiusSearch");
   assert (point_representation_->isValid (point) && "Invalid (NaN, Inf) point coordinates given to radiusSearch!");
 
   std::vector<float> query (dim_);
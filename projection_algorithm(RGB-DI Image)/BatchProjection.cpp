@@ -0,0 +1,212 @@
+#include "BatchProjection.h"
+#include <stdio.h>
+#include <fstream>
+#include <algorithm>
+#include <set>
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/algorithm/string.hpp>
+#include <pcl/common/time.h>
+
+static const char *stageNames[BatchProjection::STAGE_COUNT] = { "load", "filter", "project", "encode" };
+
+BatchProjection::BatchProjection(ProjectionAlgorithm &algorithm)
+:m_algorithm(algorithm), m_flag(1), m_format(FORMAT_AUTO), m_outputDir("."),
+m_queueDepth(2), m_writeMirror(false), m_wallTime(0)
+{
+	for (int s = 0; s < STAGE_COUNT; s++)
+	{
+		m_stats[s].name = stageNames[s];
+		m_stats[s].frames = m_stats[s].failures = m_stats[s].points = 0;
+		m_stats[s].busy = m_stats[s].starved = m_stats[s].blocked = 0;
+	}
+}
+
+BatchProjection::~BatchProjection()
+{
+}
+
+bool BatchProjection::collectInputs(const std::string &source, std::vector<std::string> &files)
+{
+	namespace fs = boost::filesystem;
+	files.clear();
+	if (fs::is_directory(source))
+	{
+		for (fs::directory_iterator it(source), end; it != end; ++it)
+		{
+			if (!fs::is_regular_file(it->status()))
+				continue;
+			std::string ext = boost::algorithm::to_lower_copy(it->path().extension().string());
+			if (ext == ".txt" || ext == ".pcd" || ext == ".bin" || ext == ".raw")
+				files.push_back(it->path().string());
+		}
+		std::sort(files.begin(), files.end());
+		return !files.empty();
+	}
+
+	std::ifstream list(source.c_str());
+	if (!list)
+		return false;
+	std::string line;
+	while (std::getline(list, line))
+	{
+		boost::algorithm::trim(line);
+		if (!line.empty() && line[0] != '#')
+			files.push_back(line);
+	}
+	return !files.empty();
+}
+
+size_t BatchProjection::run(const std::vector<std::string> &files)
+{
+	for (int s = 0; s < STAGE_COUNT; s++)
+	{
+		m_stats[s].frames = m_stats[s].failures = m_stats[s].points = 0;
+		m_stats[s].busy = m_stats[s].starved = m_stats[s].blocked = 0;
+	}
+	boost::filesystem::create_directories(m_outputDir);
+
+	pcl::StopWatch wall;
+	FrameQueue loaded(m_queueDepth), filtered(m_queueDepth), projected(m_queueDepth);
+	boost::thread_group stages;
+	stages.create_thread(boost::bind(&BatchProjection::loadStage, this, &files, &loaded));
+	stages.create_thread(boost::bind(&BatchProjection::stageLoop, this, STAGE_FILTER, &loaded, &filtered));
+	stages.create_thread(boost::bind(&BatchProjection::stageLoop, this, STAGE_PROJECT, &filtered, &projected));
+	stages.create_thread(boost::bind(&BatchProjection::stageLoop, this, STAGE_ENCODE, &projected, static_cast<FrameQueue*>(NULL)));
+	stages.join_all();
+	m_wallTime = wall.getTimeSeconds();
+	return m_stats[STAGE_ENCODE].frames;
+}
+
+void BatchProjection::loadStage(const std::vector<std::string> *files, FrameQueue *out)
+{
+	StageStatistics &stats = m_stats[STAGE_LOAD];
+	pcl::StopWatch watch;
+	//scan.txt and scan.pcd keep their extension, a/scan.txt and b/scan.txt get the index
+	std::set<std::string> names;
+	for (size_t i = 0; i < files->size(); i++)
+	{
+		ProjectionFramePtr frame(new ProjectionFrame);
+		frame->index = i;
+		frame->input = (*files)[i];
+		std::string name = boost::filesystem::path(frame->input).filename().string();
+		if (!names.insert(name).second)
+		{
+			char suffix[32];
+			sprintf(suffix, "_%u", static_cast<unsigned int>(i));
+			name += suffix;
+			names.insert(name);
+		}
+		frame->stem = (boost::filesystem::path(m_outputDir) / name).string();
+		frame->ok = true;
+		frame->pointCount = 0;
+
+		watch.reset();
+		process(STAGE_LOAD, *frame);
+		stats.busy += watch.getTimeSeconds();
+
+		watch.reset();
+		out->push(frame);
+		stats.blocked += watch.getTimeSeconds();
+	}
+	//an empty frame marks the end of the input
+	out->push(ProjectionFramePtr());
+}
+
+void BatchProjection::stageLoop(int stage, FrameQueue *in, FrameQueue *out)
+{
+	StageStatistics &stats = m_stats[stage];
+	pcl::StopWatch watch;
+	while (true)
+	{
+		watch.reset();
+		ProjectionFramePtr frame = in->pop();
+		stats.starved += watch.getTimeSeconds();
+		if (!frame)
+		{
+			if (out)
+				out->push(frame);
+			break;
+		}
+
+		watch.reset();
+		if (frame->ok)
+			process(stage, *frame);
+		stats.busy += watch.getTimeSeconds();
+
+		if (out)
+		{
+			watch.reset();
+			out->push(frame);
+			stats.blocked += watch.getTimeSeconds();
+		}
+	}
+}
+
+void BatchProjection::process(int stage, ProjectionFrame &frame)
+{
+	StageStatistics &stats = m_stats[stage];
+	switch (stage)
+	{
+	case STAGE_LOAD:
+		frame.cloud.reset(new pcl::PointCloud<pcl::PointXYZRGB>);
+		frame.ok = loadPoints6D(frame.input, m_flag, *frame.cloud, m_format);
+		if (!frame.ok)
+		{
+			std::cerr << "load data failure: " << frame.input << std::endl;
+			stats.failures++;
+		}
+		stats.points += frame.cloud->points.size();
+		break;
+	case STAGE_FILTER:
+		m_algorithm.filterPoints(frame.cloud, frame.points);
+		stats.points += frame.cloud->points.size();
+		frame.pointCount = frame.points.size();
+		frame.cloud.reset();
+		break;
+	case STAGE_PROJECT:
+		m_algorithm.projectPoints(frame.points, frame.projected, frame.image);
+		stats.points += frame.pointCount;
+		if (!m_writeMirror)
+		{
+			Points6D().swap(frame.points);
+			ProjectedPoints6D().swap(frame.projected);
+		}
+		break;
+	case STAGE_ENCODE:
+		frame.ok = m_algorithm.saveImage(frame.image, frame.stem + "_A.png", frame.stem + "_DIA.png");
+		frame.image.flipHorizontal();
+		frame.ok = m_algorithm.saveImage(frame.image, frame.stem + "_B.png", frame.stem + "_DIB.png") && frame.ok;
+		if (m_writeMirror)
+			frame.ok = m_algorithm.saveMirrorPoints(frame.points, frame.projected, frame.stem + "_mirror.txt") && frame.ok;
+		if (!frame.ok)
+		{
+			std::cerr << "write failure: " << frame.stem << std::endl;
+			stats.failures++;
+		}
+		stats.points += frame.pointCount;
+		break;
+	}
+	if (frame.ok)
+		stats.frames++;
+}
+
+void BatchProjection::printStatistics(std::ostream &os) const
+{
+	os << "stage     frames  failed   busy[s]  frames/s   Mpts/s  starved[s]  blocked[s]" << std::endl;
+	for (int s = 0; s < STAGE_COUNT; s++)
+	{
+		const StageStatistics &st = m_stats[s];
+		char line[128];
+		sprintf(line, "%-8s %7u %7u %9.2f %9.2f %8.2f %11.2f %11.2f", st.name.c_str(), static_cast<unsigned int>(st.frames),
+			static_cast<unsigned int>(st.failures), st.busy, st.busy > 0 ? st.frames / st.busy : 0.0,
+			st.busy > 0 ? st.points / st.busy * 1e-6 : 0.0, st.starved, st.blocked);
+		os << line << std::endl;
+	}
+	os << "total: " << m_stats[STAGE_ENCODE].frames << " frames in " << m_wallTime << " s";
+	if (m_wallTime > 0)
+		os << " (" << m_stats[STAGE_ENCODE].frames / m_wallTime << " frames/s)";
+	os << ", " << m_stats[STAGE_LOAD].failures << " unreadable, " << m_stats[STAGE_ENCODE].failures << " not written";
+	os << std::endl;
+}
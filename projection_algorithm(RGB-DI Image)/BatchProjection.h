@@ -0,0 +1,86 @@
+#ifndef __BatchProjection
+#define __BatchProjection
+#include <string>
+#include <vector>
+#include <ostream>
+#include <boost/shared_ptr.hpp>
+#include "ProjectionAlgorithm.h"
+#include "BoundedQueue.h"
+
+//one scan travelling through the pipeline, every stage frees what it consumed
+struct ProjectionFrame
+{
+	size_t index;
+	std::string input;
+	std::string stem; //output path without suffix, unique within a run
+	bool ok;
+	size_t pointCount; //points left after filtering
+	pcl::PointCloud<pcl::PointXYZRGB>::Ptr cloud;
+	Points6D points;
+	ProjectedPoints6D projected;
+	RGBDIImage image;
+};
+typedef boost::shared_ptr<ProjectionFrame> ProjectionFramePtr;
+
+struct StageStatistics
+{
+	std::string name;
+	size_t frames;
+	size_t failures; //frames that failed in this stage, e.g. unreadable input or unwritable output
+	size_t points;
+	double busy;    //seconds spent processing
+	double starved; //seconds waiting for input
+	double blocked; //seconds waiting for room in the next queue
+};
+
+//Runs load -> filter -> project -> encode over many scans, one thread per stage,
+//connected by bounded queues so that at most 3*queueDepth+4 frames are in memory.
+//Filtering and projection keep using OpenMP inside their stage.
+class BatchProjection
+{
+public:
+	enum Stage { STAGE_LOAD = 0, STAGE_FILTER, STAGE_PROJECT, STAGE_ENCODE, STAGE_COUNT };
+
+	explicit BatchProjection(ProjectionAlgorithm &algorithm);
+	~BatchProjection();
+
+	//x upward -0,y upward -1,z upward -2
+	void setUpAxis(int flag) { m_flag = flag; }
+	void setInputFormat(InputFormat format) { m_format = format; }
+	void setOutputDirectory(const std::string &dir) { m_outputDir = dir; }
+	//frames waiting between two stages
+	void setQueueDepth(int depth) { m_queueDepth = depth > 0 ? depth : 1; }
+	//also write the projected points as <stem>_mirror.txt; the stem is the input file
+	//name including its extension, followed by _<index> if another input had that name
+	void setWriteMirrorPoints(bool enable) { m_writeMirror = enable; }
+
+	//source is a directory (all .txt/.pcd/.bin/.raw files, sorted) or a text file
+	//with one input path per line; returns false if nothing could be read
+	static bool collectInputs(const std::string &source, std::vector<std::string> &files);
+
+	//processes all files, returns the number of frames written successfully;
+	//frames that could not be read or written are counted in the stage statistics
+	size_t run(const std::vector<std::string> &files);
+
+	const StageStatistics& getStatistics(int stage) const { return m_stats[stage]; }
+	double getWallTime() const { return m_wallTime; }
+	void printStatistics(std::ostream &os) const;
+
+private:
+	typedef BoundedQueue<ProjectionFramePtr> FrameQueue;
+
+	void loadStage(const std::vector<std::string> *files, FrameQueue *out);
+	void stageLoop(int stage, FrameQueue *in, FrameQueue *out);
+	void process(int stage, ProjectionFrame &frame);
+
+	ProjectionAlgorithm &m_algorithm;
+	int m_flag;
+	InputFormat m_format;
+	std::string m_outputDir;
+	int m_queueDepth;
+	bool m_writeMirror;
+	StageStatistics m_stats[STAGE_COUNT];
+	double m_wallTime;
+};
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef __BoundedQueue
+#define __BoundedQueue
+#include <deque>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+
+//blocking FIFO with a fixed capacity, push waits while full and pop while empty
+template <typename T>
+class BoundedQueue
+{
+public:
+	explicit BoundedQueue(size_t capacity)
+	:m_capacity(capacity > 0 ? capacity : 1)
+	{
+	}
+
+	void push(const T &item)
+	{
+		boost::mutex::scoped_lock lock(m_mutex);
+		while (m_items.size() >= m_capacity)
+			m_notFull.wait(lock);
+		m_items.push_back(item);
+		m_notEmpty.notify_one();
+	}
+
+	T pop()
+	{
+		boost::mutex::scoped_lock lock(m_mutex);
+		while (m_items.empty())
+			m_notEmpty.wait(lock);
+		T item = m_items.front();
+		m_items.pop_front();
+		m_notFull.notify_one();
+		return item;
+	}
+
+	size_t size() const
+	{
+		boost::mutex::scoped_lock lock(m_mutex);
+		return m_items.size();
+	}
+
+	size_t capacity() const { return m_capacity; }
+
+private:
+	std::deque<T> m_items;
+	size_t m_capacity;
+	mutable boost::mutex m_mutex;
+	boost::condition_variable m_notFull;
+	boost::condition_variable m_notEmpty;
+};
+
+#endif
@@ -0,0 +1,226 @@
+#include "DIRasterizer.h"
+#include <math.h>
+#include <limits>
+#include <algorithm>
+
+//points per block of the binning passes, fixed so that the tile order is reproducible
+static const int kBlockSize = 1 << 16;
+
+static inline unsigned char toByte(float f)
+{
+	return static_cast<unsigned char>(f <= 0.0f ? 0.0f : (f >= 255.0f ? 255.0f : f));
+}
+
+static inline bool isFiniteValue(float f)
+{
+	return f == f && f - f == 0.0f;
+}
+
+void RGBDIImage::resize(int r, int c)
+{
+	rows = r;
+	cols = c;
+	const size_t n = static_cast<size_t>(r) * c;
+	bgr.resize(n * 3);
+	depth.resize(n);
+	intensity.resize(n);
+}
+
+void RGBDIImage::flipHorizontal()
+{
+#pragma omp parallel for schedule(static)
+	for (int row = 0; row < rows; row++)
+	{
+		const size_t first = static_cast<size_t>(row) * cols;
+		for (int l = 0, r = cols - 1; l < r; l++, r--)
+		{
+			for (int k = 0; k < 3; k++)
+				std::swap(bgr[(first + l) * 3 + k], bgr[(first + r) * 3 + k]);
+			std::swap(depth[first + l], depth[first + r]);
+			std::swap(intensity[first + l], intensity[first + r]);
+		}
+	}
+}
+
+DIRasterizer::DIRasterizer()
+:m_rows(240), m_cols(320), m_fillRadius(0), m_tileSize(32)
+{
+}
+
+DIRasterizer::~DIRasterizer()
+{
+}
+
+void DIRasterizer::setResolution(int rows, int cols)
+{
+	m_rows = std::max(rows, 1);
+	m_cols = std::max(cols, 1);
+}
+
+void DIRasterizer::rasterize(const float *u, const float *v, const float *depth,
+	const float *r, const float *g, const float *b, const float *intensity,
+	size_t n, RGBDIImage &img)
+{
+	const int rows = m_rows, cols = m_cols, tile = m_tileSize;
+	const int npix = rows * cols;
+	const int np = static_cast<int>(n);
+	const int nblocks = (np + kBlockSize - 1) / kBlockSize;
+	const int tilesX = (cols + tile - 1) / tile, tilesY = (rows + tile - 1) / tile;
+	const int ntiles = tilesX * tilesY;
+
+	//bounding box of the image plane coordinates
+	std::vector<float> bounds(static_cast<size_t>(nblocks) * 4);
+#pragma omp parallel for schedule(static)
+	for (int blk = 0; blk < nblocks; blk++)
+	{
+		float bmin[2] = { std::numeric_limits<float>::max(), std::numeric_limits<float>::max() };
+		float bmax[2] = { -std::numeric_limits<float>::max(), -std::numeric_limits<float>::max() };
+		const int end = std::min(np, (blk + 1) * kBlockSize);
+		for (int i = blk * kBlockSize; i < end; i++)
+		{
+			if (!isFiniteValue(u[i]) || !isFiniteValue(v[i]))
+				continue;
+			bmin[0] = std::min(bmin[0], u[i]), bmax[0] = std::max(bmax[0], u[i]);
+			bmin[1] = std::min(bmin[1], v[i]), bmax[1] = std::max(bmax[1], v[i]);
+		}
+		bounds[blk * 4 + 0] = bmin[0], bounds[blk * 4 + 1] = bmax[0];
+		bounds[blk * 4 + 2] = bmin[1], bounds[blk * 4 + 3] = bmax[1];
+	}
+	float umin = std::numeric_limits<float>::max(), umax = -std::numeric_limits<float>::max();
+	float vmin = umin, vmax = umax;
+	for (int blk = 0; blk < nblocks; blk++)
+	{
+		umin = std::min(umin, bounds[blk * 4 + 0]), umax = std::max(umax, bounds[blk * 4 + 1]);
+		vmin = std::min(vmin, bounds[blk * 4 + 2]), vmax = std::max(vmax, bounds[blk * 4 + 3]);
+	}
+	const float su = umax > umin ? (cols - 1) / (umax - umin) : 0.0f;
+	const float sv = vmax > vmin ? (rows - 1) / (vmax - vmin) : 0.0f;
+
+	//pixel and tile of every point, counted per block and tile
+	m_pix.resize(n);
+	m_tile.resize(n);
+	m_offsets.assign(static_cast<size_t>(nblocks) * ntiles, 0);
+#pragma omp parallel for schedule(static)
+	for (int blk = 0; blk < nblocks; blk++)
+	{
+		int *count = &m_offsets[static_cast<size_t>(blk) * ntiles];
+		const int end = std::min(np, (blk + 1) * kBlockSize);
+		for (int i = blk * kBlockSize; i < end; i++)
+		{
+			if (!isFiniteValue(u[i]) || !isFiniteValue(v[i]) || !isFiniteValue(depth[i]))
+			{
+				m_pix[i] = -1;
+				continue;
+			}
+			int col = std::min(cols - 1, static_cast<int>((u[i] - umin) * su));
+			int row = rows - 1 - std::min(rows - 1, static_cast<int>((v[i] - vmin) * sv));
+			m_pix[i] = row * cols + col;
+			m_tile[i] = (row / tile) * tilesX + col / tile;
+			count[m_tile[i]]++;
+		}
+	}
+
+	//exclusive prefix sum in tile major order keeps the points of a tile sorted by index
+	m_tileStart.resize(ntiles + 1);
+	int running = 0;
+	for (int t = 0; t < ntiles; t++)
+	{
+		m_tileStart[t] = running;
+		for (int blk = 0; blk < nblocks; blk++)
+		{
+			int c = m_offsets[static_cast<size_t>(blk) * ntiles + t];
+			m_offsets[static_cast<size_t>(blk) * ntiles + t] = running;
+			running += c;
+		}
+	}
+	m_tileStart[ntiles] = running;
+	m_bucket.resize(running);
+#pragma omp parallel for schedule(static)
+	for (int blk = 0; blk < nblocks; blk++)
+	{
+		int *offset = &m_offsets[static_cast<size_t>(blk) * ntiles];
+		const int end = std::min(np, (blk + 1) * kBlockSize);
+		for (int i = blk * kBlockSize; i < end; i++)
+			if (m_pix[i] >= 0)
+				m_bucket[offset[m_tile[i]]++] = i;
+	}
+
+	//z-buffer, every tile is owned by one thread
+	m_zbuf.resize(npix);
+	m_owner.resize(npix);
+#pragma omp parallel for schedule(static)
+	for (int p = 0; p < npix; p++)
+	{
+		m_zbuf[p] = std::numeric_limits<float>::infinity();
+		m_owner[p] = -1;
+	}
+#pragma omp parallel for schedule(dynamic)
+	for (int t = 0; t < ntiles; t++)
+	{
+		for (int k = m_tileStart[t]; k < m_tileStart[t + 1]; k++)
+		{
+			const int i = m_bucket[k];
+			const int p = m_pix[i];
+			if (depth[i] < m_zbuf[p])
+			{
+				m_zbuf[p] = depth[i];
+				m_owner[p] = i;
+			}
+		}
+	}
+
+	if (m_fillRadius > 0)
+		fillHoles();
+
+	img.resize(rows, cols);
+	const float nan = std::numeric_limits<float>::quiet_NaN();
+#pragma omp parallel for schedule(static)
+	for (int p = 0; p < npix; p++)
+	{
+		const int i = m_owner[p];
+		if (i < 0)
+		{
+			img.bgr[p * 3 + 0] = img.bgr[p * 3 + 1] = img.bgr[p * 3 + 2] = 0;
+			img.depth[p] = nan;
+			img.intensity[p] = nan;
+			continue;
+		}
+		img.bgr[p * 3 + 0] = toByte(b[i]);
+		img.bgr[p * 3 + 1] = toByte(g[i]);
+		img.bgr[p * 3 + 2] = toByte(r[i]);
+		img.depth[p] = depth[i];
+		img.intensity[p] = intensity ? intensity[i] : 0.299f*r[i] + 0.587f*g[i] + 0.114f*b[i];
+	}
+}
+
+void DIRasterizer::fillHoles()
+{
+	const int rows = m_rows, cols = m_cols, radius = m_fillRadius;
+	//read from m_owner and write to m_filled so that filled pixels do not propagate
+	m_filled.resize(m_owner.size());
+#pragma omp parallel for schedule(static)
+	for (int row = 0; row < rows; row++)
+	{
+		for (int col = 0; col < cols; col++)
+		{
+			const int p = row * cols + col;
+			m_filled[p] = m_owner[p];
+			if (m_owner[p] >= 0)
+				continue;
+			float best = std::numeric_limits<float>::infinity();
+			for (int rr = std::max(0, row - radius); rr <= std::min(rows - 1, row + radius); rr++)
+			{
+				for (int cc = std::max(0, col - radius); cc <= std::min(cols - 1, col + radius); cc++)
+				{
+					const int q = rr * cols + cc;
+					if (m_owner[q] >= 0 && m_zbuf[q] < best)
+					{
+						best = m_zbuf[q];
+						m_filled[p] = m_owner[q];
+					}
+				}
+			}
+		}
+	}
+	m_owner.swap(m_filled);
+}
@@ -0,0 +1,66 @@
+#ifndef __DIRasterizer
+#define __DIRasterizer
+#include <vector>
+#include <cstddef>
+
+//RGB-DI image, row-major rows x cols pixels
+struct RGBDIImage
+{
+	int rows;
+	int cols;
+	std::vector<unsigned char> bgr; //3 bytes per pixel, OpenCV channel order
+	std::vector<float> depth;       //signed depth behind the projection plane, NaN where empty
+	std::vector<float> intensity;   //NaN where empty
+
+	RGBDIImage() : rows(0), cols(0) {}
+	void resize(int r, int c);
+	//mirrors every channel left to right in place
+	void flipHorizontal();
+};
+
+//Rasterizes projected points into an RGB-DI image. The nearest point (smallest
+//signed depth along the viewing direction) wins each pixel; ties go to the lower
+//point index. Points are binned into square pixel tiles with a stable counting
+//sort and every tile is z-buffered by a single thread, so the result does not
+//depend on the number of threads.
+//Scratch buffers are kept between calls to avoid reallocating them every frame.
+class DIRasterizer
+{
+public:
+	DIRasterizer();
+	~DIRasterizer();
+
+	void setResolution(int rows, int cols);
+	int getRows() const { return m_rows; }
+	int getCols() const { return m_cols; }
+	//empty pixels take the nearest point found in a (2*radius+1)^2 window, 0 disables
+	void setHoleFilling(int radius) { m_fillRadius = radius; }
+	int getHoleFilling() const { return m_fillRadius; }
+	//edge length in pixels of the tiles processed by one thread
+	void setTileSize(int size) { m_tileSize = size > 0 ? size : 1; }
+
+	//u,v are image plane coordinates (u to the right, v upwards), scaled onto the
+	//image from their bounding box. intensity may be NULL, in which case the
+	//luminance of r,g,b is used.
+	void rasterize(const float *u, const float *v, const float *depth,
+		const float *r, const float *g, const float *b, const float *intensity,
+		size_t n, RGBDIImage &img);
+
+private:
+	void fillHoles();
+
+	int m_rows;
+	int m_cols;
+	int m_fillRadius;
+	int m_tileSize;
+	std::vector<int> m_pix;     //pixel of every point, -1 if outside
+	std::vector<int> m_tile;    //tile of every point
+	std::vector<int> m_offsets; //per block and tile start in m_bucket
+	std::vector<int> m_tileStart;
+	std::vector<int> m_bucket;  //point indices sorted by tile
+	std::vector<float> m_zbuf;
+	std::vector<int> m_owner;   //point that won each pixel, -1 if empty
+	std::vector<int> m_filled;
+};
+
+#endif
@@ -0,0 +1,293 @@
+#include "PlaneSearch.h"
+#include <math.h>
+#include <algorithm>
+#include <pcl/common/eigen.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+//definitions of the in-class constants, they are bound to references by std::min
+const int PlaneSearch::kBlockSize;
+const int PlaneSearch::kBatchSize;
+
+//search domain of the original random sampling: fa in [pi/3,2pi/3], thr in [0,pi]
+static const float kFaMin = static_cast<float>(M_PI / 3);
+static const float kFaMax = static_cast<float>(M_PI / 3 * 2);
+static const float kThrMin = 0.0f;
+static const float kThrMax = static_cast<float>(M_PI);
+
+//radical inverse in the given base, used for the low-discrepancy direction set
+static float radicalInverse(unsigned int i, unsigned int base)
+{
+	double inv = 1.0 / base, f = inv, r = 0.0;
+	while (i > 0)
+	{
+		r += f * (i % base);
+		i /= base;
+		f *= inv;
+	}
+	return static_cast<float>(r);
+}
+
+//sum of |p-c| over the points [begin,end)
+static double blockDistanceSum(const float *x, const float *y, const float *z,
+	size_t begin, size_t end, float cx, float cy, float cz)
+{
+	size_t i = begin;
+	double sum = 0.0;
+#ifdef __SSE2__
+	__m128 acc = _mm_setzero_ps();
+	const __m128 vcx = _mm_set1_ps(cx), vcy = _mm_set1_ps(cy), vcz = _mm_set1_ps(cz);
+	for (; i + 4 <= end; i += 4)
+	{
+		__m128 dx = _mm_sub_ps(_mm_loadu_ps(x + i), vcx);
+		__m128 dy = _mm_sub_ps(_mm_loadu_ps(y + i), vcy);
+		__m128 dz = _mm_sub_ps(_mm_loadu_ps(z + i), vcz);
+		__m128 d2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+		acc = _mm_add_ps(acc, _mm_sqrt_ps(d2));
+	}
+	float lanes[4];
+	_mm_storeu_ps(lanes, acc);
+	sum = (static_cast<double>(lanes[0]) + lanes[1]) + (static_cast<double>(lanes[2]) + lanes[3]);
+#endif
+	for (; i < end; i++)
+	{
+		float dx = x[i] - cx, dy = y[i] - cy, dz = z[i] - cz;
+		sum += sqrtf(dx*dx + dy*dy + dz*dz);
+	}
+	return sum;
+}
+
+PlaneSearch::PlaneSearch()
+:m_x(NULL), m_y(NULL), m_z(NULL), m_n(0), m_x0(1), m_y0(2), m_z0(3),
+m_mode(SEARCH_SAMPLED), m_candidateCount(1000), m_best(-1)
+{
+	std::fill(m_mean, m_mean + 3, 0.0);
+	std::fill(m_cov, m_cov + 6, 0.0);
+}
+
+PlaneSearch::~PlaneSearch()
+{
+}
+
+void PlaneSearch::setInputPoints(const float *x, const float *y, const float *z, size_t n)
+{
+	m_x = x, m_y = y, m_z = z;
+	m_n = n;
+	m_best = -1;
+	computeMoments();
+}
+
+void PlaneSearch::setReferencePoint(float x0, float y0, float z0)
+{
+	m_x0 = x0, m_y0 = y0, m_z0 = z0;
+}
+
+PlaneCandidate PlaneSearch::makeCandidate(float fa, float thr)
+{
+	PlaneCandidate c;
+	c.fa = fa;
+	c.thr = thr;
+	c.nx = sinf(fa)*cosf(thr);
+	c.ny = cosf(fa);
+	c.nz = sinf(fa)*sinf(thr);
+	return c;
+}
+
+void PlaneSearch::computeMoments()
+{
+	std::fill(m_mean, m_mean + 3, 0.0);
+	std::fill(m_cov, m_cov + 6, 0.0);
+	if (m_n == 0)
+		return;
+
+	//per block sums of x,y,z and of the second order products, reduced in block order
+	const int nblocks = static_cast<int>((m_n + kBlockSize - 1) / kBlockSize);
+	m_partial.assign(static_cast<size_t>(nblocks) * 9, 0.0);
+#pragma omp parallel for schedule(static)
+	for (int blk = 0; blk < nblocks; blk++)
+	{
+		size_t begin = static_cast<size_t>(blk) * kBlockSize;
+		size_t end = std::min(begin + kBlockSize, m_n);
+		//shift by the first point of the cloud to keep the second moments well conditioned
+		const double ox = m_x[0], oy = m_y[0], oz = m_z[0];
+		double s[9] = { 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+		for (size_t i = begin; i < end; i++)
+		{
+			double dx = m_x[i] - ox, dy = m_y[i] - oy, dz = m_z[i] - oz;
+			s[0] += dx; s[1] += dy; s[2] += dz;
+			s[3] += dx*dx; s[4] += dx*dy; s[5] += dx*dz;
+			s[6] += dy*dy; s[7] += dy*dz; s[8] += dz*dz;
+		}
+		std::copy(s, s + 9, &m_partial[static_cast<size_t>(blk) * 9]);
+	}
+	double s[9] = { 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+	for (int blk = 0; blk < nblocks; blk++)
+		for (int k = 0; k < 9; k++)
+			s[k] += m_partial[static_cast<size_t>(blk) * 9 + k];
+
+	const double inv = 1.0 / static_cast<double>(m_n);
+	double mx = s[0] * inv, my = s[1] * inv, mz = s[2] * inv;
+	m_cov[0] = s[3] * inv - mx*mx; m_cov[1] = s[4] * inv - mx*my; m_cov[2] = s[5] * inv - mx*mz;
+	m_cov[3] = s[6] * inv - my*my; m_cov[4] = s[7] * inv - my*mz; m_cov[5] = s[8] * inv - mz*mz;
+	m_mean[0] = mx + m_x[0];
+	m_mean[1] = my + m_y[0];
+	m_mean[2] = mz + m_z[0];
+}
+
+void PlaneSearch::evaluate(const PlaneCandidate *cand, int count, float *scores)
+{
+	if (m_n == 0)
+	{
+		std::fill(scores, scores + count, 0.0f);
+		return;
+	}
+	const int nblocks = static_cast<int>((m_n + kBlockSize - 1) / kBlockSize);
+	for (int b0 = 0; b0 < count; b0 += kBatchSize)
+	{
+		const int nb = std::min(kBatchSize, count - b0);
+		//the projection is affine, so the centroid of the projected points is the
+		//projection of the centroid: pm = mean + n*(n.(ref-mean))
+		float cx[kBatchSize], cy[kBatchSize], cz[kBatchSize];
+		for (int k = 0; k < nb; k++)
+		{
+			const PlaneCandidate &c = cand[b0 + k];
+			double t = c.nx*(m_x0 - m_mean[0]) + c.ny*(m_y0 - m_mean[1]) + c.nz*(m_z0 - m_mean[2]);
+			cx[k] = static_cast<float>(m_mean[0] + c.nx*t);
+			cy[k] = static_cast<float>(m_mean[1] + c.ny*t);
+			cz[k] = static_cast<float>(m_mean[2] + c.nz*t);
+		}
+
+		m_partial.resize(static_cast<size_t>(nblocks) * nb);
+#pragma omp parallel for schedule(static)
+		for (int blk = 0; blk < nblocks; blk++)
+		{
+			size_t begin = static_cast<size_t>(blk) * kBlockSize;
+			size_t end = std::min(begin + kBlockSize, m_n);
+			//the block stays in cache while every direction of the batch reads it
+			for (int k = 0; k < nb; k++)
+				m_partial[static_cast<size_t>(blk) * nb + k] = blockDistanceSum(m_x, m_y, m_z, begin, end, cx[k], cy[k], cz[k]);
+		}
+
+		for (int k = 0; k < nb; k++)
+		{
+			double sum = 0.0;
+			for (int blk = 0; blk < nblocks; blk++)
+				sum += m_partial[static_cast<size_t>(blk) * nb + k];
+			scores[b0 + k] = static_cast<float>(sum / static_cast<double>(m_n));
+		}
+	}
+}
+
+void PlaneSearch::project(const PlaneCandidate &c, float *xo, float *yo, float *zo, float *dist) const
+{
+	project(c, m_x0, m_y0, m_z0, m_x, m_y, m_z, m_n, xo, yo, zo, dist);
+}
+
+void PlaneSearch::project(const PlaneCandidate &c, float x0, float y0, float z0,
+	const float *x, const float *y, const float *z, size_t count,
+	float *xo, float *yo, float *zo, float *dist)
+{
+	const float nx = c.nx, ny = c.ny, nz = c.nz;
+	const int n = static_cast<int>(count);
+#pragma omp parallel for schedule(static)
+	for (int i = 0; i < n; i++)
+	{
+		float t = nx*(x0 - x[i]) + ny*(y0 - y[i]) + nz*(z0 - z[i]);
+		xo[i] = x[i] + nx*t;
+		yo[i] = y[i] + ny*t;
+		zo[i] = z[i] + nz*t;
+		if (dist)
+			dist[i] = t;
+	}
+}
+
+void PlaneSearch::generateSampled()
+{
+	//Halton (2,3) points mapped onto the search domain: deterministic and evenly
+	//spread, unlike two generators sharing one seed
+	m_candidates.resize(std::max(m_candidateCount, 1));
+	for (size_t i = 0; i < m_candidates.size(); i++)
+	{
+		float fa = kFaMin + (kFaMax - kFaMin) * radicalInverse(static_cast<unsigned int>(i + 1), 2);
+		float thr = kThrMin + (kThrMax - kThrMin) * radicalInverse(static_cast<unsigned int>(i + 1), 3);
+		m_candidates[i] = makeCandidate(fa, thr);
+	}
+}
+
+int PlaneSearch::search()
+{
+	m_best = -1;
+	if (m_n == 0)
+		return m_best;
+	if (m_mode == SEARCH_PCA_SEEDED)
+		return searchPCASeeded();
+
+	generateSampled();
+	m_scores.resize(m_candidates.size());
+	evaluate(&m_candidates[0], static_cast<int>(m_candidates.size()), &m_scores[0]);
+	m_best = static_cast<int>(std::max_element(m_scores.begin(), m_scores.end()) - m_scores.begin());
+	return m_best;
+}
+
+int PlaneSearch::searchPCASeeded()
+{
+	m_candidates.clear();
+
+	//seed with the principal axes of the cloud; n and -n describe the same plane
+	Eigen::Matrix3d cov;
+	cov << m_cov[0], m_cov[1], m_cov[2],
+		m_cov[1], m_cov[3], m_cov[4],
+		m_cov[2], m_cov[4], m_cov[5];
+	Eigen::Matrix3d evecs;
+	Eigen::Vector3d evals;
+	pcl::eigen33(cov, evecs, evals);
+	for (int a = 0; a < 3; a++)
+	{
+		Eigen::Vector3d n = evecs.col(a);
+		if (n.z() < 0)
+			n = -n;
+		float fa = static_cast<float>(acos(std::max(-1.0, std::min(1.0, n.y()))));
+		float thr = static_cast<float>(atan2(n.z(), n.x()));
+		fa = std::max(kFaMin, std::min(kFaMax, fa));
+		thr = std::max(kThrMin, std::min(kThrMax, thr));
+		m_candidates.push_back(makeCandidate(fa, thr));
+	}
+	//coarse 4x4 grid over the domain in case the optimum is not near an axis
+	const int grid = 4;
+	for (int i = 0; i < grid; i++)
+		for (int j = 0; j < grid; j++)
+			m_candidates.push_back(makeCandidate(kFaMin + (kFaMax - kFaMin) * (i + 0.5f) / grid,
+				kThrMin + (kThrMax - kThrMin) * (j + 0.5f) / grid));
+
+	m_scores.resize(m_candidates.size());
+	evaluate(&m_candidates[0], static_cast<int>(m_candidates.size()), &m_scores[0]);
+	m_best = static_cast<int>(std::max_element(m_scores.begin(), m_scores.end()) - m_scores.begin());
+
+	//pattern search around the best seed, halving the step every round
+	float dfa = (kFaMax - kFaMin) / (2 * grid);
+	float dthr = (kThrMax - kThrMin) / (2 * grid);
+	const int rounds = 3;
+	for (int r = 0; r < rounds; r++, dfa *= 0.5f, dthr *= 0.5f)
+	{
+		const PlaneCandidate center = m_candidates[m_best];
+		const size_t first = m_candidates.size();
+		for (int i = -1; i <= 1; i++)
+			for (int j = -1; j <= 1; j++)
+			{
+				if (i == 0 && j == 0)
+					continue;
+				float fa = std::max(kFaMin, std::min(kFaMax, center.fa + i*dfa));
+				float thr = std::max(kThrMin, std::min(kThrMax, center.thr + j*dthr));
+				m_candidates.push_back(makeCandidate(fa, thr));
+			}
+		m_scores.resize(m_candidates.size());
+		evaluate(&m_candidates[first], static_cast<int>(m_candidates.size() - first), &m_scores[first]);
+		m_best = static_cast<int>(std::max_element(m_scores.begin(), m_scores.end()) - m_scores.begin());
+	}
+	return m_best;
+}
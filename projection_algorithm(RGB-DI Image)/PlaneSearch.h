@@ -0,0 +1,84 @@
+#ifndef __PlaneSearch
+#define __PlaneSearch
+#include <vector>
+#include <cstddef>
+
+//projection direction n=(sin(fa)cos(thr), cos(fa), sin(fa)sin(thr)),
+//the trigonometry is evaluated once when the candidate is created
+struct PlaneCandidate
+{
+	float fa;
+	float thr;
+	float nx;
+	float ny;
+	float nz;
+};
+
+//Searches the projection plane through a reference point that maximizes the mean
+//distance between the points and the centroid of their projection.
+//Points are read from caller-owned SoA arrays; a batch of directions is scored in a
+//single blocked pass over the points and the per-block partial sums are reduced in
+//block order, so the result does not depend on the number of OpenMP threads.
+class PlaneSearch
+{
+public:
+	//SEARCH_SAMPLED: fixed low-discrepancy set of m_candidateCount directions
+	//SEARCH_PCA_SEEDED: principal axes and a coarse grid, refined by a local pattern search
+	enum SearchMode { SEARCH_SAMPLED = 0, SEARCH_PCA_SEEDED = 1 };
+
+	PlaneSearch();
+	~PlaneSearch();
+
+	void setInputPoints(const float *x, const float *y, const float *z, size_t n);
+	void setReferencePoint(float x0, float y0, float z0);
+	void setSearchMode(SearchMode mode) { m_mode = mode; }
+	SearchMode getSearchMode() const { return m_mode; }
+	//number of directions evaluated in SEARCH_SAMPLED mode
+	void setCandidateCount(int n) { m_candidateCount = n; }
+	int getCandidateCount() const { return m_candidateCount; }
+
+	//evaluates all candidates of the current mode, returns the index of the best one or -1
+	int search();
+	const std::vector<PlaneCandidate>& getCandidates() const { return m_candidates; }
+	const std::vector<float>& getScores() const { return m_scores; }
+	const PlaneCandidate& getBest() const { return m_candidates[m_best]; }
+
+	//scores count directions with one pass over the input per batch of kBatchSize
+	void evaluate(const PlaneCandidate *cand, int count, float *scores);
+	//projects the input onto the plane of c through the reference point,
+	//dist (optional) receives the signed depth of every point along the viewing
+	//direction -n, negative in front of the plane (on the side n points to)
+	void project(const PlaneCandidate &c, float *xo, float *yo, float *zo, float *dist = NULL) const;
+	//same for arbitrary SoA points and reference point (x0,y0,z0)
+	static void project(const PlaneCandidate &c, float x0, float y0, float z0,
+		const float *x, const float *y, const float *z, size_t n,
+		float *xo, float *yo, float *zo, float *dist = NULL);
+
+	static PlaneCandidate makeCandidate(float fa, float thr);
+
+	//points per reduction block and directions per pass, fixed for reproducibility
+	static const int kBlockSize = 4096;
+	static const int kBatchSize = 32;
+
+private:
+	void computeMoments();
+	void generateSampled();
+	int searchPCASeeded();
+
+	const float *m_x;
+	const float *m_y;
+	const float *m_z;
+	size_t m_n;
+	float m_x0; float m_y0; float m_z0;
+	SearchMode m_mode;
+	int m_candidateCount;
+	int m_best;
+	//mean and covariance of the input, accumulated in double
+	double m_mean[3];
+	double m_cov[6];
+	std::vector<PlaneCandidate> m_candidates;
+	std::vector<float> m_scores;
+	std::vector<double> m_partial;
+};
+
+#endif
@@ -0,0 +1,262 @@
+#include "PointLoader.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <iostream>
+#include <vector>
+#include <boost/filesystem.hpp>
+#include <boost/algorithm/string.hpp>
+#include <pcl/io/pcd_io.h>
+
+//bytes read from disk per chunk
+static const size_t kChunkSize = 1 << 22;
+
+//cloud axis k is read from input axis axisMap[upAxis][k]; the up axis always lands on y
+static const int axisMap[3][3] = { { 1, 0, 2 }, { 0, 1, 2 }, { 0, 2, 1 } };
+
+static inline bool isBlank(char c)
+{
+	return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+}
+
+static inline void setPoint(pcl::PointXYZRGB &pt, const float *v, const int *map)
+{
+	pt.x = v[map[0]];
+	pt.y = v[map[1]];
+	pt.z = v[map[2]];
+	uint8_t c[3];
+	for (int k = 0; k < 3; k++)
+	{
+		float f = v[3 + k];
+		c[k] = static_cast<uint8_t>(f <= 0.0f ? 0.0f : (f >= 255.0f ? 255.0f : f));
+	}
+	pt.rgba = static_cast<uint32_t>(c[0]) << 16 | static_cast<uint32_t>(c[1]) << 8 | static_cast<uint32_t>(c[2]);
+}
+
+//locale independent decimal parser for [-+]digits[.digits][e[-+]digits];
+//anything else (nan, inf, hex) is handed to strtod. Returns NULL if no number was read.
+static const char* parseNumber(const char *p, const char *end, float &v)
+{
+	static const double pow10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+		1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+	const char *start = p;
+	bool neg = false;
+	if (p < end && (*p == '-' || *p == '+'))
+		neg = (*p++ == '-');
+
+	unsigned long long mant = 0;
+	int digits = 0, exp10 = 0;
+	bool any = false;
+	for (; p < end && *p >= '0' && *p <= '9'; p++, any = true)
+	{
+		if (digits < 19)
+			mant = mant * 10 + (*p - '0'), digits += (mant != 0);
+		else
+			exp10++;
+	}
+	if (p < end && *p == '.')
+	{
+		for (p++; p < end && *p >= '0' && *p <= '9'; p++, any = true)
+		{
+			if (digits < 19)
+				mant = mant * 10 + (*p - '0'), digits += (mant != 0), exp10--;
+		}
+	}
+	if (any && p < end && (*p == 'e' || *p == 'E'))
+	{
+		const char *q = p + 1;
+		bool eneg = false;
+		if (q < end && (*q == '-' || *q == '+'))
+			eneg = (*q++ == '-');
+		if (q < end && *q >= '0' && *q <= '9')
+		{
+			int e = 0;
+			for (; q < end && *q >= '0' && *q <= '9'; q++)
+				e = std::min(e * 10 + (*q - '0'), 9999);
+			exp10 += eneg ? -e : e;
+			p = q;
+		}
+	}
+	if (!any || (p < end && !isBlank(*p)))
+	{
+		char token[64];
+		size_t len = 0;
+		for (p = start; p < end && !isBlank(*p) && len < sizeof(token) - 1; p++)
+			token[len++] = *p;
+		token[len] = '\0';
+		char *stop = NULL;
+		double r = strtod(token, &stop);
+		if (stop == token)
+			return NULL;
+		v = static_cast<float>(r);
+		return p;
+	}
+
+	double r = static_cast<double>(mant);
+	if (exp10 < 0)
+		r = (exp10 >= -22) ? r / pow10[-exp10] : r * pow(10.0, exp10);
+	else if (exp10 > 0)
+		r = (exp10 <= 22) ? r * pow10[exp10] : r * pow(10.0, exp10);
+	v = static_cast<float>(neg ? -r : r);
+	return p;
+}
+
+static bool loadASCII(const std::string &file, const int *map, pcl::PointCloud<pcl::PointXYZRGB> &cloud)
+{
+	FILE *fp = fopen(file.c_str(), "rb");
+	if (!fp)
+		return false;
+	std::vector<char> buf(kChunkSize);
+
+	//first pass: count the lines so that the cloud is allocated exactly once
+	size_t lines = 0, got = 0;
+	char last = '\n';
+	while ((got = fread(&buf[0], 1, kChunkSize, fp)) > 0)
+	{
+		lines += std::count(buf.begin(), buf.begin() + got, '\n');
+		last = buf[got - 1];
+	}
+	if (last != '\n')
+		lines++;
+	cloud.points.clear();
+	cloud.points.reserve(lines);
+	rewind(fp);
+
+	//second pass: parse complete tokens of every chunk, carry the cut one over
+	float v[6];
+	int nv = 0;
+	size_t carry = 0;
+	bool ok = true;
+	while (ok)
+	{
+		got = fread(&buf[carry], 1, kChunkSize - carry, fp);
+		const bool eof = (got == 0);
+		size_t len = carry + got, limit = len;
+		if (!eof)
+		{
+			while (limit > 0 && !isBlank(buf[limit - 1]))
+				limit--;
+			if (limit == 0)
+			{
+				std::cerr << "token longer than " << kChunkSize << " bytes in " << file << std::endl;
+				ok = false;
+				break;
+			}
+		}
+		const char *p = &buf[0], *end = &buf[0] + limit;
+		while (p < end)
+		{
+			if (isBlank(*p))
+			{
+				p++;
+				continue;
+			}
+			p = parseNumber(p, end, v[nv]);
+			if (!p)
+			{
+				std::cerr << "malformed number in " << file << std::endl;
+				ok = false;
+				break;
+			}
+			if (++nv == 6)
+			{
+				cloud.points.push_back(pcl::PointXYZRGB());
+				setPoint(cloud.points.back(), v, map);
+				nv = 0;
+			}
+		}
+		if (eof)
+			break;
+		carry = len - limit;
+		memmove(&buf[0], &buf[limit], carry);
+	}
+	fclose(fp);
+	return ok;
+}
+
+static bool loadRaw(const std::string &file, const int *map, pcl::PointCloud<pcl::PointXYZRGB> &cloud)
+{
+	boost::system::error_code ec;
+	const boost::uintmax_t bytes = boost::filesystem::file_size(file, ec);
+	FILE *fp = fopen(file.c_str(), "rb");
+	if (ec || !fp)
+	{
+		if (fp)
+			fclose(fp);
+		return false;
+	}
+	const size_t record = 6 * sizeof(float);
+	const size_t count = static_cast<size_t>(bytes / record);
+	cloud.points.resize(count);
+
+	const size_t perChunk = kChunkSize / record;
+	std::vector<float> buf(perChunk * 6);
+	size_t done = 0;
+	while (done < count)
+	{
+		size_t want = std::min(perChunk, count - done);
+		size_t got = fread(&buf[0], record, want, fp);
+		if (got == 0)
+			break;
+#pragma omp parallel for schedule(static)
+		for (int i = 0; i < static_cast<int>(got); i++)
+			setPoint(cloud.points[done + i], &buf[static_cast<size_t>(i) * 6], map);
+		done += got;
+	}
+	fclose(fp);
+	cloud.points.resize(done);
+	return done == count;
+}
+
+static bool loadPCD(const std::string &file, const int *map, pcl::PointCloud<pcl::PointXYZRGB> &cloud)
+{
+	if (pcl::io::loadPCDFile(file, cloud) < 0)
+		return false;
+	if (map[0] == 0 && map[1] == 1 && map[2] == 2)
+		return true;
+	const int n = static_cast<int>(cloud.points.size());
+#pragma omp parallel for schedule(static)
+	for (int i = 0; i < n; i++)
+	{
+		pcl::PointXYZRGB &pt = cloud.points[i];
+		const float v[3] = { pt.x, pt.y, pt.z };
+		pt.x = v[map[0]], pt.y = v[map[1]], pt.z = v[map[2]];
+	}
+	return true;
+}
+
+bool loadPoints6D(const std::string &LaserPoints6D, int upAxis,
+	pcl::PointCloud<pcl::PointXYZRGB> &cloud, InputFormat format)
+{
+	if (upAxis < 0 || upAxis > 2)
+	{
+		std::cerr << "invalid up axis " << upAxis << " (x-0, y-1, z-2)" << std::endl;
+		return false;
+	}
+	if (format == FORMAT_AUTO)
+	{
+		std::string ext = boost::algorithm::to_lower_copy(boost::filesystem::extension(LaserPoints6D));
+		if (ext == ".pcd")
+			format = FORMAT_PCD;
+		else if (ext == ".bin" || ext == ".raw")
+			format = FORMAT_RAW;
+		else
+			format = FORMAT_ASCII;
+	}
+
+	bool ok = false;
+	const int *map = axisMap[upAxis];
+	if (format == FORMAT_PCD)
+		ok = loadPCD(LaserPoints6D, map, cloud);
+	else if (format == FORMAT_RAW)
+		ok = loadRaw(LaserPoints6D, map, cloud);
+	else
+		ok = loadASCII(LaserPoints6D, map, cloud);
+
+	cloud.width = static_cast<uint32_t>(cloud.points.size());
+	cloud.height = 1;
+	cloud.is_dense = false;
+	return ok;
+}
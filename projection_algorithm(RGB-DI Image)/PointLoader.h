@@ -0,0 +1,23 @@
+#ifndef __PointLoader
+#define __PointLoader
+#include <string>
+#include <pcl/point_types.h>
+#include <pcl/point_cloud.h>
+
+//input formats of the 6D (x y z r g b) scans
+enum InputFormat
+{
+	FORMAT_AUTO = 0,  //chosen from the file extension
+	FORMAT_ASCII = 1, //whitespace separated "x y z r g b" text
+	FORMAT_PCD = 2,   //any PCD file with x y z rgb fields
+	FORMAT_RAW = 3    //packed little-endian float32 records x y z r g b (.bin/.raw)
+};
+
+//Streams LaserPoints6D into cloud, which is resized once and filled in place.
+//upAxis selects the input axis pointing upwards (x-0, y-1, z-2); it is mapped
+//onto the cloud y axis exactly like the former fun0/fun1/fun2.
+//Returns false if the file cannot be read or upAxis is invalid.
+bool loadPoints6D(const std::string &LaserPoints6D, int upAxis,
+	pcl::PointCloud<pcl::PointXYZRGB> &cloud, InputFormat format = FORMAT_AUTO);
+
+#endif
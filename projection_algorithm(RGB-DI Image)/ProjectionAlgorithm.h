@@ -1,24 +1,46 @@
 #ifndef __ProjectionAlgorithm
 #define __ProjectionAlgorithm
 #include"header.h"
+#include"PointLoader.h"
+#include"RGBDIProjection.h"
 
 class ProjectionAlgorithm
 {
 public:
 	ProjectionAlgorithm();
 	~ProjectionAlgorithm();
-	void fun0(const string &LaserPoints6D);
-	void fun1(const string &LaserPoints6D);
-	void fun2(const string &LaserPoints6D);
-	//x upward -0,x upward -1,x upward -2
-	void PointsFilter6D(const string &LaserPoints6D,int flag);
+	//x upward -0,y upward -1,z upward -2; ASCII, PCD or raw float32 input
+	bool PointsFilter6D(const string &LaserPoints6D, int flag, InputFormat format = FORMAT_AUTO);
 	float standardization(float a, float b, float c, float d, float x);
 	void ProjectionMirror6D();
+
+	//single stages of PointsFilter6D/ProjectionMirror6D, used by the batch pipeline;
+	//filterPoints and the save functions may run concurrently, projectPoints may not
+	void filterPoints(const pcl::PointCloud<pcl::PointXYZRGB>::ConstPtr &cloud, Points6D &points) const
+	{
+		m_projection.filterPoints(cloud, points);
+	}
+	void projectPoints(const Points6D &points, ProjectedPoints6D &projected, RGBDIImage &image)
+	{
+		m_projection.projectPoints(points, projected, image);
+	}
+	//both return false if a file could not be written, saveImage also for an empty image
+	bool saveMirrorPoints(const Points6D &points, const ProjectedPoints6D &projected, const string &name) const;
+	bool saveImage(RGBDIImage &image, const string &rgbName, const string &diName) const;
+	//SEARCH_SAMPLED evaluates candidateCount directions, SEARCH_PCA_SEEDED a few dozen
+	void setSearchMode(PlaneSearch::SearchMode mode, int candidateCount = 1000)
+	{
+		m_projection.setSearchMode(mode, candidateCount);
+	}
+	//output resolution and hole filling radius of the RGB-DI images, 0 disables filling
+	void setImageSize(int rows, int cols) { m_projection.setImageSize(rows, cols); }
+	void setHoleFilling(int radius) { m_projection.setHoleFilling(radius); }
+	//the in-memory implementation behind the file based interface
+	RGBDIProjection& getProjection() { return m_projection; }
     
 private:
-	vector<vector<float>> m_feapicked;
-	int imgRows;
-	int imgClos;
+	Points6D m_feapicked;
+	RGBDIProjection m_projection;
 	float m_bx; float m_by; float m_bz;
 };
 
@@ -0,0 +1,105 @@
+#include "RGBDIProjection.h"
+#include <pcl/filters/statistical_outlier_removal.h>
+
+RGBDIProjection::RGBDIProjection()
+:m_searchMode(PlaneSearch::SEARCH_SAMPLED), m_candidateCount(1000), m_meanK(50), m_stddevMul(1.0),
+m_rows(240), m_cols(320), m_holeFill(0), m_x0(1), m_y0(2), m_z0(3)
+{
+}
+
+RGBDIProjection::~RGBDIProjection()
+{
+}
+
+void RGBDIProjection::compute(const pcl::PointCloud<pcl::PointXYZRGB>::ConstPtr &cloud, RGBDIImage &image,
+	RGBDIImage *mirrored)
+{
+	Points6D points;
+	ProjectedPoints6D projected;
+	filterPoints(cloud, points);
+	projectPoints(points, projected, image);
+	if (mirrored)
+	{
+		*mirrored = image;
+		mirrored->flipHorizontal();
+	}
+}
+
+void RGBDIProjection::filterPoints(const pcl::PointCloud<pcl::PointXYZRGB>::ConstPtr &cloud, Points6D &points) const
+{
+	// Create the filtering object, only the indices of the inliers are kept
+	std::vector<int> inliers;
+	if (m_meanK > 0)
+	{
+		pcl::StatisticalOutlierRemoval<pcl::PointXYZRGB> sor;
+		sor.setInputCloud(cloud);
+		sor.setMeanK(m_meanK);
+		sor.setStddevMulThresh(m_stddevMul);
+		sor.filter(inliers);
+	}
+	else
+	{
+		inliers.resize(cloud->points.size());
+		for (size_t i = 0; i < inliers.size(); i++)
+			inliers[i] = static_cast<int>(i);
+	}
+
+	const int n = static_cast<int>(inliers.size());
+	points.resize(n);
+#pragma omp parallel for schedule(static)
+	for (int i = 0; i < n; i++)
+	{
+		const pcl::PointXYZRGB &pt = cloud->points[inliers[i]];
+		points.x[i] = pt.x;
+		points.y[i] = pt.y;
+		points.z[i] = pt.z;
+		points.r[i] = pt.r;
+		points.g[i] = pt.g;
+		points.b[i] = pt.b;
+	}
+}
+
+PlaneCandidate RGBDIProjection::searchPlane(const Points6D &points)
+{
+	m_search.setInputPoints(&points.x[0], &points.y[0], &points.z[0], points.size());
+	m_search.setReferencePoint(m_x0, m_y0, m_z0);
+	m_search.setSearchMode(m_searchMode);
+	m_search.setCandidateCount(m_candidateCount);
+	m_search.search();
+	return m_search.getBest();
+}
+
+void RGBDIProjection::projectPoints(const Points6D &points, const PlaneCandidate &plane, ProjectedPoints6D &projected) const
+{
+	projected.resize(points.size());
+	if (points.size() == 0)
+		return;
+	PlaneSearch::project(plane, m_x0, m_y0, m_z0, &points.x[0], &points.y[0], &points.z[0], points.size(),
+		&projected.x[0], &projected.y[0], &projected.z[0], &projected.d[0]);
+}
+
+void RGBDIProjection::rasterize(const Points6D &points, const ProjectedPoints6D &projected, RGBDIImage &image)
+{
+	m_raster.setResolution(m_rows, m_cols);
+	m_raster.setHoleFilling(m_holeFill);
+	if (points.size() == 0)
+	{
+		m_raster.rasterize(NULL, NULL, NULL, NULL, NULL, NULL, NULL, 0, image);
+		return;
+	}
+	//image x follows the projected x, image rows the projected y (upwards)
+	m_raster.rasterize(&projected.x[0], &projected.y[0], &projected.d[0], &points.r[0], &points.g[0], &points.b[0],
+		NULL, points.size(), image);
+}
+
+void RGBDIProjection::projectPoints(const Points6D &points, ProjectedPoints6D &projected, RGBDIImage &image)
+{
+	if (points.size() == 0)
+	{
+		projected.resize(0);
+		rasterize(points, projected, image);
+		return;
+	}
+	projectPoints(points, searchPlane(points), projected);
+	rasterize(points, projected, image);
+}
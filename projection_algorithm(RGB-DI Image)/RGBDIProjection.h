@@ -0,0 +1,101 @@
+#ifndef __RGBDIProjection
+#define __RGBDIProjection
+#include <vector>
+#include <pcl/point_types.h>
+#include <pcl/point_cloud.h>
+#include "PlaneSearch.h"
+#include "DIRasterizer.h"
+
+//filtered points, one array per channel so that the plane search reads them in place
+struct Points6D
+{
+	std::vector<float> x, y, z;
+	std::vector<float> r, g, b;
+	size_t size() const { return x.size(); }
+	void resize(size_t n)
+	{
+		x.resize(n), y.resize(n), z.resize(n);
+		r.resize(n), g.resize(n), b.resize(n);
+	}
+	void clear()
+	{
+		x.clear(), y.clear(), z.clear();
+		r.clear(), g.clear(), b.clear();
+	}
+	void swap(Points6D &other)
+	{
+		x.swap(other.x), y.swap(other.y), z.swap(other.z);
+		r.swap(other.r), g.swap(other.g), b.swap(other.b);
+	}
+};
+
+//points projected onto the plane and their signed depth along the viewing direction
+struct ProjectedPoints6D
+{
+	std::vector<float> x, y, z;
+	std::vector<float> d;
+	void resize(size_t n)
+	{
+		x.resize(n), y.resize(n), z.resize(n), d.resize(n);
+	}
+	void swap(ProjectedPoints6D &other)
+	{
+		x.swap(other.x), y.swap(other.y), z.swap(other.z), d.swap(other.d);
+	}
+};
+
+//In-memory RGB-DI generation: outlier removal, plane search, projection and
+//rasterization of a PointCloud<PointXYZRGB> whose up axis is y. Nothing is read
+//from or written to disk. The single stages are public for pipelines and benchmarks;
+//filterPoints may run concurrently, the other stages share the plane search and
+//the rasterizer buffers of the object.
+class RGBDIProjection
+{
+public:
+	RGBDIProjection();
+	~RGBDIProjection();
+
+	//SEARCH_SAMPLED evaluates candidateCount directions, SEARCH_PCA_SEEDED a few dozen
+	void setSearchMode(PlaneSearch::SearchMode mode, int candidateCount = 1000)
+	{
+		m_searchMode = mode;
+		m_candidateCount = candidateCount;
+	}
+	//StatisticalOutlierRemoval parameters, meanK 0 disables the filter
+	void setOutlierFilter(int meanK, double stddevMul)
+	{
+		m_meanK = meanK;
+		m_stddevMul = stddevMul;
+	}
+	//output resolution and hole filling radius of the RGB-DI images, 0 disables filling
+	void setImageSize(int rows, int cols) { m_rows = rows, m_cols = cols; }
+	void setHoleFilling(int radius) { m_holeFill = radius; }
+	int getImageRows() const { return m_rows; }
+	int getImageCols() const { return m_cols; }
+
+	//runs all stages; mirrored (optional) receives the left-right flipped image
+	void compute(const pcl::PointCloud<pcl::PointXYZRGB>::ConstPtr &cloud, RGBDIImage &image,
+		RGBDIImage *mirrored = NULL);
+
+	void filterPoints(const pcl::PointCloud<pcl::PointXYZRGB>::ConstPtr &cloud, Points6D &points) const;
+	//returns the best plane for points, which must not be empty
+	PlaneCandidate searchPlane(const Points6D &points);
+	void projectPoints(const Points6D &points, const PlaneCandidate &plane, ProjectedPoints6D &projected) const;
+	void rasterize(const Points6D &points, const ProjectedPoints6D &projected, RGBDIImage &image);
+	//searchPlane + projectPoints + rasterize
+	void projectPoints(const Points6D &points, ProjectedPoints6D &projected, RGBDIImage &image);
+
+private:
+	PlaneSearch::SearchMode m_searchMode;
+	int m_candidateCount;
+	int m_meanK;
+	double m_stddevMul;
+	int m_rows;
+	int m_cols;
+	int m_holeFill;
+	float m_x0; float m_y0; float m_z0;
+	PlaneSearch m_search;
+	DIRasterizer m_raster;
+};
+
+#endif
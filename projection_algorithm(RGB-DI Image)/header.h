@@ -8,29 +8,20 @@
 #include <time.h>
 #include <vector>
 #include <algorithm>
-#include <Windows.h>
-#include <process.h>
 #include <numeric>
 #include <queue>
 #include "opencv2/opencv.hpp"
 #include <math.h>
 #include "omp.h"
 #include <map>
-#include <opencv/cv.h>
-#include <opencv/highgui.h>
 #include <stdio.h>
 #include <math.h>
 #include <vector>
 #include <float.h>
 #include <stdlib.h> 
 #include <pcl/point_types.h>
-#include <pcl/features/normal_3d.h>
-#include <pcl/features/pfh.h>
-#include <pcl/features/fpfh.h>
 #include <pcl/io/pcd_io.h>
 #include <pcl/point_types.h>
-#include <pcl/features/fpfh_omp.h>
-#include <pcl/features/normal_3d_omp.h>
 #include <pcl/filters/statistical_outlier_removal.h>
 #include <boost/progress.hpp>
 #include <boost/thread.hpp>
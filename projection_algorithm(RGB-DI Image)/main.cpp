@@ -1,14 +1,50 @@
 
 #include"ProjectionAlgorithm.h"
-int main()
+#include"BatchProjection.h"
+#include<pcl/console/parse.h>
+int main(int argc, char **argv)
 {   
 
 
 	boost::progress_timer ptx;
-	string data6dtxt("TestData6D_RGB.txt");
-	ProjectionAlgorithm *pt = new ProjectionAlgorithm;
 	//x upward -0,y upward -1,z upward -2
-	pt->PointsFilter6D(data6dtxt,1);
+	int flag = 1;
+	pcl::console::parse_argument(argc, argv, "-axis", flag);
+	ProjectionAlgorithm *pt = new ProjectionAlgorithm;
+
+	//-batch <directory|file list> [-out <directory>] [-queue <frames>] [-mirror]
+	string source;
+	if (pcl::console::parse_argument(argc, argv, "-batch", source) >= 0)
+	{
+		vector<string> files;
+		if (!BatchProjection::collectInputs(source, files))
+		{
+			cout << "no input files in " << source << endl;
+			delete pt;
+			return -1;
+		}
+		string outdir(".");
+		int depth = 2;
+		pcl::console::parse_argument(argc, argv, "-out", outdir);
+		pcl::console::parse_argument(argc, argv, "-queue", depth);
+
+		BatchProjection pipeline(*pt);
+		pipeline.setUpAxis(flag);
+		pipeline.setOutputDirectory(outdir);
+		pipeline.setQueueDepth(depth);
+		pipeline.setWriteMirrorPoints(pcl::console::find_switch(argc, argv, "-mirror"));
+		size_t done = pipeline.run(files);
+		pipeline.printStatistics(std::cerr);
+		delete pt;
+		return done == files.size() ? 0 : -1;
+	}
+
+	string data6dtxt("TestData6D_RGB.txt");
+	if (!pt->PointsFilter6D(data6dtxt,flag))
+	{
+		delete pt;
+		return -1;
+	}
 	pt->ProjectionMirror6D();
 	delete pt;
 
@@ -0,0 +1,168 @@
+#include <stdio.h>
+#include <math.h>
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+#include <pcl/console/parse.h>
+#include <pcl/common/time.h>
+#include "RGBDIProjection.h"
+
+//micro-benchmark of the RGB-DI stages on synthetic clouds
+//usage: pcl_projection_benchmark [-sizes 1e6,1e7,...] [-repeat n] [-rows r -cols c]
+//                                [-skip_filter] [-thresholds file]
+//thresholds file: one "stage minimum_Mpts_per_second" pair per line; the exit
+//code is 1 if any stage of any size is slower
+
+//deterministic hash of (seed, i) onto [0,1), so points can be generated in parallel
+static inline float random01(unsigned long long seed, unsigned long long i)
+{
+	unsigned long long z = seed * 0x9E3779B97F4A7C15ULL + i + 1;
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	z ^= z >> 31;
+	return static_cast<float>(z >> 40) / static_cast<float>(1ULL << 24);
+}
+
+//street-like scene with y up: ground, two facades, scattered boxes and 1% outliers
+static void makeCloud(size_t n, pcl::PointCloud<pcl::PointXYZRGB> &cloud)
+{
+	cloud.points.resize(n);
+	cloud.width = static_cast<uint32_t>(n);
+	cloud.height = 1;
+	cloud.is_dense = true;
+#pragma omp parallel for schedule(static)
+	for (long long li = 0; li < static_cast<long long>(n); li++)
+	{
+		const unsigned long long i = static_cast<unsigned long long>(li);
+		pcl::PointXYZRGB &pt = cloud.points[static_cast<size_t>(li)];
+		const float a = random01(1, i), b = random01(2, i), c = random01(3, i);
+		const float noise = 0.02f * (random01(4, i) - 0.5f);
+		const float kind = random01(5, i);
+		if (kind < 0.5f)
+			pt.x = 100.0f * a - 50.0f, pt.y = noise, pt.z = 20.0f * b - 10.0f;
+		else if (kind < 0.8f)
+			pt.x = 100.0f * a - 50.0f, pt.y = 15.0f * b, pt.z = (c < 0.5f ? -10.0f : 10.0f) + noise;
+		else if (kind < 0.99f)
+		{
+			const float cx = floorf(a * 20.0f) * 5.0f - 50.0f;
+			pt.x = cx + 2.0f * b, pt.y = 2.0f * c, pt.z = 4.0f * random01(6, i) - 2.0f + noise;
+		}
+		else
+			pt.x = 100.0f * a - 50.0f, pt.y = 30.0f * b - 10.0f, pt.z = 40.0f * c - 20.0f;
+		uint8_t r = static_cast<uint8_t>(255.0f * a), g = static_cast<uint8_t>(255.0f * b), bl = static_cast<uint8_t>(255.0f * c);
+		pt.rgba = static_cast<uint32_t>(r) << 16 | static_cast<uint32_t>(g) << 8 | static_cast<uint32_t>(bl);
+	}
+}
+
+static bool loadThresholds(const std::string &file, std::map<std::string, double> &thresholds)
+{
+	std::ifstream in(file.c_str());
+	if (!in)
+		return false;
+	std::string stage;
+	double minimum;
+	while (in >> stage)
+	{
+		if (stage[0] == '#')
+		{
+			std::getline(in, stage);
+			continue;
+		}
+		if (in >> minimum)
+			thresholds[stage] = minimum;
+	}
+	return true;
+}
+
+int main(int argc, char **argv)
+{
+	std::vector<double> sizes;
+	if (pcl::console::parse_x_arguments(argc, argv, "-sizes", sizes) < 0)
+	{
+		sizes.push_back(1e6);
+		sizes.push_back(1e7);
+	}
+	int repeat = 3, rows = 480, cols = 640;
+	pcl::console::parse_argument(argc, argv, "-repeat", repeat);
+	pcl::console::parse_argument(argc, argv, "-rows", rows);
+	pcl::console::parse_argument(argc, argv, "-cols", cols);
+	const bool skipFilter = pcl::console::find_switch(argc, argv, "-skip_filter");
+	std::string thresholdFile;
+	std::map<std::string, double> thresholds;
+	if (pcl::console::parse_argument(argc, argv, "-thresholds", thresholdFile) >= 0 &&
+		!loadThresholds(thresholdFile, thresholds))
+	{
+		std::cerr << "cannot read thresholds " << thresholdFile << std::endl;
+		return 1;
+	}
+
+	RGBDIProjection projection;
+	projection.setImageSize(rows, cols);
+	bool regression = false;
+	printf("%12s %-12s %10s %10s\n", "points", "stage", "best[ms]", "Mpts/s");
+	for (size_t s = 0; s < sizes.size(); s++)
+	{
+		const size_t n = static_cast<size_t>(sizes[s]);
+		pcl::PointCloud<pcl::PointXYZRGB>::Ptr cloud(new pcl::PointCloud<pcl::PointXYZRGB>);
+		makeCloud(n, *cloud);
+
+		Points6D points;
+		ProjectedPoints6D projected;
+		RGBDIImage image;
+		PlaneCandidate plane;
+		for (int stage = 0; stage < 5; stage++)
+		{
+			static const char *stageNames[] = { "filter", "search", "search_pca", "project", "raster" };
+			if (stage == 0 && skipFilter)
+			{
+				projection.setOutlierFilter(0, 1.0);
+				projection.filterPoints(cloud, points);
+				continue;
+			}
+			double fastest = -1;
+			for (int k = 0; k < std::max(repeat, 1); k++)
+			{
+				pcl::StopWatch watch;
+				switch (stage)
+				{
+				case 0:
+					projection.setOutlierFilter(50, 1.0);
+					projection.filterPoints(cloud, points);
+					break;
+				case 1:
+					projection.setSearchMode(PlaneSearch::SEARCH_SAMPLED, 1000);
+					plane = projection.searchPlane(points);
+					break;
+				case 2:
+					projection.setSearchMode(PlaneSearch::SEARCH_PCA_SEEDED);
+					projection.searchPlane(points);
+					break;
+				case 3:
+					projection.projectPoints(points, plane, projected);
+					break;
+				case 4:
+					projection.rasterize(points, projected, image);
+					break;
+				}
+				double ms = watch.getTime();
+				if (fastest < 0 || ms < fastest)
+					fastest = ms;
+			}
+			//the filter reads the whole cloud, the later stages only the inliers
+			const double count = static_cast<double>(stage == 0 ? n : points.size());
+			const double mpts = count / std::max(fastest, 1.0) * 1e-3;
+			printf("%12u %-12s %10.1f %10.2f", static_cast<unsigned int>(n), stageNames[stage], fastest, mpts);
+			std::map<std::string, double>::const_iterator it = thresholds.find(stageNames[stage]);
+			if (it != thresholds.end() && mpts < it->second)
+			{
+				printf("  REGRESSION (minimum %.2f)", it->second);
+				regression = true;
+			}
+			printf("\n");
+		}
+	}
+	return regression ? 1 : 0;
+}
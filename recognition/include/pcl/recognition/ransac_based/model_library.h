@@ -67,7 +67,8 @@ namespace pcl
         {
           public:
             Model (const PointCloudIn& points, const PointCloudN& normals, float voxel_size, const std::string& object_name,
-                   float frac_of_points_for_registration, void* user_data = NULL)
+                   float frac_of_points_for_registration, void* user_data = NULL,
+                   uint32_t random_seed = static_cast<uint32_t> (time (NULL)))
             : obj_name_(object_name),
               user_data_ (user_data)
             {
@@ -105,20 +106,20 @@ namespace pcl
                 ids[i] = i;
 
               // The random generator
-              pcl::common::UniformGenerator<int> randgen (0, num_octree_points - 1, static_cast<uint32_t> (time (NULL)));
+              pcl::common::Xoshiro128 rng (random_seed);
 
               // Randomly sample some points from the octree
               for ( int i = 0 ; i < num_points_for_registration ; ++i )
               {
                 // Choose a random position within the array of ids
-                randgen.setParameters (0, static_cast<int> (ids.size ()) - 1);
-                int rand_pos = randgen.run ();
+                int rand_pos = static_cast<int> (rng.nextBounded (static_cast<uint32_t> (ids.size ())));
 
                 // Copy the randomly selected octree point
                 aux::copy3 (octree_.getFullLeaves ()[ids[rand_pos]]->getData ()->getPoint (), points_for_registration_[i]);
 
-                // Delete the selected id
-                ids.erase (ids.begin() + rand_pos);
+                // Delete the selected id, the order of the remaining ones does not matter
+                ids[rand_pos] = ids.back ();
+                ids.pop_back ();
               }
             }
 
@@ -213,6 +214,17 @@ namespace pcl
           ignore_coplanar_opps_ = false;
         }
 
+        /** \brief Reseed the random number generator which picks the registration points of the models added
+          * from now on. The default seed is the construction time.
+          * \param[in] seed the random seed
+          * \param[in] stream the index of the random stream
+          */
+        inline void
+        setRandomSeed (unsigned int seed, unsigned int stream = 0)
+        {
+          rng_alg_.seed (seed, stream);
+        }
+
         /** \brief Adds a model to the hash table.
           *
           * \param[in] points represents the model to be added.
@@ -263,6 +275,7 @@ namespace pcl
         float voxel_size_;
         float max_coplanarity_angle_;
         bool ignore_coplanar_opps_;
+        pcl::common::Xoshiro128 rng_alg_;
 
         std::map<std::string,Model*> models_;
         HashTable hash_table_;
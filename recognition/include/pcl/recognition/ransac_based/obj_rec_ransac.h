@@ -215,6 +215,17 @@ namespace pcl
           do_icp_hypotheses_refinement_ = false;
         }
 
+        /** \brief Set the seed of the random number generator used to sample oriented point pairs from the scene.
+          * Every call to recognize () restarts the generator from this seed, so recognizing the same scene twice
+          * gives the same result. The seed also restarts the generator of the model library, which picks the
+          * registration points of the models added afterwards. The default seed is the construction time. */
+        inline void
+        setRandomSeed (unsigned int seed)
+        {
+          random_seed_ = seed;
+          model_library_.setRandomSeed (seed);
+        }
+
         /** \brief Add an object model to be recognized.
           *
           * \param[in] points are the object points.
@@ -466,6 +477,7 @@ namespace pcl
         bool ignore_coplanar_opps_;
         float frac_of_points_for_icp_refinement_;
         bool do_icp_hypotheses_refinement_;
+        unsigned int random_seed_;
 
         ModelLibrary model_library_;
         ORROctree scene_octree_;
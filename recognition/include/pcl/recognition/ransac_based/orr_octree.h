@@ -50,6 +50,7 @@
 #include <pcl/point_types.h>
 #include <pcl/point_cloud.h>
 #include <pcl/pcl_exports.h>
+#include <pcl/common/random.h>
 #include <cstdlib>
 #include <ctime>
 #include <vector>
@@ -359,6 +360,11 @@ namespace pcl
         ORROctree::Node*
         getRandomFullLeafOnSphere (const float* p, float radius) const;
 
+        /** \brief Same as above but draws the random numbers from the caller's generator 'rng', which makes
+          * the choice reproducible and allows concurrent calls with one generator per thread. */
+        ORROctree::Node*
+        getRandomFullLeafOnSphere (const float* p, float radius, pcl::common::Xoshiro128& rng) const;
+
         /** \brief Since the leaves are aligned in a rectilinear grid, each leaf has a unique id. The method returns the leaf
           * with id [i, j, k] or NULL is no such leaf exists. */
         ORROctree::Node*
@@ -55,7 +55,8 @@ ModelLibrary::ModelLibrary (float pair_width, float voxel_size, float max_coplan
 : pair_width_ (pair_width),
   voxel_size_ (voxel_size),
   max_coplanarity_angle_ (max_coplanarity_angle),
-  ignore_coplanar_opps_ (true)
+  ignore_coplanar_opps_ (true),
+  rng_alg_ (static_cast<unsigned int> (time (NULL)))
 {
   num_of_cells_[0] = 60;
   num_of_cells_[1] = 60;
@@ -121,7 +122,7 @@ ModelLibrary::addModel (const PointCloudIn& points, const PointCloudN& normals,
   }
 
   // It is unique -> create a new library model and save it
-  Model* new_model = new Model (points, normals, voxel_size_, object_name, frac_of_points_for_registration, user_data);
+  Model* new_model = new Model (points, normals, voxel_size_, object_name, frac_of_points_for_registration, user_data, rng_alg_ ());
   result.first->second = new_model;
 
   const ORROctree& octree = new_model->getOctree ();
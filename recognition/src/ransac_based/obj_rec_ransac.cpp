@@ -58,6 +58,7 @@ pcl::recognition::ObjRecRANSAC::ObjRecRANSAC (float pair_width, float voxel_size
   ignore_coplanar_opps_ (true),
   frac_of_points_for_icp_refinement_ (0.3f),
   do_icp_hypotheses_refinement_ (true),
+  random_seed_ (static_cast<unsigned int> (time (NULL))),
   model_library_ (pair_width, voxel_size, max_coplanarity_angle_),
   rec_mode_ (ObjRecRANSAC::FULL_RECOGNITION)
 {
@@ -181,7 +182,7 @@ pcl::recognition::ObjRecRANSAC::sampleOrientedPointPairs (int num_iterations, co
   }
 
   // The random generator
-  UniformGenerator<int> randgen (0, num_full_leaves - 1, static_cast<uint32_t> (time (NULL)));
+  Xoshiro128 rng (random_seed_);
 
   // Init the vector with the ids
   vector<int> ids (num_full_leaves);
@@ -189,24 +190,24 @@ pcl::recognition::ObjRecRANSAC::sampleOrientedPointPairs (int num_iterations, co
     ids[i] = i;
 
   // Sample 'num_iterations' number of oriented point pairs
-  for ( int i = 0 ; i < num_iterations ; ++i )
+  for ( int i = 0 ; i < num_iterations && !ids.empty () ; ++i )
   {
     // Choose a random position within the array of ids
-    randgen.setParameters (0, static_cast<int> (ids.size ()) - 1);
-    int rand_pos = randgen.run ();
+    int rand_pos = static_cast<int> (rng.nextBounded (static_cast<uint32_t> (ids.size ())));
 
     // Get the leaf at that random position
     ORROctree::Node *leaf1 = full_scene_leaves[ids[rand_pos]];
 
-    // Delete the selected id
-    ids.erase (ids.begin() + rand_pos);
+    // Delete the selected id, the order of the remaining ones does not matter
+    ids[rand_pos] = ids.back ();
+    ids.pop_back ();
 
     // Get the leaf's point and normal
     const float *p1 = leaf1->getData ()->getPoint ();
     const float *n1 = leaf1->getData ()->getNormal ();
 
     // Randomly select a leaf at the right distance from 'leaf1'
-    ORROctree::Node *leaf2 = scene_octree_.getRandomFullLeafOnSphere (p1, pair_width_);
+    ORROctree::Node *leaf2 = scene_octree_.getRandomFullLeafOnSphere (p1, pair_width_, rng);
     if ( !leaf2 )
       continue;
 
@@ -335,11 +335,15 @@ pcl::recognition::ORROctree::getFullLeavesIntersectedBySphere (const float* p, f
 ORROctree::Node*
 pcl::recognition::ORROctree::getRandomFullLeafOnSphere (const float* p, float radius) const
 {
-  vector<int> tmp_ids;
-  tmp_ids.reserve (8);
+  pcl::common::Xoshiro128 rng (static_cast<uint32_t> (time (NULL)));
+  return (this->getRandomFullLeafOnSphere (p, radius, rng));
+}
 
-  pcl::common::UniformGenerator<int> randgen (0, 1, static_cast<uint32_t> (time (NULL)));
+//================================================================================================================================================================
 
+ORROctree::Node*
+pcl::recognition::ORROctree::getRandomFullLeafOnSphere (const float* p, float radius, pcl::common::Xoshiro128& rng) const
+{
   list<ORROctree::Node*> nodes;
   nodes.push_back (root_);
 
@@ -356,18 +360,16 @@ pcl::recognition::ORROctree::getRandomFullLeafOnSphere (const float* p, float ra
       // We have an intersection -> push back the children of the current node
       if ( node->hasChildren () )
       {
-        // Prepare the tmp id vector
-        for ( int i = 0 ; i < 8 ; ++i )
-          tmp_ids.push_back (i);
+        // Prepare the tmp id array
+        int tmp_ids[8] = {0, 1, 2, 3, 4, 5, 6, 7};
 
         // Push back the children in random order
-        for ( int i = 0 ; i < 8 ; ++i )
+        for ( int i = 8 ; i > 0 ; --i )
         {
-          randgen.setParameters (0, static_cast<int> (tmp_ids.size ()) - 1);
-          int rand_pos = randgen.run ();
+          int rand_pos = static_cast<int> (rng.nextBounded (i));
           nodes.push_back (node->getChild (tmp_ids[rand_pos]));
           // Remove the randomly selected id
-          tmp_ids.erase (tmp_ids.begin () + rand_pos);
+          tmp_ids[rand_pos] = tmp_ids[i-1];
         }
       }
       else if ( node->hasData () )
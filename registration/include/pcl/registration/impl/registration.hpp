@@ -175,6 +175,7 @@ pcl::Registration<PointSource, PointTarget, Scalar>::align (PointCloudSource &ou
 template <typename PointSource, typename PointTarget, typename Scalar> inline void
 pcl::Registration<PointSource, PointTarget, Scalar>::align (PointCloudSource &output, const Matrix4& guess)
 {
+  PCL_PROFILE_SCOPE (reg_name_.c_str ());
   if (!initCompute ()) 
     return;
 
@@ -79,13 +79,12 @@ namespace pcl
         , threshold_ (std::numeric_limits<double>::max ())
         , max_iterations_ (1000)
         , rng_alg_ ()
-        , rng_ (new boost::uniform_01<boost::mt19937> (rng_alg_))
       {
          // Create a random number generator object
          if (random)
-           rng_->base ().seed (static_cast<unsigned> (std::time (0)));
+           rng_alg_.seed (static_cast<unsigned> (std::time (0)));
          else
-           rng_->base ().seed (12345u);
+           rng_alg_.seed (12345u);
       };
 
       /** \brief Constructor for base SAC.
@@ -105,13 +104,12 @@ namespace pcl
         , threshold_ (threshold)
         , max_iterations_ (1000)
         , rng_alg_ ()
-        , rng_ (new boost::uniform_01<boost::mt19937> (rng_alg_))
       {
          // Create a random number generator object
          if (random)
-           rng_->base ().seed (static_cast<unsigned> (std::time (0)));
+           rng_alg_.seed (static_cast<unsigned> (std::time (0)));
          else
-           rng_->base ().seed (12345u);
+           rng_alg_.seed (12345u);
       };
 
       /** \brief Set the Sample Consensus model to use.
@@ -283,8 +281,7 @@ namespace pcl
       {
         indices_subset.clear ();
         while (indices_subset.size () < nr_samples)
-          //indices_subset.insert ((*indices)[(int) (indices->size () * (rand () / (RAND_MAX + 1.0)))]);
-          indices_subset.insert ((*indices)[static_cast<int> (static_cast<double>(indices->size ()) * rnd ())]);
+          indices_subset.insert ((*indices)[rng_alg_.nextBounded (static_cast<pcl::uint32_t> (indices->size ()))]);
       }
 
       /** \brief Return the best model found so far. 
@@ -330,17 +327,14 @@ namespace pcl
       /** \brief Maximum number of iterations before giving up. */
       int max_iterations_;
 
-      /** \brief Boost-based random number generator algorithm. */
-      boost::mt19937 rng_alg_;
+      /** \brief Random number generator algorithm. */
+      pcl::common::Xoshiro128 rng_alg_;
 
-      /** \brief Boost-based random number generator distribution. */
-      boost::shared_ptr<boost::uniform_01<boost::mt19937> > rng_;
-
-      /** \brief Boost-based random number generator. */
+      /** \brief Random number generator. \return a random number in [0, 1). */
       inline double
       rnd ()
       {
-        return ((*rng_) ());
+        return (rng_alg_.nextDouble ());
       }
    };
 }
@@ -41,14 +41,17 @@
 #ifndef PCL_SAMPLE_CONSENSUS_MODEL_H_
 #define PCL_SAMPLE_CONSENSUS_MODEL_H_
 
+#include <cassert>
 #include <cfloat>
 #include <ctime>
+#include <limits>
 #include <limits.h>
 #include <set>
 
 #include <pcl/console/print.h>
 #include <pcl/point_cloud.h>
 #include <pcl/sample_consensus/boost.h>
+#include <pcl/common/random.h>
 #include <pcl/sample_consensus/model_types.h>
 
 #include <pcl/search/search.h>
@@ -87,8 +90,6 @@ namespace pcl
         , samples_radius_search_ ()
         , shuffled_indices_ ()
         , rng_alg_ ()
-        , rng_dist_ (new boost::uniform_int<> (0, std::numeric_limits<int>::max ()))
-        , rng_gen_ ()
         , error_sqr_dists_ ()
       {
         // Create a random number generator object
@@ -96,8 +97,6 @@ namespace pcl
           rng_alg_.seed (static_cast<unsigned> (std::time(0)));
         else
           rng_alg_.seed (12345u);
-
-        rng_gen_.reset (new boost::variate_generator<boost::mt19937&, boost::uniform_int<> > (rng_alg_, *rng_dist_)); 
        }
 
     public:
@@ -114,8 +113,6 @@ namespace pcl
         , samples_radius_search_ ()
         , shuffled_indices_ ()
         , rng_alg_ ()
-        , rng_dist_ (new boost::uniform_int<> (0, std::numeric_limits<int>::max ()))
-        , rng_gen_ ()
         , error_sqr_dists_ ()
       {
         if (random)
@@ -125,9 +122,6 @@ namespace pcl
 
         // Sets the input cloud and creates a vector of "fake" indices
         setInputCloud (cloud);
-
-        // Create a random number generator object
-        rng_gen_.reset (new boost::variate_generator<boost::mt19937&, boost::uniform_int<> > (rng_alg_, *rng_dist_)); 
       }
 
       /** \brief Constructor for base SampleConsensusModel.
@@ -146,8 +140,6 @@ namespace pcl
         , samples_radius_search_ ()
         , shuffled_indices_ ()
         , rng_alg_ ()
-        , rng_dist_ (new boost::uniform_int<> (0, std::numeric_limits<int>::max ()))
-        , rng_gen_ ()
         , error_sqr_dists_ ()
       {
         if (random)
@@ -161,9 +153,6 @@ namespace pcl
           indices_->clear ();
         }
         shuffled_indices_ = *indices_;
-
-        // Create a random number generator object
-        rng_gen_.reset (new boost::variate_generator<boost::mt19937&, boost::uniform_int<> > (rng_alg_, *rng_dist_)); 
        };
 
       /** \brief Destructor for base SampleConsensusModel. */
@@ -404,6 +393,19 @@ namespace pcl
         radius = samples_radius_;
       }
 
+      /** \brief Reseed the random number generator used to draw samples.
+        * Models used concurrently (e.g. one per thread in a parallel RANSAC) should
+        * use the same seed with a different \a stream each, which gives reproducible
+        * and statistically independent sample sequences.
+        * \param[in] seed the random seed
+        * \param[in] stream the index of the random stream, e.g. the thread number
+        */
+      inline void
+      setRandomSeed (unsigned int seed, unsigned int stream = 0)
+      {
+        rng_alg_.seed (seed, stream);
+      }
+
       friend class ProgressiveSampleConsensus<PointT>;
 
       /** \brief Compute the variance of the errors to the model.
@@ -443,10 +445,7 @@ namespace pcl
         size_t sample_size = sample.size ();
         size_t index_size = shuffled_indices_.size ();
         for (unsigned int i = 0; i < sample_size; ++i)
-          // The 1/(RAND_MAX+1.0) trick is when the random numbers are not uniformly distributed and for small modulo
-          // elements, that does not matter (and nowadays, random number generators are good)
-          //std::swap (shuffled_indices_[i], shuffled_indices_[i + (rand () % (index_size - i))]);
-          std::swap (shuffled_indices_[i], shuffled_indices_[i + (rnd () % (index_size - i))]);
+          std::swap (shuffled_indices_[i], shuffled_indices_[i + rndBounded (index_size - i)]);
         std::copy (shuffled_indices_.begin (), shuffled_indices_.begin () + sample_size, sample.begin ());
       }
 
@@ -460,7 +459,7 @@ namespace pcl
         size_t sample_size = sample.size ();
         size_t index_size = shuffled_indices_.size ();
 
-        std::swap (shuffled_indices_[0], shuffled_indices_[0 + (rnd () % (index_size - 0))]);
+        std::swap (shuffled_indices_[0], shuffled_indices_[rndBounded (index_size)]);
         //const PointT& pt0 = (*input_)[shuffled_indices_[0]];
 
         std::vector<int> indices;
@@ -483,7 +482,7 @@ namespace pcl
         else
         {
           for (unsigned int i = 0; i < sample_size-1; ++i)
-            std::swap (indices[i], indices[i + (rnd () % (indices.size () - i))]);
+            std::swap (indices[i], indices[i + rndBounded (indices.size () - i)]);
           for (unsigned int i = 1; i < sample_size; ++i)
             shuffled_indices_[i] = indices[i-1];
         }
@@ -527,23 +526,27 @@ namespace pcl
       /** Data containing a shuffled version of the indices. This is used and modified when drawing samples. */
       std::vector<int> shuffled_indices_;
 
-      /** \brief Boost-based random number generator algorithm. */
-      boost::mt19937 rng_alg_;
-
-      /** \brief Boost-based random number generator distribution. */
-      boost::shared_ptr<boost::uniform_int<> > rng_dist_;
-
-      /** \brief Boost-based random number generator. */
-      boost::shared_ptr<boost::variate_generator< boost::mt19937&, boost::uniform_int<> > > rng_gen_;
+      /** \brief Random number generator, owned by the model so that concurrent models do not share state. */
+      pcl::common::Xoshiro128 rng_alg_;
 
       /** \brief A vector holding the distances to the computed model. Used internally. */
       std::vector<double> error_sqr_dists_;
 
-      /** \brief Boost-based random number generator. */
+      /** \brief Random number generator. \return a random integer in [0, INT_MAX]. */
       inline int
       rnd ()
       {
-        return ((*rng_gen_) ());
+        return (static_cast<int> (rng_alg_ () >> 1));
+      }
+
+      /** \brief Random number generator. \return an unbiased random index in [0, bound).
+        * \note bound must fit in 32 bits, the range of the underlying generator.
+        */
+      inline size_t
+      rndBounded (size_t bound)
+      {
+        assert (bound <= std::numeric_limits<pcl::uint32_t>::max ());
+        return (rng_alg_.nextBounded (static_cast<pcl::uint32_t> (bound)));
       }
     public:
       EIGEN_MAKE_ALIGNED_OPERATOR_NEW
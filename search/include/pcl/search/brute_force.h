@@ -39,12 +39,18 @@
 #define PCL_SEARCH_BRUTE_FORCE_H_
 
 #include <pcl/search/search.h>
+#include <pcl/common/point_cloud_soa.h>
 
 namespace pcl
 {
   namespace search
   {
     /** \brief Implementation of a simple brute force search algorithm.
+      *
+      * The valid points of the input are copied into a pcl::PointCloudSoA by
+      * \ref setInputCloud, and the distances are computed from it in blocks with
+      * vectorized code. Changes to the input cloud after setInputCloud are
+      * therefore not seen by the search.
       * \author Suat Gedikli
       * \ingroup search
       */
@@ -82,8 +88,6 @@ namespace pcl
         }
       };
 
-      // replace by some metric functor
-      float getDistSqr (const PointT& point1, const PointT& point2) const;
       public:
         BruteForce (bool sorted_results = false)
         : Search<PointT> ("BruteForce", sorted_results)
@@ -96,6 +100,15 @@ namespace pcl
         {
         }
 
+        /** \brief Provide a pointer to the input dataset and copy its valid points into
+          * structure-of-arrays form.
+          * \param[in] cloud the const boost shared pointer to a PointCloud message
+          * \param[in] indices the point indices subset that is to be used from \a cloud
+          */
+        virtual void
+        setInputCloud (const PointCloudConstPtr& cloud,
+                       const IndicesConstPtr &indices = IndicesConstPtr ());
+
         /** \brief Search for the k-nearest neighbors for the given query point.
           * \param[in] point the given query point
           * \param[in] k the number of neighbors to search for
@@ -123,21 +136,14 @@ namespace pcl
                       unsigned int max_nn = 0) const;
 
       private:
-        int
-        denseKSearch (const PointT &point, int k, std::vector<int> &k_indices, std::vector<float> &k_distances) const;
+        /** \brief Number of distances computed per block. */
+        static const size_t block_size_ = 256;
 
-        int
-        sparseKSearch (const PointT &point, int k, std::vector<int> &k_indices, std::vector<float> &k_distances) const;
+        /** \brief Coordinates of the valid points of the input, in the order of the indices. */
+        PointCloudSoA soa_;
 
-        int
-        denseRadiusSearch (const PointT& point, double radius,
-                           std::vector<int> &k_indices, std::vector<float> &k_sqr_distances,
-                           unsigned int max_nn = 0) const;
-
-        int
-        sparseRadiusSearch (const PointT& point, double radius,
-                            std::vector<int> &k_indices, std::vector<float> &k_sqr_distances,
-                            unsigned int max_nn = 0) const;
+        /** \brief Index into the input cloud of each point in soa_. */
+        std::vector<int> soa_indices_;
     };
   }
 }
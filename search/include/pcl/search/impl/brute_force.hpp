@@ -42,11 +42,28 @@
 #include <queue>
 
 //////////////////////////////////////////////////////////////////////////////////////////////
-template <typename PointT> float
-pcl::search::BruteForce<PointT>::getDistSqr (
-    const PointT& point1, const PointT& point2) const
+template <typename PointT> void
+pcl::search::BruteForce<PointT>::setInputCloud (
+    const PointCloudConstPtr& cloud, const IndicesConstPtr &indices)
 {
-  return (point1.getVector3fMap () - point2.getVector3fMap ()).squaredNorm ();
+  Search<PointT>::setInputCloud (cloud, indices);
+
+  soa_indices_.clear ();
+  if (indices_ != NULL)
+  {
+    soa_indices_.reserve (indices_->size ());
+    for (std::vector<int>::const_iterator iIt = indices_->begin (); iIt != indices_->end (); ++iIt)
+      if (input_->is_dense || isFinite (input_->points[*iIt]))
+        soa_indices_.push_back (*iIt);
+  }
+  else
+  {
+    soa_indices_.reserve (input_->size ());
+    for (size_t index = 0; index < input_->size (); ++index)
+      if (input_->is_dense || isFinite (input_->points[index]))
+        soa_indices_.push_back (static_cast<int> (index));
+  }
+  toPointCloudSoA (*input_, soa_indices_, soa_);
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////////
@@ -61,146 +78,39 @@ pcl::search::BruteForce<PointT>::nearestKSearch (
   if (k < 1)
     return 0;
 
-  if (input_->is_dense)
-    return denseKSearch (point, k, k_indices, k_distances);
-  else
-    return sparseKSearch (point, k, k_indices, k_distances);
-}
-
-//////////////////////////////////////////////////////////////////////////////////////////////
-template <typename PointT> int
-pcl::search::BruteForce<PointT>::denseKSearch (
-    const PointT &point, int k, std::vector<int> &k_indices, std::vector<float> &k_distances) const
-{
   // container for first k elements -> O(1) for insertion, since order not required here
   std::vector<Entry> result;
-  result.reserve (k);
+  result.reserve (std::min (static_cast<size_t> (k), soa_.size ()));
   std::priority_queue<Entry> queue;
-  if (indices_ != NULL)
-  {
-    std::vector<int>::const_iterator iIt =indices_->begin ();
-    std::vector<int>::const_iterator iEnd = indices_->begin () + std::min (static_cast<unsigned> (k), static_cast<unsigned> (indices_->size ()));
-    for (; iIt != iEnd; ++iIt)
-      result.push_back (Entry (*iIt, getDistSqr (input_->points[*iIt], point)));
 
-    queue = std::priority_queue<Entry> (result.begin (), result.end ());
-
-    // add the rest
-    Entry entry;
-    for (; iIt != indices_->end (); ++iIt)
-    {
-      entry.distance = getDistSqr (input_->points[*iIt], point);
-      if (queue.top ().distance > entry.distance)
-      {
-        entry.index = *iIt;
-        queue.pop ();
-        queue.push (entry);
-      }
-    }
-  }
-  else
+  const Eigen::Vector3f query = point.getVector3fMap ();
+  float distances[block_size_];
+  for (size_t begin = 0; begin < soa_.size (); begin += block_size_)
   {
-    Entry entry;
-    for (entry.index = 0; entry.index < std::min (static_cast<unsigned> (k), static_cast<unsigned> (input_->size ())); ++entry.index)
+    const size_t end = std::min (begin + block_size_, soa_.size ());
+    getSquaredDistances (soa_, begin, end, query, distances);
+    size_t i = begin;
+    for (; i < end && result.size () < static_cast<size_t> (k); ++i)
     {
-      entry.distance = getDistSqr (input_->points[entry.index], point);
-      result.push_back (entry);
+      result.push_back (Entry (soa_indices_[i], distances[i - begin]));
+      if (result.size () == static_cast<size_t> (k))
+        queue = std::priority_queue<Entry> (result.begin (), result.end ());
     }
 
-    queue = std::priority_queue<Entry> (result.begin (), result.end ());
-
     // add the rest
-    for (; entry.index < input_->size (); ++entry.index)
+    for (; i < end; ++i)
     {
-      entry.distance = getDistSqr (input_->points[entry.index], point);
-      if (queue.top ().distance > entry.distance)
+      if (queue.top ().distance > distances[i - begin])
       {
         queue.pop ();
-        queue.push (entry);
-      }      
-    }
-  }
-
-  k_indices.resize (queue.size ());
-  k_distances.resize (queue.size ());
-  size_t idx = queue.size () - 1;
-  while (!queue.empty ())
-  {
-    k_indices [idx] = queue.top ().index;
-    k_distances [idx] = queue.top ().distance;
-    queue.pop ();
-    --idx;
-  }
-  
-  return (static_cast<int> (k_indices.size ()));
-}
-
-//////////////////////////////////////////////////////////////////////////////////////////////
-template <typename PointT> int
-pcl::search::BruteForce<PointT>::sparseKSearch (
-    const PointT &point, int k, std::vector<int> &k_indices, std::vector<float> &k_distances) const
-{
-  // result used to collect the first k neighbors -> unordered
-  std::vector<Entry> result;
-  result.reserve (k);
-  
-  std::priority_queue<Entry> queue;
-  if (indices_ != NULL)
-  {
-    std::vector<int>::const_iterator iIt =indices_->begin ();
-    for (; iIt != indices_->end () && result.size () < static_cast<unsigned> (k); ++iIt)
-    {
-      if (pcl_isfinite (input_->points[*iIt].x))
-        result.push_back (Entry (*iIt, getDistSqr (input_->points[*iIt], point)));
-    }
-    
-    queue = std::priority_queue<Entry> (result.begin (), result.end ());
-
-    // either we have k elements, or there are none left to iterate >in either case we're fine
-    // add the rest
-    Entry entry;
-    for (; iIt != indices_->end (); ++iIt)
-    {
-      if (!pcl_isfinite (input_->points[*iIt].x))
-        continue;
-
-      entry.distance = getDistSqr (input_->points[*iIt], point);
-      if (queue.top ().distance > entry.distance)
-      {
-        entry.index = *iIt;
-        queue.pop ();
-        queue.push (entry);
+        queue.push (Entry (soa_indices_[i], distances[i - begin]));
       }
     }
   }
-  else
-  {
-    Entry entry;
-    for (entry.index = 0; entry.index < input_->size () && result.size () < static_cast<unsigned> (k); ++entry.index)
-    {
-      if (pcl_isfinite (input_->points[entry.index].x))
-      {
-        entry.distance = getDistSqr (input_->points[entry.index], point);
-        result.push_back (entry);
-      }
-    }
+  // fewer than k points
+  if (result.size () < static_cast<size_t> (k))
     queue = std::priority_queue<Entry> (result.begin (), result.end ());
-    
-    // add the rest
-    for (; entry.index < input_->size (); ++entry.index)
-    {
-      if (!pcl_isfinite (input_->points[entry.index].x))
-        continue;
 
-      entry.distance = getDistSqr (input_->points[entry.index], point);
-      if (queue.top ().distance > entry.distance)
-      {
-        queue.pop ();
-        queue.push (entry);
-      }
-    }
-  }
-  
   k_indices.resize (queue.size ());
   k_distances.resize (queue.size ());
   size_t idx = queue.size () - 1;
@@ -211,115 +121,48 @@ pcl::search::BruteForce<PointT>::sparseKSearch (
     queue.pop ();
     --idx;
   }
-  return (static_cast<int> (k_indices.size ()));
-}
-
-//////////////////////////////////////////////////////////////////////////////////////////////
-template <typename PointT> int
-pcl::search::BruteForce<PointT>::denseRadiusSearch (
-    const PointT& point, double radius,
-    std::vector<int> &k_indices, std::vector<float> &k_sqr_distances,
-    unsigned int max_nn) const
-{  
-  radius *= radius;
-
-  size_t reserve = max_nn;
-  if (reserve == 0)
-  {
-    if (indices_ != NULL)
-      reserve = std::min (indices_->size (), input_->size ());
-    else
-      reserve = input_->size ();
-  }
-  k_indices.reserve (reserve);
-  k_sqr_distances.reserve (reserve);
-  float distance;
-  if (indices_ != NULL)
-  {
-    for (std::vector<int>::const_iterator iIt =indices_->begin (); iIt != indices_->end (); ++iIt)
-    {
-      distance = getDistSqr (input_->points[*iIt], point);
-      if (distance <= radius)
-      {
-        k_indices.push_back (*iIt);
-        k_sqr_distances.push_back (distance);
-        if (k_indices.size () == max_nn) // max_nn = 0 -> never true
-          break;
-      }
-    }
-  }
-  else
-  {
-    for (unsigned index = 0; index < input_->size (); ++index)
-    {
-      distance = getDistSqr (input_->points[index], point);
-      if (distance <= radius)
-      {
-        k_indices.push_back (index);
-        k_sqr_distances.push_back (distance);
-        if (k_indices.size () == max_nn) // never true if max_nn = 0
-          break;
-      }
-    }
-  }
-
-  if (sorted_results_)
-    this->sortResults (k_indices, k_sqr_distances);
   
   return (static_cast<int> (k_indices.size ()));
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////////
 template <typename PointT> int
-pcl::search::BruteForce<PointT>::sparseRadiusSearch (
-    const PointT& point, double radius,
-    std::vector<int> &k_indices, std::vector<float> &k_sqr_distances,
-    unsigned int max_nn) const
+pcl::search::BruteForce<PointT>::radiusSearch (
+    const PointT& point, double radius, std::vector<int> &k_indices,
+    std::vector<float> &k_sqr_distances, unsigned int max_nn) const
 {
+  assert (isFinite (point) && "Invalid (NaN, Inf) point coordinates given to nearestKSearch!");
+  
+  k_indices.clear ();
+  k_sqr_distances.clear ();
+  if (radius <= 0)
+    return 0;
+
   radius *= radius;
 
   size_t reserve = max_nn;
-  if (reserve == 0)
-  {
-    if (indices_ != NULL)
-      reserve = std::min (indices_->size (), input_->size ());
-    else
-      reserve = input_->size ();
-  }
+  if (reserve == 0 || reserve > soa_.size ())
+    reserve = soa_.size ();
   k_indices.reserve (reserve);
   k_sqr_distances.reserve (reserve);
 
-  float distance;
-  if (indices_ != NULL)
-  {
-    for (std::vector<int>::const_iterator iIt =indices_->begin (); iIt != indices_->end (); ++iIt)
-    {
-      if (!pcl_isfinite (input_->points[*iIt].x))
-        continue;
-
-      distance = getDistSqr (input_->points[*iIt], point);
-      if (distance <= radius)
-      {
-        k_indices.push_back (*iIt);
-        k_sqr_distances.push_back (distance);
-        if (k_indices.size () == max_nn) // never true if max_nn = 0
-          break;
-      }
-    }
-  }
-  else
+  const Eigen::Vector3f query = point.getVector3fMap ();
+  float distances[block_size_];
+  for (size_t begin = 0; begin < soa_.size (); begin += block_size_)
   {
-    for (unsigned index = 0; index < input_->size (); ++index)
+    const size_t end = std::min (begin + block_size_, soa_.size ());
+    getSquaredDistances (soa_, begin, end, query, distances);
+    for (size_t i = begin; i < end; ++i)
     {
-      if (!pcl_isfinite (input_->points[index].x))
-        continue;
-      distance = getDistSqr (input_->points[index], point);
-      if (distance <= radius)
+      if (distances[i - begin] <= radius)
       {
-        k_indices.push_back (index);
-        k_sqr_distances.push_back (distance);
+        k_indices.push_back (soa_indices_[i]);
+        k_sqr_distances.push_back (distances[i - begin]);
         if (k_indices.size () == max_nn) // never true if max_nn = 0
+        {
+          begin = soa_.size ();
           break;
+        }
       }
     }
   }
@@ -330,25 +173,6 @@ pcl::search::BruteForce<PointT>::sparseRadiusSearch (
   return (static_cast<int> (k_indices.size ()));
 }
 
-//////////////////////////////////////////////////////////////////////////////////////////////
-template <typename PointT> int
-pcl::search::BruteForce<PointT>::radiusSearch (
-    const PointT& point, double radius, std::vector<int> &k_indices,
-    std::vector<float> &k_sqr_distances, unsigned int max_nn) const
-{
-  assert (isFinite (point) && "Invalid (NaN, Inf) point coordinates given to nearestKSearch!");
-  
-  k_indices.clear ();
-  k_sqr_distances.clear ();
-  if (radius <= 0)
-    return 0;
-
-  if (input_->is_dense)
-    return denseRadiusSearch (point, radius, k_indices, k_sqr_distances, max_nn);
-  else
-    return sparseRadiusSearch (point, radius, k_indices, k_sqr_distances, max_nn);
-}
-
 #define PCL_INSTANTIATE_BruteForce(T) template class PCL_EXPORTS pcl::search::BruteForce<T>;
 
 #endif //PCL_SEARCH_IMPL_BRUTE_FORCE_SEARCH_H_
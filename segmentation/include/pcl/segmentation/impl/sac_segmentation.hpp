@@ -42,6 +42,7 @@
 #define PCL_SEGMENTATION_IMPL_SAC_SEGMENTATION_H_
 
 #include <pcl/segmentation/sac_segmentation.h>
+#include <pcl/common/profiler.h>
 
 // Sample Consensus methods
 #include <pcl/sample_consensus/sac.h>
@@ -74,6 +75,7 @@
 template <typename PointT> void
 pcl::SACSegmentation<PointT>::segment (PointIndices &inliers, ModelCoefficients &model_coefficients)
 {
+  PCL_PROFILE_SCOPE ("SACSegmentation::segment");
   // Copy the header information
   inliers.header = model_coefficients.header = input_->header;
 
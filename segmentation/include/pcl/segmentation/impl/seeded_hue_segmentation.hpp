@@ -58,6 +58,11 @@ pcl::seededHueSegmentation (const PointCloud<PointXYZRGB>
   // Create a bool vector of processed point indices, and initialize it to false
   std::vector<bool> processed (cloud.points.size (), false);
 
+  // Points are usually compared many times, so convert all colors once
+  std::vector<float> hue (cloud.points.size ());
+  if (!cloud.points.empty ())
+    PointCloudRGBtoHSV (cloud, &hue[0], NULL, NULL);
+
   std::vector<int> nn_indices;
   std::vector<float> nn_distances;
 
@@ -74,10 +79,7 @@ pcl::seededHueSegmentation (const PointCloud<PointXYZRGB>
     int sq_idx = 0;
     seed_queue.push_back (i);
 
-    PointXYZRGB  p;
-    p = cloud.points[i];
-    PointXYZHSV h;
-    PointXYZRGBtoXYZHSV(p, h);
+    const float seed_hue = hue[i];
 
     while (sq_idx < static_cast<int> (seed_queue.size ()))
     {
@@ -96,12 +98,7 @@ pcl::seededHueSegmentation (const PointCloud<PointXYZRGB>
         if (processed[nn_indices[j]])                             // Has this point been processed before ?
           continue;
 
-        PointXYZRGB  p_l;
-        p_l = cloud.points[nn_indices[j]];
-        PointXYZHSV h_l;
-        PointXYZRGBtoXYZHSV(p_l, h_l);
-
-        if (fabs(h_l.h - h.h) < delta_hue)
+        if (fabs(hue[nn_indices[j]] - seed_hue) < delta_hue)
         {
           seed_queue.push_back (nn_indices[j]);
           processed[nn_indices[j]] = true;
@@ -134,6 +131,11 @@ pcl::seededHueSegmentation (const PointCloud<PointXYZRGB>
   // Create a bool vector of processed point indices, and initialize it to false
   std::vector<bool> processed (cloud.points.size (), false);
 
+  // Points are usually compared many times, so convert all colors once
+  std::vector<float> hue (cloud.points.size ());
+  if (!cloud.points.empty ())
+    PointCloudRGBtoHSV (cloud, &hue[0], NULL, NULL);
+
   std::vector<int> nn_indices;
   std::vector<float> nn_distances;
 
@@ -150,10 +152,7 @@ pcl::seededHueSegmentation (const PointCloud<PointXYZRGB>
     int sq_idx = 0;
     seed_queue.push_back (i);
 
-    PointXYZRGB  p;
-    p = cloud.points[i];
-    PointXYZHSV h;
-    PointXYZRGBtoXYZHSV(p, h);
+    const float seed_hue = hue[i];
 
     while (sq_idx < static_cast<int> (seed_queue.size ()))
     {
@@ -171,12 +170,7 @@ pcl::seededHueSegmentation (const PointCloud<PointXYZRGB>
         if (processed[nn_indices[j]])                             // Has this point been processed before ?
           continue;
 
-        PointXYZRGB  p_l;
-        p_l = cloud.points[nn_indices[j]];
-        PointXYZHSV h_l;
-        PointXYZRGBtoXYZHSV(p_l, h_l);
-
-        if (fabs(h_l.h - h.h) < delta_hue)
+        if (fabs(hue[nn_indices[j]] - seed_hue) < delta_hue)
         {
           seed_queue.push_back (nn_indices[j]);
           processed[nn_indices[j]] = true;
@@ -47,6 +47,17 @@
 #include <pcl/point_cloud.h>
 
 #include <pcl/common/centroid.h>
+#include <pcl/common/point_cloud_soa.h>
+#include <pcl/common/morton.h>
+#include <pcl/common/object_pool.h>
+#include <pcl/common/quantization.h>
+#include <pcl/common/angles.h>
+#include <pcl/common/synchronizer.h>
+#include <pcl/common/indexed_point_cloud.h>
+#include <pcl/shared_point_cloud.h>
+#include <pcl/common/random.h>
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
 
 using namespace pcl;
 
@@ -564,6 +575,121 @@ TEST (PCL, compute3DCentroidCloudIterator)
 }
 
 
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST (PCL, computeBoundsAndCentroid)
+{
+  // Large enough to be split into blocks and processed in parallel
+  PointCloud<PointXYZ> cloud;
+  cloud.points.resize (PCL_COMMON_PARALLEL_MIN_POINTS + 12345);
+  cloud.width = static_cast<uint32_t> (cloud.points.size ());
+  cloud.height = 1;
+  srand (5);
+  for (size_t i = 0; i < cloud.points.size (); ++i)
+  {
+    cloud.points[i].x = 100.0f * static_cast<float> (rand ()) / static_cast<float> (RAND_MAX) - 20.0f;
+    cloud.points[i].y = 10.0f * static_cast<float> (rand ()) / static_cast<float> (RAND_MAX) + 5.0f;
+    cloud.points[i].z = -static_cast<float> (rand ()) / static_cast<float> (RAND_MAX);
+  }
+  std::vector<int> indices;
+  for (int i = 0; i < static_cast<int> (cloud.points.size ()); i += 3)
+    indices.push_back (i);
+
+  for (int dense = 1; dense >= 0; --dense)
+  {
+    if (!dense)
+    {
+      for (size_t i = 0; i < cloud.points.size (); i += 7)
+        cloud.points[i].y = std::numeric_limits<float>::quiet_NaN ();
+      cloud.points[1].z = std::numeric_limits<float>::infinity ();
+      cloud.is_dense = false;
+    }
+
+    for (int use_indices = 0; use_indices < 2; ++use_indices)
+    {
+      // Reference values, computed point by point in double precision
+      Eigen::Vector4d sum = Eigen::Vector4d::Zero ();
+      Eigen::Array4f min_ref = Eigen::Array4f::Constant (FLT_MAX), max_ref = Eigen::Array4f::Constant (-FLT_MAX);
+      unsigned int count = 0;
+      const size_t n = use_indices ? indices.size () : cloud.points.size ();
+      for (size_t i = 0; i < n; ++i)
+      {
+        const PointXYZ &p = cloud.points[use_indices ? indices[i] : i];
+        if (!isFinite (p))
+          continue;
+        min_ref = min_ref.min (p.getArray4fMap ());
+        max_ref = max_ref.max (p.getArray4fMap ());
+        sum += p.getVector4fMap ().cast<double> ();
+        ++count;
+      }
+      const Eigen::Vector4d centroid_ref = sum / count;
+
+      Eigen::Vector4f min_pt, max_pt;
+      Eigen::Vector4d centroid;
+      if (use_indices)
+      {
+        EXPECT_EQ (count, computeBoundsAndCentroid (cloud, indices, min_pt, max_pt, centroid));
+      }
+      else
+      {
+        EXPECT_EQ (count, computeBoundsAndCentroid (cloud, min_pt, max_pt, centroid));
+      }
+      for (int d = 0; d < 3; ++d)
+      {
+        EXPECT_EQ (min_ref[d], min_pt[d]);
+        EXPECT_EQ (max_ref[d], max_pt[d]);
+        EXPECT_NEAR (centroid_ref[d], centroid[d], 1e-9);
+      }
+      EXPECT_EQ (0, centroid[3]);
+
+      Eigen::Vector4f min_mm, max_mm, centroid_f;
+      if (use_indices)
+      {
+        getMinMax3D (cloud, indices, min_mm, max_mm);
+        EXPECT_EQ (count, compute3DCentroid (cloud, indices, centroid_f));
+      }
+      else
+      {
+        getMinMax3D (cloud, min_mm, max_mm);
+        EXPECT_EQ (count, compute3DCentroid (cloud, centroid_f));
+      }
+      EXPECT_EQ (min_pt, min_mm);
+      EXPECT_EQ (max_pt, max_mm);
+      EXPECT_EQ (centroid.cast<float> (), centroid_f);
+    }
+  }
+
+  // No valid point: the centroid is left untouched
+  PointCloud<PointXYZ> invalid;
+  invalid.push_back (PointXYZ (std::numeric_limits<float>::quiet_NaN (), 0, 0));
+  invalid.is_dense = false;
+  Eigen::Vector4f min_pt, max_pt, centroid (1, 2, 3, 4);
+  EXPECT_EQ (0, computeBoundsAndCentroid (invalid, min_pt, max_pt, centroid));
+  EXPECT_EQ (Eigen::Vector4f (1, 2, 3, 4), centroid);
+  EXPECT_EQ (FLT_MAX, min_pt[0]);
+  EXPECT_EQ (-FLT_MAX, max_pt[0]);
+
+  // Demeaning large clouds, to points and to a matrix
+  const Eigen::Vector4f offset (1.5f, -2.0f, 0.25f, 0.0f);
+  PointCloud<PointXYZ> demeaned;
+  demeanPointCloud (cloud, offset, demeaned);
+  Eigen::MatrixXf demeaned_matrix;
+  demeanPointCloud (cloud, indices, offset, demeaned_matrix);
+  ASSERT_EQ (cloud.points.size (), demeaned.points.size ());
+  ASSERT_EQ (4, demeaned_matrix.rows ());
+  ASSERT_EQ (static_cast<int> (indices.size ()), demeaned_matrix.cols ());
+  for (size_t i = 0; i < cloud.points.size (); i += 101)
+  {
+    EXPECT_EQ (cloud.points[i].x - offset[0], demeaned.points[i].x);
+    EXPECT_EQ (cloud.points[i].z - offset[2], demeaned.points[i].z);
+  }
+  for (size_t i = 0; i < indices.size (); i += 101)
+  {
+    EXPECT_EQ (cloud.points[indices[i]].x - offset[0], demeaned_matrix (0, i));
+    EXPECT_EQ (cloud.points[indices[i]].z - offset[2], demeaned_matrix (2, i));
+    EXPECT_EQ (0, demeaned_matrix (3, i));
+  }
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 TEST (PCL, computeCovarianceMatrix)
 {
@@ -1035,6 +1161,329 @@ TEST (PCL, computeMeanAndCovariance)
   EXPECT_EQ (covariance_matrix (2, 2), 1);
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST (PCL, computeMeanAndCovarianceMatrices)
+{
+  // Noisy planes far from the origin, with a few invalid points
+  PointCloud<PointXYZ> cloud;
+  cloud.is_dense = false;
+  srand (0);
+  for (int i = 0; i < 400; ++i)
+  {
+    const float u = static_cast<float> (rand ()) / RAND_MAX, v = static_cast<float> (rand ()) / RAND_MAX;
+    const float noise = 0.001f * static_cast<float> (rand ()) / RAND_MAX;
+    cloud.push_back (PointXYZ (1000.0f + u, 500.0f + v + noise, -200.0f + 0.5f * u + noise));
+  }
+  cloud[7].y = std::numeric_limits<float>::quiet_NaN ();
+  cloud[20].x = std::numeric_limits<float>::infinity ();
+
+  // Neighborhoods of growing size, starting with an empty one, and one of a single invalid point
+  std::vector<int> offsets (1, 0), indices;
+  for (int q = 0; q < 40; ++q)
+  {
+    for (int k = 0; k < q; ++k)
+      indices.push_back ((q * 17 + k * 5) % 400);
+    offsets.push_back (static_cast<int> (indices.size ()));
+  }
+  // Empty neighborhoods in the middle and at the end of the offsets
+  offsets.insert (offsets.begin () + 20, offsets[20]);
+  offsets.push_back (static_cast<int> (indices.size ()));
+  indices.push_back (7);
+  offsets.push_back (static_cast<int> (indices.size ()));
+
+  std::vector<Eigen::Matrix3d, Eigen::aligned_allocator<Eigen::Matrix3d> > covariances;
+  std::vector<Eigen::Vector4d, Eigen::aligned_allocator<Eigen::Vector4d> > centroids;
+  std::vector<unsigned int> counts;
+  computeMeanAndCovarianceMatrices (cloud, offsets, indices, covariances, centroids, counts);
+  std::vector<Eigen::Matrix3f, Eigen::aligned_allocator<Eigen::Matrix3f> > covariances_f;
+  std::vector<Eigen::Vector4f, Eigen::aligned_allocator<Eigen::Vector4f> > centroids_f;
+  std::vector<unsigned int> counts_f;
+  computeMeanAndCovarianceMatrices (cloud, offsets, indices, covariances_f, centroids_f, counts_f, 2);
+
+  ASSERT_EQ (offsets.size () - 1, covariances.size ());
+  ASSERT_EQ (offsets.size () - 1, counts_f.size ());
+  for (size_t q = 0; q + 1 < offsets.size (); ++q)
+  {
+    std::vector<int> neighborhood (indices.begin () + offsets[q], indices.begin () + offsets[q + 1]);
+    // Two-pass reference, computeMeanAndCovarianceMatrix multiplies the float coordinates in float
+    Eigen::Matrix3d covariance = Eigen::Matrix3d::Zero ();
+    Eigen::Vector4d centroid = Eigen::Vector4d::Zero ();
+    unsigned int count = 0;
+    for (size_t i = 0; i < neighborhood.size (); ++i)
+      if (isFinite (cloud[neighborhood[i]]))
+      {
+        centroid.head<3> () += cloud[neighborhood[i]].getVector3fMap ().cast<double> ();
+        ++count;
+      }
+    if (count != 0)
+      centroid /= count;
+    for (size_t i = 0; i < neighborhood.size (); ++i)
+      if (isFinite (cloud[neighborhood[i]]))
+      {
+        const Eigen::Vector3d d = cloud[neighborhood[i]].getVector3fMap ().cast<double> () - centroid.head<3> ();
+        covariance += d * d.transpose () / count;
+      }
+    EXPECT_EQ (count, counts[q]);
+    EXPECT_EQ (count, counts_f[q]);
+    if (count == 0)
+    {
+      EXPECT_TRUE (covariances[q].isZero ());
+      EXPECT_TRUE (centroids[q].isZero ());
+      continue;
+    }
+    for (int k = 0; k < 9; ++k)
+    {
+      EXPECT_NEAR (covariance.coeff (k), covariances[q].coeff (k), 1e-9);
+      // Accumulating relative to the first point keeps floats accurate far from the origin
+      EXPECT_NEAR (covariance.coeff (k), covariances_f[q].coeff (k), 1e-5);
+    }
+    for (int k = 0; k < 4; ++k)
+    {
+      EXPECT_NEAR (centroid[k], centroids[q][k], 1e-9);
+      EXPECT_NEAR (centroid[k], centroids_f[q][k], 1e-4);
+    }
+  }
+
+  // The fused version returns the normal of each neighborhood
+  std::vector<Eigen::Vector3d, Eigen::aligned_allocator<Eigen::Vector3d> > normals;
+  std::vector<double> eigen_values, curvatures;
+  computeSmallestEigenVectors (cloud, offsets, indices, centroids, normals, eigen_values, curvatures);
+  ASSERT_EQ (offsets.size () - 1, normals.size ());
+  const Eigen::Vector3d plane_normal = Eigen::Vector3d (-0.5, 0, 1).normalized ();
+  for (size_t q = 0; q < normals.size (); ++q)
+  {
+    if (counts[q] < 3)
+    {
+      EXPECT_TRUE (pcl_isnan (normals[q][0]));
+      EXPECT_TRUE (pcl_isnan (curvatures[q]));
+      continue;
+    }
+    double smallest;
+    Eigen::Vector3d normal;
+    eigen33 (covariances[q], smallest, normal);
+    EXPECT_NEAR (smallest, eigen_values[q], 1e-12);
+    EXPECT_NEAR (1.0, fabs (normal.dot (normals[q])), 1e-9);
+    EXPECT_NEAR (1.0, fabs (plane_normal.dot (normals[q])), 1e-2);
+    EXPECT_NEAR (eigen_values[q] / covariances[q].trace (), curvatures[q], 1e-12);
+  }
+
+  // The float version solves four matrices at once with SSE2
+  std::vector<Eigen::Vector3f, Eigen::aligned_allocator<Eigen::Vector3f> > normals_f;
+  std::vector<float> eigen_values_f, curvatures_f;
+  computeSmallestEigenVectors (cloud, offsets, indices, centroids_f, normals_f, eigen_values_f, curvatures_f);
+  for (size_t q = 0; q < normals.size (); ++q)
+    if (counts[q] >= 3)
+    {
+      EXPECT_NEAR (1.0, fabs (normals[q].cast<float> ().dot (normals_f[q])), 1e-4);
+      EXPECT_NEAR (curvatures[q], curvatures_f[q], 1e-4);
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST (PCL, PointCloudSoA)
+{
+  PointCloud<PointXYZI> cloud;
+  cloud.width = 7;
+  cloud.height = 3;
+  cloud.is_dense = false;
+  srand (17);
+  for (size_t i = 0; i < cloud.width * cloud.height; ++i)
+  {
+    PointXYZI p;
+    p.x = static_cast<float> (rand ()) / RAND_MAX * 4.0f - 2.0f;
+    p.y = static_cast<float> (rand ()) / RAND_MAX * 4.0f - 2.0f;
+    p.z = static_cast<float> (rand ()) / RAND_MAX * 4.0f - 2.0f;
+    p.intensity = static_cast<float> (i);
+    cloud.points.push_back (p);
+  }
+  cloud.points[5].y = std::numeric_limits<float>::quiet_NaN ();
+  cloud.points[12].z = std::numeric_limits<float>::infinity ();
+
+  std::vector<std::string> fields;
+  fields.push_back ("intensity");
+  fields.push_back ("missing");
+  PointCloudSoA soa;
+  toPointCloudSoA (cloud, soa, fields);
+  EXPECT_EQ (cloud.points.size (), soa.size ());
+  EXPECT_EQ (cloud.width, soa.width);
+  EXPECT_EQ (cloud.height, soa.height);
+  EXPECT_EQ (0, soa.stride () % 4);
+  ASSERT_EQ (1, soa.getFieldNames ().size ());
+  EXPECT_TRUE (soa.getField ("missing") == NULL);
+  const float *intensity = soa.getField ("intensity");
+  ASSERT_TRUE (intensity != NULL);
+
+  PointCloudSoA::MatrixMap xyz = soa.getMatrixXfMap ();
+  for (size_t i = 0; i < cloud.points.size (); ++i)
+  {
+    if (i == 5 || i == 12)
+      continue;
+    EXPECT_EQ (cloud.points[i].x, xyz (i, 0));
+    EXPECT_EQ (cloud.points[i].y, xyz (i, 1));
+    EXPECT_EQ (cloud.points[i].z, xyz (i, 2));
+    EXPECT_EQ (cloud.points[i].intensity, intensity[i]);
+  }
+
+  // Bounds and box queries agree with the AoS versions
+  Eigen::Vector4f min_soa, max_soa, min_aos, max_aos;
+  getMinMax3D (soa, min_soa, max_soa);
+  getMinMax3D (cloud, min_aos, max_aos);
+  EXPECT_EQ (min_aos, min_soa);
+  EXPECT_EQ (max_aos, max_soa);
+
+  Eigen::Vector4f box_min (-1.0f, -1.5f, -2.0f, 0.0f), box_max (1.0f, 1.5f, 2.0f, 0.0f);
+  std::vector<int> in_soa, in_aos;
+  getPointsInBox (soa, box_min, box_max, in_soa);
+  getPointsInBox (cloud, box_min, box_max, in_aos);
+  EXPECT_EQ (in_aos, in_soa);
+
+  const Eigen::Vector3f query (0.5f, -0.25f, 1.0f);
+  std::vector<float> distances (soa.size ());
+  getSquaredDistances (soa, 3, soa.size (), query, &distances[0]);
+  for (size_t i = 3; i < soa.size (); ++i)
+  {
+    if (i != 5 && i != 12)
+    {
+      EXPECT_NEAR ((cloud.points[i].getVector3fMap () - query).squaredNorm (), distances[i - 3], 1e-6);
+    }
+  }
+
+  // Indexed copy, modification and in-place write back
+  std::vector<int> indices;
+  indices.push_back (20);
+  indices.push_back (2);
+  indices.push_back (9);
+  toPointCloudSoA (cloud, indices, soa, fields);
+  EXPECT_EQ (3, soa.size ());
+  EXPECT_EQ (1, soa.height);
+  soa.getMatrixXfMap ().array () += 1.0f;
+  soa.getField ("intensity")[1] = -1.0f;
+  PointCloud<PointXYZI> out;
+  copyPointCloud (cloud, indices, out);
+  fromPointCloudSoA (soa, out);
+  for (size_t i = 0; i < indices.size (); ++i)
+  {
+    EXPECT_EQ (cloud.points[indices[i]].x + 1.0f, out.points[i].x);
+    EXPECT_EQ (cloud.points[indices[i]].z + 1.0f, out.points[i].z);
+  }
+  EXPECT_EQ (20.0f, out.points[0].intensity);
+  EXPECT_EQ (-1.0f, out.points[1].intensity);
+
+  // Resizing keeps the values and zeroes the padding
+  soa.resize (6);
+  EXPECT_EQ (cloud.points[9].y + 1.0f, soa.y ()[2]);
+  EXPECT_EQ (0.0f, soa.y ()[5]);
+  EXPECT_EQ (0.0f, soa.getField ("intensity")[4]);
+  soa.resize (5);
+  EXPECT_EQ (0.0f, soa.x ()[5]);
+  soa.clear ();
+  EXPECT_TRUE (soa.empty ());
+  EXPECT_TRUE (soa.getField ("intensity") == NULL);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST (PCL, reorderByMortonCode)
+{
+  EXPECT_EQ (0, encodeMortonCode (0, 0, 0));
+  EXPECT_EQ (7, encodeMortonCode (1, 1, 1));
+  EXPECT_EQ (1ULL << 60, encodeMortonCode (1u << 20, 0, 0));
+  EXPECT_EQ ((1ULL << 63) - 1, encodeMortonCode ((1u << 21) - 1, (1u << 21) - 1, (1u << 21) - 1));
+
+  // Scan order over a regular grid, with duplicates and invalid points
+  PointCloud<PointXYZRGB> cloud;
+  for (int z = 0; z < 16; ++z)
+    for (int y = 0; y < 16; ++y)
+      for (int x = 0; x < 16; ++x)
+      {
+        PointXYZRGB p;
+        p.x = static_cast<float> (x);
+        p.y = static_cast<float> (y);
+        p.z = static_cast<float> (z);
+        p.r = static_cast<uint8_t> (x);
+        p.g = static_cast<uint8_t> (y);
+        p.b = static_cast<uint8_t> (z);
+        cloud.push_back (p);
+      }
+  cloud.points[10].x = std::numeric_limits<float>::quiet_NaN ();
+  cloud.points[20] = cloud.points[30];
+  cloud.is_dense = false;
+
+  PointCloud<PointXYZRGB> reordered;
+  std::vector<int> permutation;
+  reorderByMortonCode (cloud, reordered, permutation);
+  ASSERT_EQ (cloud.size (), reordered.size ());
+  ASSERT_EQ (cloud.size (), permutation.size ());
+  EXPECT_EQ (1, reordered.height);
+
+  std::vector<uint64_t> codes;
+  computeMortonCodes (reordered, codes);
+  std::vector<bool> seen (cloud.size (), false);
+  for (size_t i = 0; i < reordered.size (); ++i)
+  {
+    ASSERT_TRUE (permutation[i] >= 0 && permutation[i] < static_cast<int> (cloud.size ()));
+    EXPECT_FALSE (seen[permutation[i]]);
+    seen[permutation[i]] = true;
+    EXPECT_EQ (cloud.points[permutation[i]].rgba, reordered.points[i].rgba);
+    if (i > 0)
+    {
+      EXPECT_LE (codes[i - 1], codes[i]);
+    }
+  }
+  // Stable for equal codes, invalid points last
+  EXPECT_EQ (10, permutation.back ());
+  EXPECT_EQ (MORTON_CODE_INVALID, codes.back ());
+  std::vector<int>::const_iterator it20 = std::find (permutation.begin (), permutation.end (), 20);
+  EXPECT_EQ (30, *(it20 + 1));
+
+  // The 8 points of the first 2x2x2 block are consecutive
+  EXPECT_EQ (0, permutation[0]);
+  for (int i = 0; i < 8; ++i)
+  {
+    EXPECT_GE (1, reordered.points[i].x);
+    EXPECT_GE (1, reordered.points[i].y);
+    EXPECT_GE (1, reordered.points[i].z);
+  }
+
+  // In place
+  PointCloud<PointXYZRGB> in_place = cloud;
+  std::vector<int> permutation_in_place;
+  reorderByMortonCode (in_place, permutation_in_place);
+  EXPECT_EQ (permutation, permutation_in_place);
+  for (size_t i = 0; i < in_place.size (); ++i)
+    EXPECT_EQ (reordered.points[i].rgba, in_place.points[i].rgba);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST (PCL, ObjectPool)
+{
+  // Objects are reused once released, empty but with their capacity
+  ObjectPool<PointCloud<PointXYZ> > clouds;
+  PointCloud<PointXYZ>::Ptr first = clouds.acquire ();
+  first->points.resize (1000);
+  first->width = 1000;
+  first->height = 1;
+  const PointXYZ *data = &first->points[0];
+  PointCloud<PointXYZ>::Ptr second = clouds.acquire ();
+  EXPECT_NE (first, second);
+  EXPECT_EQ (2, clouds.size ());
+  first.reset ();
+  PointCloud<PointXYZ>::Ptr third = clouds.acquire ();
+  EXPECT_EQ (2, clouds.size ());
+  EXPECT_TRUE (third->points.empty ());
+  EXPECT_EQ (0, third->width);
+  EXPECT_GE (third->points.capacity (), 1000);
+  third->points.resize (1000);
+  EXPECT_EQ (data, &third->points[0]);
+  second.reset ();
+  clouds.shrink ();
+  EXPECT_EQ (1, clouds.size ());
+
+  ObjectPool<PointIndices> indices;
+  indices.acquire ()->indices.resize (10);
+  EXPECT_TRUE (indices.acquire ()->indices.empty ());
+  EXPECT_EQ (1, indices.size ());
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 TEST (PCL, CopyIfFieldExists)
 {
@@ -1140,6 +1589,410 @@ TEST (PCL, IsSamePointType)
   EXPECT_FALSE (status);
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////////
+TEST (PCL, QuantizedPointTypes)
+{
+  EXPECT_EQ (6, sizeof (PointXYZQ16));
+  EXPECT_EQ (12, sizeof (PointXYZRGBNormalQ16));
+  EXPECT_EQ (16, sizeof (PointXYZRGBNormalQ32));
+
+  std::vector<pcl::PCLPointField> fields;
+  getFields<PointXYZRGBNormalQ32> (fields);
+  ASSERT_EQ (6, fields.size ());
+  EXPECT_EQ (pcl::PCLPointField::INT16, fields[0].datatype);
+  EXPECT_EQ (4, fields[2].offset);
+  EXPECT_EQ (pcl::PCLPointField::UINT32, fields[4].datatype);
+  EXPECT_EQ (8, fields[4].offset);
+
+  // Every normal direction survives the octahedral encoding
+  for (float theta = 0.0f; theta < float (M_PI); theta += 0.1f)
+    for (float phi = 0.0f; phi < 2.0f * float (M_PI); phi += 0.1f)
+    {
+      const Eigen::Vector3f n (sinf (theta) * cosf (phi), sinf (theta) * sinf (phi), cosf (theta));
+      EXPECT_LT (n.cross (decodeOctahedralNormal<8> (encodeOctahedralNormal<8> (n))).norm (), sinf (pcl::deg2rad (1.0f)));
+      EXPECT_LT (n.cross (decodeOctahedralNormal<16> (encodeOctahedralNormal<16> (n))).norm (), sinf (pcl::deg2rad (0.01f)));
+    }
+  EXPECT_TRUE (pcl_isnan (decodeOctahedralNormal<16> (encodeOctahedralNormal<16> (Eigen::Vector3f::Zero ()))[0]));
+
+  PointCloud<PointXYZRGBNormal> cloud;
+  for (int i = 0; i < 1000; ++i)
+  {
+    PointXYZRGBNormal p;
+    p.x = 10.0f + 0.013f * float (i % 10);
+    p.y = -5.0f + 0.021f * float ((i / 10) % 10);
+    p.z = 0.5f * float (i / 100);
+    const Eigen::Vector3f n = Eigen::Vector3f (p.y, p.z - 2.0f, 1.0f).normalized ();
+    p.normal_x = n[0]; p.normal_y = n[1]; p.normal_z = n[2];
+    p.curvature = 0.001f * float (i);
+    p.r = uint8_t (i); p.g = uint8_t (i / 4); p.b = 7;
+    cloud.points.push_back (p);
+  }
+  cloud.points[42].y = std::numeric_limits<float>::quiet_NaN ();
+  cloud.points[43].normal_x = std::numeric_limits<float>::quiet_NaN ();
+  cloud.points[44].curvature = std::numeric_limits<float>::quiet_NaN ();
+  cloud.width = 1000;
+  cloud.height = 1;
+  cloud.is_dense = false;
+
+  QuantizationParameters params;
+  const float resolution = computeQuantizationParameters (cloud, params);
+  EXPECT_NEAR (4.5f / 65534.0f, resolution, 1e-9);
+
+  PointCloud<PointXYZRGBNormalQ32> quantized;
+  quantizePointCloud (cloud, params, quantized);
+  ASSERT_EQ (cloud.points.size (), quantized.points.size ());
+  EXPECT_EQ (QUANTIZED_INVALID_COORDINATE, quantized.points[42].qx);
+
+  PointCloud<PointXYZRGBNormal> restored;
+  dequantizePointCloud (quantized, params, restored);
+  ASSERT_EQ (cloud.points.size (), restored.points.size ());
+  EXPECT_FALSE (restored.is_dense);
+  for (size_t i = 0; i < cloud.points.size (); ++i)
+  {
+    const PointXYZRGBNormal &p = cloud.points[i], &q = restored.points[i];
+    if (i == 42)
+    {
+      EXPECT_TRUE (pcl_isnan (q.x) && pcl_isnan (q.y) && pcl_isnan (q.z));
+      continue;
+    }
+    EXPECT_NEAR (p.x, q.x, 0.5f * resolution + 1e-6f);
+    EXPECT_NEAR (p.y, q.y, 0.5f * resolution + 1e-6f);
+    EXPECT_NEAR (p.z, q.z, 0.5f * resolution + 1e-6f);
+    if (i == 43)
+    {
+      EXPECT_TRUE (pcl_isnan (q.normal_x));
+    }
+    else
+    {
+      EXPECT_LT (p.getNormalVector3fMap ().cross (q.getNormalVector3fMap ()).norm (), sinf (pcl::deg2rad (0.01f)));
+    }
+    if (i == 44)
+    {
+      EXPECT_TRUE (pcl_isnan (q.curvature));
+    }
+    else
+    {
+      EXPECT_NEAR (p.curvature, q.curvature, 1e-4f);
+    }
+    EXPECT_EQ (p.rgba, q.rgba);
+  }
+
+  // Coordinates only, with a rigid transformation of the quantized cloud
+  PointCloud<PointXYZQ16> quantized_xyz;
+  quantizePointCloud (cloud, params, quantized_xyz);
+  const Eigen::Affine3f transform = Eigen::Translation3f (1.0f, 2.0f, 3.0f) *
+                                    Eigen::AngleAxisf (0.5f, Eigen::Vector3f::UnitZ ());
+  const QuantizationParameters moved = transformQuantizationParameters (params, transform);
+  PointCloud<PointXYZ> restored_xyz;
+  dequantizePointCloud (quantized_xyz, moved, restored_xyz);
+  for (size_t i = 0; i < cloud.points.size (); ++i)
+  {
+    if (i == 42)
+      continue;
+    const Eigen::Vector3f expected = transform * cloud.points[i].getVector3fMap ();
+    EXPECT_LT ((expected - restored_xyz.points[i].getVector3fMap ()).norm (), resolution);
+  }
+
+  // Normals are rotated with the parameters
+  PointCloud<PointXYZRGBNormalQ16> quantized_q16;
+  quantizePointCloud (cloud, params, quantized_q16);
+  const Eigen::Vector3f normal = dequantizeNormal (quantized_q16.points[0], moved);
+  EXPECT_LT (normal.cross (transform.linear () * cloud.points[0].getNormalVector3fMap ()).norm (), sinf (pcl::deg2rad (1.0f)));
+
+  // Values outside of the range are clamped
+  PointXYZQ16 clamped;
+  quantizeXYZ (Eigen::Vector3f (1e6f, -1e6f, 10.0f), params, clamped);
+  EXPECT_EQ (QUANTIZED_MAX_COORDINATE, clamped.qx);
+  EXPECT_EQ (-QUANTIZED_MAX_COORDINATE, clamped.qy);
+
+  QuantizedPointRepresentation<PointXYZQ16> representation (params);
+  EXPECT_EQ (3, representation.getNumberOfDimensions ());
+  EXPECT_FALSE (representation.isValid (quantized_xyz.points[42]));
+  EXPECT_TRUE (representation.isValid (quantized_xyz.points[41]));
+  float values[3];
+  representation.copyToFloatArray (quantized_xyz.points[41], values);
+  EXPECT_NEAR (cloud.points[41].x, values[0], 0.5f * resolution + 1e-6f);
+  EXPECT_NEAR (cloud.points[41].z, values[2], 0.5f * resolution + 1e-6f);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+struct SynchronizerRecorder
+{
+  SynchronizerRecorder () : pairs (), triples () {}
+
+  void
+  pair (int a, int b, unsigned long ta, unsigned long tb)
+  {
+    EXPECT_EQ (static_cast<unsigned long> (a), ta);
+    EXPECT_EQ (static_cast<unsigned long> (b), tb);
+    pairs.push_back (std::make_pair (ta, tb));
+  }
+
+  void
+  triple (int a, float, int, const boost::array<unsigned long, 3> &stamps)
+  {
+    EXPECT_EQ (static_cast<unsigned long> (a), stamps[0]);
+    triples.push_back (stamps);
+  }
+
+  std::vector<std::pair<unsigned long, unsigned long> > pairs;
+  std::vector<boost::array<unsigned long, 3> > triples;
+};
+
+void
+feedSynchronizerStream (Synchronizer<int, int> *sync, int stream, unsigned long first, int count)
+{
+  for (int i = 0; i < count; ++i)
+  {
+    const unsigned long stamp = first + 10 * i;
+    if (stream == 0)
+      sync->add0 (static_cast<int> (stamp), stamp);
+    else
+      sync->add1 (static_cast<int> (stamp), stamp);
+  }
+}
+
+TEST (PCL, Synchronizer)
+{
+  // Two streams keep the callback signature and matching of the original implementation
+  SynchronizerRecorder recorder;
+  Synchronizer<int, int> sync;
+  sync.addCallback (boost::bind (&SynchronizerRecorder::pair, &recorder, _1, _2, _3, _4));
+  EXPECT_EQ (2, sync.getNumberOfStreams ());
+  sync.add0 (100, 100);
+  sync.add1 (98, 98);
+  sync.add1 (110, 110);
+  ASSERT_EQ (1, recorder.pairs.size ());
+  EXPECT_EQ (100, recorder.pairs[0].first);
+  EXPECT_EQ (98, recorder.pairs[0].second);
+  sync.add0 (107, 107);
+  sync.add0 (115, 115);
+  ASSERT_EQ (2, recorder.pairs.size ());
+  EXPECT_EQ (107, recorder.pairs[1].first);
+  EXPECT_EQ (110, recorder.pairs[1].second);
+
+  SynchronizerStatistics stats = sync.getStatistics ();
+  ASSERT_EQ (2, stats.streams.size ());
+  EXPECT_EQ (2, stats.published);
+  EXPECT_EQ (3, stats.streams[0].received);
+  EXPECT_EQ (1, stats.streams[0].queued);
+  EXPECT_EQ (3, stats.max_skew);
+  EXPECT_GE (stats.max_latency, stats.mean_latency);
+
+  // Three streams: the closest object of every stream is matched to the newest head
+  Synchronizer<int, float, int> sync3;
+  sync3.addCallback (boost::bind (&SynchronizerRecorder::triple, &recorder, _1, _2, _3, _4));
+  EXPECT_EQ (3, sync3.getNumberOfStreams ());
+  for (int i = 0; i < 5; ++i)
+  {
+    sync3.add0 (10 * i, 10 * i);
+    sync3.add1 (0.0f, 10 * i + 1);
+    sync3.add2 (0, 10 * i + 8);
+  }
+  ASSERT_EQ (3, recorder.triples.size ());
+  EXPECT_EQ (10, recorder.triples[0][0]);
+  EXPECT_EQ (11, recorder.triples[0][1]);
+  EXPECT_EQ (8, recorder.triples[0][2]);
+  EXPECT_EQ (30, recorder.triples[2][0]);
+  EXPECT_EQ (31, recorder.triples[2][1]);
+  EXPECT_EQ (28, recorder.triples[2][2]);
+  EXPECT_EQ (1, sync3.getStatistics ().streams[0].discarded);
+
+  // Bounded queues
+  Synchronizer<int, int> drop_oldest (4, SYNCHRONIZER_DROP_OLDEST);
+  Synchronizer<int, int> drop_newest (4, SYNCHRONIZER_DROP_NEWEST);
+  for (int i = 0; i < 10; ++i)
+  {
+    drop_oldest.add0 (i, i);
+    drop_newest.add0 (i, i);
+  }
+  stats = drop_oldest.getStatistics ();
+  EXPECT_EQ (10, stats.streams[0].received);
+  EXPECT_EQ (6, stats.streams[0].dropped);
+  EXPECT_EQ (4, stats.streams[0].queued);
+  EXPECT_EQ (6, drop_newest.getStatistics ().streams[0].dropped);
+  recorder.pairs.clear ();
+  drop_oldest.addCallback (boost::bind (&SynchronizerRecorder::pair, &recorder, _1, _2, _3, _4));
+  drop_newest.addCallback (boost::bind (&SynchronizerRecorder::pair, &recorder, _1, _2, _3, _4));
+  drop_oldest.add1 (6, 6);
+  drop_oldest.add1 (20, 20);
+  drop_newest.add1 (2, 2);
+  drop_newest.add1 (20, 20);
+  ASSERT_LE (2, recorder.pairs.size ());
+  EXPECT_EQ (6, recorder.pairs[0].first);
+  EXPECT_EQ (2, recorder.pairs[recorder.pairs.size () - 1].first);
+
+  // Concurrent producers
+  recorder.pairs.clear ();
+  Synchronizer<int, int> concurrent (1024);
+  concurrent.addCallback (boost::bind (&SynchronizerRecorder::pair, &recorder, _1, _2, _3, _4));
+  boost::thread producer0 (feedSynchronizerStream, &concurrent, 0, 0, 500);
+  boost::thread producer1 (feedSynchronizerStream, &concurrent, 1, 2, 500);
+  producer0.join ();
+  producer1.join ();
+  EXPECT_EQ (499, recorder.pairs.size ());
+  for (size_t i = 0; i < recorder.pairs.size (); ++i)
+    EXPECT_EQ (recorder.pairs[i].first + 2, recorder.pairs[i].second);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+TEST (PCL, SharedPointCloud)
+{
+  PointCloud<PointXYZ>::Ptr cloud (new PointCloud<PointXYZ>);
+  for (int i = 0; i < 10; ++i)
+    cloud->push_back (PointXYZ (static_cast<float> (i), 0.0f, 0.0f));
+  const PointXYZ *buffer = &cloud->points[0];
+
+  SharedPointCloud<PointXYZ> frame (cloud);
+  cloud.reset ();
+  EXPECT_FALSE (frame.isShared ());
+  EXPECT_EQ (10, frame.size ());
+
+  // Copies and const pointers share the points
+  SharedPointCloud<PointXYZ> copy = frame;
+  PointCloud<PointXYZ>::ConstPtr input = frame.getConstPtr ();
+  EXPECT_TRUE (frame.isShared ());
+  EXPECT_EQ (buffer, &copy->points[0]);
+  EXPECT_EQ (buffer, &input->points[0]);
+
+  // Writing to a shared buffer copies it first
+  copy.getWritable ().points[0].x = 42.0f;
+  EXPECT_NE (buffer, &copy->points[0]);
+  EXPECT_EQ (42.0f, copy->points[0].x);
+  EXPECT_EQ (0.0f, frame->points[0].x);
+  EXPECT_EQ (0.0f, input->points[0].x);
+
+  // Writing to an unshared buffer does not
+  input.reset ();
+  EXPECT_FALSE (frame.isShared ());
+  frame.getWritable ().points[1].x = 7.0f;
+  EXPECT_EQ (buffer, &frame->points[0]);
+
+  PointCloud<PointXYZ> plain;
+  frame.swap (plain);
+  EXPECT_TRUE (frame.empty ());
+  EXPECT_EQ (10, plain.points.size ());
+  EXPECT_EQ (buffer, &plain.points[0]);
+
+  IndexedPointCloud<PointXYZ>::IndicesPtr indices (new std::vector<int>);
+  indices->push_back (3);
+  indices->push_back (1);
+  IndexedPointCloud<PointXYZ> view (copy.getConstPtr (), indices);
+  ASSERT_EQ (2, view.size ());
+  EXPECT_EQ (3.0f, view[0].x);
+  EXPECT_EQ (1.0f, view[1].x);
+  PointCloud<PointXYZ> materialized;
+  view.materialize (materialized);
+  ASSERT_EQ (2, materialized.points.size ());
+  EXPECT_EQ (3.0f, materialized.points[0].x);
+  view.materializeOrganized (materialized);
+  ASSERT_EQ (10, materialized.points.size ());
+  EXPECT_FALSE (materialized.is_dense);
+  EXPECT_TRUE (pcl_isnan (materialized.points[0].x));
+  EXPECT_EQ (3.0f, materialized.points[3].x);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST (PCL, Xoshiro128)
+{
+  using pcl::common::Xoshiro128;
+
+  // Reproducible for a given seed, different for different seeds and streams
+  Xoshiro128 a (42), b (42), c (43), d (42, 1);
+  bool differs_seed = false, differs_stream = false;
+  for (int i = 0; i < 16; ++i)
+  {
+    pcl::uint32_t va = a (), vb = b (), vc = c (), vd = d ();
+    EXPECT_EQ (va, vb);
+    differs_seed |= (va != vc);
+    differs_stream |= (va != vd);
+  }
+  EXPECT_TRUE (differs_seed);
+  EXPECT_TRUE (differs_stream);
+
+  // Stream i is the seed's sequence advanced by i jumps
+  Xoshiro128 jumped (7), stream1 (7, 1), stream2 (7, 2);
+  Xoshiro128 stream2_copy = Xoshiro128 (7).getStream (2);
+  jumped.jump ();
+  Xoshiro128 jumped_twice (jumped);
+  jumped_twice.jump ();
+  EXPECT_EQ (jumped (), stream1 ());
+  pcl::uint32_t v2 = stream2 ();
+  EXPECT_EQ (jumped_twice (), v2);
+  EXPECT_EQ (stream2_copy (), v2);
+
+  // Bounded integers stay in range and are uniform
+  Xoshiro128 rng (12345);
+  const int bound = 10, draws = 100000;
+  std::vector<int> histogram (bound, 0);
+  for (int i = 0; i < draws; ++i)
+  {
+    pcl::uint32_t v = rng.nextBounded (bound);
+    ASSERT_LT (v, pcl::uint32_t (bound));
+    ++histogram[v];
+  }
+  for (int i = 0; i < bound; ++i)
+    EXPECT_NEAR (draws / bound, histogram[i], draws / bound / 20);
+  EXPECT_EQ (0, rng.nextBounded (1));
+
+  double float_sum = 0, double_sum = 0;
+  for (int i = 0; i < draws; ++i)
+  {
+    float f = rng.nextFloat ();
+    double g = rng.nextDouble ();
+    ASSERT_TRUE (f >= 0.0f && f < 1.0f);
+    ASSERT_TRUE (g >= 0.0 && g < 1.0);
+    float_sum += f;
+    double_sum += g;
+  }
+  EXPECT_NEAR (0.5, float_sum / draws, 0.01);
+  EXPECT_NEAR (0.5, double_sum / draws, 0.01);
+
+  // Bulk generation continues the very same sequence as scalar calls
+  const size_t n = 1001;
+  Xoshiro128 bulk (99), scalar (99);
+  std::vector<pcl::uint32_t> raw (n), bounded (n);
+  bulk.generate (&raw[0], n);
+  bulk.generateBounded (&bounded[0], n, 1000);
+  for (size_t i = 0; i < n; ++i)
+    EXPECT_EQ (scalar (), raw[i]);
+  for (size_t i = 0; i < n; ++i)
+    EXPECT_EQ (scalar.nextBounded (1000), bounded[i]);
+  EXPECT_EQ (scalar (), bulk ());
+
+  std::vector<float> uniform (n);
+  bulk.generateUniform (&uniform[0], n, -2.0f, 3.0f);
+  for (size_t i = 0; i < n; ++i)
+    EXPECT_TRUE (uniform[i] >= -2.0f && uniform[i] < 3.0f);
+
+  std::vector<float> normal (draws + 1);
+  bulk.generateNormal (&normal[0], normal.size (), 1.0f, 2.0f);
+  double sum = 0, sum_sq = 0;
+  for (size_t i = 0; i < normal.size (); ++i)
+  {
+    ASSERT_TRUE (pcl_isfinite (normal[i]));
+    sum += normal[i];
+    sum_sq += normal[i] * normal[i];
+  }
+  double mean = sum / static_cast<double> (normal.size ());
+  EXPECT_NEAR (1.0, mean, 0.05);
+  EXPECT_NEAR (2.0, std::sqrt (sum_sq / static_cast<double> (normal.size ()) - mean * mean), 0.05);
+
+  // The generators built on top of the engine honor their parameters and seed
+  pcl::common::UniformGenerator<int> uniform_int (-3, 3, 5), uniform_int_copy (-3, 3, 5);
+  for (int i = 0; i < 100; ++i)
+  {
+    int v = uniform_int.run ();
+    EXPECT_EQ (v, uniform_int_copy.run ());
+    EXPECT_TRUE (v >= -3 && v <= 3);
+  }
+  pcl::common::NormalGenerator<float> normal_float (10.0f, 0.5f, 5);
+  sum = 0;
+  for (int i = 0; i < 10000; ++i)
+    sum += normal_float.run ();
+  EXPECT_NEAR (10.0, sum / 10000, 0.05);
+}
+
 /* ---[ */
 int
 main (int argc, char** argv)
@@ -799,6 +799,74 @@ TEST (PCL, eigen33f)
   EXPECT_LE (float(r_fail_count) / float(iterations), 0.01);
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST (PCL, eigen33Batch)
+{
+  const int count = 100003;
+  Eigen::Matrix<double, Eigen::Dynamic, 6> mats_d (count, 6);
+  for (int i = 0; i < count; ++i)
+  {
+    Eigen::Matrix3d matrix;
+    generateSymPosMatrix3x3 (matrix);
+    // Also cover matrices that are scaled down and zero ones
+    if (i % 97 == 0)
+      matrix *= 1e-3;
+    if (i % 1009 == 0)
+      matrix.setZero ();
+    mats_d.row (i) << matrix (0, 0), matrix (0, 1), matrix (0, 2), matrix (1, 1), matrix (1, 2), matrix (2, 2);
+  }
+  const Eigen::Matrix<float, Eigen::Dynamic, 6> mats_f = mats_d.cast<float> ();
+
+  // The double version is the scalar code
+  Eigen::Matrix<double, Eigen::Dynamic, 3> evals_d, evecs_d;
+  eigen33Batch (mats_d, 0, evals_d, evecs_d);
+  ASSERT_EQ (count, evals_d.rows ());
+  for (int i = 0; i < count; ++i)
+  {
+    Eigen::Matrix3d matrix;
+    matrix << mats_d (i, 0), mats_d (i, 1), mats_d (i, 2),
+              mats_d (i, 1), mats_d (i, 3), mats_d (i, 4),
+              mats_d (i, 2), mats_d (i, 4), mats_d (i, 5);
+    Eigen::Vector3d evals, evec;
+    double eval;
+    eigen33 (matrix, evals);
+    eigen33 (matrix, eval, evec);
+    EXPECT_EQ (evals, evals_d.row (i).transpose ());
+    if (pcl_isfinite (evec[0]))
+      EXPECT_EQ (evec, evecs_d.row (i).transpose ());
+  }
+
+  // The float version approximates the trigonometric functions
+  Eigen::Matrix<float, Eigen::Dynamic, 3> evals_f, evecs_f;
+  const float epsilon = std::numeric_limits<float>::epsilon ();
+  for (int index = 0; index < 3; index += 2)
+  {
+    eigen33Batch (mats_f, index, evals_f, evecs_f);
+    for (int i = 0; i < count; ++i)
+    {
+      Eigen::Matrix3d matrix;
+      matrix << mats_f (i, 0), mats_f (i, 1), mats_f (i, 2),
+                mats_f (i, 1), mats_f (i, 3), mats_f (i, 4),
+                mats_f (i, 2), mats_f (i, 4), mats_f (i, 5);
+      const double scale = std::max (matrix.cwiseAbs ().maxCoeff (), 1e-30);
+      Eigen::Vector3d evals;
+      Eigen::Matrix3d evecs;
+      eigen33 (matrix, evecs, evals);
+      // Same precision as the scalar float code
+      Eigen::Vector3f evals_scalar;
+      eigen33 (Eigen::Matrix3f (matrix.cast<float> ()), evals_scalar);
+      for (int k = 0; k < 3; ++k)
+        EXPECT_NEAR (evals_scalar[k], evals_f (i, k), 16 * epsilon * scale);
+
+      // Eigenvectors are only defined up to sign, and only for a distinct eigenvalue
+      const double gap = index == 0 ? evals[1] - evals[0] : evals[2] - evals[1];
+      if (gap < 0.05 * scale)
+        continue;
+      EXPECT_NEAR (1.0, fabs (evecs.col (index).dot (evecs_f.row (i).transpose ().cast<double> ())), 1e-5);
+    }
+  }
+}
+
 /* ---[ */
 int
 main (int argc, char** argv)
@@ -38,6 +38,7 @@
 #include <gtest/gtest.h>
 #include <pcl/point_types.h>
 #include <pcl/common/io.h>
+#include <pcl/common/point_cloud_view.h>
 
 using namespace pcl;
 using namespace std;
@@ -379,6 +380,85 @@ TEST (PCL, concatenatePointCloud)
   }
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////
+TEST (PCL, fromPCLPointCloud2)
+{
+  // Large enough to be copied in parallel
+  CloudXYZRGBNormal cloud;
+  cloud.width = 400;
+  cloud.height = 300;
+  cloud.points.resize (cloud.width * cloud.height);
+  for (size_t i = 0; i < cloud.points.size (); ++i)
+  {
+    cloud.points[i].x = static_cast<float> (i);
+    cloud.points[i].y = static_cast<float> (i) * 0.5f;
+    cloud.points[i].z = -static_cast<float> (i);
+    cloud.points[i].rgba = static_cast<uint32_t> (i * 7);
+    cloud.points[i].normal_x = 1.0f;
+    cloud.points[i].curvature = static_cast<float> (i % 13);
+  }
+  PCLPointCloud2 msg;
+  toPCLPointCloud2 (cloud, msg);
+
+  // Mismatched layouts copy the field runs of the target type
+  PointCloud<PointXYZRGBA> cloud_rgba;
+  PointCloud<PointNormal> cloud_normal;
+  for (int repeat = 0; repeat < 2; ++repeat)
+  {
+    fromPCLPointCloud2 (msg, cloud_rgba);
+    fromPCLPointCloud2 (msg, cloud_normal);
+    ASSERT_EQ (cloud.points.size (), cloud_rgba.points.size ());
+    ASSERT_EQ (cloud.points.size (), cloud_normal.points.size ());
+    EXPECT_EQ (cloud.width, cloud_rgba.width);
+    EXPECT_EQ (cloud.height, cloud_normal.height);
+    for (size_t i = 0; i < cloud.points.size (); i += 97)
+    {
+      EXPECT_EQ (cloud.points[i].x, cloud_rgba.points[i].x);
+      EXPECT_EQ (cloud.points[i].z, cloud_rgba.points[i].z);
+      EXPECT_EQ (cloud.points[i].rgba, cloud_rgba.points[i].rgba);
+      EXPECT_EQ (cloud.points[i].y, cloud_normal.points[i].y);
+      EXPECT_EQ (cloud.points[i].normal_x, cloud_normal.points[i].normal_x);
+      EXPECT_EQ (cloud.points[i].curvature, cloud_normal.points[i].curvature);
+    }
+  }
+
+  // A row-padded message goes through the field runs as well
+  PCLPointCloud2 padded = msg;
+  padded.row_step = msg.row_step + 16;
+  padded.data.assign (padded.row_step * padded.height, 0);
+  for (uint32_t row = 0; row < msg.height; ++row)
+    memcpy (&padded.data[row * padded.row_step], &msg.data[row * msg.row_step], msg.row_step);
+  CloudXYZRGBNormal cloud_padded;
+  fromPCLPointCloud2 (padded, cloud_padded);
+  ASSERT_EQ (cloud.points.size (), cloud_padded.points.size ());
+  EXPECT_EQ (cloud.points.back ().curvature, cloud_padded.points.back ().curvature);
+  EXPECT_EQ (cloud (5, 200).rgba, cloud_padded (5, 200).rgba);
+
+  // Same layout: the data can be viewed in place
+  PointCloudView<PointXYZRGBNormal> view (msg);
+  ASSERT_TRUE (view.isValid ());
+  EXPECT_EQ (reinterpret_cast<const uint8_t*> (&view[0]), &msg.data[0]);
+  EXPECT_EQ (cloud.points.size (), view.size ());
+  EXPECT_TRUE (view.isOrganized ());
+  EXPECT_EQ (cloud (17, 123).z, view (17, 123).z);
+  EXPECT_EQ (cloud.points.back ().rgba, view.back ().rgba);
+  EXPECT_EQ (cloud.points.size (), static_cast<size_t> (view.end () - view.begin ()));
+
+  // Other layouts, missing fields and padded rows have to be converted
+  EXPECT_FALSE (PointCloudView<PointXYZRGBA>::isCompatible (msg));
+  EXPECT_FALSE (PointCloudView<PointXYZRGBNormal>::isCompatible (padded));
+  PCLPointCloud2 xyz_msg;
+  toPCLPointCloud2 (cloud_rgba, xyz_msg);
+  EXPECT_TRUE (PointCloudView<PointXYZRGBA>::isCompatible (xyz_msg));
+  EXPECT_TRUE (PointCloudView<PointXYZRGB>::isCompatible (xyz_msg));
+  EXPECT_FALSE (PointCloudView<PointXYZI>::isCompatible (xyz_msg));
+  xyz_msg.fields.resize (3);
+  EXPECT_FALSE (PointCloudView<PointXYZRGBA>::isCompatible (xyz_msg));
+  PointCloudView<PointXYZRGBA> invalid_view (xyz_msg);
+  EXPECT_FALSE (invalid_view.isValid ());
+  EXPECT_TRUE (invalid_view.empty ());
+}
+
 /* ---[ */
 int
 main (int argc, char** argv)
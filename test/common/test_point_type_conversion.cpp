@@ -85,6 +85,71 @@ TEST (PointTypeConversions, PointXYZRGBtoPointXYZHSV)
   EXPECT_NEAR (hsv.v, 0.980392, 1e-2);
 }
 
+TEST (PointTypeConversions, BulkColorConversions)
+{
+  // All combinations of a few levels, plus ties between the channels; not a multiple of 4 points
+  PointCloud<PointXYZRGB> cloud;
+  const int levels[] = {0, 1, 17, 128, 200, 254, 255};
+  for (int r = 0; r < 7; ++r)
+    for (int g = 0; g < 7; ++g)
+      for (int b = 0; b < 7; ++b)
+      {
+        PointXYZRGB p;
+        p.x = static_cast<float> (r); p.y = static_cast<float> (g); p.z = static_cast<float> (b);
+        p.r = static_cast<uint8_t> (levels[r]);
+        p.g = static_cast<uint8_t> (levels[g]);
+        p.b = static_cast<uint8_t> (levels[b]);
+        cloud.points.push_back (p);
+      }
+  cloud.width = static_cast<uint32_t> (cloud.points.size ());
+  cloud.height = 1;
+  const size_t n = cloud.points.size ();
+
+  std::vector<float> h (n), s (n), v (n), intensity (n), l (n), a (n), b (n);
+  PointCloudRGBtoHSV (cloud, &h[0], &s[0], &v[0]);
+  PointCloudRGBtoIntensity (cloud, &intensity[0]);
+  PointCloudRGBtoLab (cloud, &l[0], &a[0], &b[0]);
+  PointCloud<PointXYZHSV> hsv_cloud;
+  PointCloudXYZRGBtoXYZHSV (cloud, hsv_cloud);
+  PointCloud<PointXYZI> intensity_cloud;
+  PointCloudXYZRGBtoXYZI (cloud, intensity_cloud);
+  ASSERT_EQ (n, hsv_cloud.points.size ());
+  ASSERT_EQ (n, intensity_cloud.points.size ());
+
+  for (size_t i = 0; i < n; ++i)
+  {
+    PointXYZHSV hsv;
+    PointXYZRGBtoXYZHSV (cloud.points[i], hsv);
+    EXPECT_FLOAT_EQ (hsv.h, h[i]);
+    EXPECT_FLOAT_EQ (hsv.s, s[i]);
+    EXPECT_FLOAT_EQ (hsv.v, v[i]);
+    EXPECT_FLOAT_EQ (hsv.h, hsv_cloud.points[i].h);
+    EXPECT_EQ (cloud.points[i].z, hsv_cloud.points[i].z);
+
+    PointXYZI xyzi;
+    PointXYZRGBtoXYZI (cloud.points[i], xyzi);
+    EXPECT_NEAR (xyzi.intensity, intensity[i], 1e-4);
+    EXPECT_NEAR (xyzi.intensity, intensity_cloud.points[i].intensity, 1e-4);
+    EXPECT_EQ (cloud.points[i].x, intensity_cloud.points[i].x);
+
+    float l_ref, a_ref, b_ref;
+    detail::LabConversion::convert (cloud.points[i].r, cloud.points[i].g, cloud.points[i].b, l_ref, a_ref, b_ref);
+    EXPECT_NEAR (l_ref, l[i], 1e-3);
+    EXPECT_NEAR (a_ref, a[i], 1e-3);
+    EXPECT_NEAR (b_ref, b[i], 1e-3);
+  }
+
+  // Reference values of the sRGB primaries
+  const size_t white = n - 1, red = 6 * 49;
+  EXPECT_NEAR (100.0f, l[white], 1e-2);
+  EXPECT_NEAR (0.0f, a[white], 1e-2);
+  EXPECT_NEAR (0.0f, b[white], 1e-2);
+  EXPECT_NEAR (53.24f, l[red], 1e-2);
+  EXPECT_NEAR (80.09f, a[red], 1e-1);
+  EXPECT_NEAR (67.20f, b[red], 1e-1);
+  EXPECT_NEAR (0.0f, l[0], 1e-4);
+}
+
 int
 main (int argc, char** argv)
 {
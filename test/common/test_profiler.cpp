@@ -0,0 +1,186 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2013-, Open Perception, Inc.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the copyright holder(s) nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ */
+
+// Record the PCL_PROFILE_* macros regardless of the configuration
+#ifndef PCL_ENABLE_PROFILING
+#define PCL_ENABLE_PROFILING
+#endif
+
+#include <gtest/gtest.h>
+#include <fstream>
+#include <sstream>
+#include <boost/thread/thread.hpp>
+#include <boost/filesystem.hpp>
+#include <pcl/common/profiler.h>
+#include <pcl/common/time.h>
+
+using namespace pcl::profiling;
+
+const ScopeStatistics*
+findScope (const std::vector<ScopeStatistics> &statistics, const std::string &path)
+{
+  for (size_t s = 0; s < statistics.size (); ++s)
+    if (statistics[s].path == path)
+      return (&statistics[s]);
+  return (NULL);
+}
+
+void
+work (int iterations)
+{
+  for (int i = 0; i < iterations; ++i)
+  {
+    PCL_PROFILE_SCOPE ("worker");
+    PCL_PROFILE_COUNTER ("items", 2);
+    boost::this_thread::sleep (boost::posix_time::microseconds (10));
+  }
+}
+
+std::string
+readFile (const std::string &file_name)
+{
+  std::ifstream file (file_name.c_str ());
+  std::stringstream content;
+  content << file.rdbuf ();
+  return (content.str ());
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+TEST (PCL, ProfilerScopes)
+{
+  Registry &registry = Registry::getInstance ();
+  registry.reset ();
+  {
+    PCL_PROFILE_SCOPE ("outer");
+    for (int i = 0; i < 10; ++i)
+    {
+      PCL_PROFILE_SCOPE ("inner");
+      boost::this_thread::sleep (boost::posix_time::microseconds (100));
+    }
+    pcl::ScopeTime t ("");
+  }
+
+  std::vector<ScopeStatistics> statistics;
+  registry.getStatistics (statistics);
+  ASSERT_EQ (3, statistics.size ());
+  const ScopeStatistics *outer = findScope (statistics, "outer");
+  const ScopeStatistics *inner = findScope (statistics, "outer/inner");
+  ASSERT_TRUE (outer != NULL);
+  ASSERT_TRUE (inner != NULL);
+  EXPECT_TRUE (findScope (statistics, "outer/(unnamed)") != NULL);
+  EXPECT_EQ (1, outer->count);
+  EXPECT_EQ (10, inner->count);
+  EXPECT_GE (inner->min_ms, 0.1);
+  EXPECT_GE (outer->total_ms, inner->total_ms);
+  EXPECT_NEAR (inner->total_ms / 10, inner->mean_ms, 1e-9);
+  EXPECT_LE (inner->min_ms, inner->p50_ms * 1.12);
+  EXPECT_LE (inner->p50_ms, inner->p99_ms);
+  EXPECT_LE (inner->p99_ms, inner->max_ms * 1.12);
+
+  // Disabled at runtime
+  registry.setEnabled (false);
+  {
+    PCL_PROFILE_SCOPE ("outer");
+    PCL_PROFILE_COUNTER ("items", 1);
+  }
+  registry.setEnabled (true);
+  registry.getStatistics (statistics);
+  EXPECT_EQ (1, findScope (statistics, "outer")->count);
+
+  registry.reset ();
+  registry.getStatistics (statistics);
+  EXPECT_TRUE (statistics.empty ());
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+TEST (PCL, ProfilerThreads)
+{
+  Registry &registry = Registry::getInstance ();
+  registry.reset ();
+  boost::thread_group threads;
+  for (int t = 0; t < 4; ++t)
+    threads.create_thread (boost::bind (&work, 25));
+  threads.join_all ();
+
+  std::vector<ScopeStatistics> statistics;
+  registry.getStatistics (statistics);
+  ASSERT_TRUE (findScope (statistics, "worker") != NULL);
+  EXPECT_EQ (100, findScope (statistics, "worker")->count);
+
+  std::vector<std::pair<std::string, int64_t> > counters;
+  registry.getCounters (counters);
+  ASSERT_EQ (1, counters.size ());
+  EXPECT_EQ ("items", counters[0].first);
+  EXPECT_EQ (200, counters[0].second);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+TEST (PCL, ProfilerExport)
+{
+  Registry &registry = Registry::getInstance ();
+  registry.reset ();
+  registry.setTraceEnabled (true, 3);
+  work (5);
+  registry.setTraceEnabled (false);
+
+  const std::string json_file = "test_profiler.json", trace_file = "test_profiler_trace.json";
+  ASSERT_TRUE (registry.saveJSON (json_file));
+  ASSERT_TRUE (registry.saveChromeTrace (trace_file));
+
+  const std::string json = readFile (json_file);
+  EXPECT_NE (std::string::npos, json.find ("\"path\": \"worker\", \"count\": 5"));
+  EXPECT_NE (std::string::npos, json.find ("\"items\": 10"));
+
+  // 3 events kept, 2 dropped
+  const std::string trace = readFile (trace_file);
+  size_t events = 0;
+  for (size_t pos = trace.find ("\"ph\": \"X\""); pos != std::string::npos; pos = trace.find ("\"ph\": \"X\"", pos + 1))
+    ++events;
+  EXPECT_EQ (3, events);
+  EXPECT_NE (std::string::npos, trace.find ("\"count\": 2"));
+
+  boost::filesystem::remove (json_file);
+  boost::filesystem::remove (trace_file);
+}
+
+/* ---[ */
+int
+main (int argc, char** argv)
+{
+  testing::InitGoogleTest (&argc, argv);
+  return (RUN_ALL_TESTS ());
+}
+/* ]--- */
@@ -531,6 +531,40 @@ TEST (PassThrough, Filters)
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST (PassThroughIndexView, Filters)
+{
+  PassThrough<PointXYZ> pt;
+  pt.setInputCloud (cloud);
+  pt.setFilterFieldName ("z");
+  pt.setFilterLimits (0.05f, 0.1f);
+
+  PointCloud<PointXYZ> output;
+  pt.filter (output);
+  IndexedPointCloud<PointXYZ> view;
+  pt.filter (view);
+
+  // The view refers to the input cloud instead of copying it
+  EXPECT_EQ (cloud.get (), view.getCloud ().get ());
+  ASSERT_EQ (output.points.size (), view.size ());
+  for (size_t i = 0; i < view.size (); ++i)
+    EXPECT_EQ (output.points[i].getVector3fMap (), view[i].getVector3fMap ());
+
+  PointCloud<PointXYZ> materialized;
+  view.materialize (materialized);
+  EXPECT_EQ (output.points.size (), materialized.points.size ());
+  EXPECT_NEAR (materialized.points[41].z, 0.052133, 1e-5);
+
+  // Same result as keeping the cloud organized
+  pt.setKeepOrganized (true);
+  pt.filter (output);
+  view.materializeOrganized (materialized);
+  ASSERT_EQ (output.points.size (), materialized.points.size ());
+  EXPECT_EQ (output.is_dense, materialized.is_dense);
+  for (size_t i = 0; i < output.points.size (); ++i)
+    EXPECT_EQ (pcl_isfinite (output.points[i].z), pcl_isfinite (materialized.points[i].z));
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
 TEST (VoxelGrid, Filters)
 {
   // Test the PointCloud<PointT> method
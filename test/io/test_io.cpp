@@ -46,7 +46,10 @@
 #include <pcl/io/pcd_io.h>
 #include <pcl/io/ply_io.h>
 #include <pcl/io/ascii_io.h>
+#include <pcl/io/ascii_parser.h>
+#include <pcl/io/async_pcd_writer.h>
 #include <fstream>
+#include <iomanip>
 #include <locale>
 #include <stdexcept>
 
@@ -805,6 +808,135 @@ TEST (PCL, ASCIIReader)
 
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST (PCL, ASCIIPointParser)
+{
+  // The fast path must agree with the C library for everything a writer produces
+  srand (12345);
+  char buffer[64];
+  for (int i = 0; i < 10000; ++i)
+  {
+    double ref = (rand () / (RAND_MAX + 1.0) - 0.5) * pow (10.0, rand () % 40 - 20);
+    const char *formats[] = { "%.8g", "%.17g", "%f", "%e" };
+    int length = sprintf (buffer, formats[i % 4], ref);
+    double value;
+    EXPECT_EQ (parseFloatingPoint (buffer, buffer + length, value), buffer + length);
+    EXPECT_EQ (value, strtod (buffer, NULL));
+  }
+  const char *specials[] = { "0", "-0.0", ".5", "5.", "1e5", "1E-5", "+3", "1e400", "1e-400", "123456789012345678901234567890",
+                             "4.9406564584124654e-324", "2.2250738585072011e-308", "1.7976931348623157e308" };
+  for (size_t i = 0; i < sizeof (specials) / sizeof (specials[0]); ++i)
+  {
+    double value;
+    const char *end = specials[i] + strlen (specials[i]);
+    EXPECT_EQ (parseFloatingPoint (specials[i], end, value), end);
+    EXPECT_EQ (value, strtod (specials[i], NULL));
+  }
+  double value = 7.0;
+  const char *text = "1.5e+x";
+  EXPECT_EQ (parseFloatingPoint (text, text + 6, value), text + 3);
+  EXPECT_EQ (value, 1.5);
+  text = "-.e1";
+  EXPECT_EQ (parseFloatingPoint (text, text + 4, value), text);
+  boost::int64_t integer;
+  text = "-42a";
+  EXPECT_EQ (parseInteger (text, text + 4, integer), text + 3);
+  EXPECT_EQ (integer, -42);
+
+  // PCD rules: NaN, CRLF line endings, empty lines, padding, multi-element and integer fields
+  std::ofstream fs;
+  fs.open ("parser_ascii.pcd", std::ios::binary);
+  fs << "# .PCD v0.7 - Point Cloud Data file format\n"
+        "VERSION 0.7\n"
+        "FIELDS x _ h label rgb\n"
+        "SIZE 4 4 8 2 1\n"
+        "TYPE F F F I U\n"
+        "COUNT 1 2 2 1 1\n"
+        "WIDTH 3\n"
+        "HEIGHT 1\n"
+        "VIEWPOINT 0 0 0 1 0 0 0\n"
+        "POINTS 3\n"
+        "DATA ascii\n"
+        "1.5 9 9 0.25 -2e3 -7 255\r\n"
+        "\r\n"
+        "  nan 9 9 1e-10 3 12 0 \r\n"
+        "-0.125\t9 9 4 5 -32768 17 trailing values are ignored";
+  fs.close ();
+
+  pcl::PCLPointCloud2 blob;
+  EXPECT_EQ (loadPCDFile ("parser_ascii.pcd", blob), 0);
+  EXPECT_EQ (blob.width, 3);
+  EXPECT_EQ (blob.is_dense, false);
+  ASSERT_EQ (blob.data.size (), 3 * blob.point_step);
+  float x[3];
+  double h[3][2];
+  boost::int16_t label[3];
+  for (int i = 0; i < 3; ++i)
+  {
+    memcpy (&x[i], &blob.data[i * blob.point_step + blob.fields[0].offset], sizeof (float));
+    memcpy (&h[i][0], &blob.data[i * blob.point_step + blob.fields[2].offset], 2 * sizeof (double));
+    memcpy (&label[i], &blob.data[i * blob.point_step + blob.fields[3].offset], sizeof (boost::int16_t));
+  }
+  EXPECT_EQ (x[0], 1.5f);
+  EXPECT_TRUE (pcl_isnan (x[1]));
+  EXPECT_EQ (x[2], -0.125f);
+  EXPECT_EQ (h[0][0], 0.25);
+  EXPECT_EQ (h[0][1], -2000.0);
+  EXPECT_EQ (h[1][0], 1e-10);
+  EXPECT_EQ (h[2][1], 5.0);
+  EXPECT_EQ (label[0], -7);
+  EXPECT_EQ (label[2], -32768);
+  EXPECT_EQ (blob.data[0 * blob.point_step + blob.fields[4].offset], 255);
+  EXPECT_EQ (blob.data[2 * blob.point_step + blob.fields[4].offset], 17);
+
+  // A line with missing values is an error
+  fs.open ("parser_ascii.pcd", std::ios::binary);
+  fs << "VERSION 0.7\nFIELDS x y\nSIZE 4 4\nTYPE F F\nCOUNT 1 1\nWIDTH 2\nHEIGHT 1\nPOINTS 2\nDATA ascii\n1 2\n3\n";
+  fs.close ();
+  EXPECT_EQ (loadPCDFile ("parser_ascii.pcd", blob), -1);
+  remove ("parser_ascii.pcd");
+
+  // Many chunks give the same points as a single thread, in the same order
+  std::string lines;
+  for (int i = 0; i < 200000; ++i)
+  {
+    int length = sprintf (buffer, i % 1000 ? "%d %.8g %.8g\n" : "# comment\n%d bad %.8g %.8g\n",
+                          i, rand () / (RAND_MAX + 1.0), -rand () / (RAND_MAX + 1.0));
+    lines.append (buffer, length);
+  }
+  ASCIIPointParser parser;
+  std::vector<ASCIIPointParser::Column> columns;
+  columns.push_back (ASCIIPointParser::Column (0, pcl::PCLPointField::UINT32));
+  columns.push_back (ASCIIPointParser::Column (4, pcl::PCLPointField::FLOAT32));
+  columns.push_back (ASCIIPointParser::Column (8, pcl::PCLPointField::FLOAT64));
+  parser.setColumns (columns);
+  parser.setCommentCharacter ('#');
+  parser.setLinePolicy (ASCIIPointParser::SKIP_INVALID_LINES);
+  std::vector<boost::uint8_t> serial, parallel;
+  bool is_dense = true;
+  parser.setNumberOfThreads (1);
+  EXPECT_EQ (parser.parse (lines.data (), lines.data () + lines.size (), 16, 1000000, serial, is_dense), 199800);
+  parser.setNumberOfThreads (4);
+  EXPECT_EQ (parser.parse (lines.data (), lines.data () + lines.size (), 16, 1000000, parallel, is_dense), 199800);
+  EXPECT_TRUE (is_dense);
+  EXPECT_TRUE (serial == parallel);
+  boost::uint32_t index;
+  memcpy (&index, &parallel[16 * 999], sizeof (index));
+  EXPECT_EQ (index, 1001);
+  EXPECT_EQ (parser.parse (lines.data (), lines.data () + lines.size (), 16, 10, parallel, is_dense), 10);
+  EXPECT_EQ (parallel.size (), 160);
+
+  // Out of range integers wrap around with the PCD rules and skip the line otherwise
+  const std::string bytes ("256\n7\n");
+  parser.setColumns (std::vector<ASCIIPointParser::Column> (1, ASCIIPointParser::Column (0, pcl::PCLPointField::UINT8)));
+  parser.setLinePolicy (ASCIIPointParser::STRICT_LINES);
+  EXPECT_EQ (parser.parse (bytes.data (), bytes.data () + bytes.size (), 1, 10, parallel, is_dense), 2);
+  EXPECT_EQ (parallel[0], 0);
+  parser.setLinePolicy (ASCIIPointParser::SKIP_INVALID_LINES);
+  EXPECT_EQ (parser.parse (bytes.data (), bytes.data () + bytes.size (), 1, 10, parallel, is_dense), 1);
+  EXPECT_EQ (parallel[0], 7);
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 TEST (PCL, PLYReaderWriter)
 {
@@ -865,6 +997,118 @@ TEST (PCL, PLYReaderWriter)
   }
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename T> void
+writePLYValue (std::ostream &os, T value, const std::string &format)
+{
+  if (format == "ascii")
+  {
+    os << std::setprecision (17) << +value << " ";
+    return;
+  }
+  if ((format == "binary_big_endian") != (pcl::io::ply::host_byte_order == pcl::io::ply::big_endian_byte_order))
+    pcl::io::ply::swap_byte_order (value);
+  os.write (reinterpret_cast<const char*> (&value), sizeof (T));
+}
+
+void
+writePLYTestMesh (const std::string &file_name, const std::string &format,
+                  size_t nr_vertices, size_t nr_faces)
+{
+  std::ofstream fs (file_name.c_str (), std::ios::binary);
+  fs << "ply\nformat " << format << " 1.0\n"
+     << "element vertex " << nr_vertices << "\n"
+     << "property float x\nproperty float y\nproperty float z\n"
+     << "property uchar red\nproperty uchar green\nproperty uchar blue\nproperty uchar alpha\n"
+     << "property uchar intensity\nproperty double quality\nproperty short flags\n"
+     << "element face " << nr_faces << "\n"
+     << "property list uchar int vertex_indices\n"
+     << "element extra 2\n"
+     << "property int value\n"
+     << "end_header\n";
+  const char *separator = (format == "ascii") ? "\n" : "";
+  for (size_t i = 0; i < nr_vertices; ++i)
+  {
+    writePLYValue (fs, static_cast<float> (i) * 0.25f, format);
+    writePLYValue (fs, -static_cast<float> (i) / 3.0f, format);
+    writePLYValue (fs, 1.0f, format);
+    writePLYValue (fs, static_cast<uint8_t> (i), format);
+    writePLYValue (fs, static_cast<uint8_t> (i / 3), format);
+    writePLYValue (fs, static_cast<uint8_t> (255 - i), format);
+    writePLYValue (fs, static_cast<uint8_t> (128), format);
+    writePLYValue (fs, static_cast<uint8_t> (i * 7), format);
+    writePLYValue (fs, static_cast<double> (i) / 7.0, format);
+    writePLYValue (fs, static_cast<int16_t> (-static_cast<int> (i % 1000)), format);
+    fs << separator;
+  }
+  for (size_t i = 0; i < nr_faces; ++i)
+  {
+    uint8_t size = static_cast<uint8_t> (3 + i % 3);
+    writePLYValue (fs, size, format);
+    for (uint8_t j = 0; j < size; ++j)
+      writePLYValue (fs, static_cast<int32_t> ((i + j) % nr_vertices), format);
+    fs << separator;
+  }
+  for (int32_t i = 0; i < 2; ++i)
+  {
+    writePLYValue (fs, i, format);
+    fs << separator;
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST (PCL, PLYBinaryRecords)
+{
+  // Enough vertices and faces to span several blocks of records
+  const size_t nr_vertices = 180000, nr_faces = 260000;
+  const char *formats[] = { "ascii", "binary_little_endian", "binary_big_endian" };
+  pcl::PolygonMesh meshes[3];
+  PLYReader reader;
+  for (int f = 0; f < 3; ++f)
+  {
+    writePLYTestMesh ("test_pcl_io_records.ply", formats[f], nr_vertices, nr_faces);
+    ASSERT_EQ (reader.read ("test_pcl_io_records.ply", meshes[f]), 0);
+  }
+  remove ("test_pcl_io_records.ply");
+
+  // The binary files are read in blocks of records, the ascii one value by value
+  const pcl::PCLPointCloud2 &cloud = meshes[0].cloud;
+  EXPECT_EQ (cloud.width * cloud.height, nr_vertices);
+  ASSERT_EQ (cloud.fields.size (), 7);
+  EXPECT_EQ (cloud.fields[3].name, "rgba");
+  EXPECT_EQ (cloud.fields[4].name, "intensity");
+  EXPECT_EQ (cloud.fields[4].datatype, pcl::PCLPointField::FLOAT32);
+  EXPECT_EQ (cloud.point_step, 30);
+  uint32_t rgba;
+  memcpy (&rgba, &cloud.data[5 * cloud.point_step + cloud.fields[3].offset], sizeof (uint32_t));
+  EXPECT_EQ (rgba, (128u << 24) | (5u << 16) | (1u << 8) | 250u);
+  float intensity;
+  memcpy (&intensity, &cloud.data[5 * cloud.point_step + cloud.fields[4].offset], sizeof (float));
+  EXPECT_EQ (intensity, 35.0f);
+  ASSERT_EQ (meshes[0].polygons.size (), nr_faces);
+  EXPECT_EQ (meshes[0].polygons[4].vertices.size (), 4);
+  EXPECT_EQ (meshes[0].polygons[4].vertices[3], 7);
+
+  for (int f = 1; f < 3; ++f)
+  {
+    const pcl::PCLPointCloud2 &cloud_in = meshes[f].cloud;
+    EXPECT_EQ (cloud_in.width, cloud.width);
+    EXPECT_EQ (cloud_in.height, cloud.height);
+    EXPECT_EQ (cloud_in.point_step, cloud.point_step);
+    ASSERT_EQ (cloud_in.fields.size (), cloud.fields.size ());
+    for (size_t i = 0; i < cloud.fields.size (); ++i)
+    {
+      EXPECT_EQ (cloud_in.fields[i].name, cloud.fields[i].name);
+      EXPECT_EQ (cloud_in.fields[i].offset, cloud.fields[i].offset);
+      EXPECT_EQ (cloud_in.fields[i].datatype, cloud.fields[i].datatype);
+    }
+    EXPECT_TRUE (cloud_in.data == cloud.data);
+    ASSERT_EQ (meshes[f].polygons.size (), nr_faces);
+    for (size_t i = 0; i < nr_faces; ++i)
+      ASSERT_TRUE (meshes[f].polygons[i].vertices == meshes[0].polygons[i].vertices);
+  }
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 struct PointXYZFPFH33
@@ -1114,6 +1358,281 @@ TEST (PCL, LZFExtended)
   }
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST (PCL, LZFChunked)
+{
+  PointCloud<PointXYZRGBNormal> cloud, cloud2;
+  cloud.width  = 64;
+  cloud.height = 50;
+  cloud.points.resize (cloud.width * cloud.height);
+  cloud.is_dense = true;
+
+  srand (12345);
+  size_t nr_p = cloud.points.size ();
+  for (size_t i = 0; i < nr_p; ++i)
+  {
+    cloud.points[i].x = static_cast<float> (1024 * rand () / (RAND_MAX + 1.0));
+    cloud.points[i].y = static_cast<float> (1024 * rand () / (RAND_MAX + 1.0));
+    cloud.points[i].z = static_cast<float> (i);
+    cloud.points[i].normal_x = cloud.points[i].normal_y = 0.0f;
+    cloud.points[i].normal_z = 1.0f;
+    cloud.points[i].curvature = 0.0f;
+    cloud.points[i].rgba = static_cast<uint32_t> (i % 7);
+  }
+
+  // Chunks which do not divide the cloud evenly, and chunks which do not compress
+  PCDWriter writer;
+  writer.setChunkSize (333);
+  EXPECT_EQ (writer.writeBinaryCompressedChunked<PointXYZRGBNormal> ("test_pcl_io_chunked.pcd", cloud), 0);
+
+  PCDReader reader;
+  EXPECT_EQ (reader.read<PointXYZRGBNormal> ("test_pcl_io_chunked.pcd", cloud2), 0);
+  EXPECT_EQ (cloud2.width, cloud.width);
+  EXPECT_EQ (cloud2.height, cloud.height);
+  EXPECT_EQ (cloud2.is_dense, true);
+  ASSERT_EQ (cloud2.points.size (), cloud.points.size ());
+  for (size_t i = 0; i < cloud2.points.size (); ++i)
+  {
+    ASSERT_EQ (cloud2.points[i].x, cloud.points[i].x);
+    ASSERT_EQ (cloud2.points[i].z, cloud.points[i].z);
+    ASSERT_EQ (cloud2.points[i].normal_z, cloud.points[i].normal_z);
+    ASSERT_EQ (cloud2.points[i].rgba, cloud.points[i].rgba);
+  }
+
+  // Point ranges, across chunk boundaries and clamped at the end
+  pcl::PCLPointCloud2 blob;
+  EXPECT_EQ (reader.readRange ("test_pcl_io_chunked.pcd", blob, 330, 700), 0);
+  fromPCLPointCloud2 (blob, cloud2);
+  ASSERT_EQ (cloud2.points.size (), 700);
+  for (size_t i = 0; i < cloud2.points.size (); ++i)
+    ASSERT_EQ (cloud2.points[i].z, cloud.points[330 + i].z);
+  EXPECT_EQ (reader.readRange ("test_pcl_io_chunked.pcd", blob, 3190, 100), 0);
+  EXPECT_EQ (blob.width, 10);
+  EXPECT_EQ (reader.readRange ("test_pcl_io_chunked.pcd", blob, 3200, 1), -1);
+
+  // The same ranges of binary files
+  EXPECT_EQ (writer.writeBinary<PointXYZRGBNormal> ("test_pcl_io_chunked.pcd", cloud), 0);
+  EXPECT_EQ (reader.readRange ("test_pcl_io_chunked.pcd", blob, 330, 700), 0);
+  fromPCLPointCloud2 (blob, cloud2);
+  ASSERT_EQ (cloud2.points.size (), 700);
+  for (size_t i = 0; i < cloud2.points.size (); ++i)
+    ASSERT_EQ (cloud2.points[i].z, cloud.points[330 + i].z);
+
+  // Readers which take the data for binary_compressed must fail
+  PointCloud<PointXYZ> xyz;
+  xyz.width = 2000;
+  xyz.height = 1;
+  xyz.points.resize (xyz.width);
+  writer.writeBinaryCompressedChunked<PointXYZ> ("test_pcl_io_chunked.pcd", xyz);
+  std::fstream fs ("test_pcl_io_chunked.pcd", std::ios::in | std::ios::out | std::ios::binary);
+  std::string contents ((std::istreambuf_iterator<char> (fs)), std::istreambuf_iterator<char> ());
+  size_t data = contents.find ("DATA binary_compressed_chunked");
+  ASSERT_NE (data, std::string::npos);
+  fs.seekp (data + 22);
+  fs << "        ";
+  fs.close ();
+  EXPECT_LT (reader.read ("test_pcl_io_chunked.pcd", blob), 0);
+
+  remove ("test_pcl_io_chunked.pcd");
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST (PCL, PCDStreamReader)
+{
+  PointCloud<PointXYZRGBNormal> cloud;
+  cloud.width  = 40;
+  cloud.height = 30;
+  cloud.points.resize (cloud.width * cloud.height);
+  cloud.is_dense = true;
+  for (size_t i = 0; i < cloud.points.size (); ++i)
+  {
+    cloud.points[i].x = static_cast<float> (i);
+    cloud.points[i].y = static_cast<float> (i) * 0.5f;
+    cloud.points[i].z = -static_cast<float> (i);
+    cloud.points[i].normal_x = cloud.points[i].normal_y = cloud.points[i].normal_z = 0.25f;
+    cloud.points[i].curvature = 1.0f;
+    cloud.points[i].rgba = static_cast<uint32_t> (i);
+  }
+
+  PCDWriter writer;
+  writer.setChunkSize (100);
+  PCDReader reader;
+  for (int mode = 0; mode < 4; ++mode)
+  {
+    switch (mode)
+    {
+      case 0: writer.writeASCII<PointXYZRGBNormal> ("test_pcl_io_stream.pcd", cloud); break;
+      case 1: writer.writeBinary<PointXYZRGBNormal> ("test_pcl_io_stream.pcd", cloud); break;
+      case 2: writer.writeBinaryCompressed<PointXYZRGBNormal> ("test_pcl_io_stream.pcd", cloud); break;
+      case 3: writer.writeBinaryCompressedChunked<PointXYZRGBNormal> ("test_pcl_io_stream.pcd", cloud); break;
+    }
+
+    // A window of rows of only some of the fields stays organized and packs the fields
+    pcl::PCLPointCloud2 blob;
+    std::vector<std::string> field_names;
+    field_names.push_back ("z");
+    field_names.push_back ("rgb");
+    EXPECT_EQ (reader.readRange ("test_pcl_io_stream.pcd", blob, field_names, 5 * cloud.width, 3 * cloud.width), 0);
+    EXPECT_EQ (blob.width, cloud.width);
+    EXPECT_EQ (blob.height, 3);
+    ASSERT_EQ (blob.fields.size (), 2);
+    EXPECT_EQ (blob.fields[0].name, "z");
+    EXPECT_EQ (blob.fields[1].offset, 4);
+    EXPECT_EQ (blob.point_step, 8);
+    ASSERT_EQ (blob.data.size (), 3 * cloud.width * 8);
+    for (size_t i = 0; i < 3 * cloud.width; ++i)
+    {
+      float z;
+      uint32_t rgba;
+      memcpy (&z, &blob.data[i * 8], sizeof (float));
+      memcpy (&rgba, &blob.data[i * 8 + 4], sizeof (uint32_t));
+      ASSERT_EQ (z, cloud.points[5 * cloud.width + i].z);
+      ASSERT_EQ (rgba, cloud.points[5 * cloud.width + i].rgba);
+    }
+    field_names.push_back ("intensity");
+    EXPECT_EQ (reader.readRange ("test_pcl_io_stream.pcd", blob, field_names, 0, 10), -1);
+
+    // Batches that do not divide the cloud, of a point type with a subset of the fields
+    PCDStreamReader<PointXYZ> stream (250);
+    ASSERT_EQ (stream.open ("test_pcl_io_stream.pcd"), 0);
+    EXPECT_EQ (stream.getNumberOfPoints (), cloud.points.size ());
+    EXPECT_EQ (stream.getFields ().size (), 3);
+    // Opening never allocates memory for the points of the file
+    EXPECT_EQ (stream.getHeader ().data.capacity (), 0);
+    PointCloud<PointXYZ> batch;
+    size_t nr_points = 0, nr_batches = 0;
+    while (stream.next (batch))
+    {
+      ASSERT_LE (batch.points.size (), 250);
+      for (size_t i = 0; i < batch.points.size (); ++i)
+      {
+        ASSERT_EQ (batch.points[i].x, cloud.points[nr_points + i].x);
+        ASSERT_EQ (batch.points[i].y, cloud.points[nr_points + i].y);
+        ASSERT_EQ (batch.points[i].z, cloud.points[nr_points + i].z);
+      }
+      nr_points += batch.points.size ();
+      ++nr_batches;
+    }
+    EXPECT_EQ (nr_points, cloud.points.size ());
+    EXPECT_EQ (nr_batches, 5);
+
+    // Going back
+    EXPECT_EQ (stream.seek (17), 0);
+    EXPECT_TRUE (stream.next (batch));
+    EXPECT_EQ (batch.points[0].x, 17.0f);
+    EXPECT_EQ (stream.getPosition (), 267);
+    EXPECT_EQ (stream.seek (1201), -1);
+  }
+
+  // The header of a file larger than the memory is read without sizing anything for its points
+  {
+    std::ofstream fs ("test_pcl_io_stream.pcd");
+    fs << "VERSION .7\nFIELDS x y z\nSIZE 4 4 4\nTYPE F F F\nCOUNT 1 1 1\n"
+       << "WIDTH 200000000\nHEIGHT 1\nPOINTS 200000000\nDATA binary\n";
+  }
+  PCDStreamReader<PointXYZ> stream;
+  ASSERT_EQ (stream.open ("test_pcl_io_stream.pcd"), 0);
+  EXPECT_EQ (stream.getNumberOfPoints (), 200000000);
+  EXPECT_EQ (stream.getHeader ().data.capacity (), 0);
+  pcl::PCLPointCloud2 blob;
+  EXPECT_EQ (stream.read (blob, 10), -1);
+  remove ("test_pcl_io_stream.pcd");
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST (PCL, AsyncPCDWriter)
+{
+  PointCloud<PointXYZ>::Ptr cloud (new PointCloud<PointXYZ>);
+  cloud->width  = 64;
+  cloud->height = 48;
+  cloud->points.resize (cloud->width * cloud->height);
+  cloud->is_dense = true;
+  for (size_t i = 0; i < cloud->points.size (); ++i)
+  {
+    cloud->points[i].x = static_cast<float> (i);
+    cloud->points[i].y = static_cast<float> (i) * 0.5f;
+    cloud->points[i].z = -static_cast<float> (i);
+  }
+  pcl::PCLPointCloud2::Ptr blob (new pcl::PCLPointCloud2);
+  toPCLPointCloud2 (*cloud, *blob);
+
+  // Every format, from typed clouds and from blobs, with a queue large enough for all of them
+  {
+    pcl::io::AsyncPCDWriter writer (16, 2);
+    EXPECT_EQ (writer.getCapacity (), 16);
+    EXPECT_EQ (writer.getNumberOfThreads (), 2);
+    for (int i = 0; i < 6; ++i)
+    {
+      writer.setFormat (static_cast<pcl::io::AsyncPCDWriter::Format> (i % 3));
+      std::stringstream file_name;
+      file_name << "test_pcl_io_async_" << i << ".pcd";
+      if (i < 3)
+      {
+        EXPECT_TRUE (writer.write<PointXYZ> (file_name.str (), cloud));
+      }
+      else
+      {
+        EXPECT_TRUE (writer.write (file_name.str (), blob));
+      }
+    }
+    EXPECT_TRUE (writer.write<PointXYZ> ("/non_existing_directory/test_pcl_io_async.pcd", cloud));
+    writer.flush ();
+
+    pcl::io::AsyncPCDWriter::Statistics stats = writer.getStatistics ();
+    EXPECT_EQ (stats.accepted, 7);
+    EXPECT_EQ (stats.written, 6);
+    EXPECT_EQ (stats.failed, 1);
+    EXPECT_EQ (stats.dropped, 0);
+    EXPECT_EQ (stats.queue_size, 0);
+    EXPECT_LE (stats.max_queue_size, 7);
+  }
+  for (int i = 0; i < 6; ++i)
+  {
+    std::stringstream file_name;
+    file_name << "test_pcl_io_async_" << i << ".pcd";
+    PointCloud<PointXYZ> cloud_in;
+    ASSERT_EQ (loadPCDFile (file_name.str (), cloud_in), 0);
+    ASSERT_EQ (cloud_in.points.size (), cloud->points.size ());
+    EXPECT_EQ (cloud_in.width, cloud->width);
+    for (size_t j = 0; j < cloud_in.points.size (); j += 97)
+      EXPECT_EQ (cloud_in.points[j].x, cloud->points[j].x);
+    remove (file_name.str ().c_str ());
+  }
+
+  // Flooding a small queue never blocks, every cloud is either written or accounted as dropped
+  for (int policy = 0; policy < 2; ++policy)
+  {
+    pcl::io::AsyncPCDWriter writer (2, 1);
+    writer.setOverflowPolicy (static_cast<pcl::io::AsyncPCDWriter::OverflowPolicy> (policy));
+    writer.setFormat (pcl::io::AsyncPCDWriter::BINARY_COMPRESSED);
+    int nr_queued = 0;
+    for (int i = 0; i < 50; ++i)
+      if (writer.write<PointXYZ> ("test_pcl_io_async.pcd", cloud))
+        ++nr_queued;
+    writer.flush ();
+
+    pcl::io::AsyncPCDWriter::Statistics stats = writer.getStatistics ();
+    EXPECT_EQ (stats.accepted, nr_queued);
+    EXPECT_LE (stats.max_queue_size, 2);
+    EXPECT_EQ (stats.failed, 0);
+    if (writer.getOverflowPolicy () == pcl::io::AsyncPCDWriter::DROP_NEWEST)
+    {
+      EXPECT_EQ (stats.accepted + stats.dropped, 50);
+      EXPECT_EQ (stats.written, stats.accepted);
+    }
+    else
+    {
+      EXPECT_EQ (stats.accepted, 50);
+      EXPECT_EQ (stats.written + stats.dropped, 50);
+    }
+
+    PointCloud<PointXYZ> cloud_in;
+    EXPECT_EQ (loadPCDFile ("test_pcl_io_async.pcd", cloud_in), 0);
+    EXPECT_EQ (cloud_in.points.size (), cloud->points.size ());
+  }
+  remove ("test_pcl_io_async.pcd");
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 TEST (PCL, Locale)
 {
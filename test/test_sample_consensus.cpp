@@ -556,6 +556,8 @@ TEST (RANSAC, SampleConsensusModelCone)
   // Create a shared cylinder model pointer directly
   SampleConsensusModelConePtr model (new SampleConsensusModelCone<PointXYZ, Normal> (cloud.makeShared ()));
   model->setInputNormals (normals.makeShared ());
+  // The unrefined opening angle depends on the drawn samples
+  model->setRandomSeed (1);
 
   // Create the RANSAC object
   RandomSampleConsensus<PointXYZ> sac (model, 0.03);
@@ -762,6 +764,8 @@ TEST (RANSAC, SampleConsensusModelCircle3D)
 
   // Create a shared 3d circle model pointer directly
   SampleConsensusModelCircle3DPtr model (new SampleConsensusModelCircle3D<PointXYZ> (cloud.makeShared ()));
+  // The orientation of the circle normal depends on the drawn samples
+  model->setRandomSeed (1);
 
   // Create the RANSAC object
   RandomSampleConsensus<PointXYZ> sac (model, 0.03);
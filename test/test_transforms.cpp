@@ -263,6 +263,85 @@ TEST (PCL, Matrix4Affine3Transform)
   EXPECT_FLOAT_EQ (pt.z, ct[0].z); 
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////////
+TEST (PCL, TransformKernels)
+{
+  // Random cloud with normals and a few invalid points
+  PointCloud<PointNormal> c;
+  c.width = 1000;
+  c.height = 1;
+  c.is_dense = false;
+  c.points.resize (c.width);
+  srand (0);
+  for (size_t i = 0; i < c.points.size (); ++i)
+  {
+    c[i].getVector3fMap () = Eigen::Vector3f::Random () * 100.0f;
+    c[i].getNormalVector3fMap () = Eigen::Vector3f::Random ().normalized ();
+    c[i].curvature = static_cast<float> (i);
+    c[i].data[3] = c[i].data_n[3] = 42.0f;
+  }
+  c[10].x = std::numeric_limits<float>::quiet_NaN ();
+  c[20].z = std::numeric_limits<float>::infinity ();
+
+  Eigen::Affine3f tf (Eigen::Translation3f (1.5f, -20.0f, 300.0f) *
+                      Eigen::AngleAxisf (0.3f, Eigen::Vector3f (1.0f, 2.0f, 3.0f).normalized ()));
+  const Eigen::Matrix4f &m = tf.matrix ();
+
+  PointCloud<PointNormal> ct, ct_double, ct_inplace (c), ct_indices;
+  transformPointCloudWithNormals (c, ct, tf);
+  transformPointCloudWithNormals (c, ct_double, Eigen::Affine3d (tf.cast<double> ()));
+  transformPointCloudWithNormals (ct_inplace, tf);
+  std::vector<int> indices;
+  for (int i = static_cast<int> (c.points.size ()) - 1; i >= 0; i -= 3)
+    indices.push_back (i);
+  transformPointCloudWithNormals (c, indices, ct_indices, tf);
+
+  ASSERT_EQ (c.points.size (), ct.points.size ());
+  for (size_t i = 0; i < c.points.size (); ++i)
+  {
+    if (i == 10 || i == 20)
+    {
+      // Invalid points are copied as they are
+      EXPECT_EQ (0, memcmp (&c[i], &ct[i], sizeof (PointNormal)));
+      continue;
+    }
+    for (int r = 0; r < 3; ++r)
+    {
+      // Tolerance documented in transformPointCloud
+      const float ref = m (r, 0) * c[i].x + m (r, 1) * c[i].y + m (r, 2) * c[i].z + m (r, 3);
+      const float tol = 4.0f * std::numeric_limits<float>::epsilon () *
+                        (fabsf (m (r, 0) * c[i].x) + fabsf (m (r, 1) * c[i].y) + fabsf (m (r, 2) * c[i].z) + fabsf (m (r, 3)));
+      EXPECT_NEAR (ref, ct[i].data[r], tol);
+      EXPECT_NEAR (ref, ct_double[i].data[r], tol);
+      const float nref = m (r, 0) * c[i].normal_x + m (r, 1) * c[i].normal_y + m (r, 2) * c[i].normal_z;
+      EXPECT_NEAR (nref, ct[i].data_n[r], 1e-6);
+      EXPECT_NEAR (nref, ct_double[i].data_n[r], 1e-6);
+    }
+    // Padding and the other fields are untouched
+    EXPECT_EQ (42.0f, ct[i].data[3]);
+    EXPECT_EQ (42.0f, ct[i].data_n[3]);
+    EXPECT_EQ (c[i].curvature, ct[i].curvature);
+    // The in-place variant computes the same values
+    EXPECT_EQ (0, memcmp (&ct[i], &ct_inplace[i], sizeof (PointNormal)));
+  }
+
+  ASSERT_EQ (indices.size (), ct_indices.points.size ());
+  for (size_t i = 0; i < indices.size (); ++i)
+    EXPECT_EQ (0, memcmp (&ct[indices[i]], &ct_indices[i], sizeof (PointNormal)));
+
+  // XYZ only, dense and in place via a 4x4 matrix
+  PointCloud<PointXYZ> cxyz, cxyz_out;
+  copyPointCloud (c, indices, cxyz);
+  cxyz.is_dense = true;
+  for (size_t i = 0; i < cxyz.points.size (); ++i)
+    if (!pcl_isfinite (cxyz[i].x) || !pcl_isfinite (cxyz[i].z))
+      cxyz[i].x = cxyz[i].z = 0.0f;
+  transformPointCloud (cxyz, cxyz_out, tf);
+  transformPointCloud (cxyz, m);
+  for (size_t i = 0; i < cxyz.points.size (); ++i)
+    EXPECT_EQ (0, memcmp (&cxyz[i], &cxyz_out[i], sizeof (PointXYZ)));
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////////
 TEST (PCL, commonTransform)
 {
@@ -36,6 +36,7 @@
  */
 
 #include <pcl/io/pcd_io.h>
+#include <pcl/io/ascii_parser.h>
 #include <pcl/console/print.h>
 #include <pcl/console/parse.h>
 #include <pcl/console/time.h>
@@ -54,37 +55,27 @@ printHelp (int, char **argv)
 bool
 loadCloud (const string &filename, PointCloud<PointXYZ> &cloud)
 {
-  ifstream fs;
-  fs.open (filename.c_str (), ios::binary);
-  if (!fs.is_open () || fs.fail ())
-  {
-    PCL_ERROR ("Could not open file '%s'! Error : %s\n", filename.c_str (), strerror (errno)); 
-    fs.close ();
-    return (false);
-  }
-  
-  string line;
-  vector<string> st;
+  // Lines with exactly three numbers are points, all others are skipped
+  vector<ASCIIPointParser::Column> columns;
+  columns.push_back (ASCIIPointParser::Column (offsetof (PointXYZ, x), PCLPointField::FLOAT32));
+  columns.push_back (ASCIIPointParser::Column (offsetof (PointXYZ, y), PCLPointField::FLOAT32));
+  columns.push_back (ASCIIPointParser::Column (offsetof (PointXYZ, z), PCLPointField::FLOAT32));
 
-  while (!fs.eof ())
-  {
-    getline (fs, line);
-    // Ignore empty lines
-    if (line == "")
-      continue;
+  ASCIIPointParser parser;
+  parser.setColumns (columns);
+  parser.setLinePolicy (ASCIIPointParser::SKIP_INVALID_LINES);
 
-    // Tokenize the line
-    boost::trim (line);
-    boost::split (st, line, boost::is_any_of ("\t\r "), boost::token_compress_on);
-
-    if (st.size () != 3)
-      continue;
+  vector<uint8_t> data;
+  bool is_dense = true;
+  int nr_points = parser.parseFile (filename, 0, sizeof (PointXYZ), numeric_limits<size_t>::max (), data, is_dense);
+  if (nr_points < 0)
+    return (false);
 
-    cloud.push_back (PointXYZ (float (atof (st[0].c_str ())), float (atof (st[1].c_str ())), float (atof (st[2].c_str ()))));
-  }
-  fs.close ();
+  cloud.resize (nr_points);
+  if (nr_points > 0)
+    memcpy (&cloud.points[0], &data[0], data.size ());
 
-  cloud.width = uint32_t (cloud.size ()); cloud.height = 1; cloud.is_dense = true;
+  cloud.width = uint32_t (cloud.size ()); cloud.height = 1; cloud.is_dense = is_dense;
   return (true);
 }
 
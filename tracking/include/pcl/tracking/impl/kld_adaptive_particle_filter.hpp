@@ -65,10 +65,10 @@ pcl::tracking::KLDAdaptiveParticleFilterTracker<PointInT, StateT>::resample ()
   {
     int j_n = sampleWithReplacement (a, q);
     StateT x_t = particles_->points[j_n];
-    x_t.sample (zero_mean, step_noise_covariance_);
+    x_t.sample (zero_mean, step_noise_covariance_, rng_);
     
     // motion
-    if (rand () / double (RAND_MAX) < motion_ratio_)
+    if (rng_.nextDouble () < motion_ratio_)
       x_t = x_t + motion_;
     
     S->points.push_back (x_t);
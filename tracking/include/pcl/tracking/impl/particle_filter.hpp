@@ -40,11 +40,7 @@ template <typename PointInT, typename StateT> int
 pcl::tracking::ParticleFilterTracker<PointInT, StateT>::sampleWithReplacement
 (const std::vector<int>& a, const std::vector<double>& q)
 {
-  using namespace boost;
-  static mt19937 gen (static_cast<unsigned int>(time (0)));
-  uniform_real<> dst (0.0, 1.0);
-  variate_generator<mt19937&, uniform_real<> > rand (gen, dst);
-  double rU = rand () * static_cast<double> (particles_->points.size ());
+  double rU = rng_.nextDouble () * static_cast<double> (particles_->points.size ());
   int k = static_cast<int> (rU);
   rU -= k;    /* rU - [rU] */
   if ( rU < q[k] )
@@ -106,7 +102,7 @@ pcl::tracking::ParticleFilterTracker<PointInT, StateT>::initParticles (bool rese
   {
     StateT p;
     p.zero ();
-    p.sample (initial_noise_mean_, initial_noise_covariance_);
+    p.sample (initial_noise_mean_, initial_noise_covariance_, rng_);
     p = p + representative_state_;
     p.weight = 1.0f / static_cast<float> (particle_num_);
     particles_->points.push_back (p); // update
@@ -350,7 +346,7 @@ pcl::tracking::ParticleFilterTracker<PointInT, StateT>::resampleWithReplacement
     int target_particle_index = sampleWithReplacement (a, q);
     StateT p = origparticles->points[target_particle_index];
     // add noise using gaussian
-    p.sample (zero_mean, step_noise_covariance_);
+    p.sample (zero_mean, step_noise_covariance_, rng_);
     p = p + motion_;
     particles_->points.push_back (p);
   }
@@ -361,7 +357,7 @@ pcl::tracking::ParticleFilterTracker<PointInT, StateT>::resampleWithReplacement
     int target_particle_index = sampleWithReplacement (a, q);
     StateT p = origparticles->points[target_particle_index];
     // add noise using gaussian
-    p.sample (zero_mean, step_noise_covariance_);
+    p.sample (zero_mean, step_noise_covariance_, rng_);
     particles_->points.push_back (p);
   }
 }
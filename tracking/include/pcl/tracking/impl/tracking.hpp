@@ -63,6 +63,17 @@ namespace pcl
         yaw   += static_cast<float> (sampleNormal (mean[5], cov[5]));
       }
 
+      void
+      sample (const std::vector<double>& mean, const std::vector<double>& cov, pcl::common::Xoshiro128 &rng)
+      {
+        x     += static_cast<float> (sampleNormal (mean[0], cov[0], rng));
+        y     += static_cast<float> (sampleNormal (mean[1], cov[1], rng));
+        z     += static_cast<float> (sampleNormal (mean[2], cov[2], rng));
+        roll  += static_cast<float> (sampleNormal (mean[3], cov[3], rng));
+        pitch += static_cast<float> (sampleNormal (mean[4], cov[4], rng));
+        yaw   += static_cast<float> (sampleNormal (mean[5], cov[5], rng));
+      }
+
       void
       zero ()
       {
@@ -218,6 +229,17 @@ namespace pcl
         yaw   = 0;
       }
 
+      void
+      sample (const std::vector<double>& mean, const std::vector<double>& cov, pcl::common::Xoshiro128 &rng)
+      {
+        x     += static_cast<float> (sampleNormal (mean[0], cov[0], rng));
+        y     += static_cast<float> (sampleNormal (mean[1], cov[1], rng));
+        z     += static_cast<float> (sampleNormal (mean[2], cov[2], rng));
+        roll  = 0;
+        pitch += static_cast<float> (sampleNormal (mean[4], cov[4], rng));
+        yaw   = 0;
+      }
+
       void
       zero ()
       {
@@ -373,6 +395,17 @@ namespace pcl
         yaw   += static_cast<float> (sampleNormal (mean[5], cov[5]));
       }
 
+      void
+      sample (const std::vector<double>& mean, const std::vector<double>& cov, pcl::common::Xoshiro128 &rng)
+      {
+        x     += static_cast<float> (sampleNormal (mean[0], cov[0], rng));
+        y     = 0;
+        z     += static_cast<float> (sampleNormal (mean[2], cov[2], rng));
+        roll  += static_cast<float> (sampleNormal (mean[3], cov[3], rng));
+        pitch += static_cast<float> (sampleNormal (mean[4], cov[4], rng));
+        yaw   += static_cast<float> (sampleNormal (mean[5], cov[5], rng));
+      }
+
       void
       zero ()
       {
@@ -526,6 +559,17 @@ namespace pcl
         yaw   += static_cast<float> (sampleNormal (mean[5], cov[5]));
       }
 
+      void
+      sample (const std::vector<double>& mean, const std::vector<double>& cov, pcl::common::Xoshiro128 &rng)
+      {
+        x     += static_cast<float> (sampleNormal (mean[0], cov[0], rng));
+        y     = 0;
+        z     += static_cast<float> (sampleNormal (mean[2], cov[2], rng));
+        roll  = 0;
+        pitch += static_cast<float> (sampleNormal (mean[4], cov[4], rng));
+        yaw   += static_cast<float> (sampleNormal (mean[5], cov[5], rng));
+      }
+
       void
       zero ()
       {
@@ -679,6 +723,17 @@ namespace pcl
         yaw   = 0;
       }
 
+      void
+      sample (const std::vector<double>& mean, const std::vector<double>& cov, pcl::common::Xoshiro128 &rng)
+      {
+        x     += static_cast<float> (sampleNormal (mean[0], cov[0], rng));
+        y     = 0;
+        z     += static_cast<float> (sampleNormal (mean[2], cov[2], rng));
+        roll  = 0;
+        pitch += static_cast<float> (sampleNormal (mean[4], cov[4], rng));
+        yaw   = 0;
+      }
+
       void
       zero ()
       {
@@ -41,6 +41,7 @@ namespace pcl
       using ParticleFilterTracker<PointInT, StateT>::step_noise_covariance_;
       using ParticleFilterTracker<PointInT, StateT>::representative_state_;
       using ParticleFilterTracker<PointInT, StateT>::sampleWithReplacement;
+      using ParticleFilterTracker<PointInT, StateT>::rng_;
 
       typedef Tracker<PointInT, StateT> BaseClass;
       
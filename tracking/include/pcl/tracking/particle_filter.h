@@ -4,10 +4,12 @@
 #include <pcl/tracking/tracking.h>
 #include <pcl/tracking/tracker.h>
 #include <pcl/tracking/coherence.h>
+#include <pcl/common/random.h>
 #include <pcl/filters/passthrough.h>
 #include <pcl/octree/octree.h>
 
 #include <Eigen/Dense>
+#include <ctime>
 
 namespace pcl
 {
@@ -80,6 +82,7 @@ namespace pcl
         , change_detector_interval_ (10)
         , change_detector_resolution_ (0.01)
         , use_change_detector_ (false)
+        , rng_ (static_cast<unsigned> (std::time (0)))
         {
           tracker_name_ = "ParticleFilterTracker";
           pass_x_.setFilterFieldName ("x");
@@ -254,6 +257,12 @@ namespace pcl
         /** \brief Get the motion ratio. */
         inline double getMotionRatio () { return motion_ratio_;}
 
+        /** \brief Reseed the random number generator this tracker draws particles and their noise
+          * from, so that tracking runs are reproducible. Other trackers are not affected.
+          * \param[in] seed the random seed.
+          */
+        inline void setRandomSeed (unsigned int seed) { rng_.seed (seed); }
+
         /** \brief Set the number of interval frames to run change detection.
           * \param[in] change_detector_interval the number of interval frames.
           */
@@ -500,6 +509,9 @@ namespace pcl
         
         /** \brief The flag which will be true if using change detection. */
         bool use_change_detector_;
+
+        /** \brief Random number generator used to draw particles and their noise. */
+        pcl::common::Xoshiro128 rng_;
     };
   }
 }
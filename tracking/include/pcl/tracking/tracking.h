@@ -41,6 +41,8 @@
 #define PCL_TRACKING_TRACKING_H_
 
 #include <pcl/point_types.h>
+#include <pcl/common/random.h>
+#include <cmath>
 
 #ifdef BUILD_Maintainer
 #  if defined __GNUC__
@@ -61,6 +63,23 @@ namespace pcl
     /* \brief return the value of normal distribution */
     PCL_EXPORTS double
     sampleNormal (double mean, double sigma);
+
+    /** \brief Return a normally distributed value drawn from the given generator.
+      * \param[in] mean the mean of the distribution
+      * \param[in] sigma the variance of the distribution, as for sampleNormal (mean, sigma)
+      * \param[in] rng the generator to draw from
+      */
+    inline double
+    sampleNormal (double mean, double sigma, pcl::common::Xoshiro128 &rng)
+    {
+      return (mean + std::sqrt (sigma) * rng.nextNormal ());
+    }
+
+    /** \brief Reseed the process wide random number generator used by sampleNormal.
+      * \param[in] seed the new seed
+      */
+    PCL_EXPORTS void
+    setSampleNormalSeed (unsigned int seed);
   }
 }
 
@@ -36,17 +36,28 @@
  */
 
 #include <pcl/tracking/tracking.h>
+#include <pcl/common/random.h>
+#include <ctime>
+
+namespace
+{
+  /** \brief The generator shared by all calls to sampleNormal. */
+  pcl::common::Xoshiro128&
+  getSampleNormalGenerator ()
+  {
+    static pcl::common::Xoshiro128 rng (static_cast<unsigned> (std::time (0)));
+    return (rng);
+  }
+}
 
 double
 pcl::tracking::sampleNormal (double mean, double sigma)
 {
-  using namespace boost;
-  static mt19937 rng (static_cast<unsigned> (std::time (0)));
-  
-  normal_distribution<double> norm_dist (mean, sqrt (sigma));
-  
-  variate_generator<mt19937&, normal_distribution<double> >
-    normal_sampler (rng, norm_dist);
-  
-  return (normal_sampler ());
+  return (sampleNormal (mean, sigma, getSampleNormalGenerator ()));
+}
+
+void
+pcl::tracking::setSampleNormalSeed (unsigned int seed)
+{
+  getSampleNormalGenerator ().seed (seed);
 }